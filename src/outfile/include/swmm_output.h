@@ -32,6 +32,8 @@ extern "C" {
 int EXPORT_OUT_API SMO_init(SMO_Handle *p_handle);
 int EXPORT_OUT_API SMO_close(SMO_Handle p_handle);
 int EXPORT_OUT_API SMO_open(SMO_Handle p_handle, const char *path);
+int EXPORT_OUT_API SMO_openMapped(SMO_Handle p_handle, const char *path);
+int EXPORT_OUT_API SMO_openShared(SMO_Handle p_handle, SMO_Handle parent);
 int EXPORT_OUT_API SMO_getVersion(SMO_Handle p_handle, int *version);
 int EXPORT_OUT_API SMO_getProjectSize(SMO_Handle p_handle, int **int_out, int *int_dim);
 
@@ -39,11 +41,14 @@ int EXPORT_OUT_API SMO_getUnits(SMO_Handle p_handle, int **int_out, int *int_dim
 int EXPORT_OUT_API SMO_getStartDate(SMO_Handle p_handle, double *date);
 int EXPORT_OUT_API SMO_getTimes(SMO_Handle p_handle, SMO_time code, int *time);
 int EXPORT_OUT_API SMO_getElementName(SMO_Handle p_handle, SMO_elementType type, int elementIndex, char **elementName, int *size);
+int EXPORT_OUT_API SMO_transpose(SMO_Handle p_handle);
 
 int EXPORT_OUT_API SMO_getSubcatchSeries(SMO_Handle p_handle, int subcatchIndex, SMO_subcatchAttribute attr, int startPeriod, int endPeriod, float **float_out, int *int_dim);
 int EXPORT_OUT_API SMO_getNodeSeries(SMO_Handle p_handle, int nodeIndex, SMO_nodeAttribute attr, int startPeriod, int endPeriod, float **float_out, int *int_dim);
 int EXPORT_OUT_API SMO_getLinkSeries(SMO_Handle p_handle, int linkIndex, SMO_linkAttribute attr, int startPeriod, int endPeriod, float **float_out, int *int_dim);
 int EXPORT_OUT_API SMO_getSystemSeries(SMO_Handle p_handle, SMO_systemAttribute attr, int startPeriod, int endPeriod, float **float_out, int *int_dim);
+int EXPORT_OUT_API SMO_getSeriesBatch(SMO_Handle p_handle, SMO_elementType type, const int *indices, int count, int attr, int startPeriod, int endPeriod, float *float_out);
+int EXPORT_OUT_API SMO_getSeriesView(SMO_Handle p_handle, SMO_elementType type, int index, int attr, const float **float_out, int *stride, int *int_dim);
 
 int EXPORT_OUT_API SMO_getSubcatchAttribute(SMO_Handle p_handle, int timeIndex, SMO_subcatchAttribute attr, float **float_out, int *int_dim);
 int EXPORT_OUT_API SMO_getNodeAttribute(SMO_Handle p_handle, int timeIndex, SMO_nodeAttribute attr, float **float_out, int *int_dim);
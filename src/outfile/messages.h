@@ -26,6 +26,8 @@
 #define ERR434 "File Error 434: unable to open binary output file"
 #define ERR435 "File Error 435: invalid file - not created by SWMM"
 #define ERR436 "File Error 436: invalid file - contains no results"
+#define ERR437 "File Error 437: unable to write transposed results"
+#define ERR438 "File Error 438: results can't be viewed in place"
 
 #define ERR440 "ERROR 440: an unspecified error has occurred"
 
@@ -7,6 +7,27 @@
  *      Modified by: Michael E. Tryby,
  *                   Bryant McDonnell
  *
+ *      SMO_transpose writes a companion file holding the results in
+ *      element-major order. The SMO_get*Series functions read from it
+ *      whenever it is present and matches the output file.
+ *
+ *      SMO_openMapped maps the output file (and its companion) into
+ *      memory so that results are read without seeks or stdio calls.
+ *      SMO_getSeriesBatch fills a caller's buffer with the series of many
+ *      elements at once and SMO_getSeriesView returns a pointer straight
+ *      into the mapped results. SMO_openShared opens further handles on
+ *      a mapped handle's file that share its mappings, one per thread
+ *      that queries the file.
+ *
+ *      The header lists the codes of the variables saved for each type
+ *      of element, which may be a subset of all variables. Attribute
+ *      codes are mapped to the positions of the saved values and
+ *      variables that weren't saved are reported as invalid parameters.
+ *
+ *      Files saved with the engine's COMPRESS_OUTPUT option hold their
+ *      results in compressed chunks (see outcodec.h). The chunk holding a
+ *      requested period is decoded into a cache kept with the handle.
+ *
  */
 
 
@@ -15,11 +36,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "errormanager.h"
 #include "messages.h"
 
 #include "swmm_output.h"
+#include "shared/outcodec.h"
+
+#if defined(_WIN32) || defined(__WIN32__)
+  #define SMO_MAP_WINDOWS
+  #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+  #define SMO_MAP_POSIX
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+#endif
 
 
 // NOTE: These depend on machine data model and may change when porting
@@ -31,12 +64,29 @@
 #endif
 
 #define INT4 int      // Must be a 4 byte / 32 bit integer type
+#define INT8 long long  // Must be an 8 byte / 64 bit integer type
 #define REAL4 float   // Must be a 4 byte / 32 bit real type
 
 #define RECORDSIZE 4  // Memory alignment 4 byte word size for both int and real
 #define DATESIZE 8    // Dates are stored as 8 byte word size
 
 #define NELEMENTTYPES 5    // Number of element types
+
+// Transposed results companion file (<name>.tsp):
+//   header: magic, # periods, # values per period, # periods per tile
+//           (INT4 each), size and stamp of the output file it was made
+//           from (8 bytes each)
+//   body:   tiles of up to TilePeriods consecutive periods, each holding
+//           the series of every value in turn over the tile's periods
+// The stamp hashes the output file's modification time together with
+// TRANSPOSE_SAMPLES blocks of its contents spread evenly over the file and
+// its last block (which holds the closing records), so that a companion
+// made from an earlier run of the same size is not used.
+#define TRANSPOSE_MAGIC 0x32505354
+#define TRANSPOSE_HEADER (4 * RECORDSIZE + 16)
+#define TRANSPOSE_TILE_BYTES (32 * 1024 * 1024)    // target size of a tile
+#define TRANSPOSE_SAMPLES 64
+#define TRANSPOSE_SAMPLE_BYTES 4096
 #define MEMCHECK(x) (((x) == NULL) ? 414 : 0)
 
 
@@ -69,6 +119,14 @@ typedef struct Handle {
     int LinkVars;        // number of link reporting variables
     int SysVars;         // number of system reporting variables
 
+    int  SubcatchAttrs;    // number of subcatch attribute codes
+    int  NodeAttrs;        // number of node attribute codes
+    int  LinkAttrs;        // number of link attribute codes
+    int* SubcatchPos;      // position of each subcatch attribute's value
+    int* NodePos;          // position of each node attribute's value
+    int* LinkPos;          // position of each link attribute's value
+                           // (-1 if the attribute wasn't saved)
+
     double StartDate;     // start date of simulation
     int    ReportStep;    // reporting time step (seconds)
 
@@ -77,6 +135,27 @@ typedef struct Handle {
     F_OFF ResultsPos;        // file position where results start
     F_OFF BytesPerPeriod;    // bytes used for results in each period
 
+    FILE* tfile;          // transposed results companion file
+    int   TilePeriods;    // periods per tile of the companion file
+
+    int   mapped;         // TRUE if files are read through a mapping
+    char* map;            // mapped contents of the output file
+    F_OFF mapSize;        // size of the mapped output file
+    void* mapHandle;      // platform handle of the output file mapping
+    char* tmap;           // mapped contents of the companion file
+    F_OFF tmapSize;       // size of the mapped companion file
+    void* tmapHandle;     // platform handle of the companion file mapping
+
+    INT8* chunkIndex;     // position & first period of each compressed
+                          // chunk (NULL if results aren't compressed)
+    int   numChunks;      // number of compressed chunks
+    int   chunkLoaded;    // chunk held in chunkData (-1 if none)
+    int   chunkPeriods;   // number of periods held in chunkData
+    unsigned int* chunkData;    // decoded periods of a chunk
+
+    struct Handle* parent;    // handle whose header, names and mappings
+                              // are shared (NULL if they are owned)
+
     error_handle_t* error_handle;
 } data_t, *SMO_Handle;
 
@@ -88,6 +167,28 @@ void errorLookup(int errcode, char *errmsg, int length);
 int  validateFile(data_t *p_data);
 void initElementNames(data_t *p_data);
 
+void  companionName(const char *path, char *name);
+void  openTransposed(data_t *p_data);
+INT8  sourceStamp(data_t *p_data);
+int   writeTransposed(data_t *p_data, FILE *tfile);
+int   readTransposed(data_t *p_data, int valueIndex, int startPeriod,
+          int length, float *values);
+int   valuesPerPeriod(data_t *p_data);
+int   valueIndex(data_t *p_data, SMO_elementType type, int index, int attr);
+int   attrPosition(data_t *p_data, SMO_elementType type, int attr);
+int   readVarCodes(data_t *p_data, int numVars, int numAttrs, int **pos);
+void  readRecord(data_t *p_data, F_OFF offset, const int *pos, int numVars,
+          int numAttrs, float *values);
+F_OFF fileSize(FILE *f);
+
+int   mapFile(const char *path, char **data, F_OFF *size, void **handle);
+void  unmapFile(char **data, F_OFF *size, void **handle);
+int   readResults(data_t *p_data, F_OFF offset, void *dest, size_t bytes);
+int   readBytes(data_t *p_data, F_OFF offset, void *dest, size_t bytes);
+int   readChunkIndex(data_t *p_data);
+int   loadChunk(data_t *p_data, int chunk);
+int   readCompanion(data_t *p_data, F_OFF offset, void *dest, size_t bytes);
+
 double getTimeValue(data_t *p_data, int timeIndex);
 float  getSubcatchValue(data_t *p_data, int timeIndex, int subcatchIndex, SMO_subcatchAttribute attr);
 float  getNodeValue(data_t *p_data, int timeIndex, int nodeIndex, SMO_nodeAttribute attr);
@@ -143,7 +244,7 @@ int EXPORT_OUT_API SMO_close(SMO_Handle p_handle)
         errorcode = -1;
 
     else {
-        if (p_data->elementNames != NULL) {
+        if (p_data->elementNames != NULL && p_data->parent == NULL) {
             n = p_data->Nsubcatch + p_data->Nnodes + p_data->Nlinks +
                 p_data->Npolluts;
 
@@ -158,6 +259,21 @@ int EXPORT_OUT_API SMO_close(SMO_Handle p_handle)
         if (p_data->file != NULL)
             fclose(p_data->file);
 
+        if (p_data->tfile != NULL)
+            fclose(p_data->tfile);
+
+        // --- what a shared handle borrowed stays with its parent
+        if (p_data->parent == NULL) {
+            unmapFile(&p_data->map, &p_data->mapSize, &p_data->mapHandle);
+            unmapFile(&p_data->tmap, &p_data->tmapSize,
+                      &p_data->tmapHandle);
+
+            free(p_data->SubcatchPos);
+            free(p_data->NodePos);
+            free(p_data->LinkPos);
+            free(p_data->chunkIndex);
+        }
+        free(p_data->chunkData);
         free(p_data);
     }
 
@@ -208,19 +324,31 @@ int EXPORT_OUT_API SMO_open(SMO_Handle p_handle, const char *path)
             offset += p_data->ObjPropPos;
 
             // Read number & codes of computed variables
+            p_data->SubcatchAttrs =
+                SMO_pollutant_conc_subcatch + p_data->Npolluts;
+            p_data->NodeAttrs = SMO_pollutant_conc_node + p_data->Npolluts;
+            p_data->LinkAttrs = SMO_pollutant_conc_link + p_data->Npolluts;
+
             _fseek(p_data->file, offset, SEEK_SET);
             fread(&(p_data->SubcatchVars), RECORDSIZE, 1,
                   p_data->file);    // # Subcatch variables
+            err = readVarCodes(p_data, p_data->SubcatchVars,
+                p_data->SubcatchAttrs, &p_data->SubcatchPos);
 
-            _fseek(p_data->file, p_data->SubcatchVars * RECORDSIZE, SEEK_CUR);
             fread(&(p_data->NodeVars), RECORDSIZE, 1,
                   p_data->file);    // # Node variables
+            if (!err)
+                err = readVarCodes(p_data, p_data->NodeVars,
+                    p_data->NodeAttrs, &p_data->NodePos);
 
-            _fseek(p_data->file, p_data->NodeVars * RECORDSIZE, SEEK_CUR);
             fread(&(p_data->LinkVars), RECORDSIZE, 1,
                   p_data->file);    // # Link variables
+            if (!err)
+                err = readVarCodes(p_data, p_data->LinkVars,
+                    p_data->LinkAttrs, &p_data->LinkPos);
+            if (err)
+                errorcode = err;
 
-            _fseek(p_data->file, p_data->LinkVars * RECORDSIZE, SEEK_CUR);
             fread(&(p_data->SysVars), RECORDSIZE, 1,
                   p_data->file);    // # System variables
 
@@ -238,6 +366,13 @@ int EXPORT_OUT_API SMO_open(SMO_Handle p_handle, const char *path)
                  p_data->Nnodes * p_data->NodeVars +
                  p_data->Nlinks * p_data->LinkVars + p_data->SysVars) *
                     RECORDSIZE;
+
+            // --- find the chunks of compressed results
+            if (!err && (err = readChunkIndex(p_data)) != 0)
+                errorcode = err;
+
+            // --- use transposed results if they were saved
+            openTransposed(p_data);
         }
     }
     // If error close the binary file
@@ -249,6 +384,100 @@ int EXPORT_OUT_API SMO_open(SMO_Handle p_handle, const char *path)
     return errorcode;
 }
 
+int EXPORT_OUT_API SMO_openMapped(SMO_Handle p_handle, const char *path)
+//
+//  Purpose: Opens the output binary file like SMO_open and maps its
+//  contents into memory, from where all results are then read.
+//
+//  Note: If the file can't be mapped it is read through stdio as usual.
+//  A handle records the last error and caches the decoded chunk of a
+//  compressed file, so it must only be used by one thread at a time.
+//  Threads that query the file at the same time should each use a handle
+//  opened on this one with SMO_openShared.
+//
+{
+    int     errorcode;
+    data_t *p_data;
+
+    p_data = (data_t *)p_handle;
+
+    if (p_data == NULL)
+        return -1;
+
+    errorcode = SMO_open(p_handle, path);
+    if (errorcode < 400) {
+        p_data->mapped = 1;
+        if (!mapFile(p_data->name, &p_data->map, &p_data->mapSize,
+                &p_data->mapHandle))
+            p_data->mapped = 0;
+
+        // --- map the transposed results found by SMO_open
+        else if (p_data->tfile != NULL) {
+            fclose(p_data->tfile);
+            openTransposed(p_data);
+        }
+    }
+    return errorcode;
+}
+
+int EXPORT_OUT_API SMO_openShared(SMO_Handle p_handle, SMO_Handle parent)
+//
+//  Purpose: Opens the file of an open (normally mapped) parent handle,
+//  sharing the parent's header, element names and mappings rather than
+//  reading and mapping the file again.
+//
+//  Note: Only what the parent holds read-only is shared; the new handle
+//  keeps its own error status, decoded chunk and stdio streams, so that
+//  several threads may query the file at once through a shared handle
+//  each. The parent must be opened and shared on one thread, must stay
+//  open while its shared handles are, and can't be transposed meanwhile.
+//
+{
+    int     errorcode = 0;
+    char    name[MAXFILENAME + 1];
+    data_t  *p_data, *p_parent;
+    error_handle_t *error_handle;
+
+    p_data   = (data_t *)p_handle;
+    p_parent = (data_t *)parent;
+
+    if (p_data == NULL)
+        return -1;
+    else if (p_parent == NULL || p_parent->file == NULL)
+        errorcode = 434;
+    else {
+        if (p_parent->parent != NULL)
+            p_parent = p_parent->parent;
+
+        // --- read the names the handles will share while still on the
+        //     parent's thread
+        if (p_parent->elementNames == NULL)
+            initElementNames(p_parent);
+
+        error_handle  = p_data->error_handle;
+        *p_data       = *p_parent;
+        p_data->error_handle = error_handle;
+        p_data->parent       = p_parent;
+        p_data->chunkLoaded  = -1;
+        p_data->chunkPeriods = 0;
+        p_data->chunkData    = NULL;
+
+        // --- streams used when reading without a mapping are our own
+        p_data->tfile = NULL;
+        if (_fopen(&p_data->file, p_data->name, "rb") != 0) {
+            p_data->file = NULL;
+            errorcode = 434;
+        }
+        else if (p_parent->tfile != NULL) {
+            companionName(p_data->name, name);
+            if (_fopen(&p_data->tfile, name, "rb") != 0)
+                p_data->tfile = NULL;
+        }
+    }
+
+    return set_error(p_data->error_handle, errorcode);
+}
+
 int EXPORT_OUT_API SMO_getVersion(SMO_Handle p_handle, int *version)
 //
 //  Input:   p_handle = pointer to SMO_Handle struct
@@ -471,6 +700,49 @@ int EXPORT_OUT_API SMO_getElementName(SMO_Handle p_handle, SMO_elementType type,
     return set_error(p_data->error_handle, errorcode);
 }
 
+int EXPORT_OUT_API SMO_transpose(SMO_Handle p_handle)
+//
+//  Purpose: Writes the results in element-major order to a companion
+//  file (the output file's name with a .tsp extension) and uses it for
+//  all subsequent series requests.
+//
+{
+    int    errorcode = 0;
+    char   name[MAXFILENAME + 1];
+    FILE   *tfile;
+    data_t *p_data;
+
+    p_data = (data_t *)p_handle;
+
+    if (p_data == NULL)
+        return -1;
+    else if (p_data->file == NULL)
+        errorcode = 411;
+    else if (p_data->parent != NULL)
+        errorcode = 437;
+    else {
+        if (p_data->tfile != NULL) {
+            fclose(p_data->tfile);
+            p_data->tfile = NULL;
+        }
+        unmapFile(&p_data->tmap, &p_data->tmapSize, &p_data->tmapHandle);
+        companionName(p_data->name, name);
+        if (_fopen(&tfile, name, "wb") != 0)
+            errorcode = 437;
+        else {
+            errorcode = writeTransposed(p_data, tfile);
+            if (fclose(tfile) != 0 && !errorcode)
+                errorcode = 437;
+            if (errorcode)
+                remove(name);
+            else
+                openTransposed(p_data);
+        }
+    }
+
+    return set_error(p_data->error_handle, errorcode);
+}
+
 int EXPORT_OUT_API SMO_getSubcatchSeries(SMO_Handle p_handle, int subcatchIndex,
     SMO_subcatchAttribute attr, int startPeriod, int endPeriod,
     float **outValueArray, int *length)
@@ -489,6 +761,8 @@ int EXPORT_OUT_API SMO_getSubcatchSeries(SMO_Handle p_handle, int subcatchIndex,
         errorcode = -1;
     else if (subcatchIndex < 0 || subcatchIndex > p_data->Nsubcatch)
         errorcode = 420;
+    else if (attrPosition(p_data, SMO_subcatch, attr) < 0)
+        errorcode = 421;
     else if (startPeriod < 0 || startPeriod >= p_data->Nperiods ||
              endPeriod <= startPeriod)
         errorcode = 422;
@@ -497,10 +771,12 @@ int EXPORT_OUT_API SMO_getSubcatchSeries(SMO_Handle p_handle, int subcatchIndex,
         MEMCHECK(temp = newFloatArray(len = endPeriod - startPeriod))
     errorcode = 411;
     else {
-        // loop over and build time series
-        for (k = 0; k < len; k++)
-            temp[k] =
-                getSubcatchValue(p_data, startPeriod + k, subcatchIndex, attr);
+        // read series from transposed results or loop over and build it
+        k = valueIndex(p_data, SMO_subcatch, subcatchIndex, attr);
+        if (!readTransposed(p_data, k, startPeriod, len, temp))
+            for (k = 0; k < len; k++)
+                temp[k] = getSubcatchValue(p_data, startPeriod + k,
+                                           subcatchIndex, attr);
 
         *outValueArray = temp;
         *length         = len;
@@ -527,6 +803,8 @@ int EXPORT_OUT_API SMO_getNodeSeries(SMO_Handle p_handle, int nodeIndex,
         errorcode = -1;
     else if (nodeIndex < 0 || nodeIndex > p_data->Nnodes)
         errorcode = 420;
+    else if (attrPosition(p_data, SMO_node, attr) < 0)
+        errorcode = 421;
     else if (startPeriod < 0 || startPeriod >= p_data->Nperiods ||
              endPeriod <= startPeriod)
         errorcode = 422;
@@ -535,9 +813,11 @@ int EXPORT_OUT_API SMO_getNodeSeries(SMO_Handle p_handle, int nodeIndex,
         MEMCHECK(temp = newFloatArray(len = endPeriod - startPeriod))
     errorcode = 411;
     else {
-        // loop over and build time series
-        for (k = 0; k < len; k++)
-            temp[k] = getNodeValue(p_data, startPeriod + k, nodeIndex, attr);
+        // read series from transposed results or loop over and build it
+        k = valueIndex(p_data, SMO_node, nodeIndex, attr);
+        if (!readTransposed(p_data, k, startPeriod, len, temp))
+            for (k = 0; k < len; k++)
+                temp[k] = getNodeValue(p_data, startPeriod + k, nodeIndex, attr);
 
         *outValueArray = temp;
         *length         = len;
@@ -564,6 +844,8 @@ int EXPORT_OUT_API SMO_getLinkSeries(SMO_Handle p_handle, int linkIndex,
         errorcode = -1;
     else if (linkIndex < 0 || linkIndex > p_data->Nlinks)
         errorcode = 420;
+    else if (attrPosition(p_data, SMO_link, attr) < 0)
+        errorcode = 421;
     else if (startPeriod < 0 || startPeriod >= p_data->Nperiods ||
              endPeriod <= startPeriod)
         errorcode = 422;
@@ -572,9 +854,11 @@ int EXPORT_OUT_API SMO_getLinkSeries(SMO_Handle p_handle, int linkIndex,
         MEMCHECK(temp = newFloatArray(len = endPeriod - startPeriod))
     errorcode = 411;
     else {
-        // loop over and build time series
-        for (k = 0; k < len; k++)
-            temp[k] = getLinkValue(p_data, startPeriod + k, linkIndex, attr);
+        // read series from transposed results or loop over and build it
+        k = valueIndex(p_data, SMO_link, linkIndex, attr);
+        if (!readTransposed(p_data, k, startPeriod, len, temp))
+            for (k = 0; k < len; k++)
+                temp[k] = getLinkValue(p_data, startPeriod + k, linkIndex, attr);
 
         *outValueArray = temp;
         *length         = len;
@@ -598,6 +882,8 @@ int EXPORT_OUT_API SMO_getSystemSeries(SMO_Handle p_handle, SMO_systemAttribute
 
     if (p_data == NULL)
         errorcode = -1;
+    else if (attrPosition(p_data, SMO_sys, attr) < 0)
+        errorcode = 421;
     else if (startPeriod < 0 || startPeriod >= p_data->Nperiods ||
              endPeriod <= startPeriod)
         errorcode = 422;
@@ -606,9 +892,11 @@ int EXPORT_OUT_API SMO_getSystemSeries(SMO_Handle p_handle, SMO_systemAttribute
         MEMCHECK(temp = newFloatArray(len = endPeriod - startPeriod))
     errorcode = 411;
     else {
-        // loop over and build time series
-        for (k = 0; k < len; k++)
-            temp[k] = getSystemValue(p_data, startPeriod + k, attr);
+        // read series from transposed results or loop over and build it
+        k = valueIndex(p_data, SMO_sys, 0, attr);
+        if (!readTransposed(p_data, k, startPeriod, len, temp))
+            for (k = 0; k < len; k++)
+                temp[k] = getSystemValue(p_data, startPeriod + k, attr);
 
         *outValueArray = temp;
         *length         = len;
@@ -617,6 +905,123 @@ int EXPORT_OUT_API SMO_getSystemSeries(SMO_Handle p_handle, SMO_systemAttribute
     return set_error(p_data->error_handle, errorcode);
 }
 
+int EXPORT_OUT_API SMO_getSeriesBatch(SMO_Handle p_handle,
+    SMO_elementType type, const int *indices, int count, int attr,
+    int startPeriod, int endPeriod, float *outValues)
+//
+//  Purpose: Gets the series of an attribute over a range of periods for a
+//  list of elements of one type (the index is ignored for the system).
+//  outValues must hold count * (endPeriod - startPeriod) values; the series
+//  of indices[i] is placed at outValues + i * (endPeriod - startPeriod).
+//
+{
+    int    i, k, len, errorcode = 0;
+    int    *values = NULL;
+    F_OFF  offset;
+    data_t *p_data;
+
+    p_data = (data_t *)p_handle;
+
+    if (p_data == NULL)
+        return -1;
+    else if (type < SMO_subcatch || type > SMO_sys || count < 0 ||
+             (count > 0 && (indices == NULL || outValues == NULL)))
+        errorcode = 421;
+    else if (startPeriod < 0 || endPeriod > p_data->Nperiods ||
+             endPeriod <= startPeriod)
+        errorcode = 422;
+    else if (count > 0 && MEMCHECK(values = newIntArray(count)))
+        errorcode = 411;
+    else {
+        len = endPeriod - startPeriod;
+        for (i = 0; i < count; i++) {
+            values[i] = valueIndex(p_data, type, indices[i], attr);
+            if (values[i] < 0)
+                errorcode = 423;
+        }
+        if (attrPosition(p_data, type, attr) < 0)
+            errorcode = 421;
+
+        // --- read each series from the transposed results if available
+        for (i = 0; i < count && !errorcode; i++) {
+            if (!readTransposed(p_data, values[i], startPeriod, len,
+                    outValues + (size_t)i * len))
+                break;
+        }
+
+        // --- otherwise visit the periods in file order, picking out
+        //     the values of each element
+        if (i < count && !errorcode) {
+            for (k = 0; k < len; k++) {
+                offset = p_data->ResultsPos +
+                         (F_OFF)(startPeriod + k) * p_data->BytesPerPeriod +
+                         DATESIZE;
+                for (i = 0; i < count; i++)
+                    readResults(p_data,
+                        offset + (F_OFF)values[i] * RECORDSIZE,
+                        outValues + (size_t)i * len + k, RECORDSIZE);
+            }
+        }
+        free(values);
+    }
+
+    return set_error(p_data->error_handle, errorcode);
+}
+
+int EXPORT_OUT_API SMO_getSeriesView(SMO_Handle p_handle,
+    SMO_elementType type, int index, int attr, const float **values,
+    int *stride, int *length)
+//
+//  Purpose: Returns a read-only view of an attribute's series over all
+//  periods in a mapped file without copying it. The value of period k is
+//  at (*values)[k * *stride]. The view stays valid until the handle is
+//  closed and must not be freed.
+//
+//  Note: Views are only available for mapped handles. The series is
+//  contiguous (stride 1) when the transposed results hold it in a single
+//  tile, otherwise the stride steps over each period in the output file
+//  (which compressed files can't provide).
+//
+{
+    int    k, errorcode = 0;
+    F_OFF  offset;
+    data_t *p_data;
+
+    p_data = (data_t *)p_handle;
+
+    *values = NULL;
+    *stride = 0;
+    *length = 0;
+
+    if (p_data == NULL)
+        return -1;
+    else if ((k = valueIndex(p_data, type, index, attr)) < 0)
+        errorcode = 423;
+    else if (p_data->tmap != NULL &&
+             p_data->TilePeriods >= p_data->Nperiods) {
+        offset  = TRANSPOSE_HEADER +
+                  (F_OFF)k * p_data->Nperiods * RECORDSIZE;
+        *values = (const float *)(p_data->tmap + offset);
+        *stride = 1;
+        *length = p_data->Nperiods;
+    }
+    else {
+        // --- view into the output file needs its results to be aligned
+        offset = p_data->ResultsPos + DATESIZE + (F_OFF)k * RECORDSIZE;
+        if (p_data->map == NULL || p_data->chunkIndex != NULL ||
+            offset % RECORDSIZE != 0 ||
+            p_data->BytesPerPeriod % RECORDSIZE != 0)
+            errorcode = 438;
+        else {
+            *values = (const float *)(p_data->map + offset);
+            *stride = (int)(p_data->BytesPerPeriod / RECORDSIZE);
+            *length = p_data->Nperiods;
+        }
+    }
+
+    return set_error(p_data->error_handle, errorcode);
+}
+
 int EXPORT_OUT_API SMO_getSubcatchAttribute(SMO_Handle p_handle, int periodIndex,
     SMO_subcatchAttribute attr, float **outValueArray, int *length)
 //
@@ -633,6 +1038,8 @@ int EXPORT_OUT_API SMO_getSubcatchAttribute(SMO_Handle p_handle, int periodIndex
         errorcode = -1;
     else if (periodIndex < 0 || periodIndex >= p_data->Nperiods)
         errorcode = 422;
+    else if (attrPosition(p_data, SMO_subcatch, attr) < 0)
+        errorcode = 421;
     // Check memory for outValues
     else if
         MEMCHECK(temp = newFloatArray(p_data->Nsubcatch)) errorcode = 411;
@@ -664,6 +1071,8 @@ int EXPORT_OUT_API SMO_getNodeAttribute(SMO_Handle p_handle, int periodIndex,
         errorcode = -1;
     else if (periodIndex < 0 || periodIndex >= p_data->Nperiods)
         errorcode = 422;
+    else if (attrPosition(p_data, SMO_node, attr) < 0)
+        errorcode = 421;
     // Check memory for outValues
     else if
         MEMCHECK(temp = newFloatArray(p_data->Nnodes)) errorcode = 411;
@@ -695,6 +1104,8 @@ int EXPORT_OUT_API SMO_getLinkAttribute(SMO_Handle p_handle, int periodIndex,
         errorcode = -1;
     else if (periodIndex < 0 || periodIndex >= p_data->Nperiods)
         errorcode = 422;
+    else if (attrPosition(p_data, SMO_link, attr) < 0)
+        errorcode = 421;
     // Check memory for outValues
     else if
         MEMCHECK(temp = newFloatArray(p_data->Nlinks)) errorcode = 411;
@@ -726,6 +1137,8 @@ int EXPORT_OUT_API SMO_getSystemAttribute(SMO_Handle p_handle, int periodIndex,
         errorcode = -1;
     else if (periodIndex < 0 || periodIndex >= p_data->Nperiods)
         errorcode = 422;
+    else if (attrPosition(p_data, SMO_sys, attr) < 0)
+        errorcode = 421;
     else if
         MEMCHECK(temp = newFloatArray(1)) errorcode = 411;
     else {
@@ -759,7 +1172,7 @@ int EXPORT_OUT_API SMO_getSubcatchResult(SMO_Handle p_handle, int periodIndex,
     else if (subcatchIndex < 0 || subcatchIndex > p_data->Nsubcatch)
         errorcode = 423;
     else if
-        MEMCHECK(temp = newFloatArray(p_data->SubcatchVars)) errorcode = 411;
+        MEMCHECK(temp = newFloatArray(p_data->SubcatchAttrs)) errorcode = 411;
     else {
         // --- compute offset into output file
         offset = p_data->ResultsPos + (periodIndex)*p_data->BytesPerPeriod +
@@ -767,11 +1180,11 @@ int EXPORT_OUT_API SMO_getSubcatchResult(SMO_Handle p_handle, int periodIndex,
         // add offset for subcatchment
         offset += (subcatchIndex * p_data->SubcatchVars) * RECORDSIZE;
 
-        _fseek(p_data->file, offset, SEEK_SET);
-        fread(temp, RECORDSIZE, p_data->SubcatchVars, p_data->file);
+        readRecord(p_data, offset, p_data->SubcatchPos, p_data->SubcatchVars,
+                   p_data->SubcatchAttrs, temp);
 
         *outValueArray = temp;
-        *arrayLength   = p_data->SubcatchVars;
+        *arrayLength   = p_data->SubcatchAttrs;
     }
 
     return set_error(p_data->error_handle, errorcode);
@@ -797,7 +1210,7 @@ int EXPORT_OUT_API SMO_getNodeResult(SMO_Handle p_handle, int periodIndex,
     else if (nodeIndex < 0 || nodeIndex > p_data->Nnodes)
         errorcode = 423;
     else if
-        MEMCHECK(temp = newFloatArray(p_data->NodeVars)) errorcode = 411;
+        MEMCHECK(temp = newFloatArray(p_data->NodeAttrs)) errorcode = 411;
     else {
         // calculate byte offset to start time for series
         offset = p_data->ResultsPos + (periodIndex)*p_data->BytesPerPeriod +
@@ -807,11 +1220,11 @@ int EXPORT_OUT_API SMO_getNodeResult(SMO_Handle p_handle, int periodIndex,
                    nodeIndex * p_data->NodeVars) *
                   RECORDSIZE;
 
-        _fseek(p_data->file, offset, SEEK_SET);
-        fread(temp, RECORDSIZE, p_data->NodeVars, p_data->file);
+        readRecord(p_data, offset, p_data->NodePos, p_data->NodeVars,
+                   p_data->NodeAttrs, temp);
 
         *outValueArray = temp;
-        *arrayLength   = p_data->NodeVars;
+        *arrayLength   = p_data->NodeAttrs;
     }
 
     return set_error(p_data->error_handle, errorcode);
@@ -837,7 +1250,7 @@ int EXPORT_OUT_API SMO_getLinkResult(SMO_Handle p_handle, int periodIndex,
     else if (linkIndex < 0 || linkIndex > p_data->Nlinks)
         errorcode = 423;
     else if
-        MEMCHECK(temp = newFloatArray(p_data->LinkVars)) errorcode = 411;
+        MEMCHECK(temp = newFloatArray(p_data->LinkAttrs)) errorcode = 411;
     else {
         // calculate byte offset to start time for series
         offset = p_data->ResultsPos + (periodIndex)*p_data->BytesPerPeriod +
@@ -848,11 +1261,11 @@ int EXPORT_OUT_API SMO_getLinkResult(SMO_Handle p_handle, int periodIndex,
              p_data->Nnodes * p_data->NodeVars + linkIndex * p_data->LinkVars) *
             RECORDSIZE;
 
-        _fseek(p_data->file, offset, SEEK_SET);
-        fread(temp, RECORDSIZE, p_data->LinkVars, p_data->file);
+        readRecord(p_data, offset, p_data->LinkPos, p_data->LinkVars,
+                   p_data->LinkAttrs, temp);
 
         *outValueArray = temp;
-        *arrayLength   = p_data->LinkVars;
+        *arrayLength   = p_data->LinkAttrs;
     }
 
     return set_error(p_data->error_handle, errorcode);
@@ -888,8 +1301,7 @@ int EXPORT_OUT_API SMO_getSystemResult(SMO_Handle p_handle, int periodIndex,
                    p_data->Nlinks * p_data->LinkVars) *
                   RECORDSIZE;
 
-        _fseek(p_data->file, offset, SEEK_SET);
-        fread(temp, RECORDSIZE, p_data->SysVars, p_data->file);
+        readResults(p_data, offset, temp, p_data->SysVars * RECORDSIZE);
 
         *outValueArray = temp;
         *arrayLength   = p_data->SysVars;
@@ -968,6 +1380,12 @@ void errorLookup(int errcode, char *dest_msg, int dest_len)
         case 436:
             msg = ERR436;
             break;
+        case 437:
+            msg = ERR437;
+            break;
+        case 438:
+            msg = ERR438;
+            break;
         default:
             msg = ERR440;
     }
@@ -1029,6 +1447,602 @@ void initElementNames(data_t *p_data) {
     }
 }
 
+void companionName(const char *path, char *name)
+//
+//  Purpose: Makes the name of the transposed results file that goes with
+//  an output file by replacing the output file's extension with .tsp.
+//
+{
+    char *ext, *sep;
+
+    strncpy(name, path, MAXFILENAME);
+    name[MAXFILENAME] = '\0';
+    ext = strrchr(name, '.');
+    sep = strrchr(name, '/');
+    if (sep == NULL || strrchr(name, '\\') > sep)
+        sep = strrchr(name, '\\');
+    if (ext == NULL || (sep != NULL && ext < sep))
+        ext = name + strlen(name);
+    if (ext - name + 4 <= MAXFILENAME)
+        strcpy(ext, ".tsp");
+}
+
+int valueIndex(data_t *p_data, SMO_elementType type, int index, int attr)
+//
+//  Purpose: Returns the position of an element's attribute among the
+//  REAL4 values saved each period or -1 if there is no such value.
+//
+{
+    int pos = attrPosition(p_data, type, attr);
+
+    if (pos < 0)
+        return -1;
+    switch (type) {
+        case SMO_subcatch:
+            if (index < 0 || index >= p_data->Nsubcatch)
+                return -1;
+            return index * p_data->SubcatchVars + pos;
+
+        case SMO_node:
+            if (index < 0 || index >= p_data->Nnodes)
+                return -1;
+            return p_data->Nsubcatch * p_data->SubcatchVars +
+                   index * p_data->NodeVars + pos;
+
+        case SMO_link:
+            if (index < 0 || index >= p_data->Nlinks)
+                return -1;
+            return p_data->Nsubcatch * p_data->SubcatchVars +
+                   p_data->Nnodes * p_data->NodeVars +
+                   index * p_data->LinkVars + pos;
+
+        default:
+            return p_data->Nsubcatch * p_data->SubcatchVars +
+                   p_data->Nnodes * p_data->NodeVars +
+                   p_data->Nlinks * p_data->LinkVars + pos;
+    }
+}
+
+int attrPosition(data_t *p_data, SMO_elementType type, int attr)
+//
+//  Purpose: Returns the position of an attribute's value among those
+//  saved for an element of a given type or -1 if it wasn't saved.
+//
+{
+    switch (type) {
+        case SMO_subcatch:
+            if (attr < 0 || attr >= p_data->SubcatchAttrs)
+                return -1;
+            return p_data->SubcatchPos[attr];
+
+        case SMO_node:
+            if (attr < 0 || attr >= p_data->NodeAttrs)
+                return -1;
+            return p_data->NodePos[attr];
+
+        case SMO_link:
+            if (attr < 0 || attr >= p_data->LinkAttrs)
+                return -1;
+            return p_data->LinkPos[attr];
+
+        case SMO_sys:
+            if (attr < 0 || attr >= p_data->SysVars)
+                return -1;
+            return attr;
+
+        default:
+            return -1;
+    }
+}
+
+int readVarCodes(data_t *p_data, int numVars, int numAttrs, int **pos)
+//
+//  Purpose: Reads the codes of the variables saved for a type of element
+//  and records the position of each attribute's value (-1 if not saved).
+//  Returns an error code.
+//
+{
+    int i, code;
+
+    free(*pos);
+    if (MEMCHECK(*pos = newIntArray(numAttrs)))
+        return 411;
+    for (i = 0; i < numAttrs; i++)
+        (*pos)[i] = -1;
+    for (i = 0; i < numVars; i++) {
+        if (fread(&code, RECORDSIZE, 1, p_data->file) < 1)
+            return 435;
+        if (code >= 0 && code < numAttrs)
+            (*pos)[code] = i;
+    }
+    return 0;
+}
+
+void readRecord(data_t *p_data, F_OFF offset, const int *pos, int numVars,
+    int numAttrs, float *values)
+//
+//  Purpose: Reads the values saved for an element at the given offset
+//  into a vector of all its attributes, setting those not saved to 0.
+//
+{
+    int   i;
+    float *saved;
+
+    if (numVars == numAttrs) {
+        readResults(p_data, offset, values, numVars * RECORDSIZE);
+        return;
+    }
+    for (i = 0; i < numAttrs; i++)
+        values[i] = 0.0f;
+    if (numVars <= 0 || (saved = newFloatArray(numVars)) == NULL)
+        return;
+    readResults(p_data, offset, saved, numVars * RECORDSIZE);
+    for (i = 0; i < numAttrs; i++)
+        if (pos[i] >= 0)
+            values[i] = saved[pos[i]];
+    free(saved);
+}
+
+int valuesPerPeriod(data_t *p_data)
+//
+//  Purpose: Returns the number of REAL4 values saved each period.
+//
+{
+    return (int)((p_data->BytesPerPeriod - DATESIZE) / RECORDSIZE);
+}
+
+F_OFF fileSize(FILE *f)
+//
+//  Purpose: Returns the size of a file (leaving it positioned at its end).
+//
+{
+    if (_fseek(f, 0, SEEK_END) != 0)
+        return -1;
+    return _ftell(f);
+}
+
+void openTransposed(data_t *p_data)
+//
+//  Purpose: Opens the output file's transposed results companion if it
+//  exists and was made from the same results.
+//
+{
+    char  name[MAXFILENAME + 1];
+    INT4  header[4];
+    F_OFF sourceSize, expected;
+    INT8  stamp;
+    FILE  *tfile;
+
+    p_data->tfile = NULL;
+    companionName(p_data->name, name);
+    if (strcmp(name, p_data->name) == 0 || _fopen(&tfile, name, "rb") != 0)
+        return;
+
+    expected = TRANSPOSE_HEADER + (F_OFF)p_data->Nperiods *
+               valuesPerPeriod(p_data) * RECORDSIZE;
+    if (fread(header, RECORDSIZE, 4, tfile) == 4 &&
+        fread(&sourceSize, 8, 1, tfile) == 1 &&
+        fread(&stamp, 8, 1, tfile) == 1 &&
+        header[0] == TRANSPOSE_MAGIC &&
+        header[1] == p_data->Nperiods &&
+        header[2] == valuesPerPeriod(p_data) &&
+        header[3] > 0 &&
+        sourceSize == fileSize(p_data->file) &&
+        fileSize(tfile) == expected &&
+        stamp == sourceStamp(p_data)) {
+        p_data->tfile       = tfile;
+        p_data->TilePeriods = header[3];
+        if (p_data->mapped)
+            mapFile(name, &p_data->tmap, &p_data->tmapSize,
+                    &p_data->tmapHandle);
+    }
+    else
+        fclose(tfile);
+}
+
+INT8 sourceStamp(data_t *p_data)
+//
+//  Purpose: Returns a 64-bit FNV-1a hash of the output file's modification
+//  time, of TRANSPOSE_SAMPLES blocks spread evenly over its contents and
+//  of its last block.
+//
+{
+    unsigned char      buf[TRANSPOSE_SAMPLE_BYTES];
+    unsigned long long hash = 14695981039346656037ULL;
+    struct stat        st;
+    INT8               mtime = 0;
+    F_OFF              size, offset;
+    size_t             n, i;
+    int                s;
+
+    if (stat(p_data->name, &st) == 0)
+        mtime = (INT8)st.st_mtime;
+    for (i = 0; i < sizeof(mtime); i++) {
+        hash ^= (unsigned char)(mtime >> (8 * i));
+        hash *= 1099511628211ULL;
+    }
+
+    size = fileSize(p_data->file);
+    n = TRANSPOSE_SAMPLE_BYTES;
+    if ((F_OFF)n > size)
+        n = (size_t)size;
+    for (s = 0; s <= TRANSPOSE_SAMPLES; s++) {
+        if (s < TRANSPOSE_SAMPLES)
+            offset = (size - (F_OFF)n) / TRANSPOSE_SAMPLES * s;
+        else
+            offset = size - (F_OFF)n;
+        if (!readBytes(p_data, offset, buf, n))
+            break;
+        for (i = 0; i < n; i++) {
+            hash ^= buf[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+    return (INT8)hash;
+}
+
+int writeTransposed(data_t *p_data, FILE *tfile)
+//
+//  Purpose: Writes the results of all periods to the transposed results
+//  file one tile of consecutive periods at a time.
+//
+{
+    INT4   header[4];
+    F_OFF  sourceSize;
+    INT8   stamp;
+    int    nValues = valuesPerPeriod(p_data);
+    int    nTile, t0, nt, t, v, v0, v1;
+    char   *rows;
+    float  *cols, *row;
+
+    // --- size tiles to hold as many periods as fit in TRANSPOSE_TILE_BYTES
+    nTile = (int)(TRANSPOSE_TILE_BYTES / p_data->BytesPerPeriod);
+    if (nTile < 1)
+        nTile = 1;
+    if (nTile > p_data->Nperiods)
+        nTile = p_data->Nperiods;
+
+    rows = (char *)malloc((size_t)nTile * p_data->BytesPerPeriod);
+    cols = newFloatArray(nTile * nValues);
+    if (rows == NULL || cols == NULL) {
+        free(rows);
+        free(cols);
+        return 411;
+    }
+
+    // --- write header with no magic number until the body is complete
+    sourceSize = fileSize(p_data->file);
+    stamp      = sourceStamp(p_data);
+    header[0]  = 0;
+    header[1]  = p_data->Nperiods;
+    header[2]  = nValues;
+    header[3]  = nTile;
+    fwrite(header, RECORDSIZE, 4, tfile);
+    fwrite(&sourceSize, 8, 1, tfile);
+    fwrite(&stamp, 8, 1, tfile);
+
+    for (t0 = 0; t0 < p_data->Nperiods; t0 += nTile) {
+        // --- read the tile's periods with a single read
+        nt = p_data->Nperiods - t0;
+        if (nt > nTile)
+            nt = nTile;
+        if (!readResults(p_data,
+                p_data->ResultsPos + (F_OFF)t0 * p_data->BytesPerPeriod,
+                rows, (size_t)nt * p_data->BytesPerPeriod))
+            break;
+
+        // --- transpose them in blocks of values to stay in cache
+        for (v0 = 0; v0 < nValues; v0 += 256) {
+            v1 = v0 + 256;
+            if (v1 > nValues)
+                v1 = nValues;
+            for (t = 0; t < nt; t++) {
+                row = (float *)(rows + t * p_data->BytesPerPeriod + DATESIZE);
+                for (v = v0; v < v1; v++)
+                    cols[(size_t)v * nt + t] = row[v];
+            }
+        }
+        if (fwrite(cols, RECORDSIZE, (size_t)nt * nValues, tfile) !=
+            (size_t)nt * nValues)
+            break;
+    }
+    free(rows);
+    free(cols);
+    if (t0 < p_data->Nperiods)
+        return 437;
+
+    // --- mark the file as complete
+    header[0] = TRANSPOSE_MAGIC;
+    if (_fseek(tfile, 0, SEEK_SET) != 0 ||
+        fwrite(header, RECORDSIZE, 1, tfile) != 1)
+        return 437;
+    return 0;
+}
+
+int readTransposed(data_t *p_data, int valueIndex, int startPeriod,
+    int length, float *values)
+//
+//  Purpose: Reads a value's series over a range of periods from the
+//  transposed results file, returning 1 if successful and 0 if not.
+//
+{
+    int   p, t0, nt, n;
+    F_OFF offset;
+    F_OFF tileBytes;
+
+    if (p_data->tfile == NULL || valueIndex < 0 ||
+        valueIndex >= valuesPerPeriod(p_data) ||
+        startPeriod + length > p_data->Nperiods)
+        return 0;
+
+    tileBytes = (F_OFF)p_data->TilePeriods * valuesPerPeriod(p_data) *
+                RECORDSIZE;
+    for (p = startPeriod; p < startPeriod + length; p += n) {
+        // --- locate the tile holding period p
+        t0 = p - p % p_data->TilePeriods;
+        nt = p_data->Nperiods - t0;
+        if (nt > p_data->TilePeriods)
+            nt = p_data->TilePeriods;
+
+        // --- read the rest of the series within the tile
+        n = t0 + nt - p;
+        if (n > startPeriod + length - p)
+            n = startPeriod + length - p;
+        offset = TRANSPOSE_HEADER + (t0 / p_data->TilePeriods) * tileBytes +
+                 ((F_OFF)valueIndex * nt + (p - t0)) * RECORDSIZE;
+        if (!readCompanion(p_data, offset, values + (p - startPeriod),
+                (size_t)n * RECORDSIZE))
+            return 0;
+    }
+    return 1;
+}
+
+int mapFile(const char *path, char **data, F_OFF *size, void **handle)
+//
+//  Purpose: Maps a file's contents into memory for reading, returning 1 if
+//  successful and 0 if not (an empty file can't be mapped).
+//
+{
+    *data   = NULL;
+    *size   = 0;
+    *handle = NULL;
+
+#if defined(SMO_MAP_WINDOWS)
+    {
+        HANDLE hFile, hMap;
+        LARGE_INTEGER fsize;
+
+        hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (hFile == INVALID_HANDLE_VALUE)
+            return 0;
+        if (!GetFileSizeEx(hFile, &fsize) || fsize.QuadPart == 0) {
+            CloseHandle(hFile);
+            return 0;
+        }
+        hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(hFile);
+        if (hMap == NULL)
+            return 0;
+        *data = (char *)MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+        if (*data == NULL) {
+            CloseHandle(hMap);
+            return 0;
+        }
+        *size   = fsize.QuadPart;
+        *handle = hMap;
+        return 1;
+    }
+#elif defined(SMO_MAP_POSIX)
+    {
+        int fd;
+        struct stat st;
+        void *p;
+
+        fd = open(path, O_RDONLY);
+        if (fd < 0)
+            return 0;
+        if (fstat(fd, &st) != 0 || st.st_size == 0 ||
+            (F_OFF)(size_t)st.st_size != st.st_size) {
+            close(fd);
+            return 0;
+        }
+        p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED)
+            return 0;
+        *data = (char *)p;
+        *size = st.st_size;
+        return 1;
+    }
+#else
+    return 0;
+#endif
+}
+
+void unmapFile(char **data, F_OFF *size, void **handle)
+//
+//  Purpose: Releases a file mapped by mapFile.
+//
+{
+    if (*data != NULL) {
+#if defined(SMO_MAP_WINDOWS)
+        UnmapViewOfFile(*data);
+        CloseHandle((HANDLE)*handle);
+#elif defined(SMO_MAP_POSIX)
+        munmap(*data, (size_t)*size);
+#endif
+    }
+    *data   = NULL;
+    *size   = 0;
+    *handle = NULL;
+}
+
+int readResults(data_t *p_data, F_OFF offset, void *dest, size_t bytes)
+//
+//  Purpose: Reads results from the output file at their offset in an
+//  uncompressed file, decoding the chunks that hold them if the file is
+//  compressed. Returns 1 if successful, 0 if not.
+//
+{
+    INT8   period, end;
+    F_OFF  within;
+    size_t n;
+    int    lo, hi, mid;
+    char   *p = (char *)dest;
+
+    if (p_data->chunkIndex == NULL || offset < p_data->ResultsPos)
+        return readBytes(p_data, offset, dest, bytes);
+
+    while (bytes > 0) {
+        // --- find last chunk whose first period is not past the period
+        //     holding the offset
+        period = (offset - p_data->ResultsPos) / p_data->BytesPerPeriod;
+        lo = 0;
+        hi = p_data->numChunks - 1;
+        while (lo < hi) {
+            mid = (lo + hi + 1) / 2;
+            if (p_data->chunkIndex[2 * mid + 1] <= period)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        if (!loadChunk(p_data, lo))
+            break;
+
+        // --- copy what the chunk holds of the requested bytes
+        within = offset - p_data->ResultsPos -
+                 (F_OFF)p_data->chunkIndex[2 * lo + 1] *
+                     p_data->BytesPerPeriod;
+        end = (INT8)p_data->chunkPeriods * p_data->BytesPerPeriod;
+        if (within >= end)
+            break;
+        n = bytes;
+        if ((F_OFF)n > end - within)
+            n = (size_t)(end - within);
+        memcpy(p, (char *)p_data->chunkData + within, n);
+        p += n;
+        offset += n;
+        bytes -= n;
+    }
+    if (bytes > 0) {
+        memset(p, 0, bytes);
+        return 0;
+    }
+    return 1;
+}
+
+int readBytes(data_t *p_data, F_OFF offset, void *dest, size_t bytes)
+//
+//  Purpose: Reads bytes from the output file at an offset, copying them
+//  from its mapping when there is one. Returns 1 if successful, 0 if not.
+//
+{
+    if (p_data->map != NULL) {
+        if (offset < 0 || offset + (F_OFF)bytes > p_data->mapSize) {
+            memset(dest, 0, bytes);
+            return 0;
+        }
+        memcpy(dest, p_data->map + offset, bytes);
+        return 1;
+    }
+    if (_fseek(p_data->file, offset, SEEK_SET) != 0)
+        return 0;
+    return fread(dest, 1, bytes, p_data->file) == bytes;
+}
+
+int readChunkIndex(data_t *p_data)
+//
+//  Purpose: Reads the index of a compressed file's chunks, found through
+//  the footer that precedes the file's closing records. Leaves the index
+//  empty if the results aren't compressed. Returns an error code.
+//
+{
+    INT8  indexPos;
+    INT4  footer[2];
+    F_OFF size = fileSize(p_data->file);
+
+    free(p_data->chunkIndex);
+    p_data->chunkIndex  = NULL;
+    p_data->numChunks   = 0;
+    p_data->chunkLoaded = -1;
+
+    if (size < p_data->ResultsPos + OUTCODEC_FOOTER + 6 * RECORDSIZE ||
+        _fseek(p_data->file, size - 6 * RECORDSIZE - OUTCODEC_FOOTER,
+            SEEK_SET) != 0 ||
+        fread(&indexPos, sizeof(INT8), 1, p_data->file) != 1 ||
+        fread(footer, RECORDSIZE, 2, p_data->file) != 2 ||
+        footer[1] != OUTCODEC_MAGIC || footer[0] <= 0 ||
+        indexPos + (INT8)footer[0] * OUTCODEC_INDEX_ENTRY !=
+            size - 6 * RECORDSIZE - OUTCODEC_FOOTER)
+        return 0;
+
+    p_data->chunkIndex = (INT8 *)malloc(footer[0] * OUTCODEC_INDEX_ENTRY);
+    if (MEMCHECK(p_data->chunkIndex))
+        return 411;
+    if (_fseek(p_data->file, (F_OFF)indexPos, SEEK_SET) != 0 ||
+        fread(p_data->chunkIndex, OUTCODEC_INDEX_ENTRY, footer[0],
+            p_data->file) != (size_t)footer[0])
+        return 435;
+    p_data->numChunks = footer[0];
+    return 0;
+}
+
+int loadChunk(data_t *p_data, int chunk)
+//
+//  Purpose: Decodes a compressed chunk into the handle's cache unless it
+//  is already held there. Returns 1 if successful, 0 if not.
+//
+{
+    INT4          header[2];
+    unsigned char *packed;
+    unsigned int  *data;
+    int           ok;
+
+    if (chunk == p_data->chunkLoaded)
+        return 1;
+    if (!readBytes(p_data, (F_OFF)p_data->chunkIndex[2 * chunk], header,
+            OUTCODEC_CHUNK_HEADER) ||
+        header[0] <= 0 || header[1] < 0)
+        return 0;
+
+    packed = (unsigned char *)malloc((size_t)header[1] + 1);
+    data   = (unsigned int *)realloc(p_data->chunkData,
+        (size_t)header[0] * p_data->BytesPerPeriod);
+    if (data != NULL)
+        p_data->chunkData = data;
+    p_data->chunkLoaded = -1;
+    ok = packed != NULL && data != NULL &&
+         readBytes(p_data,
+             (F_OFF)p_data->chunkIndex[2 * chunk] + OUTCODEC_CHUNK_HEADER,
+             packed, header[1]) &&
+         outcodec_decode(packed, header[1], header[0],
+             (int)(p_data->BytesPerPeriod / RECORDSIZE), p_data->chunkData);
+    free(packed);
+    if (!ok)
+        return 0;
+    p_data->chunkLoaded  = chunk;
+    p_data->chunkPeriods = header[0];
+    return 1;
+}
+
+int readCompanion(data_t *p_data, F_OFF offset, void *dest, size_t bytes)
+//
+//  Purpose: Reads bytes from the transposed results file at an offset,
+//  copying them from its mapping when there is one.
+//
+{
+    if (p_data->tmap != NULL) {
+        if (offset < 0 || offset + (F_OFF)bytes > p_data->tmapSize)
+            return 0;
+        memcpy(dest, p_data->tmap + offset, bytes);
+        return 1;
+    }
+    if (_fseek(p_data->tfile, offset, SEEK_SET) != 0)
+        return 0;
+    return fread(dest, 1, bytes, p_data->tfile) == bytes;
+}
+
 double getTimeValue(data_t *p_data, int timeIndex) {
 
     F_OFF  offset;
@@ -1038,8 +2052,7 @@ double getTimeValue(data_t *p_data, int timeIndex) {
     offset = p_data->ResultsPos + timeIndex * p_data->BytesPerPeriod;
 
     // --- re-position the file and read the result
-    _fseek(p_data->file, offset, SEEK_SET);
-    fread(&value, RECORDSIZE * 2, 1, p_data->file);
+    readResults(p_data, offset, &value, DATESIZE);
 
     return value;
 }
@@ -1054,11 +2067,11 @@ float getSubcatchValue(data_t *p_data, int timeIndex, int subcatchIndex,
     offset = p_data->ResultsPos + timeIndex * p_data->BytesPerPeriod +
              2 * RECORDSIZE;
     // offset for subcatch
-    offset += RECORDSIZE * (subcatchIndex * p_data->SubcatchVars + attr);
+    offset += RECORDSIZE * (subcatchIndex * p_data->SubcatchVars +
+                            attrPosition(p_data, SMO_subcatch, attr));
 
-    // --- re-position the file and read the result
-    _fseek(p_data->file, offset, SEEK_SET);
-    fread(&value, RECORDSIZE, 1, p_data->file);
+    // --- read the result from the mapped or opened file
+    readResults(p_data, offset, &value, RECORDSIZE);
 
     return value;
 }
@@ -1074,11 +2087,11 @@ float getNodeValue(data_t *p_data, int timeIndex, int nodeIndex,
              2 * RECORDSIZE;
     // offset for node
     offset += RECORDSIZE * (p_data->Nsubcatch * p_data->SubcatchVars +
-                            nodeIndex * p_data->NodeVars + attr);
+                            nodeIndex * p_data->NodeVars +
+                            attrPosition(p_data, SMO_node, attr));
 
-    // --- re-position the file and read the result
-    _fseek(p_data->file, offset, SEEK_SET);
-    fread(&value, RECORDSIZE, 1, p_data->file);
+    // --- read the result from the mapped or opened file
+    readResults(p_data, offset, &value, RECORDSIZE);
 
     return value;
 }
@@ -1095,11 +2108,11 @@ float getLinkValue(data_t *p_data, int timeIndex, int linkIndex,
     // offset for link
     offset += RECORDSIZE * (p_data->Nsubcatch * p_data->SubcatchVars +
                             p_data->Nnodes * p_data->NodeVars +
-                            linkIndex * p_data->LinkVars + attr);
+                            linkIndex * p_data->LinkVars +
+                            attrPosition(p_data, SMO_link, attr));
 
-    // --- re-position the file and read the result
-    _fseek(p_data->file, offset, SEEK_SET);
-    fread(&value, RECORDSIZE, 1, p_data->file);
+    // --- read the result from the mapped or opened file
+    readResults(p_data, offset, &value, RECORDSIZE);
 
     return value;
 }
@@ -1117,9 +2130,8 @@ float getSystemValue(data_t *p_data, int timeIndex, SMO_systemAttribute attr) {
                             p_data->Nnodes * p_data->NodeVars +
                             p_data->Nlinks * p_data->LinkVars + attr);
 
-    // --- re-position the file and read the result
-    _fseek(p_data->file, offset, SEEK_SET);
-    fread(&value, RECORDSIZE, 1, p_data->file);
+    // --- read the result from the mapped or opened file
+    readResults(p_data, offset, &value, RECORDSIZE);
 
     return value;
 }
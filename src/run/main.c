@@ -25,15 +25,21 @@
 
 #define FMT_USAGE \
 "\nUsage:\n \
- \trunswmm <input file> <report file> <output file>\n\n"
+ \trunswmm <input file> <report file> <output file>\n \
+ \trunswmm --compile <input file> <report file> <compiled file>\n \
+ \trunswmm --compiled <compiled file> <report file> <output file>\n\n"
 
 #define FMT_HELP \
 "\n\nOWA Stormwater Management Model (SWMM5) Help\n\n \
  Commands:\n \
  \t--help (-h)       Help Docs\n \
  \t--version (-v)    Build Version\n \
+ \t--compile         Save input file as a compiled project file\n \
+ \t--compiled        Run a compiled project file\n \
  \nUsage:\n \
- \t swmm5 <input file> <report file> <output file>\n\n"
+ \t swmm5 <input file> <report file> <output file>\n \
+ \t swmm5 --compile <input file> <report file> <compiled file>\n \
+ \t swmm5 --compiled <compiled file> <report file> <output file>\n\n"
 
 
 static long Start;
@@ -85,6 +91,8 @@ int  main(int argc, char *argv[])
 //  Command line is: runswmm f1  f2  f3
 //  where f1 = name of input file, f2 = name of report file, and
 //  f3 = name of binary output file if saved (or blank if not saved).
+//  With --compile f1 is saved to a compiled project file f3, and with
+//  --compiled f1 is a compiled project file.
 //
 {
 
@@ -92,16 +100,20 @@ int  main(int argc, char *argv[])
     // OWA runs adds a progress bar to the SWMM executable, so this main funciton is 
     // slightly diffent than EPA's
 
-    if (argc == 4) {
-        char *inputFile = argv[1];
-        char *reportFile = argv[2];
+    if (argc == 4 || (argc == 5 && strcmp(argv[1], "--compiled") == 0)) {
+        int compiled = (argc == 5);
+        char *inputFile = argv[1 + compiled];
+        char *reportFile = argv[2 + compiled];
 
         char *binaryFile = "";
-        if (argc > 3)
-            binaryFile = argv[3];
+        if (argc > 3 + compiled)
+            binaryFile = argv[3 + compiled];
 
         Start = current_time_millis();
-        swmm_run_cb(inputFile, reportFile, binaryFile, &progress_bar);
+        if (compiled)
+            swmm_runCompiled_cb(inputFile, reportFile, binaryFile, &progress_bar);
+        else
+            swmm_run_cb(inputFile, reportFile, binaryFile, &progress_bar);
 
         long stop = current_time_millis();
         char time[TIMER_LEN + 1] = {'\0'};
@@ -121,6 +133,21 @@ int  main(int argc, char *argv[])
             printf(" successfully.\n");
     }
 
+    else if (argc == 5 && strcmp(argv[1], "--compile") == 0) {
+        char errMsg[128];
+        int  msgLen = 127;
+
+        // Output file isn't written when only compiling a project
+        if ( swmm_open(argv[2], argv[3], "") == 0 )
+            swmm_saveCompiled(argv[4]);
+
+        if ( swmm_getError(errMsg, msgLen) > 0 )
+            printf("\n... SWMM compile failed with errors.\n");
+        else
+            printf("\n... SWMM compiled %s to %s.\n", argv[2], argv[4]);
+        swmm_close();
+    }
+
     else if (argc == 2) {
         char *arg1 = argv[1];
 
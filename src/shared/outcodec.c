@@ -0,0 +1,233 @@
+//-----------------------------------------------------------------------------
+//  outcodec.c
+//
+//  Project:  EPA SWMM5
+//  Version:  5.2
+//  Date:     10/16/26   (Build 5.2.4 (OWA))
+//
+//  Lossless codec of binary output file results.
+//
+//  outcodec_bound()  - largest size of a chunk's encoded periods
+//  outcodec_encode() - encodes a chunk of reporting periods
+//  outcodec_decode() - decodes a chunk of reporting periods
+//
+//  A period is a vector of 4-byte words (its date and REAL4 results).
+//  Each word is XOR-ed with the same word of the previous period (the
+//  first period of a chunk with zero), so a chunk can be decoded on its
+//  own. Slowly varying values share their sign, exponent and leading
+//  mantissa bits with the previous period's, leaving an XOR with many
+//  leading zero bits, while unchanged values (e.g., zero flows) give 0.
+//  XOR-ed words are packed into a bit stream as:
+//    0                              word is 0
+//    10 <32-lz bits>                word has at least lz leading zeros,
+//                                   where lz is that of the last word
+//                                   written with a 11 prefix
+//    11 <5-bit lz> <32-lz bits>     word has lz leading zeros
+//-----------------------------------------------------------------------------
+#define _CRT_SECURE_NO_DEPRECATE
+
+#include "outcodec.h"
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+#define  MAX_WORD_BITS  39             // bits used by the longest code
+
+typedef unsigned long long TBits;
+
+typedef struct
+{
+    unsigned char* p;                  // next byte written
+    TBits          acc;                // bits not yet written
+    int            n;                  // number of bits in acc
+}   TBitWriter;
+
+typedef struct
+{
+    const unsigned char* p;            // next byte read
+    const unsigned char* end;          // end of encoded data
+    TBits          acc;                // bits read but not yet used
+    int            n;                  // number of bits in acc
+    int            overrun;            // TRUE if read past end of data
+}   TBitReader;
+
+//-----------------------------------------------------------------------------
+//  Local functions
+//-----------------------------------------------------------------------------
+static int          leadingZeros(unsigned int x);
+static void         putBits(TBitWriter* w, unsigned int x, int bits);
+static unsigned int getBits(TBitReader* r, int bits);
+
+//=============================================================================
+
+size_t outcodec_bound(int nPeriods, int nWords)
+//
+//  Input:   nPeriods = number of periods in a chunk
+//           nWords = number of 4-byte words per period
+//  Output:  returns most bytes the chunk's periods can be encoded into
+//  Purpose: sizes the buffer that receives a chunk's encoded periods.
+//
+{
+    return ((size_t)nPeriods * nWords * MAX_WORD_BITS + 7) / 8 + 8;
+}
+
+//=============================================================================
+
+size_t outcodec_encode(const unsigned int* in, int nPeriods, int nWords,
+                       unsigned char* out)
+//
+//  Input:   in = words of consecutive periods
+//           nPeriods = number of periods
+//           nWords = number of words per period
+//           out = buffer of at least outcodec_bound() bytes
+//  Output:  returns number of bytes of encoded data
+//  Purpose: encodes a chunk of periods.
+//
+{
+    int i, j, lz, lastLz = 0;
+    unsigned int x;
+    const unsigned int* prev = NULL;
+    TBitWriter w = {out, 0, 0};
+
+    for (i = 0; i < nPeriods; i++)
+    {
+        for (j = 0; j < nWords; j++)
+        {
+            x = prev ? in[j] ^ prev[j] : in[j];
+            if ( x == 0 )
+            {
+                putBits(&w, 0, 1);
+                continue;
+            }
+
+            // --- reuse the last leading zero count unless it would
+            //     waste more bits than writing a new one costs
+            lz = leadingZeros(x);
+            if ( lz >= lastLz && lz - lastLz <= 5 )
+            {
+                putBits(&w, 2, 2);
+                putBits(&w, x, 32 - lastLz);
+            }
+            else
+            {
+                putBits(&w, (3 << 5) | lz, 7);
+                putBits(&w, x, 32 - lz);
+                lastLz = lz;
+            }
+        }
+        prev = in;
+        in += nWords;
+    }
+    if ( w.n > 0 ) *w.p++ = (unsigned char)(w.acc << (8 - w.n));
+    return (size_t)(w.p - out);
+}
+
+//=============================================================================
+
+int outcodec_decode(const unsigned char* in, size_t size, int nPeriods,
+                    int nWords, unsigned int* out)
+//
+//  Input:   in = encoded data of a chunk
+//           size = number of bytes of encoded data
+//           nPeriods = number of periods in the chunk
+//           nWords = number of words per period
+//  Output:  out = words of the chunk's periods;
+//           returns TRUE if the data decoded properly, FALSE if not
+//  Purpose: decodes a chunk of periods.
+//
+{
+    int i, j, lz, lastLz = 0;
+    unsigned int x;
+    const unsigned int* prev = NULL;
+    TBitReader r = {in, in + size, 0, 0, 0};
+
+    for (i = 0; i < nPeriods; i++)
+    {
+        for (j = 0; j < nWords; j++)
+        {
+            if ( getBits(&r, 1) == 0 ) x = 0;
+            else
+            {
+                if ( getBits(&r, 1) == 1 ) lastLz = getBits(&r, 5);
+                lz = lastLz;
+                x = getBits(&r, 32 - lz);
+            }
+            out[j] = prev ? x ^ prev[j] : x;
+        }
+        if ( r.overrun ) return 0;
+        prev = out;
+        out += nWords;
+    }
+    return 1;
+}
+
+//=============================================================================
+
+int leadingZeros(unsigned int x)
+//
+//  Input:   x = a non-zero word
+//  Output:  returns number of leading zero bits of x
+//
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clz(x);
+#elif defined(_MSC_VER)
+    unsigned long k;
+    _BitScanReverse(&k, x);
+    return 31 - (int)k;
+#else
+    int n = 0;
+    while ( !(x & 0x80000000u) )
+    {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+//=============================================================================
+
+void putBits(TBitWriter* w, unsigned int x, int bits)
+//
+//  Input:   w = a bit stream writer
+//           x = value whose lowest bits are written
+//           bits = number of bits written (1 to 32)
+//  Output:  none
+//  Purpose: appends the lowest bits of a value to a bit stream.
+//
+{
+    if ( bits < 32 ) x &= (1u << bits) - 1;
+    w->acc = (w->acc << bits) | x;
+    w->n += bits;
+    while ( w->n >= 8 )
+    {
+        w->n -= 8;
+        *w->p++ = (unsigned char)(w->acc >> w->n);
+    }
+}
+
+//=============================================================================
+
+unsigned int getBits(TBitReader* r, int bits)
+//
+//  Input:   r = a bit stream reader
+//           bits = number of bits read (1 to 32)
+//  Output:  returns the next bits of the stream
+//  Purpose: reads bits from a bit stream (zeros past its end).
+//
+{
+    while ( r->n < bits )
+    {
+        if ( r->p < r->end ) r->acc = (r->acc << 8) | *r->p++;
+        else
+        {
+            r->acc <<= 8;
+            r->overrun = 1;
+        }
+        r->n += 8;
+    }
+    r->n -= bits;
+    return (unsigned int)((r->acc >> r->n) & (((TBits)1 << bits) - 1));
+}
@@ -0,0 +1,36 @@
+//-----------------------------------------------------------------------------
+//  outcodec.h
+//
+//  Header for outcodec.c
+//
+//  Lossless codec of the results held in a compressed binary output file.
+//  It is shared by the engine (swmm5) and the output file reader
+//  (swmm-output), so it depends on nothing else in either of them.
+//
+//  Layout of the results section of a compressed file:
+//    chunks:  for each chunk, # periods & # bytes of encoded data (INT4
+//             each) followed by the encoded periods
+//    index:   for each chunk, its file position & the index of its first
+//             period (8-byte integers)
+//    footer:  file position of the index (8 bytes), # chunks and
+//             OUTCODEC_MAGIC (INT4 each)
+//  The usual closing records of the file follow the footer.
+//-----------------------------------------------------------------------------
+
+#ifndef OUTCODEC_H
+#define OUTCODEC_H
+
+#include <stddef.h>
+
+#define OUTCODEC_MAGIC  0x5A504D53     // identifies a compressed file
+#define OUTCODEC_CHUNK_HEADER  8       // bytes ahead of a chunk's data
+#define OUTCODEC_INDEX_ENTRY   16      // bytes per chunk in the index
+#define OUTCODEC_FOOTER        16      // bytes of the footer
+
+size_t outcodec_bound(int nPeriods, int nWords);
+size_t outcodec_encode(const unsigned int* in, int nPeriods, int nWords,
+       unsigned char* out);
+int    outcodec_decode(const unsigned char* in, size_t size, int nPeriods,
+       int nWords, unsigned int* out);
+
+#endif //OUTCODEC_H
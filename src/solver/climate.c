@@ -56,57 +56,37 @@ static char* ClimateVarWords[] = {"TMIN", "TMAX", "EVAP", "WDMV", "AWND",
                                   NULL};
 static char* TempUnitsWords[] = {"C10", "C", "F", NULL};
 
-//-----------------------------------------------------------------------------
-//  Data Structures
-//-----------------------------------------------------------------------------
-typedef struct
-{
-    double    tAve;          // moving avg. for daily temperature (deg F)
-    double    tRng;          // moving avg. for daily temp. range (deg F)
-    double    ta[7];         // data window for tAve
-    double    tr[7];         // data window for tRng
-    int       count;         // length of moving average window
-    int       maxCount;      // maximum length of moving average window
-    int       front;         // index of front of moving average window
-} TMovAve;
-
 
 //-----------------------------------------------------------------------------
-//  Shared variables
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-// Temperature variables
-static double    Tmin;                 // min. daily temperature (deg F)
-static double    Tmax;                 // max. daily temperature (deg F)
-static double    Trng;                 // 1/2 range of daily temperatures
-static double    Trng1;                // prev. max - current min. temp.
-static double    Tave;                 // average daily temperature (deg F)
-static double    Hrsr;                 // time of min. temp. (hrs)
-static double    Hrss;                 // time of max. temp (hrs)
-static double    Hrday;                // avg. of min/max temp times
-static double    Dhrdy;                // hrs. between min. & max. temp. times
-static double    Dydif;                // hrs. between max. & min. temp. times
-static DateTime  LastDay;              // date of last day with temp. data
-static TMovAve   Tma;                  // moving average of daily temperatures
-
-// Evaporation variables
-static DateTime  NextEvapDate;         // next date when evap. rate changes
-static double    NextEvapRate;         // next evaporation rate (user units)
-
-// Climate file variables
-static int      FileFormat;            // file format (see ClimateFileFormats)
-static int      FileYear;              // current year of file data
-static int      FileMonth;             // current month of year of file data
-static int      FileDay;               // current day of month of file data
-static int      FileLastDay;           // last day of current month of file data
-static int      FileElapsedDays;       // number of days read from file
-static double   FileValue[4];          // current day's values of climate data
-static double   FileData[4][32];       // month's worth of daily climate data
-static char     FileLine[MAXLINE+1];   // line from climate data file
-
-static int      FileFieldPos[4];       // start of data fields for file record
-static int      FileDateFieldPos;      // start of date field for file record 
-static int      FileWindType;          // wind speed type
-static int      FileTempUnits;         // GHCND file temperature units (C10, C or F)
+#define Tmin              (ActiveProject->climate.Tmin)
+#define Tmax              (ActiveProject->climate.Tmax)
+#define Trng              (ActiveProject->climate.Trng)
+#define Trng1             (ActiveProject->climate.Trng1)
+#define Tave              (ActiveProject->climate.Tave)
+#define Hrsr              (ActiveProject->climate.Hrsr)
+#define Hrss              (ActiveProject->climate.Hrss)
+#define Hrday             (ActiveProject->climate.Hrday)
+#define Dhrdy             (ActiveProject->climate.Dhrdy)
+#define Dydif             (ActiveProject->climate.Dydif)
+#define LastDay           (ActiveProject->climate.LastDay)
+#define Tma               (ActiveProject->climate.Tma)
+#define NextEvapDate      (ActiveProject->climate.NextEvapDate)
+#define NextEvapRate      (ActiveProject->climate.NextEvapRate)
+#define FileFormat        (ActiveProject->climate.FileFormat)
+#define FileYear          (ActiveProject->climate.FileYear)
+#define FileMonth         (ActiveProject->climate.FileMonth)
+#define FileDay           (ActiveProject->climate.FileDay)
+#define FileLastDay       (ActiveProject->climate.FileLastDay)
+#define FileElapsedDays   (ActiveProject->climate.FileElapsedDays)
+#define FileValue         (ActiveProject->climate.FileValue)
+#define FileData          (ActiveProject->climate.FileData)
+#define FileLine          (ActiveProject->climate.FileLine)
+#define FileFieldPos      (ActiveProject->climate.FileFieldPos)
+#define FileDateFieldPos  (ActiveProject->climate.FileDateFieldPos)
+#define FileWindType      (ActiveProject->climate.FileWindType)
+#define FileTempUnits     (ActiveProject->climate.FileTempUnits)
 
 //-----------------------------------------------------------------------------
 //  External functions (defined in funcs.h)
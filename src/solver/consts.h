@@ -27,6 +27,11 @@
 #define   MAXTOKS            40             // Max. items per line of input
 #define   MAXSTATES          10             // Max. # computed hyd. variables
 #define   MAXODES            4              // Max. # ODE's to be solved
+#define   MAX_STATS          5              // Max. # critical elements reported
+#define   MAXSTEPCLASSES     8              // Max. # conduit time step classes
+#define   MINPARALLELLINKS   1000           // Min. # links routed in parallel
+#define   SUMBLOCK           256            // Items per block of a parallel sum
+#define   DWBATCH            64             // Conduits per batch of DW updates
 #define   NA                 -1             // NOT APPLICABLE code
 #define   TRUE               1              // Value for TRUE state
 #define   FALSE              0              // Value for FALSE state
@@ -159,23 +159,22 @@ struct  TRule
 };
 
 //-----------------------------------------------------------------------------
-//  Shared variables
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-struct   TRule*       Rules;           // array of control rules
-struct   TActionList* ActionList;      // linked list of control actions
-int      InputState;                   // state of rule interpreter
-int      RuleCount;                    // total number of rules
-double   ControlValue;                 // value of controller variable
-double   SetPoint;                     // value of controller setpoint
-DateTime CurrentDate;                  // current date in whole days 
-DateTime CurrentTime;                  // current time of day (decimal)
-
-int     VariableCount;
-int     ExpressionCount;
-int     CurrentVariable;
-int     CurrentExpression;
-struct  TNamedVariable* NamedVariable; // array of named variables
-struct  TExpression* Expression;       // array of math expressions
+#define Rules              (ActiveProject->controls.Rules)
+#define ActionList         (ActiveProject->controls.ActionList)
+#define InputState         (ActiveProject->controls.InputState)
+#define RuleCount          (ActiveProject->controls.RuleCount)
+#define ControlValue       (ActiveProject->controls.ControlValue)
+#define SetPoint           (ActiveProject->controls.SetPoint)
+#define CurrentDate        (ActiveProject->controls.CurrentDate)
+#define CurrentTime        (ActiveProject->controls.CurrentTime)
+#define VariableCount      (ActiveProject->controls.VariableCount)
+#define ExpressionCount    (ActiveProject->controls.ExpressionCount)
+#define CurrentVariable    (ActiveProject->controls.CurrentVariable)
+#define CurrentExpression  (ActiveProject->controls.CurrentExpression)
+#define NamedVariable      (ActiveProject->controls.NamedVariable)
+#define Expression         (ActiveProject->controls.Expression)
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
@@ -20,7 +20,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include "datetime.h"
+#include "headers.h"
 
 // Macro to convert charcter x to upper case
 #define UCHAR(x) (((x) >= 'a' && (x) <= 'z') ? ((x)&~32) : (x))
@@ -41,9 +41,9 @@ static const int DateDelta = 693594;        // days since 01/01/00
 static const double SecsPerDay = 86400.;    // seconds per day
 
 //-----------------------------------------------------------------------------
-//  Shared variables
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-static int DateFormat;
+#define DateFormat  (ActiveProject->datetime.DateFormat)
 
 
 //=============================================================================
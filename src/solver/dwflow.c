@@ -28,14 +28,56 @@
 //   - Implements the new option to skip checking for normal flow limitations.
 //   Build 5.2.4:
 //   - Arguments to function link_getLossRate changed.
+//   Build 5.2.4 (OWA):
+//   - Conduits updated in batches, with the geometry of circular conduits
+//     found by a vectorized kernel (dwflow_findConduitFlows replaces
+//     dwflow_findConduitFlow).
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
 #include <math.h>
 #include "headers.h"
 
+//-----------------------------------------------------------------------------
+//  Shared variables (held in the project context, see globals.h)
+//-----------------------------------------------------------------------------
+#define Xlink         (ActiveProject->dynwave.Xlink)
+
 static const  double MAXVELOCITY =  50.;     // max. allowable velocity (ft/sec)
 
+//-----------------------------------------------------------------------------
+//  Data Structures
+//-----------------------------------------------------------------------------
+//  Conduits are updated in batches of up to DWBATCH. The cross section
+//  geometry of a batch is evaluated at 3 depths per conduit (upstream,
+//  downstream & midpoint) stored in structure-of-arrays form, so that
+//  conduits of circular shape can be handled together by a vectorized
+//  kernel (xsect_getCircAandR).
+typedef struct
+{
+    int     n;                         // number of conduits in batch
+    int     link[DWBATCH];             // link index of each conduit
+    double  h1[DWBATCH];               // upstream head (ft)
+    double  h2[DWBATCH];               // downstream head (ft)
+    double  y[3*DWBATCH];              // flow depths (ft)
+    double  wSlot[3*DWBATCH];          // Preissmann slot widths (ft)
+    double  a[3*DWBATCH];              // flow areas (ft2)
+    double  r[3*DWBATCH];              // hyd. radii (ft)
+}  TDwBatch;
+
+//  Location of the 3 depths of the i-th conduit in a batch's depth arrays
+#define Y1(i)   (i)
+#define Y2(i)   (DWBATCH + (i))
+#define YMID(i) (2*DWBATCH + (i))
+
+//-----------------------------------------------------------------------------
+//  Local functions
+//-----------------------------------------------------------------------------
+static void   initConduitFlow(TDwBatch* b, int i);
+static void   findBatchGeometry(TDwBatch* b);
+static void   updateConduitFlow(TDwBatch* b, int i, int steps, double omega,
+              double dt);
+
 static int    getFlowClass(int link, double q, double h1, double h2,
               double y1, double y2, double* criticalDepth, double* normalDepth,
               double* fasnh);
@@ -54,20 +96,214 @@ static double checkNormalFlow(int j, double q, double y1, double y2,
 
 //=============================================================================
 
-void  dwflow_findConduitFlow(int j, int steps, double omega, double dt)
+int  dwflow_isCircBatched(int j)
+//
+//  Input:   j = link index
+//  Output:  returns TRUE if conduit's geometry is found by the circular
+//           batch kernel
+//  Purpose: identifies conduits whose area & hyd. radius can be evaluated
+//           together by xsect_getCircAandR.
+//
+{
+    TXsect* xsect = &Link[j].xsect;
+    return ( Link[j].type == CONDUIT &&
+             (xsect->type == CIRCULAR || xsect->type == FORCE_MAIN) &&
+             xsect->geomTable == NULL );
+}
+
+//=============================================================================
+
+void  dwflow_findConduitFlows(int* links, int n, int steps, double omega,
+                              double dt)
+//
+//  Input:   links    = list of link indexes
+//           n        = number of links in list
+//           steps    = number of iteration steps taken
+//           omega    = under-relaxation parameter
+//           dt       = time step (sec)
+//  Output:  none
+//  Purpose: updates flow in each non-dummy, non-bypassed conduit in a list
+//           of links by solving finite difference form of continuity and
+//           momentum equations.
+//
+//  Note:    a conduit whose flow was held over previous time steps (see
+//           TIME_STEP_CLASSES) has its time step lengthened by the time
+//           it was held.
+{
+    int      i, j, m;
+    TDwBatch b;
+
+    m = 0;
+    while ( m < n )
+    {
+        // --- collect the next batch of conduits to update
+        b.n = 0;
+        while ( m < n && b.n < DWBATCH )
+        {
+            j = links[m++];
+            if ( Link[j].type != CONDUIT || Link[j].xsect.type == DUMMY ||
+                 Link[j].bypassed ) continue;
+            b.link[b.n++] = j;
+        }
+
+        // --- find depths, cross section geometry & new flows
+        for ( i = 0; i < b.n; i++ ) initConduitFlow(&b, i);
+        findBatchGeometry(&b);
+        for ( i = 0; i < b.n; i++ )
+        {
+            j = b.link[i];
+            updateConduitFlow(&b, i, steps, omega, dt + Xlink[j].heldTime);
+        }
+    }
+}
+
+//=============================================================================
+
+void  initConduitFlow(TDwBatch* b, int i)
+//
+//  Input:   b = batch of conduits being updated
+//           i = position of conduit in batch
+//  Output:  none
+//  Purpose: finds the heads & flow depths at each end of a conduit and
+//           assigns the conduit's surface area to its end nodes.
+//
+{
+    int    j = b->link[i];                 // link index
+    int    k = Link[j].subIndex;           // conduit index
+    int    n1, n2;                         // indexes of end nodes
+    double z1, z2;                         // upstream/downstream invert elev. (ft)
+    double h1, h2;                         // upstream/downstream flow heads (ft)
+    double y1, y2;                         // upstream/downstream flow depths (ft)
+    double yMid;                           // mid-stream flow depth (ft)
+    TXsect* xsect = &Link[j].xsect;        // ptr. to conduit's cross section data
+
+    Conduit[k].evapLossRate = 0.0;
+    Conduit[k].seepLossRate = 0.0;
+
+    // --- get most current heads at upstream and downstream ends of conduit
+    n1 = Link[j].node1;
+    n2 = Link[j].node2;
+    z1 = Node[n1].invertElev + Link[j].offset1;
+    z2 = Node[n2].invertElev + Link[j].offset2;
+    h1 = Node[n1].newDepth + Node[n1].invertElev;
+    h2 = Node[n2].newDepth + Node[n2].invertElev;
+    h1 = MAX(h1, z1);
+    h2 = MAX(h2, z2);
+
+    // --- get unadjusted upstream and downstream flow depths in conduit
+    //    (flow depth = head in conduit - elev. of conduit invert)
+    y1 = h1 - z1;
+    y2 = h2 - z2;
+    y1 = MAX(y1, FUDGE);
+    y2 = MAX(y2, FUDGE);
+
+    // --- flow depths can't exceed full depth of conduit if slot not used
+    if ( SurchargeMethod != SLOT )
+    {
+        y1 = MIN(y1, xsect->yFull);
+        y2 = MIN(y2, xsect->yFull);
+    }
+
+    // --- find surface area contributions to upstream and downstream nodes
+    //     based on previous iteration's flow estimate
+    //     (using Courant-modified length instead of conduit's actual length)
+    findSurfArea(j, Conduit[k].q1, Conduit[k].modLength, &h1, &h2, &y1, &y2);
+
+    // --- save heads and the depths at which to evaluate cross section
+    //     geometry (each end of conduit & midpoint)
+    yMid = 0.5 * (y1 + y2);
+    b->h1[i] = h1;
+    b->h2[i] = h2;
+    b->y[Y1(i)] = y1;
+    b->y[Y2(i)] = y2;
+    b->y[YMID(i)] = yMid;
+    b->wSlot[Y1(i)] = getSlotWidth(xsect, y1);
+    b->wSlot[Y2(i)] = getSlotWidth(xsect, y2);
+    b->wSlot[YMID(i)] = getSlotWidth(xsect, yMid);
+}
+
+//=============================================================================
+
+void  findBatchGeometry(TDwBatch* b)
+//
+//  Input:   b = batch of conduits being updated
+//  Output:  none
+//  Purpose: finds flow area & hyd. radius at the depths of each conduit in a
+//           batch, evaluating those of circular conduits together.
+//
+{
+    int     i, j, m, p;
+    int     nc = 0;                        // number of circular depths
+    int     pos[3*DWBATCH];                // batch position of circular depths
+    double  y[3*DWBATCH];                  // circular flow depths (ft)
+    double  wSlot[3*DWBATCH];              // circular slot widths (ft)
+    double  yFull[3*DWBATCH];              // circular full depths (ft)
+    double  aFull[3*DWBATCH];              // circular full areas (ft2)
+    double  rFull[3*DWBATCH];              // circular full hyd. radii (ft)
+    double  a[3*DWBATCH];                  // circular flow areas (ft2)
+    double  r[3*DWBATCH];                  // circular hyd. radii (ft)
+    TXsect* xsect;
+
+    for ( i = 0; i < b->n; i++ )
+    {
+        j = b->link[i];
+        xsect = &Link[j].xsect;
+
+        // --- gather depths of circular conduits for the batch kernel
+        if ( Xlink[j].circBatched )
+        {
+            for ( m = 0; m < 3; m++ )
+            {
+                p = m * DWBATCH + i;
+                pos[nc] = p;
+                y[nc] = b->y[p];
+                wSlot[nc] = b->wSlot[p];
+                yFull[nc] = xsect->yFull;
+                aFull[nc] = xsect->aFull;
+                rFull[nc] = xsect->rFull;
+                nc++;
+            }
+        }
+
+        // --- evaluate geometry of other conduits one at a time
+        //     (hyd. radius at downstream end isn't needed)
+        else
+        {
+            b->a[Y1(i)] = getArea(xsect, b->y[Y1(i)], b->wSlot[Y1(i)]);
+            b->r[Y1(i)] = getHydRad(xsect, b->y[Y1(i)]);
+            b->a[Y2(i)] = getArea(xsect, b->y[Y2(i)], b->wSlot[Y2(i)]);
+            b->a[YMID(i)] = getArea(xsect, b->y[YMID(i)], b->wSlot[YMID(i)]);
+            b->r[YMID(i)] = getHydRad(xsect, b->y[YMID(i)]);
+        }
+    }
+    if ( nc == 0 ) return;
+
+    // --- evaluate circular conduit geometry & scatter it back to the batch
+    xsect_getCircAandR(nc, y, yFull, aFull, rFull, wSlot, a, r);
+    for ( m = 0; m < nc; m++ )
+    {
+        b->a[pos[m]] = a[m];
+        b->r[pos[m]] = r[m];
+    }
+}
+
+//=============================================================================
+
+void  updateConduitFlow(TDwBatch* b, int i, int steps, double omega, double dt)
 //
-//  Input:   j        = link index
+//  Input:   b        = batch of conduits being updated
+//           i        = position of conduit in batch
 //           steps    = number of iteration steps taken
 //           omega    = under-relaxation parameter
 //           dt       = time step (sec)
-//  Output:  returns new flow value (cfs)
-//  Purpose: updates flow in conduit link by solving finite difference
+//  Output:  none
+//  Purpose: updates flow in a conduit by solving finite difference
 //           form of continuity and momentum equations.
 //
 {
+    int    j = b->link[i];             // link index
     int    k;                          // index of conduit
     int    n1, n2;                     // indexes of end nodes
-    double z1, z2;                     // upstream/downstream invert elev. (ft)
     double h1, h2;                     // upstream/dounstream flow heads (ft)
     double y1, y2;                     // upstream/downstream flow depths (ft)
     double a1, a2;                     // upstream/downstream flow areas (ft2)
@@ -81,7 +317,6 @@ void  dwflow_findConduitFlow(int j, int steps, double omega, double dt)
     double rho;                        // upstream weighting factor
     double sigma;                      // inertial damping factor
     double length;                     // effective conduit length (ft)
-    double wSlot;                      // Preissmann slot width (ft)
     double dq1, dq2, dq3, dq4, dq5,    // terms in momentum eqn.
            dq6;                        // term for evap and infil losses
     double denom;                      // denominator of flow update formula
@@ -91,8 +326,6 @@ void  dwflow_findConduitFlow(int j, int steps, double omega, double dt)
     char   isFull = FALSE;             // TRUE if conduit flowing full
     char   isClosed = FALSE;           // TRUE if conduit closed
 
-
-
     // --- adjust isClosed status by any control action
     if ( Link[j].setting == 0 ) isClosed = TRUE;
 
@@ -101,32 +334,8 @@ void  dwflow_findConduitFlow(int j, int steps, double omega, double dt)
     barrels = Conduit[k].barrels;
     qOld = Link[j].oldFlow / barrels;
     qLast = Conduit[k].q1;
-    Conduit[k].evapLossRate = 0.0; 
-    Conduit[k].seepLossRate = 0.0;
-
-    // --- get most current heads at upstream and downstream ends of conduit
     n1 = Link[j].node1;
     n2 = Link[j].node2;
-    z1 = Node[n1].invertElev + Link[j].offset1;
-    z2 = Node[n2].invertElev + Link[j].offset2;
-    h1 = Node[n1].newDepth + Node[n1].invertElev;
-    h2 = Node[n2].newDepth + Node[n2].invertElev;
-    h1 = MAX(h1, z1);
-    h2 = MAX(h2, z2);
-
-    // --- get unadjusted upstream and downstream flow depths in conduit
-    //    (flow depth = head in conduit - elev. of conduit invert)
-    y1 = h1 - z1;
-    y2 = h2 - z2;
-    y1 = MAX(y1, FUDGE);
-    y2 = MAX(y2, FUDGE);
-
-    // --- flow depths can't exceed full depth of conduit if slot not used
-    if ( SurchargeMethod != SLOT )
-    {
-        y1 = MIN(y1, xsect->yFull);
-        y2 = MIN(y2, xsect->yFull);
-    }
 
     // -- get area from solution at previous time step
     aOld = Conduit[k].a2;
@@ -135,22 +344,17 @@ void  dwflow_findConduitFlow(int j, int steps, double omega, double dt)
     // --- use Courant-modified length instead of conduit's actual length
     length = Conduit[k].modLength;
 
-    // --- find surface area contributions to upstream and downstream nodes
-    //     based on previous iteration's flow estimate
-    findSurfArea(j, qLast, length, &h1, &h2, &y1, &y2);
-
-    // --- compute area at each end of conduit & hyd. radius at upstream end
-    wSlot = getSlotWidth(xsect, y1);
-    a1 = getArea(xsect, y1, wSlot);
-    r1 = getHydRad(xsect, y1);
-    wSlot = getSlotWidth(xsect, y2);
-    a2 = getArea(xsect, y2, wSlot);
-
-    // --- compute area & hyd. radius at midpoint
-    yMid = 0.5 * (y1 + y2);
-    wSlot = getSlotWidth(xsect, yMid);
-    aMid = getArea(xsect, yMid, wSlot);
-    rMid = getHydRad(xsect, yMid);
+    // --- retrieve heads, depths, areas & hyd. radii found for the batch
+    h1 = b->h1[i];
+    h2 = b->h2[i];
+    y1 = b->y[Y1(i)];
+    y2 = b->y[Y2(i)];
+    yMid = b->y[YMID(i)];
+    a1 = b->a[Y1(i)];
+    r1 = b->r[Y1(i)];
+    a2 = b->a[Y2(i)];
+    aMid = b->a[YMID(i)];
+    rMid = b->r[YMID(i)];
 
     // --- alternate approach not currently used, but might produce better
     //     Bernoulli energy balance for steady flows
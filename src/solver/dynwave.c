@@ -15,6 +15,20 @@
 //   to solve the explicit form of the continuity and momentum equations
 //   for conduits.
 //
+//   With the TIME_STEP_CLASSES option each conduit is placed in a time step
+//   class c from its own Courant time step, and its flow is only recomputed
+//   every 2^c routing steps using the time elapsed since it was last found.
+//   In between, the flow is held (the conduit is bypassed) and both of its
+//   end nodes receive that same flow, so continuity is kept across classes.
+//   A held conduit is recomputed early if the head difference across it
+//   changes by more than the head tolerance.
+//
+//   With the DYNWAVE_IMPLICIT routing choice the node depths are instead
+//   found by Newton iterations on the nodal continuity equations, whose
+//   Jacobian is built from the links' flow derivatives (dqdh) and solved
+//   with a Jacobi-preconditioned conjugate gradient method. This keeps
+//   the solution stable at time steps well above the Courant limit.
+//
 //   Update History
 //   ==============
 //   Build 5.1.002:
@@ -47,6 +61,20 @@
 //   Build 5.2.4:
 //   - Conduit evap+seepage outflow split evenly between outflow from
 //     conduit's upstream and non-outfall downstream nodes.
+//   Build 5.2.4 (OWA):
+//   - Conduit flows added to node inflow/outflow in parallel using a
+//     node-to-conduit adjacency list.
+//   - Critical link & node time steps found in parallel.
+//   - Extended node & link solver state (TXnode & TXlink) declared in
+//     objects.h.
+//   - Implicit Newton solver option (DYNWAVE_IMPLICIT) added.
+//   - Optional active set trials that recompute only unconverged nodes
+//     and the conduits attached to them (ACTIVE_SET option).
+//   - Optional local time stepping of conduits (TIME_STEP_CLASSES option).
+//   - All trials of a time step share one team of threads, and networks
+//     with fewer than MIN_PARALLEL_LINKS links are routed serially.
+//   - Conduit flows found in batches of DWBATCH conduits.
+//   - Number of links visited by each step's trials added to statistics.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -64,35 +92,50 @@ static const double DEFAULT_HEADTOL     = 0.005;  // Default head tolerance (ft)
 static const double EXTRAN_CROWN_CUTOFF = 0.96;   // crown cutoff for EXTRAN
 static const double SLOT_CROWN_CUTOFF   = 0.985257; // crown cutoff for SLOT
 static const int    DEFAULT_MAXTRIALS   = 8;      // Max. trials per time step
+static const int    PCG_MAXITER         = 500;    // Max. conj. gradient iterations
+static const double HOLD_MIN_DEPTH      = 0.05;   // min. depth (fraction of
+                                                  //   crown) at nodes of
+                                                  //   held conduits
+static const double PCG_TOLERANCE       = 1.0e-4; // CG tolerance (fraction of
+                                                  //   head tolerance)
 
 
 //-----------------------------------------------------------------------------
-//  Data Structures
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-typedef struct 
-{
-    char    converged;                 // TRUE if iterations for a node done
-    double  newSurfArea;               // current surface area (ft2)
-    double  oldSurfArea;               // previous surface area (ft2)
-    double  sumdqdh;                   // sum of dqdh from adjoining links
-    double  dYdT;                      // change in depth w.r.t. time (ft/sec)
-} TXnode;
-
-//-----------------------------------------------------------------------------
-//  Shared Variables
-//-----------------------------------------------------------------------------
-static double  VariableStep;           // size of variable time step (sec)
-static TXnode* Xnode;                  // extended nodal information
-
-static double  Omega;                  // actual under-relaxation parameter
-static int     Steps;                  // number of Picard iterations
+#define VariableStep  (ActiveProject->dynwave.VariableStep)
+#define Xnode         (ActiveProject->dynwave.Xnode)
+#define Xlink         (ActiveProject->dynwave.Xlink)
+#define Omega         (ActiveProject->dynwave.Omega)
+#define Steps         (ActiveProject->dynwave.Steps)
+#define NodeConduitStart (ActiveProject->dynwave.NodeConduitStart)
+#define NodeConduits     (ActiveProject->dynwave.NodeConduits)
+#define Jdiag         (ActiveProject->dynwave.Jdiag)
+#define Jlink         (ActiveProject->dynwave.Jlink)
+#define Jrhs          (ActiveProject->dynwave.Jrhs)
+#define Jwork         (ActiveProject->dynwave.Jwork)
+#define Jfixed        (ActiveProject->dynwave.Jfixed)
+#define Jblock        (ActiveProject->dynwave.Jblock)
+#define ActiveNodes   (ActiveProject->dynwave.ActiveNodes)
+#define NumActiveNodes (ActiveProject->dynwave.NumActiveNodes)
+#define ActiveLinks   (ActiveProject->dynwave.ActiveLinks)
+#define NumActiveLinks (ActiveProject->dynwave.NumActiveLinks)
+#define StepCycle     (ActiveProject->dynwave.StepCycle)
 
 //-----------------------------------------------------------------------------
 //  Function declarations
 //-----------------------------------------------------------------------------
-static void   initRoutingStep(void);
+static void   initRoutingStep(double dt);
+static int    isLinkHeld(int link, double dt);
+static void   updateStepClasses(double dt);
+static double getHeadDiff(int link);
+static int    canHoldAtNode(int node, double dt);
 static void   initNodeStates(void);
+static int    createSolverState(void);
+static void   freeSolverState(void);
+static int    createNodeConduitList(void);
 static void   findBypassedLinks();
+static void   findActiveSets(void);
 static void   findLimitedLinks();
 
 static void   findLinkFlows(double dt);
@@ -101,16 +144,33 @@ static void   findNonConduitFlow(int link, double dt);
 static void   findNonConduitSurfArea(int link);
 static double getModPumpFlow(int link, double q, double dt);
 static void   updateNodeFlows(int link);
+static void   gatherConduitFlows(int node);
+static void   addConduitFlows(int link, int node);
 static void   updateConvergenceStats();
 
 static int    findNodeDepths(double dt);
 static void   setNodeDepth(int node, double dt);
+static int    isNodeSurcharged(int node, int isPonded, double yCrown, double y);
+static void   saveNodeDepth(int node, int canPond, double dV, double yNew,
+              double yOld, double dt);
 static double getFloodedDepth(int node, int canPond, double dV, double yNew,
               double yMax, double dt);
 
+static int    createNewtonState(void);
+static void   freeNewtonState(void);
+static int    findNewtonDepths(double dt);
+static void   buildJacobian(double dt);
+static void   solveJacobian(double x[]);
+static void   multiplyJacobian(double x[], double y[]);
+static double addBlockSums(int nBlocks, double *bigMax);
+static int    getNumBlocks(int n);
+static void   setNewtonDepth(int node, double dy, int isFinal, double dt);
+
 static double getVariableStep(double maxStep);
 static double getLinkStep(double tMin, int *minLink);
+static double getConduitStep(int link);
 static double getNodeStep(double tMin, int *minNode);
+static void   updateCriticalStep(double t, int i, double *tMin, int *iMin);
 
 //=============================================================================
 
@@ -125,19 +185,17 @@ void dynwave_init()
     double z;
 
     VariableStep = 0.0;
-    Xnode = (TXnode *) calloc(Nobjects[NODE], sizeof(TXnode));
-    if ( Xnode == NULL )
+    StepCycle = 0;
+    if ( !createSolverState() )
     {
         report_writeErrorMsg(ERR_MEMORY,
             " Not enough memory for dynamic wave routing.");
         return;
     }
     
-    // --- initialize node surface areas & crown elev.
+    // --- initialize node crown elev.
     for (i = 0; i < Nobjects[NODE]; i++ )
     {
-        Xnode[i].newSurfArea = 0.0;
-        Xnode[i].oldSurfArea = 0.0;
         Node[i].crownElev = Node[i].invertElev;
     }
 
@@ -153,6 +211,19 @@ void dynwave_init()
         Node[j].crownElev = MAX(Node[j].crownElev, z);
         Link[i].flowClass = DRY;
         Link[i].dqdh = 0.0;
+
+        // --- partition conduits by whether their geometry is
+        //     found by the circular batch kernel
+        Xlink[i].circBatched = (char)dwflow_isCircBatched(i);
+    }
+
+    // --- list the conduits attached to each node
+    if ( !createNodeConduitList() ||
+         (DynWaveSolver == NEWTON_SOLVER && !createNewtonState()) )
+    {
+        report_writeErrorMsg(ERR_MEMORY,
+            " Not enough memory for dynamic wave routing.");
+        return;
     }
 
     // --- set crown cutoff for finding top width of closed conduits
@@ -169,7 +240,10 @@ void  dynwave_close()
 //  Purpose: frees memory allocated for dynamic wave routing method.
 //
 {
-    FREE(Xnode);
+    freeSolverState();
+    freeNewtonState();
+    FREE(NodeConduitStart);
+    FREE(NodeConduits);
 }
 
 //=============================================================================
@@ -188,6 +262,9 @@ void dynwave_validate()
     if ( HeadTol == 0.0 ) HeadTol = DEFAULT_HEADTOL;
     else HeadTol /= UCF(LENGTH);
     if ( MaxTrials == 0 ) MaxTrials = DEFAULT_MAXTRIALS;
+
+    // --- the implicit solver doesn't need a Courant-limited time step
+    if ( DynWaveSolver == NEWTON_SOLVER ) CourantFactor = 0.0;
 }
 
 //=============================================================================
@@ -230,13 +307,26 @@ int dynwave_execute(double tStep)
 //
 {
     int converged;
+    int linkTrials = 0;       // links visited over all trials
+    TProject* project = ActiveProject;
 
     // --- initialize
     if ( ErrorCode ) return 0;
     Steps = 0;
     converged = FALSE;
     Omega = OMEGA;
-    initRoutingStep();
+    initRoutingStep(tStep);
+
+    // --- one team of threads carries out all trials of the time step,
+    //     sharing the work of the loops in the functions called below
+    //     (networks with too few links to gain from this are routed
+    //     serially)
+#pragma omp parallel num_threads(NumThreads) \
+    if ( Nobjects[LINK] >= MinParallelLinks )
+{
+    int isConverged = FALSE;  // this thread's copy of convergence status
+
+    ActiveProject = project;  // worker threads work on the caller's project
 
     // --- keep iterating until convergence 
     while ( Steps < MaxTrials )
@@ -244,17 +334,40 @@ int dynwave_execute(double tStep)
         // --- execute a routing step & check for nodal convergence
         initNodeStates();
         findLinkFlows(tStep);
-        converged = findNodeDepths(tStep);
-        Steps++;
+        if ( DynWaveSolver == NEWTON_SOLVER )
+            isConverged = findNewtonDepths(tStep);
+        else
+            isConverged = findNodeDepths(tStep);
+        #pragma omp single
+        {
+            Steps++;
+            linkTrials += NumActiveLinks;
+        }
         if ( Steps > 1 )
         {
-            if ( converged ) break;
+            if ( isConverged ) break;
 
             // --- check if link calculations can be skipped in next step
-            findBypassedLinks();
+            //     (not done for Newton steps, which need every link's dqdh)
+            if ( DynWaveSolver == PICARD_SOLVER )
+            {
+                findBypassedLinks();
+                if ( ActiveSet )
+                {
+                    #pragma omp single
+                    findActiveSets();
+                }
+            }
         }
     }
+    #pragma omp master
+    converged = isConverged;
+}
     if ( !converged ) updateConvergenceStats();
+    stats_updateLinkTrials(linkTrials);
+
+    //  --- assign conduits whose flows were just found to time step classes
+    updateStepClasses(tStep);
 
     //  --- identify any capacity-limited conduits
     findLimitedLinks();
@@ -263,6 +376,131 @@ int dynwave_execute(double tStep)
 
 //=============================================================================
 
+int createSolverState()
+//
+//  Input:   none
+//  Output:  returns FALSE if out of memory
+//  Purpose: allocates the node & link solver state records
+//           (all values start at 0).
+//
+{
+    Xnode = (TXnode *) calloc(Nobjects[NODE], sizeof(TXnode));
+    Xlink = (TXlink *) calloc(Nobjects[LINK], sizeof(TXlink));
+    ActiveNodes = (int *) calloc(Nobjects[NODE], sizeof(int));
+    ActiveLinks = (int *) calloc(Nobjects[LINK], sizeof(int));
+    if ( Xnode == NULL || Xlink == NULL ||
+         ActiveNodes == NULL || ActiveLinks == NULL ) return FALSE;
+    return TRUE;
+}
+
+//=============================================================================
+
+void freeSolverState()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: frees the node & link solver state records.
+//
+{
+    FREE(Xnode);
+    FREE(Xlink);
+    FREE(ActiveNodes);
+    FREE(ActiveLinks);
+}
+
+//=============================================================================
+
+int createNewtonState()
+//
+//  Input:   none
+//  Output:  returns FALSE if out of memory
+//  Purpose: allocates the arrays used by the implicit Newton solver.
+//
+{
+    int nNodes = Nobjects[NODE];
+    int nLinks = Nobjects[LINK];
+
+    Jdiag  = (double *) calloc(nNodes, sizeof(double));
+    Jrhs   = (double *) calloc(nNodes, sizeof(double));
+    Jwork  = (double *) calloc(5*(size_t)nNodes, sizeof(double));
+    Jlink  = (double *) calloc(nLinks, sizeof(double));
+    Jfixed = (char *) calloc(nNodes, sizeof(char));
+    Jblock = (double *) calloc(2*(size_t)getNumBlocks(nNodes), sizeof(double));
+    if ( Jdiag == NULL || Jrhs == NULL || Jwork == NULL ||
+         Jlink == NULL || Jfixed == NULL || Jblock == NULL ) return FALSE;
+    return TRUE;
+}
+
+//=============================================================================
+
+void freeNewtonState()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: frees the arrays used by the implicit Newton solver.
+//
+{
+    FREE(Jdiag);
+    FREE(Jrhs);
+    FREE(Jwork);
+    FREE(Jlink);
+    FREE(Jfixed);
+    FREE(Jblock);
+}
+
+//=============================================================================
+
+int createNodeConduitList()
+//
+//  Input:   none
+//  Output:  returns FALSE if out of memory
+//  Purpose: creates a list of the non-dummy conduits attached to each node,
+//           in order of link index, so that node flows can be accumulated
+//           one node at a time.
+//
+{
+    int i, j, n, m;
+
+    NodeConduitStart = (int *) calloc(Nobjects[NODE]+1, sizeof(int));
+    NodeConduits = (int *) calloc(2*(size_t)Nobjects[LINK]+1, sizeof(int));
+    if ( NodeConduitStart == NULL || NodeConduits == NULL ) return FALSE;
+
+    // --- count the conduits at each node
+    //     (a conduit whose ends are at the same node is listed once)
+    for (j = 0; j < Nobjects[LINK]; j++)
+    {
+        if ( !isTrueConduit(j) ) continue;
+        NodeConduitStart[Link[j].node1+1]++;
+        if ( Link[j].node2 != Link[j].node1 )
+            NodeConduitStart[Link[j].node2+1]++;
+    }
+    for (i = 0; i < Nobjects[NODE]; i++)
+        NodeConduitStart[i+1] += NodeConduitStart[i];
+
+    // --- fill in each node's conduits using its count as a position marker
+    for (j = 0; j < Nobjects[LINK]; j++)
+    {
+        if ( !isTrueConduit(j) ) continue;
+        n = Link[j].node1;
+        m = NodeConduitStart[n];
+        NodeConduits[m] = j;
+        NodeConduitStart[n] = m + 1;
+        n = Link[j].node2;
+        if ( n == Link[j].node1 ) continue;
+        m = NodeConduitStart[n];
+        NodeConduits[m] = j;
+        NodeConduitStart[n] = m + 1;
+    }
+
+    // --- restore start positions shifted by the fill-in
+    for (i = Nobjects[NODE]; i > 0; i--)
+        NodeConduitStart[i] = NodeConduitStart[i-1];
+    NodeConduitStart[0] = 0;
+    return TRUE;
+}
+
+//=============================================================================
+
 void updateConvergenceStats()
 {
     int i;
@@ -273,19 +511,28 @@ void updateConvergenceStats()
 
 //=============================================================================
 
-void   initRoutingStep()
+void   initRoutingStep(double dt)
 {
     int i;
     for (i = 0; i < Nobjects[NODE]; i++)
     {
         Xnode[i].converged = FALSE;
         Xnode[i].dYdT = 0.0;
+        Xnode[i].active = TRUE;
+        ActiveNodes[i] = i;
     }
+    NumActiveNodes = Nobjects[NODE];
+    NumActiveLinks = 0;
+    StepCycle++;
     for (i = 0; i < Nobjects[LINK]; i++)
     {
-        Link[i].bypassed = FALSE;
+        // --- a conduit whose flow is held keeps its surface areas
+        Xlink[i].held = (char)isLinkHeld(i, dt);
+        Link[i].bypassed = Xlink[i].held;
+        if ( Xlink[i].held ) continue;
         Link[i].surfArea1 = 0.0;
         Link[i].surfArea2 = 0.0;
+        ActiveLinks[NumActiveLinks++] = i;
     }
 
     // --- a2 preserves conduit area from solution at last time step
@@ -294,6 +541,112 @@ void   initRoutingStep()
 
 //=============================================================================
 
+int isLinkHeld(int i, double dt)
+//
+//  Input:   i = link index
+//           dt = time step (sec)
+//  Output:  returns TRUE if link's flow is held over the time step
+//  Purpose: checks if a conduit's flow need not be recomputed this time step
+//           under local time stepping.
+//
+{
+    int c;
+
+    if ( StepClasses <= 1 || DynWaveSolver != PICARD_SOLVER ||
+         CourantFactor == 0.0 || !isTrueConduit(i) ) return FALSE;
+
+    // --- a class c conduit is recomputed every 2^c time steps
+    c = Xlink[i].stepClass;
+    if ( c == 0 || StepCycle % (1 << c) == 0 ) return FALSE;
+
+    // --- full conduits are always recomputed (pressurized flow has no
+    //     Courant time step limit) as are those whose end nodes can't
+    //     take a held flow
+    if ( Conduit[Link[i].subIndex].fullState ||
+         !canHoldAtNode(Link[i].node1, dt) ||
+         !canHoldAtNode(Link[i].node2, dt) ) return FALSE;
+
+    // --- recompute sooner if its Courant time step would be exceeded or
+    //     the head difference driving its flow has changed
+    if ( Xlink[i].heldTime + dt > Xlink[i].courantStep ) return FALSE;
+    if ( fabs(getHeadDiff(i) - Xlink[i].headDiff) > HeadTol ) return FALSE;
+    return TRUE;
+}
+
+//=============================================================================
+
+void updateStepClasses(double dt)
+//
+//  Input:   dt = time step (sec)
+//  Output:  none
+//  Purpose: updates the time since each conduit's flow was last found and
+//           assigns recomputed conduits to a time step class.
+//
+{
+    int    i, c;
+    double t;
+
+    if ( StepClasses <= 1 ) return;
+    for (i = 0; i < Nobjects[LINK]; i++)
+    {
+        if ( !isTrueConduit(i) ) continue;
+        if ( Xlink[i].held )
+        {
+            Xlink[i].heldTime += dt;
+            continue;
+        }
+
+        // --- class is the largest power of 2 times dt within the
+        //     conduit's Courant time step (conduits with negligible flow
+        //     have none and stay in the first class)
+        t = getConduitStep(i);
+        c = 0;
+        while ( c + 1 < StepClasses && ldexp(dt, c + 1) <= t && t < BIG ) c++;
+        Xlink[i].stepClass = (char)c;
+        Xlink[i].heldTime = 0.0;
+        Xlink[i].courantStep = t;
+        Xlink[i].headDiff = getHeadDiff(i);
+    }
+}
+
+//=============================================================================
+
+int canHoldAtNode(int i, double dt)
+//
+//  Input:   i = node index
+//           dt = time step (sec)
+//  Output:  returns TRUE if flows of links attached to node can be held
+//  Purpose: checks that a node is neither surcharged, flooded, nearly
+//           dry nor about to run dry over the time step.
+//
+{
+    double y = Node[i].newDepth;
+    double yCrown = Node[i].crownElev - Node[i].invertElev;
+
+    if ( Node[i].type == OUTFALL ) return TRUE;
+    if ( y > yCrown || y >= Node[i].fullDepth ) return FALSE;
+    if ( y <= HOLD_MIN_DEPTH * yCrown ) return FALSE;
+    y += Node[i].oldNetInflow * dt / MAX(Xnode[i].newSurfArea, MinSurfArea);
+    return ( y > 0.0 );
+}
+
+//=============================================================================
+
+double getHeadDiff(int i)
+//
+//  Input:   i = link index
+//  Output:  returns difference in head between link's end nodes (ft)
+//  Purpose: finds the head difference that drives flow through a link.
+//
+{
+    int n1 = Link[i].node1;
+    int n2 = Link[i].node2;
+    return Node[n1].newDepth + Node[n1].invertElev -
+           Node[n2].newDepth - Node[n2].invertElev;
+}
+
+//=============================================================================
+
 void initNodeStates()
 //
 //  Input:   none
@@ -301,10 +654,12 @@ void initNodeStates()
 //  Purpose: initializes node's surface area, inflow & outflow
 //
 {
-    int i;
+    int i, k;
 
-    for (i = 0; i < Nobjects[NODE]; i++)
+    #pragma omp for private(i)
+    for (k = 0; k < NumActiveNodes; k++)
     {
+        i = ActiveNodes[k];
         // --- initialize nodal surface area
         if ( AllowPonding )
         {
@@ -335,6 +690,7 @@ void initNodeStates()
 void   findBypassedLinks()
 {
     int i;
+    #pragma omp for
     for (i = 0; i < Nobjects[LINK]; i++)
     {
         if ( Xnode[Link[i].node1].converged &&
@@ -346,6 +702,37 @@ void   findBypassedLinks()
 
 //=============================================================================
 
+void findActiveSets()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: lists the nodes & conduits to be recomputed on the next trial.
+//
+//  Note: a node stays active if it has not converged or if any conduit
+//        attached to it is not bypassed. Nodes attached to other types
+//        of links are always active (their flows are added to both end
+//        nodes on every trial). The remaining nodes keep their current
+//        depth, inflow & outflow.
+{
+    int i;
+
+    for (i = 0; i < Nobjects[NODE]; i++)
+        Xnode[i].active = !Xnode[i].converged;
+    NumActiveLinks = 0;
+    for (i = 0; i < Nobjects[LINK]; i++)
+    {
+        if ( isTrueConduit(i) && Link[i].bypassed ) continue;
+        if ( isTrueConduit(i) ) ActiveLinks[NumActiveLinks++] = i;
+        Xnode[Link[i].node1].active = TRUE;
+        Xnode[Link[i].node2].active = TRUE;
+    }
+    NumActiveNodes = 0;
+    for (i = 0; i < Nobjects[NODE]; i++)
+        if ( Xnode[i].active ) ActiveNodes[NumActiveNodes++] = i;
+}
+
+//=============================================================================
+
 void  findLimitedLinks()
 //
 //  Input:   none
@@ -381,26 +768,28 @@ void  findLimitedLinks()
 
 void findLinkFlows(double dt)
 {
-    int i;
+    int i, k, n;
 
-    // --- find new flow in each non-dummy conduit
-#pragma omp parallel num_threads(NumThreads)
-{
-    #pragma omp for
-    for ( i = 0; i < Nobjects[LINK]; i++)
+    // --- find new flow in each active non-dummy conduit
+    //     (the active links are split into batches of DWBATCH)
+    #pragma omp for private(n)
+    for ( k = 0; k < NumActiveLinks; k += DWBATCH)
     {
-        if ( isTrueConduit(i) && !Link[i].bypassed )
-            dwflow_findConduitFlow(i, Steps, Omega, dt);
+        n = MIN(DWBATCH, NumActiveLinks - k);
+        dwflow_findConduitFlows(&ActiveLinks[k], n, Steps, Omega, dt);
     }
-}
 
-    // --- update inflow/outflows for nodes attached to non-dummy conduits
-    for ( i = 0; i < Nobjects[LINK]; i++)
+    // --- update inflow/outflows for active nodes attached to non-dummy
+    //     conduits (each node sums its own conduits so there are no
+    //     write conflicts)
+    #pragma omp for
+    for ( k = 0; k < NumActiveNodes; k++)
     {
-        if ( isTrueConduit(i) ) updateNodeFlows(i);
+        gatherConduitFlows(ActiveNodes[k]);
     }
 
     // --- find new flows for all dummy conduits, pumps & regulators
+    #pragma omp single
     for ( i = 0; i < Nobjects[LINK]; i++)
     {
         if ( !isTrueConduit(i) )
@@ -590,6 +979,77 @@ void updateNodeFlows(int i)
 
 //=============================================================================
 
+void gatherConduitFlows(int n)
+//
+//  Input:   n = node index
+//  Output:  none
+//  Purpose: updates cumulative inflow & outflow at a node from the
+//           non-dummy conduits attached to it.
+//
+//  Note: conduits are visited in order of link index, so each node total
+//        receives the same sequence of additions as when updateNodeFlows()
+//        is called for every conduit in turn.
+{
+    int m, i;
+
+    for (m = NodeConduitStart[n]; m < NodeConduitStart[n+1]; m++)
+    {
+        i = NodeConduits[m];
+        if ( Link[i].node1 == Link[i].node2 ) updateNodeFlows(i);
+        else addConduitFlows(i, n);
+    }
+}
+
+//=============================================================================
+
+void addConduitFlows(int i, int n)
+//
+//  Input:   i = index of a non-dummy conduit link
+//           n = index of one of the link's end nodes
+//  Output:  none
+//  Purpose: adds the part of updateNodeFlows() for link i that applies
+//           to node n.
+//
+{
+    int    k = Link[i].subIndex;
+    int    n1 = Link[i].node1;
+    int    n2 = Link[i].node2;
+    int    isUpstream = (n == n1);
+    int    barrels = Conduit[k].barrels;
+    double q = Link[i].newFlow;
+    double conduitLossRate;
+
+    // --- update total inflow & outflow at the node
+    if ( q >= 0.0 )
+    {
+        if ( isUpstream ) Node[n].outflow += q;
+        else              Node[n].inflow  += q;
+    }
+    else
+    {
+        if ( isUpstream ) Node[n].inflow  -= q;
+        else              Node[n].outflow -= q;
+    }
+
+    // --- add the node's share of any uniform evap & seepage loss
+    conduitLossRate = (Conduit[k].evapLossRate + Conduit[k].seepLossRate) *
+                      barrels;
+    if ( conduitLossRate > 0.0 )
+    {
+        if (Node[n1].type != OUTFALL && Node[n2].type != OUTFALL)
+            conduitLossRate /= 2.0;
+        if (Node[n].type != OUTFALL)
+            Node[n].outflow += conduitLossRate;
+    }
+
+    // --- add surf. area & dqdh contributions to the node
+    if ( isUpstream ) Xnode[n].newSurfArea += Link[i].surfArea1 * barrels;
+    else              Xnode[n].newSurfArea += Link[i].surfArea2 * barrels;
+    Xnode[n].sumdqdh += Link[i].dqdh;
+}
+
+//=============================================================================
+
 int findNodeDepths(double dt)
 //
 //  Input:   dt = time step (sec)
@@ -598,19 +1058,19 @@ int findNodeDepths(double dt)
 //  Purpose: finds new depth at all nodes and checks if convergence achieved.
 //
 {
-    int i;
+    int i, k;
     double yOld = 0.0;       // previous node depth (ft)
 
     // --- compute outfall depths based on flow in connecting link
+    #pragma omp single
     for ( i = 0; i < Nobjects[LINK]; i++ ) link_setOutfallDepth(i);
 
-    // --- compute new depth for all non-outfall nodes and determine if
-    //     depth change from previous iteration is below tolerance
-#pragma omp parallel num_threads(NumThreads)
-{
-    #pragma omp for private(yOld)
-    for ( i = 0; i < Nobjects[NODE]; i++ )
+    // --- compute new depth for all active non-outfall nodes and determine
+    //     if depth change from previous iteration is below tolerance
+    #pragma omp for private(i, yOld)
+    for ( k = 0; k < NumActiveNodes; k++ )
     {
+        i = ActiveNodes[k];
         if ( Node[i].type == OUTFALL ) continue;
         yOld = Node[i].newDepth;
         setNodeDepth(i, dt);
@@ -620,11 +1080,12 @@ int findNodeDepths(double dt)
             Xnode[i].converged = FALSE;
         }
     }
-}
 
    // --- return FALSE if any non-Outfall node failed to converge
-    for (i = 0; i < Nobjects[NODE]; i++)
+    //     (inactive nodes have already converged)
+    for (k = 0; k < NumActiveNodes; k++)
     {
+        i = ActiveNodes[k];
         if ( Node[i].type == OUTFALL ) continue;
         if (Xnode[i].converged == FALSE) return FALSE;
     }
@@ -647,7 +1108,6 @@ void setNodeDepth(int i, double dt)
     double  dQ;                        // inflow minus outflow at node (cfs)
     double  dV;                        // change in node volume (ft3)
     double  dy;                        // change in node depth (ft)
-    double  yMax;                      // max. depth at node (ft)
     double  yOld;                      // node depth at previous time step (ft)
     double  yLast;                     // previous node depth (ft)
     double  yNew;                      // new node depth (ft)
@@ -676,18 +1136,7 @@ void setNodeDepth(int i, double dt)
     // --- determine if node is EXTRAN surcharged
     if (SurchargeMethod == EXTRAN)
     {
-        // --- ponded nodes don't surcharge
-        if (isPonded) isSurcharged = FALSE;
-
-        // --- closed storage units that are full are in surcharge
-        else if (Node[i].type == STORAGE)
-        {
-            isSurcharged = (Node[i].surDepth > 0.0 &&
-                            yLast > Node[i].fullDepth);
-        }
-
-        // --- surcharge occurs when node depth exceeds top of its highest link
-        else isSurcharged = (yCrown > 0.0 && yLast > yCrown);
+        isSurcharged = isNodeSurcharged(i, isPonded, yCrown, yLast);
     }
 
     // --- if node not surcharged, base depth change on surface area        
@@ -739,6 +1188,51 @@ void setNodeDepth(int i, double dt)
         if ( canPond && yNew > Node[i].fullDepth )
             yNew = Node[i].fullDepth + FUDGE;
     }
+    saveNodeDepth(i, canPond, dV, yNew, yOld, dt);
+}
+
+//=============================================================================
+
+int isNodeSurcharged(int i, int isPonded, double yCrown, double y)
+//
+//  Input:   i  = node index
+//           isPonded = TRUE if water is currently ponded
+//           yCrown = depth to node crown (ft)
+//           y = current node depth (ft)
+//  Output:  returns TRUE if node is surcharged under the EXTRAN method
+//  Purpose: checks if a non-outfall node is in EXTRAN surcharge.
+//
+{
+    // --- ponded nodes don't surcharge
+    if (isPonded) return FALSE;
+
+    // --- closed storage units that are full are in surcharge
+    if (Node[i].type == STORAGE)
+    {
+        return (Node[i].surDepth > 0.0 && y > Node[i].fullDepth);
+    }
+
+    // --- surcharge occurs when node depth exceeds top of its highest link
+    return (yCrown > 0.0 && y > yCrown);
+}
+
+//=============================================================================
+
+void saveNodeDepth(int i, int canPond, double dV, double yNew, double yOld,
+                   double dt)
+//
+//  Input:   i  = node index
+//           canPond = TRUE if water can pond over node
+//           dV = change in volume over time step (ft3)
+//           yNew = new estimate of node depth (ft)
+//           yOld = node depth at previous time step (ft)
+//           dt = time step (sec)
+//  Output:  none
+//  Purpose: applies depth limits to a new node depth estimate and saves it
+//           along with the node's volume and overflow.
+//
+{
+    double  yMax;                      // max. depth at node (ft)
 
     // --- depth cannot be negative
     if ( yNew < 0 ) yNew = 0.0;
@@ -796,6 +1290,406 @@ double getFloodedDepth(int i, int canPond, double dV, double yNew,
 
 //=============================================================================
 
+int findNewtonDepths(double dt)
+//
+//  Input:   dt = time step (sec)
+//  Output:  returns TRUE if depth change at all non-Outfall nodes is 
+//           within the convergence tolerance and FALSE otherwise
+//  Purpose: finds new depth at all nodes from a Newton step on the nodal
+//           continuity equations and checks if convergence achieved.
+//
+{
+    int    i;
+    int    converged = TRUE;
+    int    isFinal;
+    double *dy = Jwork;      // change in node depths (ft)
+
+    // --- compute outfall depths based on flow in connecting link &
+    //     build the linearized continuity equations
+    #pragma omp single
+    {
+        for ( i = 0; i < Nobjects[LINK]; i++ ) link_setOutfallDepth(i);
+        buildJacobian(dt);
+    }
+
+    // --- solve the equations for the depth changes
+    solveJacobian(dy);
+
+    // --- check that both the depth change and the continuity residual
+    //     (scaled to a depth) are within tolerance at every node
+    #pragma omp for
+    for ( i = 0; i < Nobjects[NODE]; i++ )
+    {
+        if ( Node[i].type == OUTFALL ) continue;
+        Xnode[i].converged = TRUE;
+        if ( fabs(dy[i]) > HeadTol || fabs(Jrhs[i]) > HeadTol * Jdiag[i] )
+        {
+            Xnode[i].converged = FALSE;
+        }
+    }
+    for ( i = 0; i < Nobjects[NODE]; i++ )
+    {
+        if ( Node[i].type == OUTFALL ) continue;
+        if ( Xnode[i].converged == FALSE )
+        {
+            converged = FALSE;
+            break;
+        }
+    }
+
+    // --- update node depths (once converged or out of trials, the depths
+    //     are made to match the volume of the link flows just found)
+    isFinal = converged || Steps + 1 >= MaxTrials;
+    #pragma omp for
+    for ( i = 0; i < Nobjects[NODE]; i++ )
+    {
+        if ( Node[i].type == OUTFALL ) continue;
+        setNewtonDepth(i, dy[i], isFinal, dt);
+    }
+    return converged;
+}
+
+//=============================================================================
+
+void buildJacobian(double dt)
+//
+//  Input:   dt = time step (sec)
+//  Output:  none
+//  Purpose: builds the Jacobian matrix & residuals of the nodal continuity
+//           equations with respect to node depths.
+//
+//  Note: the continuity residual at a non-surcharged node is
+//          A*(y - yOld)/dt - (oldNetInflow + netInflow)/2
+//        and at a surcharged node is -netInflow/2. A link's flow changes
+//        by dqdh per unit of head difference between its end nodes, so
+//        it adds dqdh/2 to the diagonal terms of its end nodes and -dqdh/2
+//        to the off-diagonal term that couples them. The matrix is
+//        symmetric and diagonally dominant. Outfalls and nodes that stay
+//        flooded are held at their current depth.
+{
+    int    i, j, n1, n2;
+    int    canPond, isPonded, oneSided;
+    double yCrown, yLast, yMax, surfArea, dQ, f, dqdh, y1;
+    double w = 1.0;          // weight on flow changes
+
+    // --- after the first iteration new link flows are under-relaxed,
+    //     so they change by only Omega times dqdh
+    if ( Steps > 0 ) w = Omega;
+
+    for ( i = 0; i < Nobjects[NODE]; i++ )
+    {
+        Jfixed[i] = TRUE;
+        Jdiag[i] = 1.0;
+        Jrhs[i] = 0.0;
+        if ( Node[i].type == OUTFALL ) continue;
+
+        canPond = (AllowPonding && Node[i].pondedArea > 0.0);
+        isPonded = (canPond && Node[i].newDepth > Node[i].fullDepth);
+        yCrown = Node[i].crownElev - Node[i].invertElev;
+        yLast = Node[i].newDepth;
+        surfArea = MAX(Xnode[i].newSurfArea, MinSurfArea);
+        dQ = Node[i].inflow - Node[i].outflow;
+
+        // --- surcharged node: no change in stored volume, so net inflow
+        //     is driven to zero (surface area only damps the step)
+        if ( SurchargeMethod == EXTRAN &&
+             isNodeSurcharged(i, isPonded, yCrown, yLast) )
+        {
+            surfArea = MinSurfArea;
+            if ( yLast < 1.25 * yCrown )
+            {
+                f = (yLast - yCrown) / yCrown;
+                surfArea = MAX(Xnode[i].oldSurfArea * exp(-15.0 * f),
+                               MinSurfArea);
+            }
+            Jrhs[i] = 0.5 * dQ;
+        }
+
+        // --- otherwise change in volume balances average net inflow
+        else Jrhs[i] = 0.5 * (Node[i].oldNetInflow + dQ) -
+                       surfArea * (yLast - Node[i].oldDepth) / dt;
+
+        // --- a non-ponding node that is flooded & still filling
+        //     stays at its max. depth
+        yMax = Node[i].fullDepth + Node[i].surDepth;
+        if ( !canPond && yLast >= yMax && Jrhs[i] > 0.0 )
+        {
+            Jrhs[i] = 0.0;
+            continue;
+        }
+        Jfixed[i] = FALSE;
+        Jdiag[i] = surfArea / dt;
+    }
+
+    // --- add each link's flow derivative to the matrix
+    for ( j = 0; j < Nobjects[LINK]; j++ )
+    {
+        n1 = Link[j].node1;
+        n2 = Link[j].node2;
+        Jlink[j] = 0.0;
+        dqdh = w * Link[j].dqdh;
+        oneSided = FALSE;
+        if ( Link[j].type == CONDUIT )
+        {
+            // --- dry or closed conduits carry no flow
+            if ( Link[j].flowClass == DRY || Link[j].flowClass == UP_DRY ||
+                 Link[j].flowClass == DN_DRY || Link[j].setting == 0.0 )
+                continue;
+
+            // --- normal flow (~ y^5/3) & inlet controlled flow depend
+            //     only on the upstream head
+            if ( Link[j].normalFlow )
+            {
+                y1 = MAX(Node[n1].newDepth - Link[j].offset1, FUDGE);
+                dqdh = MIN(dqdh, w * 5.0 / 3.0 * fabs(Link[j].newFlow) / y1);
+                oneSided = TRUE;
+            }
+            if ( Link[j].inletControl ) oneSided = TRUE;
+        }
+
+        // --- pump flows don't depend on the head difference across them
+        else if ( Link[j].type == PUMP ) oneSided = TRUE;
+
+        // --- a one-sided derivative only adds to the upstream node's
+        //     diagonal (so the matrix stays symmetric)
+        if ( !Jfixed[n1] ) Jdiag[n1] += 0.5 * dqdh;
+        if ( oneSided || n1 == n2 ) continue;
+        if ( !Jfixed[n2] ) Jdiag[n2] += 0.5 * dqdh;
+        if ( !Jfixed[n1] && !Jfixed[n2] ) Jlink[j] = 0.5 * dqdh;
+    }
+}
+
+//=============================================================================
+
+void solveJacobian(double x[])
+//
+//  Input:   none
+//  Output:  x = change in depth at each node (ft)
+//  Purpose: solves the Newton equations with a Jacobi-preconditioned
+//           conjugate gradient method.
+//
+//  Note: the threads of a team share the work of each loop. Dot products
+//        are summed over fixed blocks of SUMBLOCK nodes whose sums are
+//        then added in block order, so the solution is the same for any
+//        number of threads.
+{
+    int    i, i2, k, iter;
+    int    n = Nobjects[NODE];
+    int    nBlocks = getNumBlocks(n);
+    double *r = x + n;                 // residual
+    double *z = r + n;                 // preconditioned residual
+    double *p = z + n;                 // search direction
+    double *q = p + n;                 // matrix times search direction
+    double rz, rzNew, pq, alpha, beta, zMax;
+    double sum, big;                   // sum & max. of a block of nodes
+    double tol = PCG_TOLERANCE * HeadTol;
+
+    // --- start from a zero depth change
+    #pragma omp for private(i, i2, sum, big)
+    for ( k = 0; k < nBlocks; k++ )
+    {
+        sum = 0.0;
+        big = 0.0;
+        i2 = MIN(n, (k + 1) * SUMBLOCK);
+        for ( i = k * SUMBLOCK; i < i2; i++ )
+        {
+            x[i] = 0.0;
+            r[i] = Jrhs[i];
+            z[i] = r[i] / Jdiag[i];
+            p[i] = z[i];
+            sum += r[i] * z[i];
+            big = MAX(big, fabs(z[i]));
+        }
+        Jblock[2*k] = sum;
+        Jblock[2*k+1] = big;
+    }
+    rz = addBlockSums(nBlocks, &zMax);
+
+    // --- iterate until residual, scaled to a depth, is within tolerance
+    for ( iter = 0; iter < PCG_MAXITER && zMax > tol; iter++ )
+    {
+        multiplyJacobian(p, q);
+        #pragma omp for private(i, i2, sum)
+        for ( k = 0; k < nBlocks; k++ )
+        {
+            sum = 0.0;
+            i2 = MIN(n, (k + 1) * SUMBLOCK);
+            for ( i = k * SUMBLOCK; i < i2; i++ ) sum += p[i] * q[i];
+            Jblock[2*k] = sum;
+            Jblock[2*k+1] = 0.0;
+        }
+        pq = addBlockSums(nBlocks, &big);
+        if ( pq <= 0.0 ) break;
+        alpha = rz / pq;
+        #pragma omp for private(i, i2, sum, big)
+        for ( k = 0; k < nBlocks; k++ )
+        {
+            sum = 0.0;
+            big = 0.0;
+            i2 = MIN(n, (k + 1) * SUMBLOCK);
+            for ( i = k * SUMBLOCK; i < i2; i++ )
+            {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * q[i];
+                z[i] = r[i] / Jdiag[i];
+                sum += r[i] * z[i];
+                big = MAX(big, fabs(z[i]));
+            }
+            Jblock[2*k] = sum;
+            Jblock[2*k+1] = big;
+        }
+        rzNew = addBlockSums(nBlocks, &zMax);
+        beta = rzNew / rz;
+        rz = rzNew;
+        #pragma omp for
+        for ( i = 0; i < n; i++ ) p[i] = z[i] + beta * p[i];
+    }
+}
+
+//=============================================================================
+
+double addBlockSums(int nBlocks, double *bigMax)
+//
+//  Input:   nBlocks = number of blocks of nodes
+//  Output:  bigMax = largest of the blocks' max. values;
+//           returns sum of the blocks' sums
+//  Purpose: combines the block sums & max. values left in Jblock by the
+//           threads of a team.
+//
+{
+    int    k;
+    double sum = 0.0;
+    double big = 0.0;
+
+    // --- one thread adds the block sums in block order and passes the
+    //     result to the others (which wait, so Jblock can then be reused)
+    #pragma omp single copyprivate(sum, big)
+    for ( k = 0; k < nBlocks; k++ )
+    {
+        sum += Jblock[2*k];
+        big = MAX(big, Jblock[2*k+1]);
+    }
+    *bigMax = big;
+    return sum;
+}
+
+//=============================================================================
+
+int getNumBlocks(int n)
+//
+//  Input:   n = number of items
+//  Output:  returns number of blocks of SUMBLOCK items that hold n items
+//  Purpose: finds how many blocks a parallel sum over n items uses.
+//
+{
+    return (n + SUMBLOCK - 1) / SUMBLOCK;
+}
+
+//=============================================================================
+
+void multiplyJacobian(double x[], double y[])
+//
+//  Input:   x = vector of node values
+//  Output:  y = Jacobian matrix times x
+//  Purpose: multiplies the Newton Jacobian matrix by a vector.
+//
+//  Note: each node gathers the terms of its own conduits (so the threads
+//        of a team have no write conflicts) before the terms of any
+//        other links are added.
+{
+    int    i, j, m, n1, n2;
+    double c;
+
+    #pragma omp for private(j, m, c)
+    for ( i = 0; i < Nobjects[NODE]; i++ )
+    {
+        y[i] = Jdiag[i] * x[i];
+        for (m = NodeConduitStart[i]; m < NodeConduitStart[i+1]; m++)
+        {
+            j = NodeConduits[m];
+            c = Jlink[j];
+            if ( c == 0.0 ) continue;
+            if ( Link[j].node1 == i ) y[i] -= c * x[Link[j].node2];
+            else                      y[i] -= c * x[Link[j].node1];
+        }
+    }
+    #pragma omp single
+    for ( j = 0; j < Nobjects[LINK]; j++ )
+    {
+        c = Jlink[j];
+        if ( c == 0.0 || isTrueConduit(j) ) continue;
+        n1 = Link[j].node1;
+        n2 = Link[j].node2;
+        y[n1] -= c * x[n2];
+        y[n2] -= c * x[n1];
+    }
+}
+
+//=============================================================================
+
+void setNewtonDepth(int i, double dy, int isFinal, double dt)
+//
+//  Input:   i  = node index
+//           dy = Newton change in node depth (ft)
+//           isFinal = TRUE if this is the last Newton iteration
+//           dt = time step (sec)
+//  Output:  none
+//  Purpose: sets depth at non-outfall node from a Newton step.
+//
+{
+    int     canPond;                   // TRUE if node can pond overflows
+    int     isPonded;                  // TRUE if node is currently ponded 
+    double  dV;                        // change in node volume (ft3)
+    double  yLast;                     // previous node depth (ft)
+    double  yNew;                      // new node depth (ft)
+    double  yCrown;                    // depth to node crown (ft)
+    double  surfArea;                  // node surface area (ft2)
+
+    canPond = (AllowPonding && Node[i].pondedArea > 0.0);
+    isPonded = (canPond && Node[i].newDepth > Node[i].fullDepth);
+    yCrown = Node[i].crownElev - Node[i].invertElev;
+    yLast = Node[i].newDepth;
+    Node[i].overflow = 0.0;
+    dV = 0.5 * (Node[i].oldNetInflow + Node[i].inflow - Node[i].outflow) * dt;
+
+    // --- a node held at its flooded depth overflows its net inflow
+    if ( Jfixed[i] )
+    {
+        yNew = getFloodedDepth(i, FALSE, dV, yLast, yLast, dt);
+        Xnode[i].dYdT = fabs(yNew - Node[i].oldDepth) / dt;
+        Node[i].newDepth = yNew;
+        return;
+    }
+    yNew = yLast + dy;
+
+    // --- apply same depth limits as a Picard iteration
+    if ( SurchargeMethod == EXTRAN &&
+         isNodeSurcharged(i, isPonded, yCrown, yLast) )
+    {
+        if ( yNew < yCrown ) yNew = yCrown - FUDGE;
+        if ( canPond && yNew > Node[i].fullDepth )
+            yNew = Node[i].fullDepth + FUDGE;
+    }
+    else
+    {
+        // --- on the final iteration, store exactly the net inflow volume
+        //     of the current link flows (the Newton step also includes
+        //     the linearized flow changes, which would upset continuity)
+        surfArea = MAX(Xnode[i].newSurfArea, MinSurfArea);
+        if ( isFinal ) yNew = Node[i].oldDepth + dV / surfArea;
+
+        // --- under-relax the update as a Picard iteration does (keeps
+        //     nearly dry nodes from being drained within a single step)
+        if ( Steps > 0 ) yNew = (1.0 - Omega) * yLast + Omega * yNew;
+        if ( !isPonded ) Xnode[i].oldSurfArea = surfArea;
+        if ( isPonded && yNew < Node[i].fullDepth )
+            yNew = Node[i].fullDepth - FUDGE;
+    }
+    saveNodeDepth(i, canPond, dV, yNew, Node[i].oldDepth, dt);
+}
+
+//=============================================================================
+
 double getVariableStep(double maxStep)
 //
 //  Input:   maxStep = user-supplied max. time step (sec)
@@ -842,42 +1736,73 @@ double getLinkStep(double tMin, int *minLink)
 //
 {
     int    i;                           // link index
-    int    k;                           // conduit index
-    double q;                           // conduit flow (cfs)
-    double t;                           // time step (sec)
+    int    iLink = -1;                  // critical link index
     double tLink = tMin;                // critical link time step (sec)
+    TProject* project = ActiveProject;
+
+#pragma omp parallel num_threads(NumThreads) \
+    if ( Nobjects[LINK] >= MinParallelLinks )
+{
+    double t;                           // time step (sec)
+    int    iLocal = -1;                 // critical link of this thread
+    double tLocal = tMin;               // critical step of this thread (sec)
+
+    ActiveProject = project;  // worker threads work on the caller's project
 
     // --- examine each conduit link
+    #pragma omp for
     for ( i = 0; i < Nobjects[LINK]; i++ )
     {
-        if ( Link[i].type == CONDUIT )
+        // --- update critical link time step
+        t = getConduitStep(i);
+        if ( t < tLocal )
         {
-            // --- skip conduits with negligible flow, area or Fr
-            k = Link[i].subIndex;
-            q = fabs(Link[i].newFlow) / Conduit[k].barrels;
-            if ( q <= FUDGE 
-            ||   Conduit[k].a1 <= FUDGE
-            ||   Link[i].froude <= 0.01 
-               ) continue;
-
-            // --- compute time step to satisfy Courant condition
-            t = Link[i].newVolume / Conduit[k].barrels / q;
-            t = t * Conduit[k].modLength / link_getLength(i);
-            t = t * Link[i].froude / (1.0 + Link[i].froude) * CourantFactor;
-
-            // --- update critical link time step
-            if ( t < tLink )
-            {
-                tLink = t;
-                *minLink = i;
-            }
+            tLocal = t;
+            iLocal = i;
         }
     }
+
+    // --- combine the results of each thread
+    #pragma omp critical
+    updateCriticalStep(tLocal, iLocal, &tLink, &iLink);
+}
+    if ( iLink >= 0 ) *minLink = iLink;
     return tLink;
 }
 
 //=============================================================================
 
+double getConduitStep(int i)
+//
+//  Input:   i = link index
+//  Output:  returns time step (sec)
+//  Purpose: finds the time step that satisfies the Courant criterion for
+//           a conduit link (BIG if link is not a flowing conduit).
+//
+{
+    int    k;                           // conduit index
+    double q;                           // conduit flow (cfs)
+    double t;                           // time step (sec)
+
+    if ( Link[i].type != CONDUIT ) return BIG;
+
+    // --- skip conduits with negligible flow, area or Fr
+    k = Link[i].subIndex;
+    q = fabs(Link[i].newFlow) / Conduit[k].barrels;
+    if ( q <= FUDGE 
+    ||   Conduit[k].a1 <= FUDGE
+    ||   Link[i].froude <= 0.01 
+       ) return BIG;
+
+    // --- compute time step to satisfy Courant condition
+    t = Link[i].newVolume / Conduit[k].barrels / q;
+    t = t * Conduit[k].modLength / link_getLength(i);
+    t = t * Link[i].froude / (1.0 + Link[i].froude) * CourantFactor;
+    return t;
+}
+
+//=============================================================================
+
 double getNodeStep(double tMin, int *minNode)
 //
 //  Input:   tMin = critical time step found so far (sec)
@@ -888,13 +1813,24 @@ double getNodeStep(double tMin, int *minNode)
 //
 {
     int    i;                           // node index
+    int    iNode = -1;                  // critical node index
+    double tNode = tMin;                // critical node time step (sec)
+    TProject* project = ActiveProject;
+
+#pragma omp parallel num_threads(NumThreads) \
+    if ( Nobjects[LINK] >= MinParallelLinks )
+{
     double maxDepth;                    // max. depth allowed at node (ft)
     double dYdT;                        // change in depth per unit time (ft/sec)
     double t1;                          // time needed to reach depth limit (sec)
-    double tNode = tMin;                // critical node time step (sec)
+    int    iLocal = -1;                 // critical node of this thread
+    double tLocal = tMin;               // critical step of this thread (sec)
+
+    ActiveProject = project;  // worker threads work on the caller's project
 
     // --- find smallest time so that estimated change in nodal depth
     //     does not exceed safety factor * maxdepth
+    #pragma omp for
     for ( i = 0; i < Nobjects[NODE]; i++ )
     {
         // --- see if node can be skipped
@@ -911,11 +1847,39 @@ double getNodeStep(double tMin, int *minNode)
 
         // --- compute time to reach max. depth & compare with critical time
         t1 = maxDepth / dYdT;
-        if ( t1 < tNode )
+        if ( t1 < tLocal )
         {
-            tNode = t1;
-            *minNode = i;
+            tLocal = t1;
+            iLocal = i;
         }
     }
+
+    // --- combine the results of each thread
+    #pragma omp critical
+    updateCriticalStep(tLocal, iLocal, &tNode, &iNode);
+}
+    if ( iNode >= 0 ) *minNode = iNode;
     return tNode;
 }
+
+//=============================================================================
+
+void updateCriticalStep(double t, int i, double *tMin, int *iMin)
+//
+//  Input:   t = critical time step found by one thread (sec)
+//           i = index of element with time step t (-1 if none found)
+//           tMin = critical time step found so far (sec)
+//           iMin = index of element with time step tMin
+//  Output:  updated values of tMin and iMin
+//  Purpose: merges one thread's critical time step into the overall one.
+//
+//  Note: ties go to the lowest element index, as in a serial search,
+//        so the result doesn't depend on the order threads finish in.
+{
+    if ( i < 0 ) return;
+    if ( t < *tMin || (t == *tMin && i < *iMin) )
+    {
+        *tMin = t;
+        *iMin = i;
+    }
+}
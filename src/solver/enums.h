@@ -33,6 +33,13 @@
 //   - Support added for analytical storage shapes.
 //   Build 5.2.1:
 //   - Adds a NEITHER option to the NormalFlowType enumeration. 
+//   Build 5.2.4 (OWA):
+//   - RENUMBER option and RenumberType enumeration added.
+//   - DynWaveSolverType enumeration added.
+//   - ACTIVE_SET, TIME_STEP_CLASSES and MIN_PARALLEL_LINKS options added.
+//   - GEOMETRY_CACHE option added.
+//   - TIMESERIES_CACHE option added.
+//   - COMPRESS_OUTPUT option added.
 //-----------------------------------------------------------------------------
 
 #ifndef ENUMS_H
@@ -371,6 +378,15 @@ enum  CompatibilityType {
       EXTRAN,                          // original EXTRAN method
       SLOT};                           // Preissmann slot method
 
+ enum  DynWaveSolverType {
+      PICARD_SOLVER,                   // under-relaxed Picard iterations
+      NEWTON_SOLVER};                  // implicit Newton iterations
+
+ enum  RenumberType {
+      NO_RENUMBER,                     // nodes & links kept in input order
+      BFS_RENUMBER,                    // breadth-first from outfalls
+      RCM_RENUMBER};                   // reverse Cuthill-McKee
+
  enum InflowType {
       EXTERNAL_INFLOW,                 // user-supplied external inflow
       DRY_WEATHER_INFLOW,              // user-supplied dry weather inflow
@@ -486,7 +502,9 @@ enum  CompatibilityType {
     IGNORE_SNOWMELT, IGNORE_GWATER, IGNORE_ROUTING,
     IGNORE_QUALITY, MAX_TRIALS, HEAD_TOL,
     SYS_FLOW_TOL, LAT_FLOW_TOL, IGNORE_RDII,
-    MIN_ROUTE_STEP, NUM_THREADS, SURCHARGE_METHOD};
+    MIN_ROUTE_STEP, NUM_THREADS, SURCHARGE_METHOD,
+    RENUMBER, ACTIVE_SET, STEP_CLASSES, MIN_PARALLEL,
+    GEOM_CACHE, TSERIES_CACHE, COMPRESS_OUTPUT};
 
 enum  NoYesType {
       NO,
@@ -23,9 +23,10 @@
 #define _CRT_SECURE_NO_DEPRECATE
 
 #include <string.h>
+#include "macros.h"
 #include "error.h"
 
-char  ErrString[256];
+SWMM_TLS char  ErrString[256];
 
 char* error_getMsg(int errCode, char* msg)
 {
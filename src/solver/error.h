@@ -160,6 +160,12 @@ enum  ErrorType {
       ERR_TABLE_FILE_OPEN      = 361,
       ERR_TABLE_FILE_READ      = 363,
 
+// ... Compiled Project File Errors
+      ERR_COMPILED_FILE_OPEN   = 371,
+      ERR_COMPILED_FILE_READ   = 373,
+      ERR_COMPILED_FILE_WRITE  = 375,
+      ERR_COMPILED_OBJECTS     = 377,
+
 // ... Runtime Errors
       ERR_SYSTEM               = 500,
 
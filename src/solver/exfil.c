@@ -18,6 +18,8 @@
 //   - Fixed units conversion error for storage units with surface area curves.
 //   Build 5.2.0:
 //   - Support added for analytical storage shapes.
+//   Build 5.2.4 (OWA):
+//   - Exfiltration objects allocated from the nodes' memory pool.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -222,7 +224,7 @@ int  createStorageExfil(int k, double x[])
 //  Output:  returns an error code.
 //  Purpose: creates an exfiltration object for a storage node.
 //
-//  Note: the exfiltration object is freed in project.c.
+//  Note: the exfiltration object is freed with the nodes' memory pool.
 //
 {
     TExfil*   exfil;
@@ -231,16 +233,16 @@ int  createStorageExfil(int k, double x[])
     exfil = Storage[k].exfil;
     if ( exfil == NULL )
     {
-        exfil = (TExfil *) malloc(sizeof(TExfil));
+        exfil = (TExfil *) project_alloc(NODE, 1, sizeof(TExfil));
         if ( exfil == NULL ) return error_setInpError(ERR_MEMORY, "");
         Storage[k].exfil = exfil;
 
         // --- create Green-Ampt infiltration objects for the bottom & banks
         exfil->btmExfil = NULL;
         exfil->bankExfil = NULL;
-        exfil->btmExfil = (TGrnAmpt *) malloc(sizeof(TGrnAmpt));
+        exfil->btmExfil = (TGrnAmpt *) project_alloc(NODE, 1, sizeof(TGrnAmpt));
         if ( exfil->btmExfil == NULL ) return error_setInpError(ERR_MEMORY, "");
-        exfil->bankExfil = (TGrnAmpt *) malloc(sizeof(TGrnAmpt));
+        exfil->bankExfil = (TGrnAmpt *) project_alloc(NODE, 1, sizeof(TGrnAmpt));
         if ( exfil->bankExfil == NULL ) return error_setInpError(ERR_MEMORY, "");
     }
 
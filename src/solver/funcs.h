@@ -31,6 +31,14 @@
 //   - Refactored external inflow code.
 //   Build 5.2.4:
 //   - Additional arguments added to function link_getLossRate.
+//   Build 5.2.4 (OWA):
+//   - Functions for renumbering nodes & links added.
+//   - Functions for caching tabulated cross section geometry added.
+//   - dwflow_findConduitFlow replaced by batched dwflow_findConduitFlows.
+//   - table_setStorageVolumes added.
+//   - Functions for caching time series data files added.
+//   - Functions for compiled project files added.
+//   - stats_updateLinkTrials added.
 //-----------------------------------------------------------------------------
 
 #ifndef FUNCS_H
@@ -47,18 +55,31 @@ int      project_readOption(char* s1, char* s2);
 void     project_validate(void);
 int      project_init(void);
 
+void     project_readCompiled(void);
+void     project_validateCompiled(void);
+void     project_getIDs(int type, char* ids[]);
+
 int      project_addObject(int type, char* id, int n);
 int      project_findObject(int type, const char* id);
 char*    project_findID(int type, char* id);
 
+void     project_renumberObjects(int type, int inputIndex[]);
+int      project_getInternalIndex(int type, int index);
+int      project_getInputIndex(int type, int index);
+
 double** project_createMatrix(int nrows, int ncols);
 void     project_freeMatrix(double** m);
 
+void*    project_alloc(int type, int n, size_t size);
+
 //-----------------------------------------------------------------------------
 //   Input Reader Methods
 //-----------------------------------------------------------------------------
 int     input_countObjects(void);
 int     input_readData(void);
+int     input_copySections(const int sects[], int n, char** text,
+        size_t* size);
+int     input_readSections(char* text, size_t size);
 
 //-----------------------------------------------------------------------------
 //   Report Writer Methods
@@ -189,7 +210,6 @@ double  gwater_getVolume(int subcatch);
 //   RDII Methods
 //-----------------------------------------------------------------------------
 int     rdii_readRdiiInflow(char* tok[], int ntoks);
-void    rdii_deleteRdiiInflow(int node);
 void    rdii_initUnitHyd(int unitHyd);
 int     rdii_readUnitHydParams(char* tok[], int ntoks);
 void    rdii_openRdii(void);
@@ -224,6 +244,8 @@ double  flowrout_getRoutingStep(int routingModel, double fixedStep);
 int     flowrout_execute(int links[], int routingModel, double tStep);
 
 void    toposort_sortLinks(int links[]);
+int     toposort_renumber(int method, int nNodes, int nLinks, int node1[],
+        int node2[], char isOutfall[], int nodeOrder[], int linkOrder[]);
 int     kinwave_execute(int link, double* qin, double* qout, double tStep);
 
 void    dynwave_validate(void);
@@ -231,10 +253,13 @@ void    dynwave_init(void);
 void    dynwave_close(void);
 double  dynwave_getRoutingStep(double fixedStep);
 int     dynwave_execute(double tStep);
-void    dwflow_findConduitFlow(int j, int steps, double omega, double dt);
+int     dwflow_isCircBatched(int j);
+void    dwflow_findConduitFlows(int* links, int n, int steps, double omega,
+        double dt);
 
 void    qualrout_init(void);
 void    qualrout_execute(double tStep);
+void    qualrout_setOldState(void);
 
 //-----------------------------------------------------------------------------
 //   Treatment Methods
@@ -284,6 +309,7 @@ void    stats_report(void);
 void    stats_updateCriticalTimeCount(int node, int link);
 void    stats_updateFlowStats(double tStep, DateTime aDate);
 void    stats_updateTimeStepStats(double tStep, int trialsCount, int steadyState);
+void    stats_updateLinkTrials(int linkCount);
 
 void    stats_updateSubcatchStats(int subcatch, double rainVol, 
         double runonVol, double evapVol, double infilVol,
@@ -351,7 +377,6 @@ void    node_validate(int node);
 void    node_initState(int node);
 void    node_initFlows(int node, double tStep);
 void    node_setOldHydState(int node);
-void    node_setOldQualState(int node);
 void    node_setOutletDepth(int node, double yNorm, double yCrit, double z);
 
 double  node_getSurfArea(int node, double depth);
@@ -382,8 +407,6 @@ void    inflow_initDwfPattern(int pattern);
 double  inflow_getExtInflow(TExtInflow* inflow, DateTime aDate);
 double  inflow_getDwfInflow(TDwfInflow* inflow, int m, int d, int h);
 
-void    inflow_deleteExtInflows(int node);
-void    inflow_deleteDwfInflows(int node);
 
 //-----------------------------------------------------------------------------
 //   Routing Interface File Methods
@@ -403,6 +426,13 @@ void    iface_saveOutletResults(DateTime reportDate, FILE* file);
 int     hotstart_open(void);
 void    hotstart_close(void);
 
+//-----------------------------------------------------------------------------
+//   Compiled Project File Methods
+//-----------------------------------------------------------------------------
+int     snapshot_save(const char* fname);
+int     snapshot_open(void);
+int     snapshot_read(void);
+
 //-----------------------------------------------------------------------------
 //   Conveyance System Link Methods
 //-----------------------------------------------------------------------------
@@ -413,7 +443,6 @@ int     link_readLossParams(char* tok[], int ntoks);
 void    link_validate(int link);
 void    link_initState(int link);
 void    link_setOldHydState(int link);
-void    link_setOldQualState(int link);
 
 void    link_setTargetSetting(int j);
 void    link_setSetting(int j, double tstep);
@@ -452,6 +481,14 @@ double  xsect_getRofY(TXsect* xsect, double y);
 double  xsect_getWofY(TXsect* xsect, double y);
 double  xsect_getYcrit(TXsect* xsect, double q);
 
+int     xsect_openGeomCache(int nXsects);
+void    xsect_closeGeomCache(void);
+void    xsect_setGeomTable(TXsect* xsect);
+int     xsect_getGeomTableCount(void);
+
+void    xsect_getCircAandR(int n, double* y, double* yFull, double* aFull,
+        double* rFull, double* wSlot, double* a, double* r);
+
 //-----------------------------------------------------------------------------
 //   Culvert/Roadway Methods
 //-----------------------------------------------------------------------------
@@ -522,12 +559,17 @@ double  table_inverseLookup(TTable* table, double y);
 
 double  table_getSlope(TTable *table, double x);
 double  table_getMaxY(TTable *table, double x);
+int     table_setStorageVolumes(TTable* table);
 double  table_getStorageVolume(TTable* table, double x);
 double  table_getStorageDepth(TTable* table, double v);
 
 void    table_tseriesInit(TTable *table);
 double  table_tseriesLookup(TTable* table, double t, char extend);
 
+int     tscache_open(TTable* table);
+void    tscache_close(TTable* table);
+int     tscache_findEntry(TTable* table, int lo, double x);
+
 //-----------------------------------------------------------------------------
 //   Utility Methods
 //-----------------------------------------------------------------------------
@@ -543,6 +585,7 @@ size_t   sstrncpy(char *dest, const char *src,
          size_t n);                           // safe string copy
 size_t   sstrcat(char* dest, const char* src,
          size_t destsize);                    // safe string concatenation 
+char*    sstrtok(char *s, const char *delim); // thread-safe strtok
 void     writecon(const char *s);             // writes string to console
 DateTime getDateTime(double elapsedMsec);     // convert elapsed time to date
 void     getElapsedTime(DateTime aDate,       // convert elapsed date
@@ -30,144 +30,621 @@
 //   - Fixes bug in summary statistics when Report Start date > Start Date.
 //   Build 5.2.0:
 //   - Support for relative file names added.
+//   Build 5.2.4 (OWA):
+//   - Global variables gathered into a per-project context (TProject)
+//     so that several projects can be run in the same process.
+//   - Renumber option and renumbered object index maps added.
+//   - DynWaveSolver option and Newton solver work arrays added.
+//   - ActiveSet option and active node & link lists added.
+//   - StepClasses option for local time stepping of conduits added.
+//   - Newton solver block sums added.
+//   - MinParallelLinks option added.
+//   - GeomCache option and xsect.c geometry cache tables added.
+//   - TseriesCache option added.
+//   - Pollutant matrices of nodes & links (NodeQual & LinkQual) added.
+//   - Lists of the result variables saved to the output file added.
+//   - CompressOutput option and compressed results chunk index added.
 //-----------------------------------------------------------------------------
 
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
+#include <time.h>
+#include "mempool.h"
 
-EXTERN TFile
-                  Finp,                     // Input file
-                  Fout,                     // Output file
-                  Frpt,                     // Report file
-                  Fclimate,                 // Climate file
-                  Frain,                    // Rainfall file
-                  Frunoff,                  // Runoff file
-                  Frdii,                    // RDII inflow file
-                  Fhotstart1,               // Hot start input file
-                  Fhotstart2,               // Hot start output file
-                  Finflows,                 // Inflows routing file
-                  Foutflows;                // Outflows routing file
-
-EXTERN long
-                  Nperiods,                 // Number of reporting periods
-                  TotalStepCount,           // Total routing steps used 
-                  ReportStepCount,          // Reporting routing steps used
-                  NonConvergeCount;         // Number of non-converging steps
-
-EXTERN char
-                  Msg[MAXMSG+1],            // Text of output message
-                  ErrorMsg[MAXMSG+1],       // Text of error message
-                  Title[MAXTITLE][MAXMSG+1],// Project title
-                  TempDir[MAXFNAME+1],      // Temporary file directory
-                  InpDir[MAXFNAME+1];       // Input file directory
-
-EXTERN TRptFlags
-                  RptFlags;                 // Reporting options
-
-EXTERN int
-                  Nobjects[MAX_OBJ_TYPES],  // Number of each object type
-                  Nnodes[MAX_NODE_TYPES],   // Number of each node sub-type
-                  Nlinks[MAX_LINK_TYPES],   // Number of each link sub-type
-                  UnitSystem,               // Unit system
-                  FlowUnits,                // Flow units
-                  InfilModel,               // Infiltration method
-                  RouteModel,               // Flow routing method
-                  ForceMainEqn,             // Flow equation for force mains
-                  LinkOffsets,              // Link offset convention
-                  SurchargeMethod,          // EXTRAN or SLOT method 
-                  AllowPonding,             // Allow water to pond at nodes
-                  InertDamping,             // Degree of inertial damping
-                  NormalFlowLtd,            // Normal flow limited
-                  SlopeWeighting,           // Use slope weighting
-                  Compatibility,            // SWMM 5/3/4 compatibility
-                  SkipSteadyState,          // Skip over steady state periods
-                  IgnoreRainfall,           // Ignore rainfall/runoff
-                  IgnoreRDII,               // Ignore RDII
-                  IgnoreSnowmelt,           // Ignore snowmelt
-                  IgnoreGwater,             // Ignore groundwater
-                  IgnoreRouting,            // Ignore flow routing
-                  IgnoreQuality,            // Ignore water quality
-                  ErrorCode,                // Error code number
-                  Warnings,                 // Number of warning messages
-                  WetStep,                  // Runoff wet time step (sec)
-                  DryStep,                  // Runoff dry time step (sec)
-                  ReportStep,               // Reporting time step (sec)
-                  RuleStep,                 // Rule evaluation time step (sec)
-                  SweepStart,               // Day of year when sweeping starts
-                  SweepEnd,                 // Day of year when sweeping ends
-                  MaxTrials,                // Max. trials for DW routing
-                  NumThreads,               // Number of parallel threads used
-                  ExtPollutFlag,            // OWA EDIT - toolkit API for set external pollutant injection
-                  NumEvents;                // Number of detailed events
-
-EXTERN double
-                  RouteStep,                // Routing time step (sec)
-                  MinRouteStep,             // Minimum variable time step (sec)
-                  LengtheningStep,          // Time step for lengthening (sec)
-                  StartDryDays,             // Antecedent dry days
-                  CourantFactor,            // Courant time step factor
-                  MinSurfArea,              // Minimum nodal surface area
-                  MinSlope,                 // Minimum conduit slope
-                  RunoffError,              // Runoff continuity error
-                  GwaterError,              // Groundwater continuity error
-                  FlowError,                // Flow routing error
-                  QualError,                // Quality routing error
-                  HeadTol,                  // DW routing head tolerance (ft)
-                  SysFlowTol,               // Tolerance for steady system flow
-                  LatFlowTol,               // Tolerance for steady nodal inflow
-                  CrownCutoff;              // Fractional pipe crown cutoff
-
-EXTERN DateTime
-                  StartDate,                // Starting date
-                  StartTime,                // Starting time
-                  StartDateTime,            // Starting Date+Time
-                  EndDate,                  // Ending date
-                  EndTime,                  // Ending time
-                  EndDateTime,              // Ending Date+Time
-                  ReportStartDate,          // Report start date
-                  ReportStartTime,          // Report start time
-                  ReportStart;              // Report start Date+Time
-
-EXTERN double
-                  ReportTime,               // Current reporting time (msec)
-                  OldRunoffTime,            // Previous runoff time (msec)
-                  NewRunoffTime,            // Current runoff time (msec)
-                  OldRoutingTime,           // Previous routing time (msec)
-                  NewRoutingTime,           // Current routing time (msec)
-                  TotalDuration,            // Simulation duration (msec)
-                  ElapsedTime;              // Current elapsed time (days)
-
-EXTERN TTemp      Temp;                     // Temperature data
-EXTERN TEvap      Evap;                     // Evaporation data
-EXTERN TWind      Wind;                     // Wind speed data
-EXTERN TSnow      Snow;                     // Snow melt data
-EXTERN TAdjust    Adjust;                   // Climate adjustments
-
-EXTERN TSnowmelt* Snowmelt;                 // Array of snow melt objects
-EXTERN TGage*     Gage;                     // Array of rain gages
-EXTERN TSubcatch* Subcatch;                 // Array of subcatchments
-EXTERN TAquifer*  Aquifer;                  // Array of groundwater aquifers
-EXTERN TUnitHyd*  UnitHyd;                  // Array of unit hydrographs
-EXTERN TNode*     Node;                     // Array of nodes
-EXTERN TOutfall*  Outfall;                  // Array of outfall nodes
-EXTERN TDivider*  Divider;                  // Array of divider nodes
-EXTERN TStorage*  Storage;                  // Array of storage nodes
-EXTERN TLink*     Link;                     // Array of links
-EXTERN TConduit*  Conduit;                  // Array of conduit links
-EXTERN TPump*     Pump;                     // Array of pump links
-EXTERN TOrifice*  Orifice;                  // Array of orifice links
-EXTERN TWeir*     Weir;                     // Array of weir links
-EXTERN TOutlet*   Outlet;                   // Array of outlet device links
-EXTERN TPollut*   Pollut;                   // Array of pollutants
-EXTERN TLanduse*  Landuse;                  // Array of landuses
-EXTERN TPattern*  Pattern;                  // Array of time patterns
-EXTERN TTable*    Curve;                    // Array of curve tables
-EXTERN TTable*    Tseries;                  // Array of time series tables
-EXTERN TTransect* Transect;                 // Array of transect data
-EXTERN TStreet*   Street;                   // Array of defined Street cross-sections
-EXTERN TShape*    Shape;                    // Array of custom conduit shapes
-EXTERN TEvent*    Event;                    // Array of routing events
+//-----------------------------------------------------------------------------
+//  Project context
+//
+//  Everything that describes the state of a single SWMM project is held in
+//  a TProject structure. The engine always works on the project that is
+//  bound to the calling thread through ActiveProject (by default a single
+//  process-wide project), so several projects can be run at the same time
+//  on separate threads. The macros at the end of this file keep the original
+//  global variable names usable throughout the code.
+//-----------------------------------------------------------------------------
+typedef struct SWMM_Project TProject;
+
+struct SWMM_Project
+{
+    TFile
+                      Finp,                     // Input file
+                      Fout,                     // Output file
+                      Frpt,                     // Report file
+                      Fclimate,                 // Climate file
+                      Frain,                    // Rainfall file
+                      Frunoff,                  // Runoff file
+                      Frdii,                    // RDII inflow file
+                      Fhotstart1,               // Hot start input file
+                      Fhotstart2,               // Hot start output file
+                      Finflows,                 // Inflows routing file
+                      Foutflows;                // Outflows routing file
+
+    long
+                      Nperiods,                 // Number of reporting periods
+                      TotalStepCount,           // Total routing steps used 
+                      ReportStepCount,          // Reporting routing steps used
+                      NonConvergeCount;         // Number of non-converging steps
+
+    char
+                      Msg[MAXMSG+1],            // Text of output message
+                      ErrorMsg[MAXMSG+1],       // Text of error message
+                      Title[MAXTITLE][MAXMSG+1],// Project title
+                      TempDir[MAXFNAME+1],      // Temporary file directory
+                      InpDir[MAXFNAME+1];       // Input file directory
+
+    TRptFlags
+                      RptFlags;                 // Reporting options
+
+    int
+                      Nobjects[MAX_OBJ_TYPES],  // Number of each object type
+                      Nnodes[MAX_NODE_TYPES],   // Number of each node sub-type
+                      Nlinks[MAX_LINK_TYPES],   // Number of each link sub-type
+                      UnitSystem,               // Unit system
+                      FlowUnits,                // Flow units
+                      InfilModel,               // Infiltration method
+                      RouteModel,               // Flow routing method
+                      ForceMainEqn,             // Flow equation for force mains
+                      LinkOffsets,              // Link offset convention
+                      SurchargeMethod,          // EXTRAN or SLOT method 
+                      DynWaveSolver,            // Picard or Newton DW solver
+                      Renumber,                 // Node & link renumbering method
+                      ActiveSet,                // Recompute only unconverged nodes
+                      StepClasses,              // Number of conduit time step classes
+                      GeomCache,                // Use tabulated xsect geometry
+                      TseriesCache,             // Cache time series files
+                      CompressOutput,           // Compress binary output results
+                      AllowPonding,             // Allow water to pond at nodes
+                      InertDamping,             // Degree of inertial damping
+                      NormalFlowLtd,            // Normal flow limited
+                      SlopeWeighting,           // Use slope weighting
+                      Compatibility,            // SWMM 5/3/4 compatibility
+                      SkipSteadyState,          // Skip over steady state periods
+                      IgnoreRainfall,           // Ignore rainfall/runoff
+                      IgnoreRDII,               // Ignore RDII
+                      IgnoreSnowmelt,           // Ignore snowmelt
+                      IgnoreGwater,             // Ignore groundwater
+                      IgnoreRouting,            // Ignore flow routing
+                      IgnoreQuality,            // Ignore water quality
+                      ErrorCode,                // Error code number
+                      Warnings,                 // Number of warning messages
+                      WetStep,                  // Runoff wet time step (sec)
+                      DryStep,                  // Runoff dry time step (sec)
+                      ReportStep,               // Reporting time step (sec)
+                      RuleStep,                 // Rule evaluation time step (sec)
+                      SweepStart,               // Day of year when sweeping starts
+                      SweepEnd,                 // Day of year when sweeping ends
+                      MaxTrials,                // Max. trials for DW routing
+                      NumThreads,               // Number of parallel threads used
+                      MinParallelLinks,         // Fewest links routed in parallel
+                      ExtPollutFlag,            // OWA EDIT - toolkit API for set external pollutant injection
+                      NumEvents;                // Number of detailed events
+
+    double
+                      RouteStep,                // Routing time step (sec)
+                      MinRouteStep,             // Minimum variable time step (sec)
+                      LengtheningStep,          // Time step for lengthening (sec)
+                      StartDryDays,             // Antecedent dry days
+                      CourantFactor,            // Courant time step factor
+                      MinSurfArea,              // Minimum nodal surface area
+                      MinSlope,                 // Minimum conduit slope
+                      RunoffError,              // Runoff continuity error
+                      GwaterError,              // Groundwater continuity error
+                      FlowError,                // Flow routing error
+                      QualError,                // Quality routing error
+                      HeadTol,                  // DW routing head tolerance (ft)
+                      SysFlowTol,               // Tolerance for steady system flow
+                      LatFlowTol,               // Tolerance for steady nodal inflow
+                      CrownCutoff;              // Fractional pipe crown cutoff
+
+    DateTime
+                      StartDate,                // Starting date
+                      StartTime,                // Starting time
+                      StartDateTime,            // Starting Date+Time
+                      EndDate,                  // Ending date
+                      EndTime,                  // Ending time
+                      EndDateTime,              // Ending Date+Time
+                      ReportStartDate,          // Report start date
+                      ReportStartTime,          // Report start time
+                      ReportStart;              // Report start Date+Time
+
+    double
+                      ReportTime,               // Current reporting time (msec)
+                      OldRunoffTime,            // Previous runoff time (msec)
+                      NewRunoffTime,            // Current runoff time (msec)
+                      OldRoutingTime,           // Previous routing time (msec)
+                      NewRoutingTime,           // Current routing time (msec)
+                      TotalDuration,            // Simulation duration (msec)
+                      ElapsedTime;              // Current elapsed time (days)
+
+    TTemp      Temp;                     // Temperature data
+    TEvap      Evap;                     // Evaporation data
+    TWind      Wind;                     // Wind speed data
+    TSnow      Snow;                     // Snow melt data
+    TAdjust    Adjust;                   // Climate adjustments
+
+    TSnowmelt* Snowmelt;                 // Array of snow melt objects
+    TGage*     Gage;                     // Array of rain gages
+    TSubcatch* Subcatch;                 // Array of subcatchments
+    TAquifer*  Aquifer;                  // Array of groundwater aquifers
+    TUnitHyd*  UnitHyd;                  // Array of unit hydrographs
+    TNode*     Node;                     // Array of nodes
+    TOutfall*  Outfall;                  // Array of outfall nodes
+    TDivider*  Divider;                  // Array of divider nodes
+    TStorage*  Storage;                  // Array of storage nodes
+    TLink*     Link;                     // Array of links
+    TConduit*  Conduit;                  // Array of conduit links
+    TPump*     Pump;                     // Array of pump links
+    TOrifice*  Orifice;                  // Array of orifice links
+    TWeir*     Weir;                     // Array of weir links
+    TOutlet*   Outlet;                   // Array of outlet device links
+    TPollut*   Pollut;                   // Array of pollutants
+    TLanduse*  Landuse;                  // Array of landuses
+    TPattern*  Pattern;                  // Array of time patterns
+    TTable*    Curve;                    // Array of curve tables
+    TTable*    Tseries;                  // Array of time series tables
+    TTransect* Transect;                 // Array of transect data
+    TStreet*   Street;                   // Array of defined Street cross-sections
+    TShape*    Shape;                    // Array of custom conduit shapes
+    TEvent*    Event;                    // Array of routing events
+    TQualMatrix NodeQual;                // Pollutant matrices of nodes
+    TQualMatrix LinkQual;                // Pollutant matrices of links
+
+    //--------------------------------------------------------------------
+    //  Shared variables of individual code modules. Each module refers to
+    //  its own group through macros defined at the top of its source file.
+    //--------------------------------------------------------------------
+    struct                                   // climate.c
+    {
+        double    Tmin;                      // min. daily temperature (deg F)
+        double    Tmax;                      // max. daily temperature (deg F)
+        double    Trng;                      // 1/2 range of daily temperatures
+        double    Trng1;                     // prev. max - current min. temp.
+        double    Tave;                      // average daily temperature (deg F)
+        double    Hrsr;                      // time of min. temp. (hrs)
+        double    Hrss;                      // time of max. temp (hrs)
+        double    Hrday;                     // avg. of min/max temp times
+        double    Dhrdy;                     // hrs. between min. & max. temp. times
+        double    Dydif;                     // hrs. between max. & min. temp. times
+        DateTime  LastDay;                   // date of last day with temp. data
+        TMovAve   Tma;                       // moving average of daily temperatures
+        DateTime  NextEvapDate;              // next date when evap. rate changes
+        double    NextEvapRate;              // next evaporation rate (user units)
+        int       FileFormat;                // file format (see ClimateFileFormats)
+        int       FileYear;                  // current year of file data
+        int       FileMonth;                 // current month of year of file data
+        int       FileDay;                   // current day of month of file data
+        int       FileLastDay;               // last day of current month of file data
+        int       FileElapsedDays;           // number of days read from file
+        double    FileValue[4];              // current day's values of climate data
+        double    FileData[4][32];           // month's worth of daily climate data
+        char      FileLine[MAXLINE+1];       // line from climate data file
+        int       FileFieldPos[4];           // start of data fields for file record
+        int       FileDateFieldPos;          // start of date field for file record
+        int       FileWindType;              // wind speed type
+        int       FileTempUnits;             // GHCND file temperature units
+    }   climate;
+
+    struct                                   // controls.c
+    {
+        struct TRule*       Rules;           // array of control rules
+        struct TActionList* ActionList;      // linked list of control actions
+        int       InputState;                // state of rule interpreter
+        int       RuleCount;                 // total number of rules
+        double    ControlValue;              // value of controller variable
+        double    SetPoint;                  // value of controller setpoint
+        DateTime  CurrentDate;               // current date in whole days
+        DateTime  CurrentTime;               // current time of day (decimal)
+        int       VariableCount;             // number of named variables
+        int       ExpressionCount;           // number of math expressions
+        int       CurrentVariable;           // index of current named variable
+        int       CurrentExpression;         // index of current math expression
+        struct TNamedVariable* NamedVariable; // array of named variables
+        struct TExpression*    Expression;    // array of math expressions
+    }   controls;
+
+    struct                                   // datetime.c
+    {
+        int       DateFormat;                // date format code
+    }   datetime;
+
+    struct                                   // dynwave.c
+    {
+        double    VariableStep;              // size of variable time step (sec)
+        TXnode*   Xnode;                     // extended nodal information
+        TXlink*   Xlink;                     // extended link information
+        double    Omega;                     // actual under-relaxation parameter
+        int       Steps;                     // number of Picard iterations
+        int*      NodeConduitStart;          // start of each node's conduits
+                                             //    in NodeConduits
+        int*      NodeConduits;              // conduits attached to each node
+        double*   Jdiag;                     // Newton Jacobian diagonal (per node)
+        double*   Jlink;                     // Newton Jacobian off-diagonal
+                                             //    term of each link
+        double*   Jrhs;                      // Newton right hand side (per node)
+        double*   Jwork;                     // linear solver work vectors
+        char*     Jfixed;                    // TRUE if node head held fixed
+        double*   Jblock;                    // block sums of solver dot products
+        int*      ActiveNodes;               // nodes recomputed in a trial
+        int       NumActiveNodes;            // number of active nodes
+        int*      ActiveLinks;               // links recomputed in a trial
+        int       NumActiveLinks;            // number of active links
+        int       StepCycle;                 // count of time steps taken
+    }   dynwave;
+
+    struct                                   // iface.c
+    {
+        int       IfaceFlowUnits;            // flow units for routing interface file
+        int       IfaceStep;                 // interface file time step (sec)
+        int       NumIfacePolluts;           // number of pollutants in interface file
+        int*      IfacePolluts;              // indexes of interface file pollutants
+        int       NumIfaceNodes;             // number of nodes on interface file
+        int*      IfaceNodes;                // indexes of nodes on interface file
+        double**  OldIfaceValues;            // interface flows & WQ at previous time
+        double**  NewIfaceValues;            // interface flows & WQ at next time
+        double    IfaceFrac;                 // fraction of interface file time step
+        DateTime  OldIfaceDate;              // previous date of interface values
+        DateTime  NewIfaceDate;              // next date of interface values
+    }   iface;
+
+    struct                                   // infil.c
+    {
+        union TInfil* Infil;                 // infiltration object of each subcatch.
+    }   infil;
+
+    struct                                   // inlet.c
+    {
+        struct TInletDesign* InletDesigns;   // array of available inlet designs
+        int       InletDesignCount;          // number of inlet designs
+        int       UsesInlets;                // TRUE if project uses inlets
+        double*   InletFlow;                 // captured inlet flow received by each node
+        struct TInlet* FirstInlet;           // head of list of deployed inlets
+    }   inlet;
+
+    struct                                   // lid.c
+    {
+        struct TLidProc*  LidProcs;          // array of LID processes
+        int       LidCount;                  // number of LID processes
+        struct LidGroup** LidGroups;         // array of LID process groups
+        int       GroupCount;                // number of LID groups (subcatchments)
+    }   lid;
+
+    struct                                   // massbal.c
+    {
+        TRunoffTotals    RunoffTotals;       // overall surface runoff continuity totals
+        TLoadingTotals*  LoadingTotals;      // overall WQ washoff continuity totals
+        TGwaterTotals    GwaterTotals;       // overall groundwater continuity totals
+        TRoutingTotals   FlowTotals;         // overall routed flow continuity totals
+        TRoutingTotals*  QualTotals;         // overall routed WQ continuity totals
+        TRoutingTotals   StepFlowTotals;     // routed flow totals over time step
+        TRoutingTotals   OldStepFlowTotals;  // routed flow totals over prior step
+        TRoutingTotals*  StepQualTotals;     // routed WQ totals over time step
+        double*   NodeInflow;                // total inflow volume to each node (ft3)
+        double*   NodeOutflow;               // total outflow volume from each node (ft3)
+        double    TotalArea;                 // total drainage area (ft2)
+    }   massbal;
+
+    struct                                   // odesolve.c
+    {
+        int       nmax;                      // max. number of equations
+        double*   y;                         // dependent variable
+        double*   yscal;                     // scaling factors
+        double*   yerr;                      // integration errors
+        double*   ytemp;                     // temporary values of y
+        double*   dydx;                      // derivatives of y
+        double*   ak;                        // derivatives at intermediate points
+    }   odesolve;
+
+    struct                                   // output.c
+    {
+        F_OFF     IDStartPos;                // starting file position of ID names
+        F_OFF     InputStartPos;             // starting file position of input data
+        F_OFF     OutputStartPos;            // starting file position of output data
+        F_OFF     BytesPerPeriod;            // bytes saved per simulation time period
+        int       NumSubcatchVars;           // number of subcatchment output variables
+        int       NumNodeVars;               // number of node output variables
+        int       NumLinkVars;               // number of link output variables
+        int       NumSavedSubcatchVars;      // number of subcatch. variables saved
+        int       NumSavedNodeVars;          // number of node variables saved
+        int       NumSavedLinkVars;          // number of link variables saved
+        int*      SavedSubcatchVars;         // indexes of subcatch. variables saved
+        int*      SavedNodeVars;             // indexes of node variables saved
+        int*      SavedLinkVars;             // indexes of link variables saved
+        int       NumSubcatch;               // number of subcatchments reported on
+        int       NumNodes;                  // number of nodes reported on
+        int       NumLinks;                  // number of links reported on
+        int       NumPolluts;                // number of pollutants reported on
+        float     SysResults[MAX_SYS_RESULTS]; // values of system output vars.
+        struct TAvgResults* AvgLinkResults;  // time averaged link results
+        struct TAvgResults* AvgNodeResults;  // time averaged node results
+        int       Nsteps;                    // number of steps averaged over
+        float*    SubcatchResults;           // subcatchment results vector
+        float*    NodeResults;               // node results vector
+        float*    LinkResults;               // link results vector
+        struct TOutWriter* OutWriter;        // background writer of results
+        long long* ChunkIndex;               // position & first period of
+                                             // each compressed chunk
+        int       NumChunks;                 // number of compressed chunks
+        int       ChunkLoaded;               // chunk held in ChunkData
+        int       ChunkPeriods;              // # periods in ChunkData
+        unsigned int* ChunkData;             // decoded periods of a chunk
+    }   output;
+
+    struct                                   // project.c
+    {
+        struct HTtable*  Htable[MAX_OBJ_TYPES]; // hash tables for object ID names
+        alloc_handle_t*  IDPool;             // memory pool for object ID names
+        alloc_handle_t*  ObjPool[MAX_OBJ_TYPES]; // memory pools for object data
+        int*      InternalIndex[MAX_OBJ_TYPES]; // internal index of each object
+                                             //    by input file position
+        int*      InputIndex[MAX_OBJ_TYPES]; // input file position of each
+                                             //    object (NULL if not renumbered)
+    }   project;
+
+    struct                                   // rdii.c
+    {
+        struct TUHGroup* UHGroup;            // processing data for each UH group
+        int       RdiiStep;                  // RDII time step (sec)
+        int       NumRdiiNodes;              // number of nodes w/ RDII data
+        int*      RdiiNodeIndex;             // indexes of nodes w/ RDII data
+        float*    RdiiNodeFlow;              // inflows for nodes with RDII
+        int       RdiiFlowUnits;             // RDII flow units code
+        DateTime  RdiiStartDate;             // start date of RDII inflow period
+        DateTime  RdiiEndDate;               // end date of RDII inflow period
+        double    TotalRainVol;              // total rainfall volume (ft3)
+        double    TotalRdiiVol;              // total RDII volume (ft3)
+        int       RdiiFileType;              // type (binary/text) of RDII file
+    }   rdii;
+
+    struct                                   // report.c
+    {
+        time_t    SysTime;                   // time when the run started
+    }   report;
+
+    struct                                   // routing.c
+    {
+        int*      SortedLinks;               // topologically sorted links
+        int       NextEvent;                 // index of next routing event
+        int       BetweenEvents;             // TRUE if between routing events
+        double    NewRuleTime;               // time of next rule evaluation (msec)
+    }   routing;
+
+    struct                                   // runoff.c
+    {
+        char      IsRaining;                 // TRUE if precip. falls on study area
+        char      HasRunoff;                 // TRUE if study area generates runoff
+        char      HasSnow;                   // TRUE if any snow cover on study area
+        char      HasWetLids;                // TRUE if any LIDs are wet
+        int       Nsteps;                    // number of runoff time steps taken
+        int       MaxSteps;                  // final number of runoff time steps
+        long      MaxStepsPos;               // position in Runoff interface file
+                                             //    where MaxSteps is saved
+        double*   OutflowLoad;               // exported pollutant mass load
+    }   runoff;
+
+    struct                                   // stats.c
+    {
+        TTimeStepStats  TimeStepStats;       // routing time step statistics
+        TMaxStats       MaxMassBalErrs[MAX_STATS];  // highest node mass bal. errors
+        TMaxStats       MaxCourantCrit[MAX_STATS];  // most time step critical elements
+        TMaxStats       MaxFlowTurns[MAX_STATS];    // links with most flow turns
+        TMaxStats       MaxNonConverged[MAX_STATS]; // most non-converging nodes
+        double          SysOutfallFlow;      // current total outfall flow (cfs)
+        TSubcatchStats* SubcatchStats;       // subcatchment statistics
+        TNodeStats*     NodeStats;           // node statistics
+        TLinkStats*     LinkStats;           // link statistics
+        TStorageStats*  StorageStats;        // storage unit statistics
+        TOutfallStats*  OutfallStats;        // outfall statistics
+        TPumpStats*     PumpStats;           // pump statistics
+        double          MaxOutfallFlow;      // max. total outfall flow (cfs)
+        double          MaxRunoffFlow;       // max. total runoff flow (cfs)
+        double          RoutingTimeSpan;     // time span of routing stats. (sec)
+    }   stats;
+
+    struct                                   // swmm5.c
+    {
+        int       IsOpenFlag;                // TRUE if a project has been opened
+        int       IsStartedFlag;             // TRUE if a simulation has been started
+        int       SaveResultsFlag;           // TRUE if output to be saved to binary file
+        int       ExceptionCount;            // number of exceptions handled
+        int       DoRunoff;                  // TRUE if runoff is computed
+        int       DoRouting;                 // TRUE if flow routing is computed
+        double    RoutingDuration;           // duration of a set of routing steps (msecs)
+    }   swmm5;
+
+    struct                                   // treatmnt.c
+    {
+        double*   R;                         // array of pollut. removals
+        double*   Cin;                       // node inflow concentrations
+    }   treatmnt;
+
+    struct                                   // transect.c
+    {
+        int       Ntransects;                // total number of transects
+    }   transect;
+
+    struct                                   // xsect.c
+    {
+        TGeomTable* GeomTables;              // cached geometry tables
+        int       NumGeomTables;             // number of tables in use
+        int       MaxGeomTables;             // number of tables allocated
+        int*      GeomIndex;                 // hash index of tables
+        int       GeomIndexSize;             // size of hash index
+    }   xsect;
+};
+
+//-----------------------------------------------------------------------------
+//  Project bound to the calling thread (defined in swmm5.c)
+//-----------------------------------------------------------------------------
+extern SWMM_TLS_FAST TProject* ActiveProject;
+
+//-----------------------------------------------------------------------------
+//  Names of project variables
+//-----------------------------------------------------------------------------
+#define Finp              (ActiveProject->Finp)
+#define Fout              (ActiveProject->Fout)
+#define Frpt              (ActiveProject->Frpt)
+#define Fclimate          (ActiveProject->Fclimate)
+#define Frain             (ActiveProject->Frain)
+#define Frunoff           (ActiveProject->Frunoff)
+#define Frdii             (ActiveProject->Frdii)
+#define Fhotstart1        (ActiveProject->Fhotstart1)
+#define Fhotstart2        (ActiveProject->Fhotstart2)
+#define Finflows          (ActiveProject->Finflows)
+#define Foutflows         (ActiveProject->Foutflows)
+#define Nperiods          (ActiveProject->Nperiods)
+#define TotalStepCount    (ActiveProject->TotalStepCount)
+#define ReportStepCount   (ActiveProject->ReportStepCount)
+#define NonConvergeCount  (ActiveProject->NonConvergeCount)
+#define Msg               (ActiveProject->Msg)
+#define ErrorMsg          (ActiveProject->ErrorMsg)
+#define Title             (ActiveProject->Title)
+#define TempDir           (ActiveProject->TempDir)
+#define InpDir            (ActiveProject->InpDir)
+#define RptFlags          (ActiveProject->RptFlags)
+#define Nobjects          (ActiveProject->Nobjects)
+#define Nnodes            (ActiveProject->Nnodes)
+#define Nlinks            (ActiveProject->Nlinks)
+#define UnitSystem        (ActiveProject->UnitSystem)
+#define FlowUnits         (ActiveProject->FlowUnits)
+#define InfilModel        (ActiveProject->InfilModel)
+#define RouteModel        (ActiveProject->RouteModel)
+#define ForceMainEqn      (ActiveProject->ForceMainEqn)
+#define LinkOffsets       (ActiveProject->LinkOffsets)
+#define SurchargeMethod   (ActiveProject->SurchargeMethod)
+#define DynWaveSolver     (ActiveProject->DynWaveSolver)
+#define Renumber          (ActiveProject->Renumber)
+#define ActiveSet         (ActiveProject->ActiveSet)
+#define StepClasses       (ActiveProject->StepClasses)
+#define MinParallelLinks  (ActiveProject->MinParallelLinks)
+#define GeomCache         (ActiveProject->GeomCache)
+#define TseriesCache      (ActiveProject->TseriesCache)
+#define CompressOutput    (ActiveProject->CompressOutput)
+#define AllowPonding      (ActiveProject->AllowPonding)
+#define InertDamping      (ActiveProject->InertDamping)
+#define NormalFlowLtd     (ActiveProject->NormalFlowLtd)
+#define SlopeWeighting    (ActiveProject->SlopeWeighting)
+#define Compatibility     (ActiveProject->Compatibility)
+#define SkipSteadyState   (ActiveProject->SkipSteadyState)
+#define IgnoreRainfall    (ActiveProject->IgnoreRainfall)
+#define IgnoreRDII        (ActiveProject->IgnoreRDII)
+#define IgnoreSnowmelt    (ActiveProject->IgnoreSnowmelt)
+#define IgnoreGwater      (ActiveProject->IgnoreGwater)
+#define IgnoreRouting     (ActiveProject->IgnoreRouting)
+#define IgnoreQuality     (ActiveProject->IgnoreQuality)
+#define ErrorCode         (ActiveProject->ErrorCode)
+#define Warnings          (ActiveProject->Warnings)
+#define WetStep           (ActiveProject->WetStep)
+#define DryStep           (ActiveProject->DryStep)
+#define ReportStep        (ActiveProject->ReportStep)
+#define RuleStep          (ActiveProject->RuleStep)
+#define SweepStart        (ActiveProject->SweepStart)
+#define SweepEnd          (ActiveProject->SweepEnd)
+#define MaxTrials         (ActiveProject->MaxTrials)
+#define NumThreads        (ActiveProject->NumThreads)
+#define ExtPollutFlag     (ActiveProject->ExtPollutFlag)
+#define NumEvents         (ActiveProject->NumEvents)
+#define RouteStep         (ActiveProject->RouteStep)
+#define MinRouteStep      (ActiveProject->MinRouteStep)
+#define LengtheningStep   (ActiveProject->LengtheningStep)
+#define StartDryDays      (ActiveProject->StartDryDays)
+#define CourantFactor     (ActiveProject->CourantFactor)
+#define MinSurfArea       (ActiveProject->MinSurfArea)
+#define MinSlope          (ActiveProject->MinSlope)
+#define RunoffError       (ActiveProject->RunoffError)
+#define GwaterError       (ActiveProject->GwaterError)
+#define FlowError         (ActiveProject->FlowError)
+#define QualError         (ActiveProject->QualError)
+#define HeadTol           (ActiveProject->HeadTol)
+#define SysFlowTol        (ActiveProject->SysFlowTol)
+#define LatFlowTol        (ActiveProject->LatFlowTol)
+#define CrownCutoff       (ActiveProject->CrownCutoff)
+#define StartDate         (ActiveProject->StartDate)
+#define StartTime         (ActiveProject->StartTime)
+#define StartDateTime     (ActiveProject->StartDateTime)
+#define EndDate           (ActiveProject->EndDate)
+#define EndTime           (ActiveProject->EndTime)
+#define EndDateTime       (ActiveProject->EndDateTime)
+#define ReportStartDate   (ActiveProject->ReportStartDate)
+#define ReportStartTime   (ActiveProject->ReportStartTime)
+#define ReportStart       (ActiveProject->ReportStart)
+#define ReportTime        (ActiveProject->ReportTime)
+#define OldRunoffTime     (ActiveProject->OldRunoffTime)
+#define NewRunoffTime     (ActiveProject->NewRunoffTime)
+#define OldRoutingTime    (ActiveProject->OldRoutingTime)
+#define NewRoutingTime    (ActiveProject->NewRoutingTime)
+#define TotalDuration     (ActiveProject->TotalDuration)
+#define ElapsedTime       (ActiveProject->ElapsedTime)
+#define Temp              (ActiveProject->Temp)
+#define Evap              (ActiveProject->Evap)
+#define Wind              (ActiveProject->Wind)
+#define Snow              (ActiveProject->Snow)
+#define Adjust            (ActiveProject->Adjust)
+#define Snowmelt          (ActiveProject->Snowmelt)
+#define Gage              (ActiveProject->Gage)
+#define Subcatch          (ActiveProject->Subcatch)
+#define Aquifer           (ActiveProject->Aquifer)
+#define UnitHyd           (ActiveProject->UnitHyd)
+#define Node              (ActiveProject->Node)
+#define Outfall           (ActiveProject->Outfall)
+#define Divider           (ActiveProject->Divider)
+#define Storage           (ActiveProject->Storage)
+#define Link              (ActiveProject->Link)
+#define Conduit           (ActiveProject->Conduit)
+#define Pump              (ActiveProject->Pump)
+#define Orifice           (ActiveProject->Orifice)
+#define Weir              (ActiveProject->Weir)
+#define Outlet            (ActiveProject->Outlet)
+#define Pollut            (ActiveProject->Pollut)
+#define Landuse           (ActiveProject->Landuse)
+#define Pattern           (ActiveProject->Pattern)
+#define Curve             (ActiveProject->Curve)
+#define Tseries           (ActiveProject->Tseries)
+#define Transect          (ActiveProject->Transect)
+#define Street            (ActiveProject->Street)
+#define Shape             (ActiveProject->Shape)
+#define Event             (ActiveProject->Event)
+#define NodeQual          (ActiveProject->NodeQual)
+#define LinkQual          (ActiveProject->LinkQual)
+
+// --- module variables shared with other modules
+#define StepFlowTotals   (ActiveProject->massbal.StepFlowTotals)
+#define StepQualTotals   (ActiveProject->massbal.StepQualTotals)
+#define NodeInflow       (ActiveProject->massbal.NodeInflow)
+#define NodeOutflow      (ActiveProject->massbal.NodeOutflow)
+#define SubcatchResults  (ActiveProject->output.SubcatchResults)
+#define NodeResults      (ActiveProject->output.NodeResults)
+#define LinkResults      (ActiveProject->output.LinkResults)
+#define HasWetLids       (ActiveProject->runoff.HasWetLids)
+#define OutflowLoad      (ActiveProject->runoff.OutflowLoad)
+#define SubcatchStats    (ActiveProject->stats.SubcatchStats)
+#define NodeStats        (ActiveProject->stats.NodeStats)
+#define LinkStats        (ActiveProject->stats.LinkStats)
+#define StorageStats     (ActiveProject->stats.StorageStats)
+#define OutfallStats     (ActiveProject->stats.OutfallStats)
+#define PumpStats        (ActiveProject->stats.PumpStats)
+#define MaxOutfallFlow   (ActiveProject->stats.MaxOutfallFlow)
+#define MaxRunoffFlow    (ActiveProject->stats.MaxRunoffFlow)
+#define RoutingTimeSpan  (ActiveProject->stats.RoutingTimeSpan)
 
 
 #endif //GLOBALS_H
@@ -20,6 +20,8 @@
 //   - Support for collecting GW statistics added.
 //   Build 5.1.010:
 //   - Unsaturated hydraulic conductivity added to GW flow equation variables.
+//   Build 5.2.4 (OWA):
+//   - Groundwater objects allocated from the subcatchments' memory pool.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -60,30 +62,30 @@ static char* GWVarWords[] = {"HGW", "HSW", "HCB", "HGS", "KS", "K",
 //  Shared variables
 //-----------------------------------------------------------------------------
 //  NOTE: all flux rates are in ft/sec, all depths are in ft.
-static double    Area;            // subcatchment area (ft2)
-static double    Infil;           // infiltration rate from surface
-static double    MaxEvap;         // max. evaporation rate
-static double    AvailEvap;       // available evaporation rate
-static double    UpperEvap;       // evaporation rate from upper GW zone
-static double    LowerEvap;       // evaporation rate from lower GW zone
-static double    UpperPerc;       // percolation rate from upper to lower zone
-static double    LowerLoss;       // loss rate from lower GW zone
-static double    GWFlow;          // flow rate from lower zone to conveyance node
-static double    MaxUpperPerc;    // upper limit on UpperPerc
-static double    MaxGWFlowPos;    // upper limit on GWFlow when its positve
-static double    MaxGWFlowNeg;    // upper limit on GWFlow when its negative
-static double    FracPerv;        // fraction of surface that is pervious
-static double    TotalDepth;      // total depth of GW aquifer
-static double    Theta;           // moisture content of upper zone
-static double    HydCon;          // unsaturated hydraulic conductivity (ft/s)
-static double    Hgw;             // ht. of saturated zone
-static double    Hstar;           // ht. from aquifer bottom to node invert
-static double    Hsw;             // ht. from aquifer bottom to water surface
-static double    Tstep;           // current time step (sec)
-static TAquifer  A;               // aquifer being analyzed
-static TGroundwater* GW;          // groundwater object being analyzed
-static MathExpr* LatFlowExpr;     // user-supplied lateral GW flow expression
-static MathExpr* DeepFlowExpr;    // user-supplied deep GW flow expression
+static SWMM_TLS double    Area;            // subcatchment area (ft2)
+static SWMM_TLS double    Infil;           // infiltration rate from surface
+static SWMM_TLS double    MaxEvap;         // max. evaporation rate
+static SWMM_TLS double    AvailEvap;       // available evaporation rate
+static SWMM_TLS double    UpperEvap;       // evaporation rate from upper GW zone
+static SWMM_TLS double    LowerEvap;       // evaporation rate from lower GW zone
+static SWMM_TLS double    UpperPerc;       // percolation rate from upper to lower zone
+static SWMM_TLS double    LowerLoss;       // loss rate from lower GW zone
+static SWMM_TLS double    GWFlow;          // flow rate from lower zone to conveyance node
+static SWMM_TLS double    MaxUpperPerc;    // upper limit on UpperPerc
+static SWMM_TLS double    MaxGWFlowPos;    // upper limit on GWFlow when its positve
+static SWMM_TLS double    MaxGWFlowNeg;    // upper limit on GWFlow when its negative
+static SWMM_TLS double    FracPerv;        // fraction of surface that is pervious
+static SWMM_TLS double    TotalDepth;      // total depth of GW aquifer
+static SWMM_TLS double    Theta;           // moisture content of upper zone
+static SWMM_TLS double    HydCon;          // unsaturated hydraulic conductivity (ft/s)
+static SWMM_TLS double    Hgw;             // ht. of saturated zone
+static SWMM_TLS double    Hstar;           // ht. from aquifer bottom to node invert
+static SWMM_TLS double    Hsw;             // ht. from aquifer bottom to water surface
+static SWMM_TLS double    Tstep;           // current time step (sec)
+static SWMM_TLS TAquifer  A;               // aquifer being analyzed
+static SWMM_TLS TGroundwater* GW;          // groundwater object being analyzed
+static SWMM_TLS MathExpr* LatFlowExpr;     // user-supplied lateral GW flow expression
+static SWMM_TLS MathExpr* DeepFlowExpr;    // user-supplied deep GW flow expression
 
 //-----------------------------------------------------------------------------
 //  External Functions (declared in funcs.h)
@@ -230,7 +232,7 @@ int gwater_readGroundwaterParams(char* tok[], int ntoks)
     // --- create a groundwater flow object
     if ( !Subcatch[j].groundwater )
     {
-        gw = (TGroundwater *) malloc(sizeof(TGroundwater));
+        gw = (TGroundwater *) project_alloc(SUBCATCH, 1, sizeof(TGroundwater));
         if ( !gw ) return error_setInpError(ERR_MEMORY, "");
         Subcatch[j].groundwater = gw;
     }
@@ -5,18 +5,26 @@
 //   CASE INSENSITIVE
 //
 //   Written by L. Rossman
-//   Last Updated on 6/19/03
+//   Last Updated on 10/16/26
 //
-//   The hash table data structure (HTable) is defined in "hash.h".
+//   The hash table data structure (HTtable) is defined in "hash.h".
 //   Interface Functions:
-//      HTcreate() - creates a hash table
-//      HTinsert() - inserts a string & its index value into a hash table
-//      HTfind()   - retrieves the index value of a string from a table
-//      HTfree()   - frees a hash table
+//      HTcreate()  - creates a hash table
+//      HTreserve() - makes room in a table for a number of strings
+//      HTinsert()  - inserts a string & its index value into a hash table
+//      HTfind()    - retrieves the index value of a string from a table
+//      HTremap()   - replaces the index values stored in a table
+//      HTkeys()    - retrieves the strings of a table by their index values
+//      HTfree()    - frees a hash table
+//
+//   Tables use open addressing with linear probing. The number of slots is
+//   a power of 2 that doubles whenever a table becomes half full, so that
+//   searches take the same time no matter how many strings are stored.
 //-----------------------------------------------------------------------------
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include "hash.h"
 #define UCHAR(x) (((x) >= 'a' && (x) <= 'z') ? ((x)&~32) : (x))
 
@@ -29,89 +37,147 @@ int  samestr(const char *s1, const char *s2)
    return(0);
 }                                       /*  End of samestr  */
 
-/* Use Fletcher's checksum to compute 2-byte hash of string */
+/* Use 64-bit FNV-1a on upper case characters, with a final bit mixing */
+/* step (from MurmurHash3), to compute a 4-byte hash of string         */
 unsigned int hash(const char *str)
 {
-    unsigned int sum1= 0, check1;
-    unsigned long sum2= 0L;
-	while(  '\0' != *str  )
-    {
-        sum1 += UCHAR(*str);
-        str++;
-        if (  255 <= sum1  ) sum1 -= 255;
-        sum2 += sum1;
-    }
-    check1= sum2;
-    check1 %= 255;
-    check1= 255 - (sum1+check1) % 255;
-    sum1= 255 - (sum1+check1) % 255;
-    return( ( ( check1 << 8 )  |  sum1  ) % HTMAXSIZE);
+        unsigned long long h = 14695981039346656037ULL;
+        while ( '\0' != *str )
+        {
+            h ^= (unsigned char)UCHAR(*str);
+            h *= 1099511628211ULL;
+            str++;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return (unsigned int)h;
 }
 
-HTtable *HTcreate()
+/* Find the slot holding key, or the empty slot where it belongs */
+static struct HTentry *findEntry(HTtable *ht, const char *key,
+                                 unsigned int code)
 {
+        unsigned int mask = (unsigned int)ht->size - 1;
+        unsigned int i = code & mask;
+        struct HTentry *entry;
+        for (;;)
+        {
+            entry = &ht->entries[i];
+            if ( entry->key == NULL ) return(entry);
+            if ( entry->code == code && samestr(entry->key, key) )
+                return(entry);
+            i = (i + 1) & mask;
+        }
+}
+
+/* Move the entries of a table into a new array of slots */
+static int resize(HTtable *ht, int size)
+{
+        struct HTentry *old = ht->entries;
+        struct HTentry *entry;
+        unsigned int mask = (unsigned int)size - 1;
+        unsigned int j;
         int i;
-        HTtable *ht = (HTtable *) calloc(HTMAXSIZE, sizeof(HTtable));
-        if (ht != NULL) for (i=0; i<HTMAXSIZE; i++) ht[i] = NULL;
+        ht->entries = (struct HTentry *) calloc(size, sizeof(struct HTentry));
+        if (ht->entries == NULL)
+        {
+            ht->entries = old;
+            return(0);
+        }
+        for (i=0; i<ht->size; i++)
+        {
+            entry = &old[i];
+            if ( entry->key == NULL ) continue;
+            j = entry->code & mask;
+            while ( ht->entries[j].key != NULL ) j = (j + 1) & mask;
+            ht->entries[j] = *entry;
+        }
+        ht->size = size;
+        free(old);
+        return(1);
+}
+
+HTtable *HTcreate()
+{
+        HTtable *ht = (HTtable *) malloc(sizeof(HTtable));
+        if (ht == NULL) return(NULL);
+        ht->entries = (struct HTentry *) calloc(HTMINSIZE,
+                                                sizeof(struct HTentry));
+        if (ht->entries == NULL)
+        {
+            free(ht);
+            return(NULL);
+        }
+        ht->size = HTMINSIZE;
+        ht->count = 0;
         return(ht);
 }
 
+int     HTreserve(HTtable *ht, int n)
+{
+        int size = ht->size;
+        if ( n > INT_MAX / 4 ) return(0);
+        while ( size < 2 * n ) size *= 2;
+        if ( size == ht->size ) return(1);
+        return(resize(ht, size));
+}
+
 int     HTinsert(HTtable *ht, char *key, int data)
 {
-        unsigned int i = hash(key);
+        unsigned int code = hash(key);
         struct HTentry *entry;
-        if ( i >= HTMAXSIZE ) return(0);
-        entry = (struct HTentry *) malloc(sizeof(struct HTentry));
-        if (entry == NULL) return(0);
+        if ( 2 * (ht->count + 1) > ht->size )
+        {
+            if ( ht->size > INT_MAX / 2 ) return(0);
+            if ( !resize(ht, 2 * ht->size) ) return(0);
+        }
+        entry = findEntry(ht, key, code);
+        if ( entry->key == NULL ) ht->count++;
         entry->key = key;
         entry->data = data;
-        entry->next = ht[i];
-        ht[i] = entry;
+        entry->code = code;
         return(1);
 }
 
 int     HTfind(HTtable *ht, const char *key)
 {
-        unsigned int i = hash(key);
-        struct HTentry *entry;
-        if ( i >= HTMAXSIZE ) return(NOTFOUND);
-        entry = ht[i];
-        while (entry != NULL)
-        {
-            if ( samestr(entry->key,key) ) return(entry->data);
-            entry = entry->next;
-        }
-        return(NOTFOUND);
+        struct HTentry *entry = findEntry(ht, key, hash(key));
+        if ( entry->key == NULL ) return(NOTFOUND);
+        return(entry->data);
 }
 
 char    *HTfindKey(HTtable *ht, const char *key)
 {
-        unsigned int i = hash(key);
-        struct HTentry *entry;
-        if ( i >= HTMAXSIZE ) return(NULL);
-        entry = ht[i];
-        while (entry != NULL)
+        return(findEntry(ht, key, hash(key))->key);
+}
+
+void    HTremap(HTtable *ht, const int *newData)
+{
+        int i;
+        for (i=0; i<ht->size; i++)
         {
-            if ( samestr(entry->key,key) ) return(entry->key);
-            entry = entry->next;
+            if ( ht->entries[i].key != NULL )
+                ht->entries[i].data = newData[ht->entries[i].data];
         }
-        return(NULL);
 }
 
-void    HTfree(HTtable *ht)
+void    HTkeys(HTtable *ht, char **keys, int n)
 {
-        struct HTentry *entry,
-                       *nextentry;
+        struct HTentry *entry;
         int i;
-        for (i=0; i<HTMAXSIZE; i++)
+        for (i=0; i<ht->size; i++)
         {
-            entry = ht[i];
-            while (entry != NULL)
-            {
-                nextentry = entry->next;
-                free(entry);
-                entry = nextentry;
-            }
+            entry = &ht->entries[i];
+            if ( entry->key != NULL && entry->data >= 0 && entry->data < n )
+                keys[entry->data] = entry->key;
         }
+}
+
+void    HTfree(HTtable *ht)
+{
+        free(ht->entries);
         free(ht);
 }
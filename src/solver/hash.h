@@ -8,22 +8,32 @@
 #define HASH_H
 
 
-#define HTMAXSIZE 1999
+#define HTMINSIZE 64
 #define NOTFOUND  -1
 
 struct HTentry
 {
-    char   *key;
-    int    data;
-    struct HTentry *next;
+    char         *key;       // string (NULL if slot is empty)
+    int          data;       // index value of string
+    unsigned int code;       // hash code of string
 };
 
-typedef struct HTentry *HTtable;
+struct HTtable
+{
+    struct HTentry *entries; // array of slots
+    int    size;             // number of slots (a power of 2)
+    int    count;            // number of strings stored
+};
+
+typedef struct HTtable HTtable;
 
 HTtable* HTcreate(void);
+int      HTreserve(HTtable *, int);
 int      HTinsert(HTtable *, char *, int);
 int      HTfind(HTtable *, const char *);
 char*    HTfindKey(HTtable *, const char *);
+void     HTremap(HTtable *, const int *);
+void     HTkeys(HTtable *, char **, int);
 void     HTfree(HTtable *);
 
 
@@ -12,7 +12,6 @@
 //-----------------------------------------------------------------------------
 #include "macros.h"
 #include "objects.h"
-#define  EXTERN extern
 #include "globals.h"
 #include "funcs.h"
 #include "error.h"
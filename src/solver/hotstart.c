@@ -35,6 +35,8 @@
 //   - Link control setting bug when reading a hot start file fixed.    
 //   Build 5.1.015:
 //   - Support added for multiple infiltration methods within a project.
+//   Build 5.2.4 (OWA):
+//   - Nodes & links saved in input file order when renumbered.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -47,7 +49,7 @@
 //-----------------------------------------------------------------------------
 //  Local Variables
 //-----------------------------------------------------------------------------
-static int fileVersion;
+static SWMM_TLS int fileVersion;
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
@@ -226,11 +228,12 @@ void  saveRouting()
 //  Purpose: saves current state of all nodes and links to hotstart file.
 //
 {
-    int   i, j;
+    int   i, j, k;
     float x[3];
 
-    for (i = 0; i < Nobjects[NODE]; i++)
+    for (k = 0; k < Nobjects[NODE]; k++)
     {
+        i = project_getInternalIndex(NODE, k);
         x[0] = (float)Node[i].newDepth;
         x[1] = (float)Node[i].newLatFlow;
         fwrite(x, sizeof(float), 2, Fhotstart2.file);
@@ -248,8 +251,9 @@ void  saveRouting()
             fwrite(&x[0], sizeof(float), 1, Fhotstart2.file);
         }
     }
-    for (i = 0; i < Nobjects[LINK]; i++)
+    for (k = 0; k < Nobjects[LINK]; k++)
     {
+        i = project_getInternalIndex(LINK, k);
         x[0] = (float)Link[i].newFlow;
         x[1] = (float)Link[i].newDepth;
         x[2] = (float)Link[i].setting;
@@ -272,7 +276,7 @@ void readRouting()
 //           from hotstart file.
 //
 {
-    int   i, j;
+    int   i, j, k;
     float x;
     double xgw[4];
     FILE* f = Fhotstart1.file;
@@ -297,8 +301,9 @@ void readRouting()
     }
 
     // --- read node states
-    for (i = 0; i < Nobjects[NODE]; i++)
+    for (k = 0; k < Nobjects[NODE]; k++)
     {
+        i = project_getInternalIndex(NODE, k);
         if ( !readFloat(&x, f) ) return;
         Node[i].newDepth = x;
         if ( !readFloat(&x, f) ) return;
@@ -328,8 +333,9 @@ void readRouting()
     }
 
     // --- read link states
-    for (i = 0; i < Nobjects[LINK]; i++)
+    for (k = 0; k < Nobjects[LINK]; k++)
     {
+        i = project_getInternalIndex(LINK, k);
         if ( !readFloat(&x, f) ) return;
         Link[i].newFlow = x;
         if ( !readFloat(&x, f) ) return;
@@ -10,6 +10,8 @@
 //
 //   Build 5.2.0:
 //   - Support added for relative file names.
+//   Build 5.2.4 (OWA):
+//   - Outlet nodes written in input file order when renumbered.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -23,20 +25,20 @@
 extern double Qcf[];                   // flow units conversion factors
                                        // (see swmm5.c)
 
-//-----------------------------------------------------------------------------                  
-//  Shared variables
-//-----------------------------------------------------------------------------                  
-static int      IfaceFlowUnits;        // flow units for routing interface file
-static int      IfaceStep;             // interface file time step (sec)
-static int      NumIfacePolluts;       // number of pollutants in interface file
-static int*     IfacePolluts;          // indexes of interface file pollutants
-static int      NumIfaceNodes;         // number of nodes on interface file
-static int*     IfaceNodes;            // indexes of nodes on interface file
-static double** OldIfaceValues;        // interface flows & WQ at previous time
-static double** NewIfaceValues;        // interface flows & WQ at next time
-static double   IfaceFrac;             // fraction of interface file time step
-static DateTime OldIfaceDate;          // previous date of interface values
-static DateTime NewIfaceDate;          // next date of interface values
+//-----------------------------------------------------------------------------
+//  Shared variables (held in the project context, see globals.h)
+//-----------------------------------------------------------------------------
+#define IfaceFlowUnits   (ActiveProject->iface.IfaceFlowUnits)
+#define IfaceStep        (ActiveProject->iface.IfaceStep)
+#define NumIfacePolluts  (ActiveProject->iface.NumIfacePolluts)
+#define IfacePolluts     (ActiveProject->iface.IfacePolluts)
+#define NumIfaceNodes    (ActiveProject->iface.NumIfaceNodes)
+#define IfaceNodes       (ActiveProject->iface.IfaceNodes)
+#define OldIfaceValues   (ActiveProject->iface.OldIfaceValues)
+#define NewIfaceValues   (ActiveProject->iface.NewIfaceValues)
+#define IfaceFrac        (ActiveProject->iface.IfaceFrac)
+#define OldIfaceDate     (ActiveProject->iface.OldIfaceDate)
+#define NewIfaceDate     (ActiveProject->iface.NewIfaceDate)
 
 //-----------------------------------------------------------------------------
 //  External Functions (declared in funcs.h)
@@ -286,15 +288,16 @@ void iface_saveOutletResults(DateTime reportDate, FILE* file)
 //  Purpose: saves system outflows to routing interface file.
 //
 {
-    int i, p, yr, mon, day, hr, min, sec;
+    int i, j, p, yr, mon, day, hr, min, sec;
     char theDate[26];
     datetime_decodeDate(reportDate, &yr, &mon, &day);
     datetime_decodeTime(reportDate, &hr, &min, &sec);
     snprintf(theDate, 26, " %04d %02d  %02d  %02d  %02d  %02d ",
             yr, mon, day, hr, min, sec);
-    for (i=0; i<Nobjects[NODE]; i++)
+    for (j=0; j<Nobjects[NODE]; j++)
     {
         // --- check that node is an outlet node
+        i = project_getInternalIndex(NODE, j);
         if ( !isOutletNode(i) ) continue;
 
         // --- write node ID, date, flow, and quality to file
@@ -351,8 +354,9 @@ void openFileForOutput()
 
     // --- write number and names of outlet nodes to file
     fprintf(Foutflows.file, "\n%-4d - number of nodes as listed below:", n);
-    for (i=0; i<Nobjects[NODE]; i++)
+    for (n=0; n<Nobjects[NODE]; n++)
     {
+          i = project_getInternalIndex(NODE, n);
           if ( isOutletNode(i) )
             fprintf(Foutflows.file, "\n%s", Node[i].ID);
     }
@@ -568,35 +572,35 @@ void readNewIfaceValues()
         fgets(line, MAXLINE, Finflows.file);
 
         // --- parse date & time from line
-        if ( strtok(line, SEPSTR) == NULL ) return;
-        s = strtok(NULL, SEPSTR);
+        if ( sstrtok(line, SEPSTR) == NULL ) return;
+        s = sstrtok(NULL, SEPSTR);
         if ( s == NULL ) return;
         yr  = atoi(s);
-        s = strtok(NULL, SEPSTR);
+        s = sstrtok(NULL, SEPSTR);
         if ( s == NULL ) return;
         mon = atoi(s);
-        s = strtok(NULL, SEPSTR);
+        s = sstrtok(NULL, SEPSTR);
         if ( s == NULL ) return;
         day = atoi(s);
-        s = strtok(NULL, SEPSTR);
+        s = sstrtok(NULL, SEPSTR);
         if ( s == NULL ) return;
         hr  = atoi(s);
-        s = strtok(NULL, SEPSTR);
+        s = sstrtok(NULL, SEPSTR);
         if ( s == NULL ) return;
         min = atoi(s);
-        s = strtok(NULL, SEPSTR);
+        s = sstrtok(NULL, SEPSTR);
         if ( s == NULL ) return;
         sec = atoi(s);
 
         // --- parse flow value
-        s = strtok(NULL, SEPSTR);
+        s = sstrtok(NULL, SEPSTR);
         if ( s == NULL ) return;
         NewIfaceValues[i][0] = atof(s) / Qcf[IfaceFlowUnits]; 
 
         // --- parse pollutant values
         for (j=1; j<=NumIfacePolluts; j++)
         {
-            s = strtok(NULL, SEPSTR);
+            s = sstrtok(NULL, SEPSTR);
             if ( s == NULL ) return;
             NewIfaceValues[i][j] = atof(s);
         }
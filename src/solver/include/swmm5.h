@@ -39,13 +39,6 @@
 //#endif
 
 
-//-----------------------------------------------------------------------------
-//  Shared variables
-//-----------------------------------------------------------------------------
-static int IsOpenFlag;           // TRUE if a project has been opened
-static int IsStartedFlag;        // TRUE if a simulation has been started
-static int SaveResultsFlag;      // TRUE if output to be saved to binary file
-
 int swmm_IsOpenFlag(void);
 int swmm_IsStartedFlag(void);
 
@@ -133,7 +126,10 @@ typedef enum {
     swmm_REPORTSTEP   = 5,
     swmm_TOTALSTEPS   = 6,
     swmm_NOREPORT     = 7,
-    swmm_FLOWUNITS    = 8
+    swmm_FLOWUNITS    = 8,
+    swmm_TRIALS       = 9,
+    swmm_LINKTRIALS   = 10,
+    swmm_GEOMTABLES   = 11
 } swmm_SystemProperty;
 
 typedef enum {
@@ -163,6 +159,24 @@ int DLLEXPORT swmm_run(const char *f1, const char *f2, const char *f3);
 */
 int DLLEXPORT swmm_open(const char *f1, const char *f2, const char *f3);
 
+/**
+ @brief Saves an opened project to a compiled project file that
+ swmm_openCompiled can read faster than the project's input file
+ @param fname pointer to name of compiled project file (to be created)
+ @return error code
+*/
+int DLLEXPORT swmm_saveCompiled(const char *fname);
+
+/**
+ @brief Opens a SWMM project from a compiled project file
+ @param f1 pointer to name of compiled project file (must exist)
+ @param f2 pointer to name of report file (to be created)
+ @param f3 pointer to name of binary output file (to be created)
+ @return error code
+*/
+int DLLEXPORT swmm_openCompiled(const char *f1, const char *f2,
+              const char *f3);
+
 /**
  @brief Start SWMM simulation
  @param saveFlag TRUE or FALSE to save timeseries to report file
@@ -232,6 +246,70 @@ void   DLLEXPORT swmm_writeLine(const char *line);
 void   DLLEXPORT swmm_decodeDate(double date, int *year, int *month, int *day,
                  int *hour, int *minute, int *second, int *dayOfWeek);
 
+//-----------------------------------------------------------------------------
+//  Reentrant API
+//
+//  A SWMM_Project handle holds the complete state of one simulation. Each
+//  swmm_xxx_r function behaves like swmm_xxx but works on the project it is
+//  given, so separate projects can be run concurrently on separate threads.
+//  A project must only be used by one thread at a time. The functions above
+//  work on the calling thread's current project (see swmm_useProject), which
+//  is a built-in default project unless another one has been selected.
+//-----------------------------------------------------------------------------
+
+typedef struct SWMM_Project SWMM_Project;
+
+/**
+ @brief Create a new, empty project
+ @param[out] project handle of the new project
+ @return error code
+*/
+int DLLEXPORT swmm_createProject(SWMM_Project** project);
+
+/**
+ @brief Close a project (if still open) and free it
+ @param project handle of the project
+ @return error code
+*/
+int DLLEXPORT swmm_deleteProject(SWMM_Project* project);
+
+/**
+ @brief Make a project the current one of the calling thread
+ @param project handle of the project (NULL selects the default project)
+ @return the thread's previous project
+*/
+SWMM_Project* DLLEXPORT swmm_useProject(SWMM_Project* project);
+
+int    DLLEXPORT swmm_run_r(SWMM_Project* p, const char *f1, const char *f2,
+                 const char *f3);
+int    DLLEXPORT swmm_open_r(SWMM_Project* p, const char *f1, const char *f2,
+                 const char *f3);
+int    DLLEXPORT swmm_saveCompiled_r(SWMM_Project* p, const char *fname);
+int    DLLEXPORT swmm_openCompiled_r(SWMM_Project* p, const char *f1,
+                 const char *f2, const char *f3);
+int    DLLEXPORT swmm_start_r(SWMM_Project* p, int saveFlag);
+int    DLLEXPORT swmm_step_r(SWMM_Project* p, double* elapsedTime);
+int    DLLEXPORT swmm_stride_r(SWMM_Project* p, int strideStep,
+                 double *elapsedTime);
+int    DLLEXPORT swmm_end_r(SWMM_Project* p);
+int    DLLEXPORT swmm_report_r(SWMM_Project* p);
+int    DLLEXPORT swmm_close_r(SWMM_Project* p);
+int    DLLEXPORT swmm_getMassBalErr_r(SWMM_Project* p, float* runoffErr,
+                 float* flowErr, float* qualErr);
+int    DLLEXPORT swmm_getError_r(SWMM_Project* p, char* errMsg, int msgLen);
+int    DLLEXPORT swmm_getWarnings_r(SWMM_Project* p);
+int    DLLEXPORT swmm_getCount_r(SWMM_Project* p, int objType);
+void   DLLEXPORT swmm_getName_r(SWMM_Project* p, int objType, int index,
+                 char *name, int size);
+int    DLLEXPORT swmm_getIndex_r(SWMM_Project* p, int objType,
+                 const char *name);
+double DLLEXPORT swmm_getValue_r(SWMM_Project* p, int property, int index);
+void   DLLEXPORT swmm_setValue_r(SWMM_Project* p, int property, int index,
+                 double value);
+double DLLEXPORT swmm_getSavedValue_r(SWMM_Project* p, int property,
+                 int index, int period);
+void   DLLEXPORT swmm_writeLine_r(SWMM_Project* p, const char *line);
+
 #ifdef __cplusplus 
 }   // matches the linkage specification from above */ 
 #endif
@@ -58,6 +58,17 @@ EXPORT_TOOLKIT const char *swmm_getBuildId();
 EXPORT_TOOLKIT int swmm_run_cb(const char *f1, const char *f2, const char *f3,
     void (*callback) (double *));
 
+/**
+ @brief Opens a compiled project file (see swmm_saveCompiled), runs, and closes
+ @param f1 pointer to name of compiled project file (must exist)
+ @param f2 pointer to name of report file (to be created)
+ @param f3 pointer to name of binary output file (to be created)
+ @param pointer to callback function (for printing progress)
+ @return error code
+*/
+EXPORT_TOOLKIT int swmm_runCompiled_cb(const char *f1, const char *f2,
+    const char *f3, void (*callback) (double *));
+
 /**
  @brief Get the text of an error code.
  @param errcode The error code
@@ -636,6 +647,140 @@ EXPORT_TOOLKIT int swmm_setGagePrecip(int index, double total_precip);
 EXPORT_TOOLKIT void swmm_freeMemory(void *memory);
 
 
+/**
+ @brief Reentrant versions of the functions above. Each swmm_xxx_r function
+ behaves like swmm_xxx but works on project p (see swmm_createProject in
+ swmm5.h) instead of the calling thread's current project.
+*/
+EXPORT_TOOLKIT int swmm_run_cb_r(struct SWMM_Project* p, const char *f1,
+    const char *f2, const char *f3, void (*callback) (double *));
+EXPORT_TOOLKIT int swmm_runCompiled_cb_r(struct SWMM_Project* p,
+    const char *f1, const char *f2, const char *f3,
+    void (*callback) (double *));
+EXPORT_TOOLKIT int swmm_project_findObject_r(struct SWMM_Project* p,
+    SM_ObjectType type, char *id, int *index);
+EXPORT_TOOLKIT int swmm_getSimulationUnit_r(struct SWMM_Project* p,
+    SM_Units type, int *value);
+EXPORT_TOOLKIT int swmm_getSimulationAnalysisSetting_r(struct SWMM_Project* p,
+    SM_SimOption type, int *value);
+EXPORT_TOOLKIT int swmm_getSimulationParam_r(struct SWMM_Project* p,
+    SM_SimSetting type, double *value);
+EXPORT_TOOLKIT int swmm_setSimulationParam_r(struct SWMM_Project* p,
+    SM_SimSetting type, double value);
+EXPORT_TOOLKIT int swmm_hotstart_r(struct SWMM_Project* p, SM_HotStart type,
+    const char *hsfile);
+EXPORT_TOOLKIT int swmm_countObjects_r(struct SWMM_Project* p,
+    SM_ObjectType type, int *count);
+EXPORT_TOOLKIT int swmm_getObjectId_r(struct SWMM_Project* p,
+    SM_ObjectType type, int index, char **id);
+EXPORT_TOOLKIT int swmm_getObjectIndex_r(struct SWMM_Project* p,
+    SM_ObjectType type, char *id, int *index);
+EXPORT_TOOLKIT int swmm_getNodeType_r(struct SWMM_Project* p, int index,
+    SM_NodeType *Ntype);
+EXPORT_TOOLKIT int swmm_getLinkType_r(struct SWMM_Project* p, int index,
+    SM_LinkType *Ltype);
+EXPORT_TOOLKIT int swmm_getLinkConnections_r(struct SWMM_Project* p,
+    int index, int *node1, int *node2);
+EXPORT_TOOLKIT int swmm_getLinkDirection_r(struct SWMM_Project* p, int index,
+    signed char *value);
+EXPORT_TOOLKIT int swmm_getSubcatchOutConnection_r(struct SWMM_Project* p,
+    int index, SM_ObjectType *type, int *out_index);
+EXPORT_TOOLKIT int swmm_getLidUCount_r(struct SWMM_Project* p, int index,
+    int *value);
+EXPORT_TOOLKIT int swmm_getLidUParam_r(struct SWMM_Project* p, int index,
+    int lidIndex, SM_LidUProperty param, double *value);
+EXPORT_TOOLKIT int swmm_setLidUParam_r(struct SWMM_Project* p, int index,
+    int lidIndex, SM_LidUProperty param, double value);
+EXPORT_TOOLKIT int swmm_getLidUOption_r(struct SWMM_Project* p, int index,
+    int lidIndex, SM_LidUOptions param, int *value);
+EXPORT_TOOLKIT int swmm_setLidUOption_r(struct SWMM_Project* p, int index,
+    int lidIndex, SM_LidUOptions param, int value);
+EXPORT_TOOLKIT int swmm_getLidCOverflow_r(struct SWMM_Project* p,
+    int lidControlIndex, int *condition);
+EXPORT_TOOLKIT int swmm_getLidCParam_r(struct SWMM_Project* p,
+    int lidControlIndex, SM_LidLayer layerIndex, SM_LidLayerProperty param,
+    double *value);
+EXPORT_TOOLKIT int swmm_setLidCParam_r(struct SWMM_Project* p,
+    int lidControlIndex, SM_LidLayer layerIndex, SM_LidLayerProperty param,
+    double value);
+EXPORT_TOOLKIT int swmm_getLidUFluxRates_r(struct SWMM_Project* p, int index,
+    int lidIndex, SM_LidLayer layerIndex, double *result);
+EXPORT_TOOLKIT int swmm_getLidGResult_r(struct SWMM_Project* p, int index,
+    SM_LidResult type, double *result);
+EXPORT_TOOLKIT int swmm_getLidUResult_r(struct SWMM_Project* p, int index,
+    int lidIndex, SM_LidResult type, double *result);
+EXPORT_TOOLKIT int swmm_getNodeParam_r(struct SWMM_Project* p, int index,
+    SM_NodeProperty param, double *value);
+EXPORT_TOOLKIT int swmm_setNodeParam_r(struct SWMM_Project* p, int index,
+    SM_NodeProperty param, double value);
+EXPORT_TOOLKIT int swmm_getLinkParam_r(struct SWMM_Project* p, int index,
+    SM_LinkProperty param, double *value);
+EXPORT_TOOLKIT int swmm_setLinkParam_r(struct SWMM_Project* p, int index,
+    SM_LinkProperty param, double value);
+EXPORT_TOOLKIT int swmm_getInletParam_r(struct SWMM_Project* p, int index,
+    SM_InletProperty param, double *value);
+EXPORT_TOOLKIT int swmm_setInletParam_r(struct SWMM_Project* p, int index,
+    SM_InletProperty param, double value);
+EXPORT_TOOLKIT int swmm_getSubcatchParam_r(struct SWMM_Project* p, int index,
+    SM_SubcProperty param, double *value);
+EXPORT_TOOLKIT int swmm_setSubcatchParam_r(struct SWMM_Project* p, int index,
+    SM_SubcProperty param, double value);
+EXPORT_TOOLKIT int swmm_getSimulationDateTime_r(struct SWMM_Project* p,
+    SM_TimePropety type, int *year, int *month, int *day, int *hour,
+    int *minute, int *second);
+EXPORT_TOOLKIT int swmm_setSimulationDateTime_r(struct SWMM_Project* p,
+    SM_TimePropety type, int year, int month, int day, int hour, int minute,
+    int second);
+EXPORT_TOOLKIT int swmm_getCurrentDateTime_r(struct SWMM_Project* p,
+    int *year, int *month, int *day, int *hour, int *minute, int *second);
+EXPORT_TOOLKIT int swmm_getNodeResult_r(struct SWMM_Project* p, int index,
+    SM_NodeResult type, double *result);
+EXPORT_TOOLKIT int swmm_getNodePollut_r(struct SWMM_Project* p, int index,
+    SM_NodePollut type, double **pollutArray, int *length);
+EXPORT_TOOLKIT int swmm_setNodePollut_r(struct SWMM_Project* p, int index,
+    SM_NodePollut type, int pollutant_index, double pollutant_value);
+EXPORT_TOOLKIT int swmm_setLinkPollut_r(struct SWMM_Project* p, int index,
+    SM_LinkPollut type, int pollutant_index, double pollutant_value);
+EXPORT_TOOLKIT int swmm_getLinkResult_r(struct SWMM_Project* p, int index,
+    SM_LinkResult type, double *result);
+EXPORT_TOOLKIT int swmm_getInletResult_r(struct SWMM_Project* p, int index,
+    SM_InletResult type, double *result);
+EXPORT_TOOLKIT int swmm_getLinkPollut_r(struct SWMM_Project* p, int index,
+    SM_LinkPollut type, double **pollutArray, int *length);
+EXPORT_TOOLKIT int swmm_getSubcatchResult_r(struct SWMM_Project* p, int index,
+    SM_SubcResult type, double *result);
+EXPORT_TOOLKIT int swmm_getSubcatchPollut_r(struct SWMM_Project* p, int index,
+    SM_SubcPollut type, double **pollutArray, int *length);
+EXPORT_TOOLKIT int swmm_getGagePrecip_r(struct SWMM_Project* p, int index,
+    SM_GagePrecip type, double *result);
+EXPORT_TOOLKIT int swmm_getNodeStats_r(struct SWMM_Project* p, int index,
+    SM_NodeStats *nodeStats);
+EXPORT_TOOLKIT int swmm_getNodeTotalInflow_r(struct SWMM_Project* p,
+    int index, double *value);
+EXPORT_TOOLKIT int swmm_getStorageStats_r(struct SWMM_Project* p, int index,
+    SM_StorageStats *storageStats);
+EXPORT_TOOLKIT int swmm_getOutfallStats_r(struct SWMM_Project* p, int index,
+    SM_OutfallStats *outfallStats);
+EXPORT_TOOLKIT int swmm_getLinkStats_r(struct SWMM_Project* p, int index,
+    SM_LinkStats *linkStats);
+EXPORT_TOOLKIT int swmm_getPumpStats_r(struct SWMM_Project* p, int index,
+    SM_PumpStats *pumpStats);
+EXPORT_TOOLKIT int swmm_getSubcatchStats_r(struct SWMM_Project* p, int index,
+    SM_SubcatchStats *subcatchStats);
+EXPORT_TOOLKIT int swmm_getSystemRoutingTotals_r(struct SWMM_Project* p,
+    SM_RoutingTotals *routingTotals);
+EXPORT_TOOLKIT int swmm_getSystemRunoffTotals_r(struct SWMM_Project* p,
+    SM_RunoffTotals *runoffTotals);
+EXPORT_TOOLKIT int swmm_setLinkSetting_r(struct SWMM_Project* p, int index,
+    double setting);
+EXPORT_TOOLKIT int swmm_setNodeInflow_r(struct SWMM_Project* p, int index,
+    double flowrate);
+EXPORT_TOOLKIT int swmm_setOutfallStage_r(struct SWMM_Project* p, int index,
+    double stage);
+EXPORT_TOOLKIT int swmm_setGagePrecip_r(struct SWMM_Project* p, int index,
+    double total_precip);
+
+
 #ifdef __cplusplus
 }    // matches the linkage specification from above */
 #endif
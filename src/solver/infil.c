@@ -32,6 +32,9 @@
 //   - Additional validity check for G-A initial deficit added.
 //   - New error message 235 added for invalid infiltration parameters.
 //   - Conversion of runon to ponded depth fixed for Curve Number infiltration.
+//   Build 5.2.4 (OWA):
+//   - New function infil_getData() added for compiled project files.
+//   - Infiltration objects allocated from the subcatchments' memory pool.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -48,16 +51,17 @@ typedef union TInfil {
     TGrnAmpt  grnAmpt;
     TCurveNum curveNum;
 } TInfil;
-TInfil *Infil;
+#define Infil  (ActiveProject->infil.Infil)
 
-static double Fumax;   // saturated water volume in upper soil zone (ft)
-static double InfilFactor;
+static SWMM_TLS double Fumax;   // saturated water volume in upper soil zone (ft)
+static SWMM_TLS double InfilFactor;
 
 //-----------------------------------------------------------------------------
 //  External Functions (declared in infil.h)
 //-----------------------------------------------------------------------------
 //  infil_create     (called by createObjects in project.c)
 //  infil_delete     (called by deleteObjects in project.c)
+//  infil_getData    (called by xferInfil in snapshot.c)
 //  infil_readParams (called by input_readLine)
 //  infil_initState  (called by subcatch_initState)
 //  infil_getState   (called by writeRunoffFile in hotstart.c)
@@ -105,8 +109,8 @@ void infil_create(int n)
 //  Output:  none
 //
 {
-    Infil = (TInfil *) calloc(n, sizeof(TInfil));
-    if (Infil == NULL) ErrorCode = ERR_MEMORY;
+    Infil = (TInfil *) project_alloc(SUBCATCH, n, sizeof(TInfil));
+    if (n > 0 && Infil == NULL) ErrorCode = ERR_MEMORY;
     InfilFactor = 1.0;
     return;
 }
@@ -120,7 +124,21 @@ void infil_delete()
 //  Output:  none
 //
 {
-    FREE(Infil);
+    Infil = NULL;     // freed with the subcatchments' memory pool
+}
+
+//=============================================================================
+
+void* infil_getData(size_t* size)
+//
+//  Input:   size = size of infiltration data (bytes)
+//  Output:  returns a pointer to the infiltration objects
+//  Purpose: provides raw access to the infiltration objects of all
+//           subcatchments so they can be saved to a compiled project file.
+//
+{
+    *size = Nobjects[SUBCATCH] * sizeof(TInfil);
+    return Infil;
 }
 
 //=============================================================================
@@ -95,6 +95,7 @@ extern TCurveNum* CNInfil;
 //-----------------------------------------------------------------------------
 void    infil_create(int n);
 void    infil_delete(void);
+void*   infil_getData(size_t* size);
 int     infil_readParams(int m, char* tok[], int ntoks);
 void    infil_initState(int j);
 void    infil_getState(int j, double x[]);
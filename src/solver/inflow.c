@@ -13,6 +13,9 @@
 //   ==============
 //   Build 5.2.0:
 //   - Removed references to unused extIfaceInflow member of ExtInflow struct. 
+//   Build 5.2.4 (OWA):
+//   - Inflow objects allocated from the nodes' memory pool, which is freed
+//     when the project is closed, so they are no longer deleted one by one.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -26,8 +29,6 @@
 //  inflow_initDwfPattern   (called createObjects in project.c)
 //  inflow_readExtInflow    (called by input_readLine)
 //  inflow_readDwfInflow    (called by input_readLine)
-//  inflow_deleteExtInflows (called by deleteObjects in project.c)
-//  inflow_deleteDwfInflows (called by deleteObjects in project.c)
 //  inflow_getExtInflow     (called by addExternalInflows in routing.c)
 //  inflow_setExtInflow     (called by setNodeInflow in swmm5.c)
 //  inflow_getDwfInflow     (called by addDryWeatherInflows in routing.c)
@@ -226,7 +227,7 @@ int inflow_setExtInflow(int j, int param, int type, int tseries, int basePat,
         // --- if it doesn't exist, then create it
         if ( inflow == NULL )
         {
-            inflow = (TExtInflow *) malloc(sizeof(TExtInflow));
+            inflow = (TExtInflow *) project_alloc(NODE, 1, sizeof(TExtInflow));
             if ( inflow == NULL ) 
             {
                 return error_setInpError(ERR_MEMORY, "");
@@ -250,26 +251,6 @@ int inflow_setExtInflow(int j, int param, int type, int tseries, int basePat,
 
 //=============================================================================
 
-void inflow_deleteExtInflows(int j)
-//
-//  Input:   j = node index
-//  Output:  none
-//  Purpose: deletes all time series inflow data for a node.
-//
-{
-    TExtInflow* inflow1;
-    TExtInflow* inflow2;
-    inflow1 = Node[j].extInflow;
-    while ( inflow1 )
-    {
-        inflow2 = inflow1->next;
-        free(inflow1);
-        inflow1 = inflow2; 
-    }
-}
-
-//=============================================================================
-
 double inflow_getExtInflow(TExtInflow* inflow, DateTime aDate)
 //
 //  Input:   inflow = external inflow data structure
@@ -364,7 +345,7 @@ int inflow_readDwfInflow(char* tok[], int ntoks)
     // --- if it doesn't exist, then create it
     if ( inflow == NULL )
     {
-        inflow = (TDwfInflow *) malloc(sizeof(TDwfInflow));
+        inflow = (TDwfInflow *) project_alloc(NODE, 1, sizeof(TDwfInflow));
         if ( inflow == NULL ) return error_setInpError(ERR_MEMORY, "");
         inflow->next = Node[j].dwfInflow;
         Node[j].dwfInflow = inflow;
@@ -379,26 +360,6 @@ int inflow_readDwfInflow(char* tok[], int ntoks)
 
 //=============================================================================
 
-void inflow_deleteDwfInflows(int j)
-//
-//  Input:   j = node index
-//  Output:  none
-//  Purpose: deletes all dry weather inflow data for a node.
-//
-{
-    TDwfInflow* inflow1;
-    TDwfInflow* inflow2;
-    inflow1 = Node[j].dwfInflow;
-    while ( inflow1 )
-    {
-        inflow2 = inflow1->next;
-        free(inflow1);
-        inflow1 = inflow2; 
-    }
-}
-
-//=============================================================================
-
 void   inflow_initDwfInflow(TDwfInflow* inflow)
 //
 //  Input:   inflow = dry weather inflow data structure
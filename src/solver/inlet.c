@@ -22,6 +22,10 @@
 //   - Fixed expression for equivalent gutter slope in getCurbInletCapture.
 //   - Corrected sign in equation for effective head in a curb inlet
 //     with an inclined throat opening in getCurbOrificeFlow.
+//   Build 5.2.4 (OWA):
+//   - Street flow summary lists streets in input file order.
+//   - Inlet designs, usages & flows allocated from memory pools freed
+//     with the project.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -63,7 +67,7 @@ typedef struct
 } TCustomInlet;
 
 // Inlet design object
-typedef struct
+typedef struct TInletDesign
 {
     char *         ID;            // name assigned to inlet design
     int            type;          // type of inlet used (grate, curb, etc)
@@ -76,10 +80,12 @@ typedef struct
 
 // OWA EDIT - TInlet and TInletStats struct defs moved to inlet.h to be shared by toolkit.c
 
-// Shared inlet variables
-TInletDesign * InletDesigns;      // array of available inlet designs
-int            InletDesignCount;  // number of inlet designs
-int            UsesInlets;        // TRUE if project uses inlets
+// Shared inlet variables (held in the project context, see globals.h)
+#define InletDesigns      (ActiveProject->inlet.InletDesigns)
+#define InletDesignCount  (ActiveProject->inlet.InletDesignCount)
+#define UsesInlets        (ActiveProject->inlet.UsesInlets)
+#define InletFlow         (ActiveProject->inlet.InletFlow)
+#define FirstInlet        (ActiveProject->inlet.FirstInlet)
 
 //-----------------------------------------------------------------------------
 //  Enumerations
@@ -138,32 +144,24 @@ static const double GrateOpeningRatios[] = {
     0.80,     //Reticuline
     1.00};    //Generic
 
-//-----------------------------------------------------------------------------
-//  Imported Variables
-//-----------------------------------------------------------------------------
-extern TLinkStats*     LinkStats;      // defined in STATS.C
-extern TNodeStats*     NodeStats;      // defined in STATS.C
-
 //-----------------------------------------------------------------------------
 //  Local Shared Variables
 //-----------------------------------------------------------------------------
 // Variables as named in the HEC-22 manual.
-static double Sx;            // street cross slope
-static double SL;            // conduit longitudinal slope
-static double Sw;            // gutter + cross slope
-static double a;             // street gutter depression (ft)
-static double W;             // street gutter width (ft)
-static double T;             // top width of flow spread (ft)
-static double n;             // Manning's roughness coeff.
+static SWMM_TLS double Sx;            // street cross slope
+static SWMM_TLS double SL;            // conduit longitudinal slope
+static SWMM_TLS double Sw;            // gutter + cross slope
+static SWMM_TLS double a;             // street gutter depression (ft)
+static SWMM_TLS double W;             // street gutter width (ft)
+static SWMM_TLS double T;             // top width of flow spread (ft)
+static SWMM_TLS double n;             // Manning's roughness coeff.
 
 // Additional variables
-static int     Nsides;       // 1- or 2-sided street
-static double  Tcrown;       // distance from street curb to crown (ft)
-static double  Beta;         // = 1.486 * sqrt(SL) / n
-static double  Qfactor;      // factor f in Izzard's eqn. Q = f*T^2.67
-static TXsect* xsect;        // cross-section data of inlet's conduit
-static double* InletFlow;    // captured inlet flow received by each node
-static TInlet* FirstInlet;   // head of list of deployed inlets
+static SWMM_TLS int     Nsides;       // 1- or 2-sided street
+static SWMM_TLS double  Tcrown;       // distance from street curb to crown (ft)
+static SWMM_TLS double  Beta;         // = 1.486 * sqrt(SL) / n
+static SWMM_TLS double  Qfactor;      // factor f in Izzard's eqn. Q = f*T^2.67
+static SWMM_TLS TXsect* xsect;        // cross-section data of inlet's conduit
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in inlet.h)
@@ -237,12 +235,13 @@ int  inlet_create(int numInlets)
     InletDesignCount = 0;
     UsesInlets = FALSE;
     FirstInlet = NULL;
-    InletDesigns = (TInletDesign *)calloc(numInlets, sizeof(TInletDesign));
-    if (InletDesigns == NULL) return ERR_MEMORY;
+    InletDesigns = (TInletDesign *)project_alloc(INLET, numInlets,
+                                                 sizeof(TInletDesign));
+    if (numInlets > 0 && InletDesigns == NULL) return ERR_MEMORY;
     InletDesignCount = numInlets;
 
-    InletFlow = (double *)calloc(Nobjects[NODE], sizeof(double));
-    if (InletFlow == NULL) return ERR_MEMORY;    
+    InletFlow = (double *)project_alloc(NODE, Nobjects[NODE], sizeof(double));
+    if (Nobjects[NODE] > 0 && InletFlow == NULL) return ERR_MEMORY;    
 
     for (i = 0; i < InletDesignCount; i++)
     {
@@ -264,17 +263,11 @@ void inlet_delete()
 //  Purpose: frees all memory allocated for inlet analysis.
 //
 {
-    TInlet* inlet = FirstInlet;
-    TInlet* nextInlet;
-    while (inlet)
-    {
-        nextInlet = inlet->nextInlet;
-        free(inlet);
-        inlet = nextInlet;
-    }
+    // --- inlet designs, usages and flows are freed with the project's
+    //     memory pools
     FirstInlet = NULL;
-    FREE(InletFlow);
-    FREE(InletDesigns);
+    InletDesigns = NULL;
+    InletFlow = NULL;
 }
 
 //=============================================================================
@@ -404,7 +397,7 @@ int inlet_readUsageParams(char* tok[], int ntoks)
     inlet = Link[linkIndex].inlet;
     if (inlet == NULL)
     {
-        inlet = (TInlet *)malloc(sizeof(TInlet));
+        inlet = (TInlet *)project_alloc(INLET, 1, sizeof(TInlet));
         if (!inlet) return error_setInpError(ERR_MEMORY, "");
         Link[linkIndex].inlet = inlet;
         inlet->nextInlet = FirstInlet;
@@ -502,13 +495,11 @@ void inlet_validate()
             {
                 FirstInlet = inlet->nextInlet;
                 prevInlet = FirstInlet;
-                free(inlet);
                 inlet = FirstInlet;
             }
             else
             {
                 prevInlet->nextInlet = inlet->nextInlet;
-                free(inlet);
                 inlet = prevInlet->nextInlet;
             }
             Link[i].inlet = NULL;
@@ -686,8 +677,6 @@ void inlet_adjustQualOutflows()
 
     // --- these variables, declared in massbal.c, accumulate system-wide flow and
     //     pollutant mass fluxes over a time step to use in mass balances
-    extern TRoutingTotals StepFlowTotals;
-    extern TRoutingTotals*  StepQualTotals;
 
     // --- examine each node
     for (j = 0; j < Nobjects[NODE]; j++)
@@ -747,11 +736,12 @@ void inlet_writeStatsReport()
 //  Purpose: writes table of street & inlet flow statistics to SWMM's report file.
 //
 {
-    int j, header = FALSE;
+    int i, j, header = FALSE;
 
     if (Nobjects[STREET] == 0) return;
-    for (j = 0; j < Nobjects[LINK]; j++)
+    for (i = 0; i < Nobjects[LINK]; i++)
     {
+        j = project_getInternalIndex(LINK, i);
         if (Link[j].xsect.type == STREET_XSECT)
         {
             if (!header)
@@ -21,6 +21,12 @@
 //   - Support added for named variables & math expressions in control rules.
 //   Build 5.2.1:
 //   - Possible integer underflow avoided in getTokens() function.
+//   Build 5.2.4 (OWA):
+//   - Nodes & links can be renumbered after the object count pass.
+//   - Input file is memory-mapped and indexed by section in a single scan.
+//   - Sections with no effect on the simulation are skipped when reading.
+//   - Conduit, cross section & time series lines can be read in parallel.
+//   - Sections can be copied and re-read later for compiled project files.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -30,32 +36,89 @@
 #include "headers.h"
 #include "lid.h"
 
+// Protect against lack of compiler support for OpenMP
+#if defined(_OPENMP)
+  #include <omp.h>
+#else
+  int omp_get_max_threads(void);       // defined in project.c
+#endif
+
 //-----------------------------------------------------------------------------
 //  Constants
 //-----------------------------------------------------------------------------
 static const int MAXERRS = 100;        // Max. input errors reported
+static const int INP_BATCH = 1024;     // Max. input lines parsed as a batch
+
+//-----------------------------------------------------------------------------
+//  Data Structures
+//-----------------------------------------------------------------------------
+// A contiguous block of lines from one section of the input file
+typedef struct
+{
+    int     sect;                 // input section type
+    size_t  start;                // file offset of first line after heading
+    size_t  end;                  // file offset just past last line
+    long    lineCount;            // number of lines before first line
+}  TInpSection;
+
+// A line of input that is parsed as part of a batch
+typedef struct
+{
+    char    text[MAXLINE+1];      // copy of line split into tokens
+    char*   tok[MAXTOKS];         // tokens found in line
+    int     ntoks;                // number of tokens
+    int     key;                  // index of object the line refers to
+    int     subIndex;             // sub-index of object the line defines
+    int     err;                  // error code from parsing the line
+    size_t  pos;                  // file offset of the line
+    char    errString[256];       // error message text
+}  TInpLine;
 
 //-----------------------------------------------------------------------------
 //  Shared variables
 //-----------------------------------------------------------------------------
-static char *Tok[MAXTOKS];             // String tokens from line of input
-static int  Ntokens;                   // Number of tokens in line of input
-static int  Mobjects[MAX_OBJ_TYPES];   // Working number of objects of each type
-static int  Mnodes[MAX_NODE_TYPES];    // Working number of node objects
-static int  Mlinks[MAX_LINK_TYPES];    // Working number of link objects
-static int  Mevents;                   // Working number of event periods
+static SWMM_TLS char *Tok[MAXTOKS];             // String tokens from line of input
+static SWMM_TLS int  Ntokens;                   // Number of tokens in line of input
+static SWMM_TLS int  Mobjects[MAX_OBJ_TYPES];   // Working number of objects of each type
+static SWMM_TLS int  Mnodes[MAX_NODE_TYPES];    // Working number of node objects
+static SWMM_TLS int  Mlinks[MAX_LINK_TYPES];    // Working number of link objects
+static SWMM_TLS int  Mevents;                   // Working number of event periods
+static SWMM_TLS int* NodeSubIndex;              // Renumbered sub-index of each node
+static SWMM_TLS int* LinkSubIndex;              // Renumbered sub-index of each link
+static SWMM_TLS TMapFile     InpFile;           // Memory-mapped input file
+static SWMM_TLS TInpSection* Sections;          // Index of input file sections
+static SWMM_TLS int          Nsections;         // Number of indexed sections
+static SWMM_TLS int          MaxSections;       // Allocated size of index
+
+extern SWMM_TLS char ErrString[256];            // defined in ERROR.C
 
 //-----------------------------------------------------------------------------
 //  External Functions (declared in funcs.h)
 //-----------------------------------------------------------------------------
 //  input_countObjects  (called by swmm_open in swmm5.c)
 //  input_readData      (called by swmm_open in swmm5.c)
+//  input_copySections  (called by snapshot_save in snapshot.c)
+//  input_readSections  (called by snapshot_read in snapshot.c)
 
 //-----------------------------------------------------------------------------
 //  Local functions
 //-----------------------------------------------------------------------------
 static int  addObject(int objType, char* id);
+static int  addSection(int sect, size_t start, long lineCount);
+static int  isCounted(int sect);
+static int  isRead(int sect);
+static int  isReadInParallel(int sect);
+static int  getLine(size_t* pos, size_t end, char* line);
+static int  readLines(int* sect, size_t start, size_t end, long lineCount,
+            int* errsum);
+static int  readLinesInParallel(int* sect, size_t start, size_t end,
+            long lineCount, int* errsum, int nThreads, TInpLine* batch);
+static void prepareLine(int sect, TInpLine* line);
+static void parseLines(int sect, int thread, int nThreads, TInpLine* batch,
+            int n);
+static void closeInpFile(void);
 static int  getTokens(char *s);
+static int  splitTokens(char *s, char *tok[]);
 static int  parseLine(int sect, char* line);
 static int  readOption(char* line);
 static int  readTitle(char* line);
@@ -63,6 +126,8 @@ static int  readControl(char* tok[], int ntoks);
 static int  readNode(int type);
 static int  readLink(int type);
 static int  readEvent(char* tok[], int ntoks);
+static int  renumberObjects(void);
+static int* createSubIndexes(int n, int order[], int subType[]);
 
 //=============================================================================
 
@@ -72,6 +137,10 @@ int input_countObjects()
 //  Output:  returns error code
 //  Purpose: reads input file to determine number of system objects.
 //
+//  The input file is mapped into memory and an index of its sections is
+//  built while objects are counted, so that later passes through the file
+//  only need to visit the sections they use.
+//
 {
     char  line[MAXLINE+1];             // line from input data file     
     char  wLine[MAXLINE+1];            // working copy of input line   
@@ -81,6 +150,7 @@ int input_countObjects()
     int   errsum = 0;                  // number of errors found                   
     int   i;
     long  lineCount = 0;
+    size_t pos = 0, lineStart;         // file offsets of lines
 
     // --- initialize number of objects & set default values
     if ( ErrorCode ) return ErrorCode;
@@ -90,13 +160,35 @@ int input_countObjects()
     for (i = 0; i < MAX_LINK_TYPES; i++) Nlinks[i] = 0;
     controls_init();
 
+    // --- map the input file into memory
+    if ( !mapfile_open(&InpFile, Finp.name) )
+    {
+        report_writeErrorMsg(ERR_INP_FILE, "");
+        return ErrorCode;
+    }
+
+    // --- lines before the first section heading are read as the title
+    if ( !addSection(s_TITLE, 0, 0) )
+    {
+        report_writeErrorMsg(ERR_MEMORY, "");
+        return ErrorCode;
+    }
+
     // --- make pass through data file counting number of each object
-    while ( fgets(line, MAXLINE, Finp.file) != NULL )
+    for (;;)
     {
-        // --- skip blank lines & those beginning with a comment
+        lineStart = pos;
+        if ( !getLine(&pos, InpFile.size, line) ) break;
+
+        // --- skip lines of sections without objects unless they
+        //     might begin a new section
         lineCount++;
+        if ( sect >= 0 && !isCounted(sect) &&
+             line[strspn(line, SEPSTR)] != '[' ) continue;
+
+        // --- skip blank lines & those beginning with a comment
         sstrncpy(wLine, line, MAXLINE);     // make working copy of line
-        tok = strtok(wLine, SEPSTR);        // get first text token on line
+        tok = sstrtok(wLine, SEPSTR);       // get first text token on line
         if ( tok == NULL ) continue;
         if ( *tok == ';' ) continue;
 
@@ -107,8 +199,12 @@ int input_countObjects()
             newsect = findmatch(tok, SectWords);
             if ( newsect >= 0 )
             {
+                // --- add the new section to the file's index
                 sect = newsect;
-                continue;
+                Sections[Nsections-1].end = lineStart;
+                if ( addSection(sect, pos, lineCount) ) continue;
+                report_writeErrorMsg(ERR_MEMORY, "");
+                return ErrorCode;
             }
             else
             {
@@ -130,9 +226,17 @@ int input_countObjects()
             if (errsum >= MAXERRS ) break;
         }
     }
+    Sections[Nsections-1].end = InpFile.size;
 
     // --- set global error code if input errors were found
     if ( errsum > 0 ) ErrorCode = ERR_INPUT;
+
+    // --- renumber nodes & links if called for
+    else if ( Renumber != NO_RENUMBER )
+    {
+        errcode = renumberObjects();
+        if ( errcode ) report_writeErrorMsg(errcode, "");
+    }
     return ErrorCode;
 }
 
@@ -145,19 +249,23 @@ int input_readData()
 //  Purpose: reads input file to determine input parameters for each object.
 //
 {
-    char  line[MAXLINE+1];        // line from input data file
-    char  wLine[MAXLINE+1];       // working copy of input line
-    char* comment;                // ptr. to start of comment in input line
-    int   sect, newsect;          // data sections
-    int   inperr, errsum;         // error code & total error count
-    int   lineLength;             // number of characters in input line
+    int   sect;                   // data section
+    int   errsum;                 // total error count
+    int   nThreads;               // number of threads used to parse lines
+    int   r;
     int   i;
-    long  lineCount = 0;
+    TInpLine* batch = NULL;       // lines parsed as a batch
 
     // --- initialize working item count arrays
     //     (final counts in Mobjects, Mnodes & Mlinks should
     //      match those in Nobjects, Nnodes and Nlinks).
-    if ( ErrorCode ) return ErrorCode;
+    if ( ErrorCode )
+    {
+        FREE(NodeSubIndex);
+        FREE(LinkSubIndex);
+        closeInpFile();
+        return ErrorCode;
+    }
     error_setInpError(0, "");
     for (i = 0; i < MAX_OBJ_TYPES; i++)  Mobjects[i] = 0;
     for (i = 0; i < MAX_NODE_TYPES; i++) Mnodes[i] = 0;
@@ -170,11 +278,172 @@ int input_readData()
         Tseries[i].lastDate = StartDate + StartTime;
     }
 
-    // --- read each line from input file
+    // --- find number of threads available for parsing
+    if ( NumThreads == 0 ) nThreads = omp_get_max_threads();
+    else nThreads = NumThreads;
+    if ( nThreads > 1 )
+    {
+        batch = (TInpLine *) malloc(INP_BATCH * sizeof(TInpLine));
+        if ( batch == NULL ) nThreads = 1;
+    }
+
+    // --- read each section of the input file
     sect = 0;
     errsum = 0;
-    rewind(Finp.file);
-    while ( fgets(line, MAXLINE, Finp.file) != NULL )
+    for (r = 0; r < Nsections; r++)
+    {
+        // --- SPECIAL CASE FOR TRANSECTS
+        //     finish processing the last set of transect data
+        if ( r > 0 && sect == s_TRANSECT )
+            transect_validate(Nobjects[TRANSECT]-1);
+
+        // --- begin a new input section, skipping those whose
+        //     data are not used by the simulation
+        sect = Sections[r].sect;
+        if ( !isRead(sect) ) continue;
+
+        // --- read the section's lines
+        if ( nThreads > 1 && isReadInParallel(sect) )
+        {
+            if ( readLinesInParallel(&sect, Sections[r].start, Sections[r].end,
+                 Sections[r].lineCount, &errsum, nThreads, batch) ) break;
+        }
+        else if ( readLines(&sect, Sections[r].start, Sections[r].end,
+                  Sections[r].lineCount, &errsum) ) break;
+    }
+
+    // --- check for errors
+    if (errsum > 0)  ErrorCode = ERR_INPUT;
+    FREE(batch);
+    FREE(NodeSubIndex);
+    FREE(LinkSubIndex);
+    closeInpFile();
+    return ErrorCode;
+}
+
+//=============================================================================
+
+int input_copySections(const int sects[], int n, char** text, size_t* size)
+//
+//  Input:   sects = array of input section types
+//           n = number of section types in sects
+//  Output:  text = copy of the headings & lines of the sections
+//           size = length of the copied text (bytes)
+//           returns error code
+//  Purpose: copies some sections of the input file so that they can be
+//           read again by input_readSections.
+//
+//  NOTE: text is NULL if the input file has none of the sections; otherwise
+//        it must be freed by the caller.
+//
+{
+    char   line[MAXLINE+1];       // line from input data file
+    char   wLine[MAXLINE+1];      // working copy of input line
+    char*  tok;                   // first string token of line
+    char*  buf = NULL;            // copied text
+    char*  newBuf;
+    int    i, newsect;
+    int    copying = FALSE;       // TRUE if in a section being copied
+    size_t pos = 0;               // file offset of next line
+    size_t len;                   // length of line
+    size_t used = 0;              // bytes of copied text
+    size_t allocated = 0;         // bytes allocated for copied text
+
+    *text = NULL;
+    *size = 0;
+    if ( !mapfile_open(&InpFile, Finp.name) ) return ERR_INP_FILE;
+    while ( getLine(&pos, InpFile.size, line) )
+    {
+        // --- check if line begins a new section
+        sstrncpy(wLine, line, MAXLINE);
+        tok = sstrtok(wLine, SEPSTR);
+        if ( tok && *tok == '[' )
+        {
+            newsect = findmatch(tok, SectWords);
+            copying = FALSE;
+            for (i = 0; i < n; i++) if ( newsect == sects[i] ) copying = TRUE;
+        }
+        if ( !copying ) continue;
+
+        // --- append the line (ending with a newline) to the copied text
+        len = strlen(line);
+        if ( used + len + 1 > allocated )
+        {
+            allocated = MAX(2 * allocated, used + len + 1 + MAXLINE);
+            newBuf = (char *) realloc(buf, allocated);
+            if ( newBuf == NULL )
+            {
+                FREE(buf);
+                mapfile_close(&InpFile);
+                return ERR_MEMORY;
+            }
+            buf = newBuf;
+        }
+        memcpy(buf + used, line, len);
+        used += len;
+        if ( len == 0 || line[len-1] != '\n' ) buf[used++] = '\n';
+    }
+    mapfile_close(&InpFile);
+    *text = buf;
+    *size = used;
+    return 0;
+}
+
+//=============================================================================
+
+int input_readSections(char* text, size_t size)
+//
+//  Input:   text = headings & lines of input sections
+//           size = length of text (bytes)
+//  Output:  returns error code
+//  Purpose: reads input data from sections copied by input_copySections
+//           into a project whose objects have already been created.
+//
+{
+    int  sect = -1;
+    int  errsum = 0;
+    int  i;
+
+    if ( ErrorCode ) return ErrorCode;
+    error_setInpError(0, "");
+    for (i = 0; i < MAX_OBJ_TYPES; i++)  Mobjects[i] = 0;
+    for (i = 0; i < MAX_NODE_TYPES; i++) Mnodes[i] = 0;
+    for (i = 0; i < MAX_LINK_TYPES; i++) Mlinks[i] = 0;
+
+    // --- read the text's lines as if they were a mapped input file
+    InpFile.data = text;
+    InpFile.size = size;
+    readLines(&sect, 0, size, 0, &errsum);
+    InpFile.data = NULL;
+    InpFile.size = 0;
+    if ( errsum > 0 ) ErrorCode = ERR_INPUT;
+    return ErrorCode;
+}
+
+//=============================================================================
+
+int readLines(int* sect, size_t start, size_t end, long lineCount, int* errsum)
+//
+//  Input:   sect = current section of input file
+//           start = file offset of first line to read
+//           end = file offset just past last line to read
+//           lineCount = number of lines before the first line
+//           errsum = number of input errors found so far
+//  Output:  sect = updated section of input file
+//           errsum = updated number of input errors
+//           returns TRUE if reading should stop, FALSE if not
+//  Purpose: reads a block of lines from the input file one at a time.
+//
+{
+    char  line[MAXLINE+1];        // line from input data file
+    char  wLine[MAXLINE+1];       // working copy of input line
+    char* comment;                // ptr. to start of comment in input line
+    int   newsect;                // new data section
+    int   inperr;                 // error code
+    int   lineLength;             // number of characters in input line
+    size_t pos = start;           // file offset of next line
+
+    while ( getLine(&pos, end, line) )
     {
         // --- make copy of line and scan for tokens
         lineCount++;
@@ -195,8 +464,8 @@ int input_readData()
             if ( lineLength >= MAXLINE )
             {
                 inperr = ERR_LINE_LENGTH;
-                report_writeInputErrorMsg(inperr, sect, line, lineCount);
-                errsum++;
+                report_writeInputErrorMsg(inperr, *sect, line, lineCount);
+                (*errsum)++;
             }
         }
 
@@ -209,41 +478,219 @@ int input_readData()
             {
                 // --- SPECIAL CASE FOR TRANSECTS
                 //     finish processing the last set of transect data
-                if ( sect == s_TRANSECT )
+                if ( *sect == s_TRANSECT )
                     transect_validate(Nobjects[TRANSECT]-1);
 
                 // --- begin a new input section
-                sect = newsect;
+                *sect = newsect;
                 continue;
             }
             else
             {
                 inperr = error_setInpError(ERR_KEYWORD, Tok[0]);
-                report_writeInputErrorMsg(inperr, sect, line, lineCount);
-                errsum++;
-                break;
+                report_writeInputErrorMsg(inperr, *sect, line, lineCount);
+                (*errsum)++;
+                return TRUE;
             }
         }
 
         // --- otherwise parse tokens from input line
         else
         {
-            inperr = parseLine(sect, line);
+            inperr = parseLine(*sect, line);
             if ( inperr > 0 )
             {
-                errsum++;
-                if ( errsum > MAXERRS ) report_writeLine(FMT19);
-                else report_writeInputErrorMsg(inperr, sect, line, lineCount);
+                (*errsum)++;
+                if ( *errsum > MAXERRS ) report_writeLine(FMT19);
+                else report_writeInputErrorMsg(inperr, *sect, line, lineCount);
             }
         }
 
         // --- stop if reach end of file or max. error count
-        if (errsum > MAXERRS) break;
-    }   /* End of while */
+        if (*errsum > MAXERRS) return TRUE;
+    }
+    return FALSE;
+}
 
-    // --- check for errors
-    if (errsum > 0)  ErrorCode = ERR_INPUT;
-    return ErrorCode;
+//=============================================================================
+
+int readLinesInParallel(int* sect, size_t start, size_t end, long lineCount,
+                        int* errsum, int nThreads, TInpLine* batch)
+//
+//  Input:   sect = current section of input file
+//           start = file offset of first line to read
+//           end = file offset just past last line to read
+//           lineCount = number of lines before the first line
+//           errsum = number of input errors found so far
+//           nThreads = number of threads to use
+//           batch = array of INP_BATCH lines to work with
+//  Output:  sect = updated section of input file
+//           errsum = updated number of input errors
+//           returns TRUE if reading should stop, FALSE if not
+//  Purpose: reads a block of lines from the input file in batches whose
+//           lines are parsed in parallel.
+//
+//  Lines are assigned to threads by the object they refer to, so each
+//  object's lines are still parsed in the order they appear. Errors are
+//  reported in line order once a batch has been parsed.
+//
+{
+    char   line[MAXLINE+1];       // line from input data file
+    int    i, j, n, t;
+    int    nData;                 // number of data lines in batch
+    size_t pos = start;           // file offset of next line
+    size_t batchStart;            // file offset of batch's first line
+    TProject* project = ActiveProject;
+
+    while ( pos < end )
+    {
+        // --- copy the next batch of lines
+        batchStart = pos;
+        for (n = 0; n < INP_BATCH; n++)
+        {
+            batch[n].pos = pos;
+            if ( !getLine(&pos, end, batch[n].text) ) break;
+        }
+
+        // --- split the lines into tokens & find the objects they refer to
+#pragma omp parallel num_threads(nThreads)
+{
+        ActiveProject = project;  // worker threads work on the caller's project
+        #pragma omp for
+        for (i = 0; i < n; i++) prepareLine(*sect, &batch[i]);
+}
+
+        // --- number the batch's data lines
+        nData = 0;
+        for (i = 0; i < n; i++)
+        {
+            if ( batch[i].ntoks == 0 || *batch[i].tok[0] == ';' ) continue;
+
+            // --- a section heading can only be handled one line at a time
+            if ( *batch[i].tok[0] == '[' )
+            {
+                if ( nData > 0 ) break;
+                return readLines(sect, batchStart, end, lineCount, errsum);
+            }
+            // --- module variables are only read here on the calling thread
+            if ( *sect == s_CONDUIT )
+            {
+                j = project_getInternalIndex(LINK, Mobjects[LINK] + nData);
+                batch[i].key = j;
+                batch[i].subIndex = LinkSubIndex ? LinkSubIndex[j] :
+                                    Mlinks[CONDUIT] + nData;
+            }
+            nData++;
+        }
+
+        // --- leave any lines after a section heading for the next batch
+        if ( i < n )
+        {
+            n = i;
+            pos = batch[n].pos;
+        }
+
+        // --- parse the lines of different objects in parallel
+#pragma omp parallel for num_threads(nThreads)
+        for (t = 0; t < nThreads; t++)
+        {
+            ActiveProject = project;
+            parseLines(*sect, t, nThreads, batch, n);
+        }
+        if ( *sect == s_CONDUIT )
+        {
+            Mobjects[LINK] += nData;
+            Mlinks[CONDUIT] += nData;
+        }
+
+        // --- report any errors found
+        for (i = 0; i < n; i++)
+        {
+            lineCount++;
+            if ( batch[i].err <= 0 ) continue;
+            (*errsum)++;
+            if ( *errsum > MAXERRS )
+            {
+                report_writeLine(FMT19);
+                return TRUE;
+            }
+            t = error_setInpError(batch[i].err, batch[i].errString);
+            getLine(&batch[i].pos, end, line);
+            report_writeInputErrorMsg(t, *sect, line, lineCount);
+        }
+    }
+    return FALSE;
+}
+
+//=============================================================================
+
+void prepareLine(int sect, TInpLine* line)
+//
+//  Input:   sect = current section of input file
+//           line = a line of input
+//  Output:  none
+//  Purpose: splits a line of input into tokens and finds the index of the
+//           object that the line refers to.
+//
+{
+    line->ntoks = splitTokens(line->text, line->tok);
+    line->key = -1;
+    line->err = 0;
+    if ( line->ntoks == 0 ) return;
+    switch ( sect )
+    {
+      case s_XSECTION:
+        line->key = project_findObject(LINK, line->tok[0]);
+        break;
+      case s_TIMESERIES:
+        line->key = project_findObject(TSERIES, line->tok[0]);
+        break;
+    }
+}
+
+//=============================================================================
+
+void parseLines(int sect, int thread, int nThreads, TInpLine* batch, int n)
+//
+//  Input:   sect = current section of input file
+//           thread = index of the calling thread
+//           nThreads = number of threads parsing the batch
+//           batch = a batch of input lines
+//           n = number of lines in the batch
+//  Output:  none
+//  Purpose: parses the lines of a batch that are assigned to a thread.
+//
+//  NOTE: this runs on worker threads, whose copies of this module's
+//        thread-local variables are not those of the calling thread, so
+//        everything it needs is stored with each line.
+//
+{
+    int i;
+    TInpLine* line;
+
+    for (i = 0; i < n; i++)
+    {
+        // --- skip lines assigned to other threads
+        line = &batch[i];
+        if ( line->ntoks == 0 || *line->tok[0] == ';' ) continue;
+        if ( MAX(line->key, 0) % nThreads != thread ) continue;
+
+        // --- parse the line's tokens
+        switch ( sect )
+        {
+          case s_CONDUIT:
+            line->err = link_readParams(line->key, CONDUIT, line->subIndex,
+                                        line->tok, line->ntoks);
+            break;
+          case s_XSECTION:
+            line->err = link_readXsectParams(line->tok, line->ntoks);
+            break;
+          case s_TIMESERIES:
+            line->err = table_readTimeseries(line->tok, line->ntoks);
+            break;
+        }
+        if ( line->err > 0 ) sstrncpy(line->errString, ErrString, 255);
+    }
 }
 
 //=============================================================================
@@ -391,7 +838,7 @@ int  addObject(int objType, char* id)
             Nobjects[CURVE]++;
 
             // --- check for a conduit shape curve
-            id = strtok(NULL, SEPSTR);
+            id = sstrtok(NULL, SEPSTR);
             if ( findmatch(id, CurveTypeWords) == SHAPE_CURVE )
                 Nobjects[SHAPE]++;
         }
@@ -416,7 +863,7 @@ int  addObject(int objType, char* id)
         // --- for TRANSECTS, ID name appears as second entry on X1 line
         if ( match(id, "X1") )
         {
-            id = strtok(NULL, SEPSTR);
+            id = sstrtok(NULL, SEPSTR);
             if ( id ) 
             {
                 if ( !project_addObject(TRANSECT, id, Nobjects[TRANSECT]) )
@@ -461,6 +908,93 @@ int  addObject(int objType, char* id)
 
 //=============================================================================
 
+int addSection(int sect, size_t start, long lineCount)
+//
+//  Input:   sect = input section type
+//           start = file offset of first line after section's heading
+//           lineCount = number of lines before the first line
+//  Output:  returns TRUE if successful, FALSE if out of memory
+//  Purpose: adds a new section to the index of the input file's sections.
+//
+{
+    TInpSection* sections;
+
+    if ( Nsections == MaxSections )
+    {
+        MaxSections = MAX(2 * MaxSections, 64);
+        sections = (TInpSection *) realloc(Sections,
+                                           MaxSections * sizeof(TInpSection));
+        if ( sections == NULL ) return FALSE;
+        Sections = sections;
+    }
+    Sections[Nsections].sect = sect;
+    Sections[Nsections].start = start;
+    Sections[Nsections].end = start;
+    Sections[Nsections].lineCount = lineCount;
+    Nsections++;
+    return TRUE;
+}
+
+//=============================================================================
+
+int isCounted(int sect)
+//
+//  Input:   sect = input section type
+//  Output:  returns TRUE if section's lines are used when counting objects
+//  Purpose: identifies the sections that define objects or options.
+//
+{
+    switch ( sect )
+    {
+      case s_OPTION:     case s_RAINGAGE:  case s_SUBCATCH:  case s_AQUIFER:
+      case s_UNITHYD:    case s_SNOWMELT:  case s_JUNCTION:  case s_OUTFALL:
+      case s_STORAGE:    case s_DIVIDER:   case s_CONDUIT:   case s_PUMP:
+      case s_ORIFICE:    case s_WEIR:      case s_OUTLET:    case s_POLLUTANT:
+      case s_LANDUSE:    case s_PATTERN:   case s_CURVE:     case s_TIMESERIES:
+      case s_CONTROL:    case s_TRANSECT:  case s_LID_CONTROL:
+      case s_EVENT:      case s_STREET:    case s_INLET:
+        return TRUE;
+      default: return FALSE;
+    }
+}
+
+//=============================================================================
+
+int isRead(int sect)
+//
+//  Input:   sect = input section type
+//  Output:  returns TRUE if section's lines are parsed when reading data
+//  Purpose: identifies the sections whose data are used by the simulation.
+//
+//  Options are read when objects are counted while map & display data
+//  are only used by the GUI.
+//
+{
+    switch ( sect )
+    {
+      case s_OPTION:     case s_COORDINATE: case s_VERTICES: case s_POLYGON:
+      case s_LABEL:      case s_SYMBOL:     case s_BACKDROP: case s_TAG:
+      case s_PROFILE:    case s_MAP:
+        return FALSE;
+      default: return TRUE;
+    }
+}
+
+//=============================================================================
+
+int isReadInParallel(int sect)
+//
+//  Input:   sect = input section type
+//  Output:  returns TRUE if section's lines can be parsed in parallel
+//  Purpose: identifies the sections whose lines only change the object
+//           they refer to.
+//
+{
+    return sect == s_CONDUIT || sect == s_XSECTION || sect == s_TIMESERIES;
+}
+
+//=============================================================================
+
 int  parseLine(int sect, char *line)
 //
 //  Input:   sect  = current section of input file
@@ -725,8 +1259,8 @@ int readNode(int type)
 //  Purpose: reads data for a node from a line of input.
 //
 {
-    int j = Mobjects[NODE];
-    int k = Mnodes[type];
+    int j = project_getInternalIndex(NODE, Mobjects[NODE]);
+    int k = NodeSubIndex ? NodeSubIndex[j] : Mnodes[type];
     int err = node_readParams(j, type, k, Tok, Ntokens);
     Mobjects[NODE]++;
     Mnodes[type]++;
@@ -742,8 +1276,8 @@ int readLink(int type)
 //  Purpose: reads data for a link from a line of input.
 //
 {
-    int j = Mobjects[LINK];
-    int k = Mlinks[type];
+    int j = project_getInternalIndex(LINK, Mobjects[LINK]);
+    int k = LinkSubIndex ? LinkSubIndex[j] : Mlinks[type];
     int err = link_readParams(j, type, k, Tok, Ntokens);
     Mobjects[LINK]++;
     Mlinks[type]++;
@@ -752,6 +1286,123 @@ int readLink(int type)
 
 //=============================================================================
 
+int renumberObjects()
+//
+//  Input:   none
+//  Output:  returns an error code
+//  Purpose: renumbers nodes & links so that connected objects lie close
+//           together in memory.
+//
+//  The node & link sections of the input file are scanned for the end
+//  nodes of each link before any object data are read, so that the objects
+//  are created at their new index positions. Node & link sub-types (e.g.
+//  Conduit or Storage arrays) follow the same order.
+//
+{
+    char  line[MAXLINE+1];             // line from input data file
+    char* tok[3];                      // ID names of link & its end nodes
+    int   sect;                        // input data section
+    int   nNodes = Nobjects[NODE];
+    int   nLinks = Nobjects[LINK];
+    int   i, j, r, errcode = 0;
+    size_t pos;                        // file offset of next line
+    int   *node1, *node2, *nodeType, *linkType, *nodeOrder, *linkOrder;
+    char  *isOutfall;
+
+    if ( nNodes == 0 || nLinks == 0 ) return 0;
+    node1     = (int *) calloc(nLinks, sizeof(int));
+    node2     = (int *) calloc(nLinks, sizeof(int));
+    linkType  = (int *) calloc(nLinks, sizeof(int));
+    linkOrder = (int *) calloc(nLinks, sizeof(int));
+    nodeType  = (int *) calloc(nNodes, sizeof(int));
+    nodeOrder = (int *) calloc(nNodes, sizeof(int));
+    isOutfall = (char *) calloc(nNodes, sizeof(char));
+    if ( node1 == NULL || node2 == NULL || linkType == NULL ||
+         linkOrder == NULL || nodeType == NULL || nodeOrder == NULL ||
+         isOutfall == NULL ) errcode = ERR_MEMORY;
+
+    // --- find the type of each node and link and the end nodes of each link
+    else
+    {
+        for (i = 0; i < nLinks; i++) node1[i] = node2[i] = -1;
+        for (r = 0; r < Nsections; r++)
+        {
+            sect = Sections[r].sect;
+            if ( sect < s_JUNCTION || sect > s_OUTLET ) continue;
+            pos = Sections[r].start;
+            while ( getLine(&pos, Sections[r].end, line) )
+            {
+                tok[0] = sstrtok(line, SEPSTR);
+                if ( tok[0] == NULL || *tok[0] == ';' ) continue;
+                switch ( sect )
+                {
+                  case s_JUNCTION: case s_OUTFALL: case s_STORAGE:
+                  case s_DIVIDER:
+                    j = project_findObject(NODE, tok[0]);
+                    if ( j < 0 ) break;
+                    nodeType[j] = sect - s_JUNCTION;
+                    isOutfall[j] = (sect == s_OUTFALL);
+                    break;
+
+                  case s_CONDUIT: case s_PUMP: case s_ORIFICE: case s_WEIR:
+                  case s_OUTLET:
+                    j = project_findObject(LINK, tok[0]);
+                    tok[1] = sstrtok(NULL, SEPSTR);
+                    tok[2] = sstrtok(NULL, SEPSTR);
+                    if ( j < 0 || tok[2] == NULL ) break;
+                    linkType[j] = sect - s_CONDUIT;
+                    node1[j] = project_findObject(NODE, tok[1]);
+                    node2[j] = project_findObject(NODE, tok[2]);
+                    break;
+                }
+            }
+        }
+
+        // --- find the new order of nodes & links and apply it
+        errcode = toposort_renumber(Renumber, nNodes, nLinks, node1, node2,
+                                    isOutfall, nodeOrder, linkOrder);
+        if ( !errcode )
+        {
+            project_renumberObjects(NODE, nodeOrder);
+            project_renumberObjects(LINK, linkOrder);
+            NodeSubIndex = createSubIndexes(nNodes, nodeOrder, nodeType);
+            LinkSubIndex = createSubIndexes(nLinks, linkOrder, linkType);
+            if ( NodeSubIndex == NULL || LinkSubIndex == NULL )
+                errcode = ERR_MEMORY;
+        }
+    }
+    FREE(node1);
+    FREE(node2);
+    FREE(linkType);
+    FREE(linkOrder);
+    FREE(nodeType);
+    FREE(nodeOrder);
+    FREE(isOutfall);
+    return errcode;
+}
+
+//=============================================================================
+
+int* createSubIndexes(int n, int order[], int subType[])
+//
+//  Input:   n = number of objects
+//           order = input file position of the object at each new index
+//           subType = sub-type of each object (by input file position)
+//  Output:  returns an array of sub-type indexes (by new index)
+//  Purpose: numbers the objects of each sub-type in their new order.
+//
+{
+    int i, count[MAX(MAX_NODE_TYPES, MAX_LINK_TYPES)];
+    int* subIndex = (int *) calloc(n, sizeof(int));
+
+    if ( subIndex == NULL ) return NULL;
+    for (i = 0; i < MAX(MAX_NODE_TYPES, MAX_LINK_TYPES); i++) count[i] = 0;
+    for (i = 0; i < n; i++) subIndex[i] = count[subType[order[i]]]++;
+    return subIndex;
+}
+
+//=============================================================================
+
 int  readEvent(char* tok[], int ntoks)
 {
     DateTime x[4];
@@ -886,6 +1537,19 @@ int  getTokens(char *s)
 //  Purpose: scans a string for tokens, saving pointers to them
 //           in shared variable Tok[].
 //
+{
+    return splitTokens(s, Tok);
+}
+
+//=============================================================================
+
+int  splitTokens(char *s, char *tok[])
+//
+//  Input:   s = a character string
+//  Output:  tok = array of MAXTOKS pointers to the tokens found in s,
+//           returns number of tokens found in s
+//  Purpose: scans a string for tokens.
+//
 //  Notes:   Tokens can be separated by the characters listed in SEPSTR
 //           (spaces, tabs, newline, carriage return) which is defined
 //           in CONSTS.H. Text between quotes is treated as a single token.
@@ -896,7 +1560,7 @@ int  getTokens(char *s)
     char *c;
 
     // --- begin with no tokens
-    for (n = 0; n < MAXTOKS; n++) Tok[n] = NULL;
+    for (n = 0; n < MAXTOKS; n++) tok[n] = NULL;
     n = 0;
 
     // --- truncate s at start of comment 
@@ -918,7 +1582,7 @@ int  getTokens(char *s)
                 m = (int)strcspn(s,"\"\n"); // find end quote or new line
             }
             s[m] = '\0';                    // null-terminate the token
-            Tok[n] = s;                     // save pointer to token 
+            tok[n] = s;                     // save pointer to token 
             n++;                            // update token count
             s += m+1;                       // begin next token
         }
@@ -928,3 +1592,69 @@ int  getTokens(char *s)
 }
 
 //=============================================================================
+
+int  getLine(size_t* pos, size_t end, char* line)
+//
+//  Input:   pos = file offset of next line of the mapped input file
+//           end = file offset where reading stops
+//  Output:  pos = file offset of the line that follows,
+//           line = contents of the line (at most MAXLINE-1 characters),
+//           returns 1 if a line was read, 0 if pos has reached end
+//  Purpose: reads the next line of the memory-mapped input file.
+//
+//  Notes:   Lines are read in the same way as by fgets(line, MAXLINE, ...)
+//           so that a line too long to fit in the buffer is split into
+//           several lines and line numbers in error messages are unchanged.
+//
+{
+    const char* s;                     // start of line in mapped file
+    size_t n;                          // number of characters left to read
+    size_t k = 0;                      // number of characters in line
+
+    if ( *pos >= end ) return 0;
+    s = InpFile.data + *pos;
+    n = end - *pos;
+
+#if defined(_WIN32) || defined(__WIN32__)
+    // --- replace CR-LF line endings as a file opened in text mode would
+    {
+        size_t i = 0;
+        while ( i < n && k < MAXLINE - 1 )
+        {
+            if ( s[i] == '\r' && i + 1 < n && s[i+1] == '\n' ) i++;
+            line[k++] = s[i++];
+            if ( line[k-1] == '\n' ) break;
+        }
+        n = i;
+    }
+#else
+    {
+        const char* eol;
+        k = MIN(n, (size_t)(MAXLINE - 1));
+        eol = (const char *)memchr(s, '\n', k);
+        if ( eol ) k = eol - s + 1;
+        memcpy(line, s, k);
+        n = k;
+    }
+#endif
+    line[k] = '\0';
+    *pos += n;
+    return 1;
+}
+
+//=============================================================================
+
+void closeInpFile()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: frees the memory-mapped input file and its section index.
+//
+{
+    mapfile_close(&InpFile);
+    FREE(Sections);
+    Nsections = 0;
+    MaxSections = 0;
+}
+
+//=============================================================================
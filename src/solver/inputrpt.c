@@ -12,6 +12,8 @@
 //   ==============
 //   Build 5.2.0:
 //   - Support added for reporting Street geometry tables.
+//   Build 5.2.4 (OWA):
+//   - Nodes & links listed in input file order when renumbered.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -32,7 +34,7 @@ void inputrpt_writeInput()
 //
 {
     int m;
-    int i, k;
+    int i, j, k;
     int lidCount = 0;
     if ( ErrorCode ) return;
 
@@ -163,8 +165,9 @@ void inputrpt_writeInput()
 "\n  Name                 Type                 Elev.     Depth      Area    Inflow  ");
         fprintf(Frpt.file,
 "\n  -------------------------------------------------------------------------------");
-        for (i = 0; i < Nobjects[NODE]; i++)
+        for (j = 0; j < Nobjects[NODE]; j++)
         {
+            i = project_getInternalIndex(NODE, j);
             fprintf(Frpt.file, "\n  %-20s %-16s%10.2f%10.2f%10.1f", Node[i].ID,
                 NodeTypeWords[Node[i].type-JUNCTION],
                 Node[i].invertElev*UCF(LENGTH),
@@ -188,8 +191,9 @@ void inputrpt_writeInput()
 "\n  Name             From Node        To Node          Type            Length    %%Slope Roughness");
         fprintf(Frpt.file,
 "\n  ---------------------------------------------------------------------------------------------");
-        for (i = 0; i < Nobjects[LINK]; i++)
+        for (j = 0; j < Nobjects[LINK]; j++)
         {
+            i = project_getInternalIndex(LINK, j);
             // --- list end nodes in their original orientation
             if ( Link[i].direction == 1 )
                 fprintf(Frpt.file, "\n  %-16s %-16s %-16s ",
@@ -230,8 +234,9 @@ void inputrpt_writeInput()
 "\n  Conduit          Shape               Depth     Area     Rad.    Width  Barrels     Flow");
         fprintf(Frpt.file,
 "\n  ---------------------------------------------------------------------------------------");
-        for (i = 0; i < Nobjects[LINK]; i++)
+        for (j = 0; j < Nobjects[LINK]; j++)
         {
+            i = project_getInternalIndex(LINK, j);
             if (Link[i].type == CONDUIT)
             {
                 k = Link[i].subIndex;
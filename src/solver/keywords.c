@@ -36,6 +36,15 @@
 //   - Support added for RptFlags.disabled option.
 //   Build 5.2.1:
 //   - Adds NONE to the list of NormalFlowWords.
+//   Build 5.2.4 (OWA):
+//   - New option keyword w_RENUMBER and RenumberWords added.
+//   - New option keywords w_ACTIVE_SET, w_STEP_CLASSES and w_MIN_PARALLEL
+//     added.
+//   - New option keyword w_GEOM_CACHE added.
+//   - New option keyword w_TSERIES_CACHE added.
+//   - New report keyword w_VARIABLES and SubcatchVarWords, NodeVarWords
+//     and LinkVarWords added.
+//   - New option keyword w_COMPRESS_OUTPUT added.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -63,9 +72,13 @@ char* InertDampingWords[]  = { w_NONE, w_PARTIAL, w_FULL, NULL};
 char* LinkOffsetWords[]    = { w_DEPTH, w_ELEVATION, NULL};
 char* LinkTypeWords[]      = { w_CONDUIT, w_PUMP, w_ORIFICE,
                                w_WEIR, w_OUTLET };
+char* LinkVarWords[]       = { w_FLOW, w_DEPTH, w_VELOCITY, w_VOLUME,
+                               w_CAPACITY, w_QUALITY, NULL};
 char* LoadUnitsWords[]     = { w_LBS, w_KG, w_LOGN };
 char* NodeTypeWords[]      = { w_JUNCTION, w_OUTFALL,
                                w_STORAGE, w_DIVIDER };
+char* NodeVarWords[]       = { w_DEPTH, w_HEAD, w_VOLUME, w_LATERAL_INFLOW,
+                               w_TOTAL_INFLOW, w_FLOODING, w_QUALITY, NULL};
 char* NoneAllWords[]       = { w_NONE, w_ALL, NULL};
 char* NormalFlowWords[]    = { w_SLOPE, w_FROUDE, w_BOTH, w_NONE, NULL};
 char* NormalizerWords[]    = { w_PER_AREA, w_PER_CURB, NULL};
@@ -94,7 +107,10 @@ char* OptionWords[]        = { w_FLOW_UNITS,        w_INFIL_MODEL,
                                w_SYS_FLOW_TOL,      w_LAT_FLOW_TOL,
                                w_IGNORE_RDII,       w_MIN_ROUTE_STEP,
                                w_NUM_THREADS,       w_SURCHARGE_METHOD,
-                               NULL };
+                               w_RENUMBER,          w_ACTIVE_SET,
+                               w_STEP_CLASSES,      w_MIN_PARALLEL,
+                               w_GEOM_CACHE,        w_TSERIES_CACHE,
+                               w_COMPRESS_OUTPUT,   NULL };
 char* OrificeTypeWords[]   = { w_SIDE, w_BOTTOM, NULL};
 char* OutfallTypeWords[]   = { w_FREE, w_NORMAL, w_FIXED, w_TIDAL,
                                w_TIMESERIES, NULL};
@@ -110,7 +126,7 @@ char* RelationWords[]      = { w_TABULAR, w_FUNCTIONAL,
                                w_PYRAMIDAL, NULL};
 char* ReportWords[]        = { w_DISABLED, w_INPUT, w_SUBCATCH, w_NODE, w_LINK,
                                w_CONTINUITY, w_FLOWSTATS,w_CONTROLS,
-                               w_AVERAGES, w_NODESTATS, NULL};
+                               w_AVERAGES, w_NODESTATS, w_VARIABLES, NULL};
 char* RouteModelWords[]    = { w_NONE, w_STEADY, w_KINWAVE, w_XKINWAVE,
                                w_DYNWAVE, NULL};
 char* RuleKeyWords[]       = { w_RULE, w_IF, w_AND, w_OR, w_THEN, w_ELSE, 
@@ -145,7 +161,11 @@ char* SectWords[]          = { ws_TITLE,          ws_OPTION,
                                ws_STREET,         ws_INLET_USAGE,
                                ws_INLET,          NULL};
 char* SnowmeltWords[]      = { w_PLOWABLE, w_IMPERV, w_PERV, w_REMOVAL, NULL};
+char* SubcatchVarWords[]   = { w_RAINFALL, w_SNOW_DEPTH, w_EVAP, w_INFIL,
+                               w_RUNOFF, w_GW_FLOW, w_GW_ELEV, w_SOIL_MOIST,
+                               w_QUALITY, NULL};
 char* SurchargeWords[]     = { w_EXTRAN, w_SLOT, NULL};
+char* RenumberWords[]      = { w_NONE, w_BFS, w_RCM, NULL};
 char* TempKeyWords[]       = { w_TIMESERIES, w_FILE, w_WINDSPEED, w_SNOWMELT,
                                w_ADC, NULL};
 char* TransectKeyWords[]   = { w_NC, w_X1, w_GR, NULL};
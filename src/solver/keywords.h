@@ -14,6 +14,8 @@
 //   - Keyword arrays listed in alphabetical order.
 //   Build 5.1.013:
 //   - New keyword array defined for surcharge method.
+//   Build 5.2.4 (OWA):
+//   - New keyword arrays defined for reported result variables.
 //-----------------------------------------------------------------------------
 
 #ifndef KEYWORDS_H
@@ -34,8 +36,10 @@ extern char* InertDampingWords[];
 extern char* InfilModelWords[];
 extern char* LinkOffsetWords[];
 extern char* LinkTypeWords[];
+extern char* LinkVarWords[];
 extern char* LoadUnitsWords[];
 extern char* NodeTypeWords[];
+extern char* NodeVarWords[];
 extern char* NoneAllWords[];
 extern char* NormalFlowWords[];
 extern char* NormalizerWords[];
@@ -58,7 +62,9 @@ extern char* RouteModelWords[];
 extern char* RuleKeyWords[];
 extern char* SectWords[];
 extern char* SnowmeltWords[];
+extern char* SubcatchVarWords[];
 extern char* SurchargeWords[];
+extern char* RenumberWords[];
 extern char* TempKeyWords[];
 extern char* TransectKeyWords[];
 extern char* TreatTypeWords[];
@@ -34,12 +34,12 @@ static const double EPSIL   = 0.001;   // convergence criterion
 //-----------------------------------------------------------------------------
 //  Shared variables
 //-----------------------------------------------------------------------------
-static double   Beta1;
-static double   C1;
-static double   C2;
-static double   Afull;
-static double   Qfull;
-static TXsect*  pXsect;
+static SWMM_TLS double   Beta1;
+static SWMM_TLS double   C1;
+static SWMM_TLS double   C2;
+static SWMM_TLS double   Afull;
+static SWMM_TLS double   Qfull;
+static SWMM_TLS TXsect*  pXsect;
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
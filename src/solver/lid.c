@@ -72,6 +72,8 @@
 //   - Fixed double counting of initial water volume in green roof drain mat.
 //   Build 5.2.4
 //   - Fixed test for invalid data in readDrainData function.
+//   Build 5.2.4 (OWA):
+//   - LID objects allocated from a memory pool freed with the project.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -126,29 +128,28 @@ char* LidTypeWords[] =
 //-----------------------------------------------------------------------------
 //  Shared Variables
 //-----------------------------------------------------------------------------
-static TLidProc*  LidProcs;            // array of LID processes
-static int        LidCount;            // number of LID processes
-static TLidGroup* LidGroups;           // array of LID process groups
-static int        GroupCount;          // number of LID groups (subcatchments)
+// (held in the project context, see globals.h)
+#define LidProcs    (ActiveProject->lid.LidProcs)
+#define LidCount    (ActiveProject->lid.LidCount)
+#define LidGroups   (ActiveProject->lid.LidGroups)
+#define GroupCount  (ActiveProject->lid.GroupCount)
 
-static double     EvapRate;            // evaporation rate (ft/s)
-static double     NativeInfil;         // native soil infil. rate (ft/s)
-static double     MaxNativeInfil;      // native soil infil. rate limit (ft/s)
+static SWMM_TLS double     EvapRate;            // evaporation rate (ft/s)
+static SWMM_TLS double     NativeInfil;         // native soil infil. rate (ft/s)
+static SWMM_TLS double     MaxNativeInfil;      // native soil infil. rate limit (ft/s)
 
 //-----------------------------------------------------------------------------
 //  Imported Variables (from SUBCATCH.C)
 //-----------------------------------------------------------------------------
 // Volumes (ft3) for a subcatchment over a time step 
-extern double     Vevap;               // evaporation
-extern double     Vpevap;              // pervious area evaporation
-extern double     Vinfil;              // non-LID infiltration
-extern double     VlidInfil;           // infiltration from LID units
-extern double     VlidIn;              // impervious area flow to LID units
-extern double     VlidOut;             // surface outflow from LID units
-extern double     VlidDrain;           // drain outflow from LID units
-extern double     VlidReturn;          // LID outflow returned to pervious area
-extern char       HasWetLids;          // TRUE if any LIDs are wet
-                                       // (from RUNOFF.C)
+extern SWMM_TLS double     Vevap;               // evaporation
+extern SWMM_TLS double     Vpevap;              // pervious area evaporation
+extern SWMM_TLS double     Vinfil;              // non-LID infiltration
+extern SWMM_TLS double     VlidInfil;           // infiltration from LID units
+extern SWMM_TLS double     VlidIn;              // impervious area flow to LID units
+extern SWMM_TLS double     VlidOut;             // surface outflow from LID units
+extern SWMM_TLS double     VlidDrain;           // drain outflow from LID units
+extern SWMM_TLS double     VlidReturn;          // LID outflow returned to pervious area
 
 //-----------------------------------------------------------------------------
 //  External Functions (prototyped in lid.h)
@@ -243,7 +244,8 @@ void lid_create(int lidCount, int subcatchCount)
     GroupCount = subcatchCount;
     if ( GroupCount > 0 )
     {
-        LidGroups = (TLidGroup *) calloc(GroupCount, sizeof(TLidGroup));
+        LidGroups = (TLidGroup *) project_alloc(LID, GroupCount,
+                                                sizeof(TLidGroup));
         if ( LidGroups == NULL )
         {
             ErrorCode = ERR_MEMORY;
@@ -256,7 +258,7 @@ void lid_create(int lidCount, int subcatchCount)
     
     //... create LID objects
     if ( LidCount == 0 ) return;
-    LidProcs = (TLidProc *) calloc(LidCount, sizeof(TLidProc));
+    LidProcs = (TLidProc *) project_alloc(LID, LidCount, sizeof(TLidProc));
     if ( LidProcs == NULL )
     {
         ErrorCode = ERR_MEMORY;
@@ -281,8 +283,8 @@ void lid_create(int lidCount, int subcatchCount)
         LidProcs[j].drainMat.roughness = 0.0;
         LidProcs[j].drainRmvl = NULL;
         LidProcs[j].drainRmvl = (double *)
-                                calloc(Nobjects[POLLUT], sizeof(double));
-        if (LidProcs[j].drainRmvl == NULL)
+                                project_alloc(LID, Nobjects[POLLUT], sizeof(double));
+        if (Nobjects[POLLUT] > 0 && LidProcs[j].drainRmvl == NULL)
         {
             ErrorCode = ERR_MEMORY;
             return;
@@ -301,9 +303,8 @@ void lid_delete()
 {
     int j;
     for (j = 0; j < GroupCount; j++) freeLidGroup(j);
-    FREE(LidGroups);
-    for (j = 0; j < LidCount; j++) FREE(LidProcs[j].drainRmvl);
-    FREE(LidProcs);
+    LidGroups = NULL;
+    LidProcs = NULL;
     GroupCount = 0;
     LidCount = 0;
 }
@@ -312,7 +313,8 @@ void lid_delete()
 
 void freeLidGroup(int j)
 //
-//  Purpose: frees all LID units associated with a subcatchment.
+//  Purpose: closes the report files of all LID units associated with a
+//           subcatchment (the units are freed with the LID memory pool).
 //  Input:   j = group (or subcatchment) index
 //  Output:  none
 //
@@ -320,24 +322,19 @@ void freeLidGroup(int j)
     TLidGroup  lidGroup = LidGroups[j];
     TLidList*  lidList;
     TLidUnit*  lidUnit;
-    TLidList*  nextLidUnit;
 
     if ( lidGroup == NULL ) return;
     lidList = lidGroup->lidList;
     while (lidList)
     {
         lidUnit = lidList->lidUnit;
-        if ( lidUnit->rptFile )
+        if ( lidUnit->rptFile && lidUnit->rptFile->file )
         {
-            if ( lidUnit->rptFile->file ) fclose(lidUnit->rptFile->file);
-            free(lidUnit->rptFile);
+            fclose(lidUnit->rptFile->file);
+            lidUnit->rptFile->file = NULL;
         }
-        nextLidUnit = lidList->nextLidUnit;
-        free(lidUnit);
-        free(lidList);
-        lidList = nextLidUnit;
+        lidList = lidList->nextLidUnit;
     }
-    free(lidGroup);
     LidGroups[j] = NULL;
 }
 
@@ -510,24 +507,21 @@ int addLidUnit(int j, int k, int n, double x[], char* fname,
     lidGroup = LidGroups[j];
     if ( !lidGroup )
     {
-        lidGroup = (struct LidGroup *) malloc(sizeof(struct LidGroup));
+        lidGroup = (struct LidGroup *) project_alloc(LID, 1,
+                                                     sizeof(struct LidGroup));
         if ( !lidGroup ) return error_setInpError(ERR_MEMORY, "");
         lidGroup->lidList = NULL;
         LidGroups[j] = lidGroup;
     }
 
     //... create a new LID unit to add to the group
-    lidUnit = (TLidUnit *) malloc(sizeof(TLidUnit));
+    lidUnit = (TLidUnit *) project_alloc(LID, 1, sizeof(TLidUnit));
     if ( !lidUnit ) return error_setInpError(ERR_MEMORY, "");
     lidUnit->rptFile = NULL;
 
     //... add the LID unit to the group
-    lidList = (TLidList *) malloc(sizeof(TLidList));
-    if ( !lidList )
-    {
-        free(lidUnit);
-        return error_setInpError(ERR_MEMORY, "");
-    }
+    lidList = (TLidList *) project_alloc(LID, 1, sizeof(TLidList));
+    if ( !lidList ) return error_setInpError(ERR_MEMORY, "");
     lidList->lidUnit = lidUnit;
     lidList->nextLidUnit = lidGroup->lidList;
     lidGroup->lidList = lidList;
@@ -559,7 +553,7 @@ int createLidRptFile(TLidUnit* lidUnit, char* fname)
 {
     TLidRptFile* rptFile;
     
-    rptFile = (TLidRptFile *) malloc(sizeof(TLidRptFile));
+    rptFile = (TLidRptFile *) project_alloc(LID, 1, sizeof(TLidRptFile));
     if ( rptFile == NULL ) return 0;
     lidUnit->rptFile = rptFile;
     rptFile->file = fopen(fname, "wt");
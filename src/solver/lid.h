@@ -132,7 +132,7 @@ typedef struct
 }  TDrainMatLayer;
 
 // LID Process - generic LID design per unit of area
-typedef struct
+typedef struct TLidProc
 {
     char*          ID;            // identifying name
     int            lidType;       // type of LID
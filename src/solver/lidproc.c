@@ -98,42 +98,37 @@ enum LidRptVars {
     STOR_DEPTH,              // water level in storage layer
     MAX_RPT_VARS};
 
-//-----------------------------------------------------------------------------
-//  Imported variables 
-//-----------------------------------------------------------------------------
-extern char HasWetLids;      // TRUE if any LIDs are wet (declared in runoff.c)
-
 //-----------------------------------------------------------------------------
 //  Local Variables
 //-----------------------------------------------------------------------------
-static TLidUnit*  theLidUnit;     // ptr. to a subcatchment's LID unit
-static TLidProc*  theLidProc;     // ptr. to a LID process
-
-static double     Tstep;          // current time step (sec)
-static double     EvapRate;       // evaporation rate (ft/s)
-static double     MaxNativeInfil; // native soil infil. rate limit (ft/s)
-
-static double     SurfaceInflow;  // precip. + runon to LID unit (ft/s)
-static double     SurfaceInfil;   // infil. rate from surface layer (ft/s)
-static double     SurfaceEvap;    // evap. rate from surface layer (ft/s)
-static double     SurfaceOutflow; // outflow from surface layer (ft/s)
-static double     SurfaceVolume;  // volume in surface storage (ft)
-
-static double     PaveEvap;       // evap. from pavement layer (ft/s)
-static double     PavePerc;       // percolation from pavement layer (ft/s)
-static double     PaveVolume;     // volume stored in pavement layer  (ft)
-
-static double     SoilEvap;       // evap. from soil layer (ft/s)
-static double     SoilPerc;       // percolation from soil layer (ft/s)
-static double     SoilVolume;     // volume in soil/pavement storage (ft)
-
-static double     StorageInflow;  // inflow rate to storage layer (ft/s)
-static double     StorageExfil;   // exfil. rate from storage layer (ft/s)
-static double     StorageEvap;    // evap.rate from storage layer (ft/s)
-static double     StorageDrain;   // underdrain flow rate layer (ft/s)
-static double     StorageVolume;  // volume in storage layer (ft)
-
-static double     Xold[MAX_LAYERS];  // previous moisture level in LID layers
+static SWMM_TLS TLidUnit*  theLidUnit;     // ptr. to a subcatchment's LID unit
+static SWMM_TLS TLidProc*  theLidProc;     // ptr. to a LID process
+
+static SWMM_TLS double     Tstep;          // current time step (sec)
+static SWMM_TLS double     EvapRate;       // evaporation rate (ft/s)
+static SWMM_TLS double     MaxNativeInfil; // native soil infil. rate limit (ft/s)
+
+static SWMM_TLS double     SurfaceInflow;  // precip. + runon to LID unit (ft/s)
+static SWMM_TLS double     SurfaceInfil;   // infil. rate from surface layer (ft/s)
+static SWMM_TLS double     SurfaceEvap;    // evap. rate from surface layer (ft/s)
+static SWMM_TLS double     SurfaceOutflow; // outflow from surface layer (ft/s)
+static SWMM_TLS double     SurfaceVolume;  // volume in surface storage (ft)
+
+static SWMM_TLS double     PaveEvap;       // evap. from pavement layer (ft/s)
+static SWMM_TLS double     PavePerc;       // percolation from pavement layer (ft/s)
+static SWMM_TLS double     PaveVolume;     // volume stored in pavement layer  (ft)
+
+static SWMM_TLS double     SoilEvap;       // evap. from soil layer (ft/s)
+static SWMM_TLS double     SoilPerc;       // percolation from soil layer (ft/s)
+static SWMM_TLS double     SoilVolume;     // volume in soil/pavement storage (ft)
+
+static SWMM_TLS double     StorageInflow;  // inflow rate to storage layer (ft/s)
+static SWMM_TLS double     StorageExfil;   // exfil. rate from storage layer (ft/s)
+static SWMM_TLS double     StorageEvap;    // evap.rate from storage layer (ft/s)
+static SWMM_TLS double     StorageDrain;   // underdrain flow rate layer (ft/s)
+static SWMM_TLS double     StorageVolume;  // volume in storage layer (ft)
+
+static SWMM_TLS double     Xold[MAX_LAYERS];  // previous moisture level in LID layers
 
 //-----------------------------------------------------------------------------
 //  External Functions (declared in lid.h)
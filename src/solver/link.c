@@ -48,6 +48,9 @@
 //   - Warning for conduit elevation drop < MIN_DELTA_Z restored.
 //   Build 5.2.4:
 //   - Conduit evap+seepage loss under DW routing limited by conduit volume.
+//   Build 5.2.4 (OWA):
+//   - Conduit assigned a geometry cache table when GEOMETRY_CACHE is in effect.
+//   - link_setOldQualState() replaced by qualrout_setOldState().
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -72,7 +75,6 @@ static const double MIN_DELTA_Z = 0.001; // minimum elevation change for conduit
 //  link_validate          (called by project_validate in project.c)
 //  link_initState         (called by initObjects in swmm5.c)
 //  link_setOldHydState    (called by routing_execute in routing.c)
-//  link_setOldQualState   (called by routing_execute in routing.c)
 //  link_setTargetSetting  (called by routing_execute in routing.c)
 //  link_setSetting        (called by routing_execute in routing.c)
 //  link_getResults        (called by output_saveLinkResults)
@@ -584,23 +586,6 @@ void link_setOldHydState(int j)
 
 //=============================================================================
 
-void link_setOldQualState(int j)
-//
-//  Input:   j = link index
-//  Output:  none
-//  Purpose: replaces link's old water quality state values with current ones.
-//
-{
-    int p;
-    for (p = 0; p < Nobjects[POLLUT]; p++)
-    {
-        Link[j].oldQual[p] = Link[j].newQual[p];
-        Link[j].newQual[p] = 0.0;
-    }
-}
-
-//=============================================================================
-
 void link_setTargetSetting(int j)
 //
 //  Input:   j = link index
@@ -1151,6 +1136,10 @@ void  conduit_validate(int j, int k)
          Link[j].cLossAvg    == 0.0
        ) Conduit[k].hasLosses = FALSE;
     else Conduit[k].hasLosses = TRUE;
+
+    // --- assign a table of tabulated cross section geometry
+    //     (done last since force main roughness factor is set above)
+    if ( GeomCache ) xsect_setGeomTable(&Link[j].xsect);
 }
 
 //=============================================================================
@@ -2565,8 +2554,8 @@ int outlet_readParams(int j, int k, char* tok[], int ntoks)
 
     // --- see if rating curve is head or depth based
     x[5] = NODE_DEPTH;                                //default is depth-based
-    s = strtok(tok[4], "/");                          //parse token for
-    s = strtok(NULL, "/");                            //  qualifier term
+    s = sstrtok(tok[4], "/");                         //parse token for
+    s = sstrtok(NULL, "/");                           //  qualifier term
     if ( strcomp(s, w_HEAD) ) x[5] = NODE_HEAD;       //check if its "HEAD"
 
     // --- get params. for functional outlet device
@@ -41,5 +41,60 @@
 //-------------------------------------------------
 #define CALL(x) (ErrorCode = ((ErrorCode>0) ? (ErrorCode) : (x)))
 
+//-------------------------------------------------
+// Storage class for variables private to a thread
+//-------------------------------------------------
+#ifdef _MSC_VER
+  #define SWMM_TLS __declspec(thread)
+  #define SWMM_TLS_FAST __declspec(thread)
+#else
+  #define SWMM_TLS __thread
+  // thread's active project pointer is read on every state access, so a
+  // static library uses the cheaper initial-exec TLS model (a shared one
+  // keeps the default model, as it may be loaded with dlopen, which can
+  // run out of static TLS space)
+  #ifdef SWMM_STATIC_LIB
+    #define SWMM_TLS_FAST __thread __attribute__((tls_model("initial-exec")))
+  #else
+    #define SWMM_TLS_FAST __thread
+  #endif
+#endif
+
+//-------------------------------------------------
+// Reentrant versions of API functions
+//-------------------------------------------------
+// Defines name_r, declared by decl with the parameters params (the first
+// being project handle p), which calls name(args) with p as the calling
+// thread's active project and returns its result of the given type.
+#define SWMM_REENTRANT(type, decl, name, params, args)                     \
+    decl name##_r params                                                  \
+    {                                                                     \
+        SWMM_Project* prevProject = swmm_useProject(p);                   \
+        type apiResult = name args;                                       \
+        swmm_useProject(prevProject);                                     \
+        return apiResult;                                                 \
+    }
+
+// Same as SWMM_REENTRANT for functions with no return value
+#define SWMM_REENTRANT_VOID(decl, name, params, args)                      \
+    decl name##_r params                                                  \
+    {                                                                     \
+        SWMM_Project* prevProject = swmm_useProject(p);                   \
+        name args;                                                        \
+        swmm_useProject(prevProject);                                     \
+    }
+
+//-------------------------------------------------
+// Large file support
+//-------------------------------------------------
+#ifdef _MSC_VER    // Windows (32-bit and 64-bit)
+  #define F_OFF __int64
+  #define F_SEEK _fseeki64
+#else              // Other platforms
+  #include <sys/types.h>
+  #define F_OFF off_t
+  #define F_SEEK fseeko
+#endif
+
 
 #endif //MACROS_H
@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+//  mapfile.c
+//
+//  Project:  EPA SWMM5
+//  Version:  5.2
+//  Date:     10/16/26   (Build 5.2.4 (OWA))
+//
+//  Read-only memory mapping of files.
+//
+//  mapfile_open()  - maps a file's contents into memory
+//  mapfile_close() - releases a mapped file
+//
+//  Files are mapped with mmap on POSIX systems and with a file mapping
+//  object on Windows. Elsewhere the file is simply read into memory.
+//  Pages of a mapped file are only read from disk as they are accessed.
+//-----------------------------------------------------------------------------
+#define _CRT_SECURE_NO_DEPRECATE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "macros.h"
+#include "mapfile.h"
+
+#if defined(_WIN32) || defined(__WIN32__)
+  #define MAPFILE_WINDOWS
+  #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+  #define MAPFILE_POSIX
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+//=============================================================================
+
+int mapfile_open(TMapFile* map, const char* fname)
+//
+//  Input:   map = pointer to a TMapFile structure
+//           fname = name of file to map
+//  Output:  returns 1 if successful, 0 if not
+//  Purpose: maps the contents of a file into memory.
+//
+//  NOTE: an empty file is mapped with a NULL data pointer.
+//
+{
+    map->data = NULL;
+    map->size = 0;
+    map->handle = NULL;
+
+#if defined(MAPFILE_WINDOWS)
+    {
+        HANDLE hFile, hMap;
+        LARGE_INTEGER size;
+
+        hFile = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if ( hFile == INVALID_HANDLE_VALUE ) return 0;
+        if ( !GetFileSizeEx(hFile, &size) )
+        {
+            CloseHandle(hFile);
+            return 0;
+        }
+        if ( size.QuadPart > 0 )
+        {
+            hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+            if ( hMap ) map->data = (char *)MapViewOfFile(hMap, FILE_MAP_READ,
+                                                          0, 0, 0);
+            CloseHandle(hFile);
+            if ( map->data == NULL )
+            {
+                if ( hMap ) CloseHandle(hMap);
+                return 0;
+            }
+            map->handle = hMap;
+        }
+        else CloseHandle(hFile);
+        map->size = (size_t)size.QuadPart;
+    }
+
+#elif defined(MAPFILE_POSIX)
+    {
+        int fd;
+        struct stat st;
+        void* p;
+
+        fd = open(fname, O_RDONLY);
+        if ( fd < 0 ) return 0;
+        if ( fstat(fd, &st) != 0 )
+        {
+            close(fd);
+            return 0;
+        }
+        if ( st.st_size > 0 )
+        {
+            p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if ( p == MAP_FAILED )
+            {
+                close(fd);
+                return 0;
+            }
+            map->data = (char *)p;
+        }
+        close(fd);
+        map->size = (size_t)st.st_size;
+    }
+
+#else
+    {
+        FILE* f;
+        long  size;
+
+        f = fopen(fname, "rb");
+        if ( f == NULL ) return 0;
+        if ( fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < 0 )
+        {
+            fclose(f);
+            return 0;
+        }
+        rewind(f);
+        if ( size > 0 )
+        {
+            map->data = (char *)malloc(size);
+            if ( map->data == NULL ||
+                 fread(map->data, 1, size, f) != (size_t)size )
+            {
+                FREE(map->data);
+                fclose(f);
+                return 0;
+            }
+        }
+        fclose(f);
+        map->size = (size_t)size;
+    }
+#endif
+    return 1;
+}
+
+//=============================================================================
+
+void mapfile_close(TMapFile* map)
+//
+//  Input:   map = pointer to a TMapFile structure
+//  Output:  none
+//  Purpose: releases the memory used by a mapped file.
+//
+{
+    if ( map->data )
+    {
+#if defined(MAPFILE_WINDOWS)
+        UnmapViewOfFile(map->data);
+        CloseHandle((HANDLE)map->handle);
+#elif defined(MAPFILE_POSIX)
+        munmap(map->data, map->size);
+#else
+        free(map->data);
+#endif
+    }
+    map->data = NULL;
+    map->size = 0;
+    map->handle = NULL;
+}
@@ -0,0 +1,25 @@
+//-----------------------------------------------------------------------------
+//  mapfile.h
+//
+//  Header for mapfile.c
+//
+//  A TMapFile provides read-only access to the contents of a file that is
+//  mapped into memory, or read into memory on platforms without mapping.
+//-----------------------------------------------------------------------------
+
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stddef.h>
+
+typedef struct
+{
+   char*   data;            // contents of the file
+   size_t  size;            // size of the file in bytes
+   void*   handle;          // platform-specific mapping handle
+}  TMapFile;
+
+int   mapfile_open(TMapFile* map, const char* fname);
+void  mapfile_close(TMapFile* map);
+
+#endif //MAPFILE_H
@@ -28,6 +28,8 @@
 //     nodes are when updating total outflow volume.
 //   Build 5.1.013:
 //   - Volume from MinSurfArea no longer included in initial & final storage.
+//   Build 5.2.4 (OWA):
+//   - System storage summed in parallel over fixed blocks of nodes & links.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -43,23 +45,15 @@ static const double MAX_RUNOFF_BALANCE_ERR = 10.0;
 static const double MAX_FLOW_BALANCE_ERR   = 10.0;
 
 //-----------------------------------------------------------------------------
-//  Shared variables   
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-TRunoffTotals    RunoffTotals;    // overall surface runoff continuity totals
-TLoadingTotals*  LoadingTotals;   // overall WQ washoff continuity totals
-TGwaterTotals    GwaterTotals;    // overall groundwater continuity totals 
-TRoutingTotals   FlowTotals;      // overall routed flow continuity totals 
-TRoutingTotals*  QualTotals;      // overall routed WQ continuity totals 
-TRoutingTotals   StepFlowTotals;  // routed flow totals over time step
-TRoutingTotals   OldStepFlowTotals;
-TRoutingTotals*  StepQualTotals;  // routed WQ totals over time step
-
-//-----------------------------------------------------------------------------
-//  Exportable variables
-//-----------------------------------------------------------------------------
-double*  NodeInflow;              // total inflow volume to each node (ft3)
-double*  NodeOutflow;             // total outflow volume from each node (ft3)
-double   TotalArea;               // total drainage area (ft2)
+#define RunoffTotals       (ActiveProject->massbal.RunoffTotals)
+#define LoadingTotals      (ActiveProject->massbal.LoadingTotals)
+#define GwaterTotals       (ActiveProject->massbal.GwaterTotals)
+#define FlowTotals         (ActiveProject->massbal.FlowTotals)
+#define QualTotals         (ActiveProject->massbal.QualTotals)
+#define OldStepFlowTotals  (ActiveProject->massbal.OldStepFlowTotals)
+#define TotalArea          (ActiveProject->massbal.TotalArea)
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
@@ -642,26 +636,56 @@ double massbal_getStorage(char isFinalStorage)
 //  Purpose: computes total system storage (nodes + links) filled
 //
 {
-    int    j;
+    int    nNodes = Nobjects[NODE];
+    int    nLinks = Nobjects[LINK];
+    int    nNodeBlocks = (nNodes + SUMBLOCK - 1) / SUMBLOCK;
+    int    nBlocks = nNodeBlocks;
     double totalStorage = 0.0;
-    double nodeStorage;
-
-    // --- get volume in nodes
-    for (j = 0; j < Nobjects[NODE]; j++)
-    {
-        nodeStorage = Node[j].newVolume;
-        if ( isFinalStorage ) NodeOutflow[j] += nodeStorage;
-        totalStorage += nodeStorage;
-    }
+    TProject* project = ActiveProject;
 
     // --- skip final link storage for Steady Flow routing 
-    if ( isFinalStorage && RouteModel == SF ) return totalStorage;
+    if ( !(isFinalStorage && RouteModel == SF) )
+        nBlocks += (nLinks + SUMBLOCK - 1) / SUMBLOCK;
+
+    // --- sum the volume in each block of nodes & then of links, adding
+    //     the block sums in block order (so the total doesn't depend on
+    //     the number of threads)
+#pragma omp parallel num_threads(NumThreads) \
+    if ( nLinks >= MinParallelLinks )
+{
+    int    j, k, j1, j2;
+    double blockStorage;
 
-    // --- add on volume stored in links
-    for (j = 0; j < Nobjects[LINK]; j++)
+    ActiveProject = project;  // worker threads work on the caller's project
+    #pragma omp for ordered schedule(static)
+    for (k = 0; k < nBlocks; k++)
     {
-        totalStorage += Link[j].newVolume;
+        blockStorage = 0.0;
+
+        // --- get volume in nodes
+        if ( k < nNodeBlocks )
+        {
+            j1 = k * SUMBLOCK;
+            j2 = MIN(nNodes, j1 + SUMBLOCK);
+            for (j = j1; j < j2; j++)
+            {
+                if ( isFinalStorage ) NodeOutflow[j] += Node[j].newVolume;
+                blockStorage += Node[j].newVolume;
+            }
+        }
+
+        // --- add on volume stored in links
+        else
+        {
+            j1 = (k - nNodeBlocks) * SUMBLOCK;
+            j2 = MIN(nLinks, j1 + SUMBLOCK);
+            for (j = j1; j < j2; j++) blockStorage += Link[j].newVolume;
+        }
+
+        #pragma omp ordered
+        totalStorage += blockStorage;
     }
+}
     return totalStorage;
 }
 
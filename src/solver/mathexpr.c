@@ -49,6 +49,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include "macros.h"
 #include "mathexpr.h"
 
 #define MAX_STACK_SIZE  1024
@@ -68,14 +69,14 @@ typedef struct TreeNode ExprTree;
 
 // Local variables
 //----------------
-static int    Err;
-static int    Bc;
-static int    PrevLex, CurLex;
-static int    Len, Pos;
-static char   *S;
-static char   Token[255];
-static int    Ivar;
-static double Fvalue;
+static SWMM_TLS int    Err;
+static SWMM_TLS int    Bc;
+static SWMM_TLS int    PrevLex, CurLex;
+static SWMM_TLS int    Len, Pos;
+static SWMM_TLS char   *S;
+static SWMM_TLS char   Token[255];
+static SWMM_TLS int    Ivar;
+static SWMM_TLS double Fvalue;
 
 // math function names
 char *MathFunc[] =  {"COS", "SIN", "TAN", "COT", "ABS", "SGN",
@@ -102,7 +103,7 @@ static void       traverseTree(ExprTree *, MathExpr **);
 static void       deleteTree(ExprTree *);
 
 // Callback functions
-static int    (*getVariableIndex) (char *); // return index of named variable
+static SWMM_TLS int    (*getVariableIndex) (char *); // return index of named variable
 
 //=============================================================================
 
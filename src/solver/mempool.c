@@ -13,10 +13,18 @@
 //  AllocReset()    - reset the current pool
 //  AllocSetPool()  - set the current pool
 //  AllocFree()     - free the memory used by the current pool.
+//
+//  Modified for Build 5.2.4 (OWA):
+//  - Memory is aligned for doubles and a pool's first block is only
+//    created when memory is first allocated from it.
+//  - Requests are served by size class: small ones are carved out of
+//    the pool's shared blocks while large ones get a block of their own,
+//    so pools can hold whole object arrays as well as small items.
 //-----------------------------------------------------------------------------
 
 
 #include <stdlib.h>
+#include "macros.h"
 #include "mempool.h"
 
 /*
@@ -26,6 +34,14 @@
 
 #define ALLOC_BLOCK_SIZE   64000       /*(62*1024)*/
 
+/*
+**  ALLOC_LARGE_SIZE - requests larger than this get a block of their own.
+**  ALLOC_ALIGN - alignment of each request (that of a double).
+*/
+
+#define ALLOC_LARGE_SIZE   (ALLOC_BLOCK_SIZE / 4)
+#define ALLOC_ALIGN        8
+
 /*
 **  alloc_hdr_t - Header for each block of memory.
 */
@@ -44,15 +60,16 @@ typedef struct alloc_hdr_s
 
 typedef struct alloc_root_s
 {
-    alloc_hdr_t *first,    /* First header in pool */
-                *current;  /* Current header       */
+    alloc_hdr_t *first,    /* First header in pool      */
+                *current,  /* Current header            */
+                *large;    /* Headers of large requests */
 }  alloc_root_t;
 
 /*
-**  root - Pointer to the current pool.
+**  root - Pointer to the current pool (each thread has its own).
 */
 
-static alloc_root_t *root;
+static SWMM_TLS alloc_root_t *root;
 
 
 /*
@@ -61,30 +78,53 @@ static alloc_root_t *root;
 **  Private routine to allocate a header and memory block.
 */
 
-static alloc_hdr_t *AllocHdr(void);
+static alloc_hdr_t *AllocHdr(long);
                 
-static alloc_hdr_t * AllocHdr()
+static alloc_hdr_t * AllocHdr(long size)
 {
     alloc_hdr_t     *hdr;
     char            *block;
 
-    block = (char *) malloc(ALLOC_BLOCK_SIZE);
+    block = (char *) malloc(size);
     hdr   = (alloc_hdr_t *) malloc(sizeof(alloc_hdr_t));
 
-    if (hdr == NULL || block == NULL) return(NULL);
+    if (hdr == NULL || block == NULL)
+    {
+        free(block);
+        free(hdr);
+        return(NULL);
+    }
     hdr->block = block;
     hdr->free  = block;
     hdr->next  = NULL;
-    hdr->end   = block + ALLOC_BLOCK_SIZE;
+    hdr->end   = block + size;
 
     return(hdr);
 }
 
 
+/*
+**  AllocLarge()
+**
+**  Private routine to allocate a block for a single large request.
+*/
+
+static char * AllocLarge(long size)
+{
+    alloc_hdr_t     *hdr;
+
+    if ( (hdr = AllocHdr(size)) == NULL) return(NULL);
+    hdr->free = hdr->end;
+    hdr->next = root->large;
+    root->large = hdr;
+    return(hdr->block);
+}
+
+
 /*
 **  AllocInit()
 **
-**  Create a new memory pool with one block.
+**  Create a new memory pool with no blocks.
 **  Returns pointer to the new pool.
 */
 
@@ -94,8 +134,9 @@ alloc_handle_t * AllocInit()
 
     root = (alloc_root_t *) malloc(sizeof(alloc_root_t));
     if (root == NULL) return(NULL);
-    if ( (root->first = AllocHdr()) == NULL) return(NULL);
-    root->current = root->first;
+    root->first = NULL;
+    root->current = NULL;
+    root->large = NULL;
     newpool = (alloc_handle_t *) root;
     return(newpool);
 }
@@ -110,21 +151,34 @@ alloc_handle_t * AllocInit()
 
 char * Alloc(long size)
 {
-    alloc_hdr_t  *hdr = root->current;
+    alloc_hdr_t  *hdr;
     char         *ptr;
 
     /*
-    **  Align to 4 byte boundary - should be ok for most machines.
+    **  Align to 8 byte boundary so that doubles can be stored.
     **  Change this if your machine has weird alignment requirements.
     */
-    size = (size + 3) & 0xfffffffc;
+    size = (size + ALLOC_ALIGN - 1) & ~(long)(ALLOC_ALIGN - 1);
+
+    /* Large requests get a block of their own. */
+
+    if (size > ALLOC_LARGE_SIZE) return(AllocLarge(size));
+
+    /* Create the pool's first block if it has none. */
+
+    if (root->first == NULL)
+    {
+        if ( (root->first = AllocHdr(ALLOC_BLOCK_SIZE)) == NULL) return(NULL);
+        root->current = root->first;
+    }
+    hdr = root->current;
 
     ptr = hdr->free;
     hdr->free += size;
 
     /* Check if the current block is exhausted. */
 
-    if (hdr->free >= hdr->end)
+    if (hdr->free > hdr->end)
     {
         /* Is the next block already allocated? */
 
@@ -137,7 +191,11 @@ char * Alloc(long size)
         else
         {
             /* extend the pool with a new block */
-            if ( (hdr->next = AllocHdr()) == NULL) return(NULL);
+            if ( (hdr->next = AllocHdr(ALLOC_BLOCK_SIZE)) == NULL)
+            {
+                hdr->free -= size;
+                return(NULL);
+            }
             root->current = hdr->next;
         }
 
@@ -169,14 +227,25 @@ alloc_handle_t * AllocSetPool(alloc_handle_t *newpool)
 /*
 **  AllocReset()
 **
-**  Reset the current pool for re-use.  No memory is freed,
-**  so this is very fast.
+**  Reset the current pool for re-use.  Only the blocks of
+**  large requests are freed, so this is very fast.
 */
 
 void  AllocReset()
 {
+    alloc_hdr_t  *tmp,
+                 *hdr = root->large;
+
+    while (hdr != NULL)
+    {
+        tmp = hdr->next;
+        free((char *) hdr->block);
+        free((char *) hdr);
+        hdr = tmp;
+    }
+    root->large = NULL;
     root->current = root->first;
-    root->current->free = root->current->block;
+    if (root->current) root->current->free = root->current->block;
 }
 
 
@@ -190,8 +259,10 @@ void  AllocReset()
 void  AllocFreePool()
 {
     alloc_hdr_t  *tmp,
-                 *hdr = root->first;
+                 *hdr;
 
+    AllocReset();
+    hdr = root->first;
     while (hdr != NULL)
     {
         tmp = hdr->next;
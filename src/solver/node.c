@@ -37,6 +37,11 @@
 //   Build 5.2.2:
 //   - Warning restored for node full depth being increased to crown of highest
 //     connecting link.
+//   Build 5.2.4 (OWA):
+//   - Cumulative volumes of a tabular storage node's area curve computed
+//     when the node is validated.
+//   - Routed outfall loads allocated from the nodes' memory pool.
+//   - node_setOldQualState() replaced by qualrout_setOldState().
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -62,7 +67,6 @@ typedef struct
 //  node_validate          (called from project_validate) 
 //  node_initState         (called from project_init)
 //  node_setOldHydState    (called from routing_execute)
-//  node_setOldQualState   (called from routing_execute)
 //  node_initFlows         (called from routing_execute)
 //  node_setOutletDepth    (called from routing_execute)
 //  node_getLosses         (called from routing_execute)
@@ -164,7 +168,7 @@ void  node_setParams(int j, int type, int k, double x[])
         if ( Outfall[k].routeTo >= 0 )
         {
             Outfall[k].wRouted =
-                (double *) calloc(Nobjects[POLLUT], sizeof(double));
+                (double *) project_alloc(NODE, Nobjects[POLLUT], sizeof(double));
         }
         break;
 
@@ -204,6 +208,7 @@ void  node_validate(int j)
 //  Purpose: validates a node's properties.
 //
 {
+    int k;
     TDwfInflow* inflow;
 
     // --- see if full depth was increased to accommodate conduit crown
@@ -218,8 +223,14 @@ void  node_validate(int j)
 
     // --- check for negative volume for storage node at full depth
     if (Node[j].type == STORAGE)
-        if (node_getVolume(j, Node[j].fullDepth) < 0.0)
+    {
+        k = Node[j].subIndex;
+        if (Storage[k].shape == TABULAR && Storage[k].aCurve >= 0 &&
+            table_setStorageVolumes(&Curve[Storage[k].aCurve]))
+            report_writeErrorMsg(ERR_MEMORY, Node[j].ID);
+        else if (node_getVolume(j, Node[j].fullDepth) < 0.0)
             report_writeErrorMsg(ERR_STORAGE_VOLUME, Node[j].ID);
+    }
 
     if ( Node[j].type == DIVIDER ) divider_validate(j);
 
@@ -305,23 +316,6 @@ void node_setOldHydState(int j)
 
 //=============================================================================
 
-void node_setOldQualState(int j)
-//
-//  Input:   j = node index
-//  Output:  none
-//  Purpose: replaces a node's old water quality state values with new ones.
-//
-{
-    int p;
-    for (p = 0; p < Nobjects[POLLUT]; p++)
-    {
-        Node[j].oldQual[p] = Node[j].newQual[p];
-        Node[j].newQual[p] = 0.0;
-    }
-}
-
-//=============================================================================
-
 void node_initFlows(int j, double tStep)
 //
 //  Input:   j = node index
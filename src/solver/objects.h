@@ -56,6 +56,22 @@
 //  - Support added for tracking a gage's prior n-hour rainfall total.
 //  - Removed extIfaceInflow member from ExtInflow struct.
 //  - Refactored TRptFlags struct.
+//  Build 5.2.4 (OWA):
+//  - Dynamic wave solver state of nodes (TXnode) & links (TXlink) moved
+//    here from dynwave.c.
+//  - Active flag added to TXnode.
+//  - Local time stepping state added to TXlink.
+//  - Circular batch kernel flag added to TXlink.
+//  - Geometry cache tables (TGeomTable) added to TXsect.
+//  - TTable data points frozen into x/y arrays with a search cursor.
+//  - Cumulative storage volumes added to TTable.
+//  - Binary cache of external time series files (TTseriesCache) added.
+//  - Quality arrays of nodes, links & subcatchments are rows of contiguous
+//    pollutant matrices (TQualMatrix).
+//  - Bit flags of result variables saved to the output file added to
+//    TRptFlags.
+//  - Count of links visited by routing trials added to
+//    TTimeStepStats.
 //-----------------------------------------------------------------------------
 
 #ifndef OBJECTS_H
@@ -66,6 +82,7 @@
 #include "enums.h"
 #include "datetime.h"
 #include "mathexpr.h"
+#include "mapfile.h"
 #include "inlet.h"
 #include "infil.h"
 #include "exfil.h"
@@ -94,6 +111,17 @@ struct  TableEntry
 };
 typedef struct TableEntry TTableEntry;
 
+//---------------------------------------
+// BINARY CACHE OF A TIME SERIES DATA FILE
+//---------------------------------------
+typedef struct
+{
+   TMapFile      map;             // memory-mapped cache file
+   double*       xBlock;          // first x-value in each block of entries
+   int           nBlocks;         // number of blocks of entries
+   int           eofEntry;        // entry whose reading ends the data file
+}  TTseriesCache;
+
 //-------------------------
 // CURVE/TIME SERIES OBJECT
 //-------------------------
@@ -106,10 +134,19 @@ typedef struct
    double        lastDate;        // last input date for time series
    double        x1, x2;          // current bracket on x-values
    double        y1, y2;          // current bracket on y-values
-   TTableEntry*  firstEntry;      // first data point
-   TTableEntry*  lastEntry;       // last data point
-   TTableEntry*  thisEntry;       // current data point
+   TTableEntry*  firstEntry;      // first data point (while parsing)
+   TTableEntry*  lastEntry;       // last data point (while parsing)
+   int           nEntries;        // number of data points
+   double*       xData;           // x-values of data points
+   double*       yData;           // y-values of data points
+   int           nRising;         // length of initial non-decreasing y-values
+   int           cursor;          // index of last interval searched
+   double*       vData;           // storage volume above 1st depth at x-values
+   double*       wData;           // total storage volume at x-values
+   int           wRising;         // TRUE if wData never decreases
+   int           thisEntry;       // index of current data point
    TFile         file;            // external data file
+   TTseriesCache* cache;          // binary cache of external file's data
 }  TTable;
 
 //-----------------
@@ -169,6 +206,20 @@ typedef struct
    double        tanAnglat;       // tangent of latitude angle
 }  TTemp;
 
+//-----------------------------------
+// MOVING AVERAGE OF DAILY TEMPERATURE
+//-----------------------------------
+typedef struct
+{
+   double        tAve;            // moving avg. for daily temperature (deg F)
+   double        tRng;            // moving avg. for daily temp. range (deg F)
+   double        ta[7];           // data window for tAve
+   double        tr[7];           // data window for tRng
+   int           count;           // length of moving average window
+   int           maxCount;        // maximum length of moving average window
+   int           front;           // index of front of moving average window
+}  TMovAve;
+
 //-----------------
 // WINDSPEED OBJECT
 //-----------------
@@ -499,7 +550,7 @@ typedef struct
    char*         ID;              // node ID
    int           type;            // node type code
    int           subIndex;        // index of node's sub-category
-   int*          extPollutFlag;   // external pollutant flag (OWA addition)
+   int*          extPollutFlag;   // external pollutant flag (OWA addition) (+)
    int           rptFlag;         // reporting flag
    double        invertElev;      // invert elevation (ft)
    double        initDepth;       // initial storage level (ft)
@@ -527,17 +578,18 @@ typedef struct
    double        newDepth;        // current water depth (ft)
    double        oldLatFlow;      // previous lateral inflow (cfs)
    double        newLatFlow;      // current lateral inflow (cfs)
-   double*       oldQual;         // previous quality state
-   double*       newQual;         // current quality state
-   double*	     extQual;	       // external quality state (OWA addition)
-   double*	     inQual;          // inflow quality state (OWA addition)
-   double*	     reactorQual;     // concentration in the mixed reactor (OWA addition)
+   double*       oldQual;         // previous quality state (+)
+   double*       newQual;         // current quality state (+)
+   double*	     extQual;	       // external quality state (OWA addition) (+)
+   double*	     inQual;          // inflow quality state (OWA addition) (+)
+   double*	     reactorQual;     // concentration in the mixed reactor (OWA addition) (+)
    double        oldFlowInflow;   // previous flow inflow
    double        oldNetInflow;    // previous net inflow
    double        qualInflow;      // inflow seen for quality routing (cfs)
    double        apiExtInflow;    // inflow from swmm_setValue function (cfs)
 
 }  TNode;
+//  (+) row of the matching NodeQual matrix
 
 //---------------
 // OUTFALL OBJECT
@@ -586,6 +638,30 @@ typedef struct
    int         flowCurve;         // index of inflow v. diverted flow curve
 }  TDivider;
 
+//-----------------------------------
+// CROSS SECTION GEOMETRY CACHE TABLE
+//-----------------------------------
+#define GEOM_KEY_SIZE 13          // number of values identifying a table
+
+typedef struct
+{
+   int           n;               // number of intervals (0 if not tabulated)
+   double        xMax;            // largest tabulated argument
+   double        dxInv;           // inverse of interval width
+   double*       values;          // function values at n+1 grid points
+}  TGeomFunc;
+
+typedef struct
+{
+   double        key[GEOM_KEY_SIZE]; // shape & dimensions of cross section
+   TGeomFunc     aOfY;            // area v. depth
+   TGeomFunc     wOfY;            // top width v. depth
+   TGeomFunc     rOfY;            // hyd. radius v. depth
+   TGeomFunc     yOfA;            // depth v. area
+   TGeomFunc     rOfA;            // hyd. radius v. area
+   TGeomFunc     sOfA;            // section factor v. area
+}  TGeomTable;
+
 //-----------------------------
 // CROSS SECTION DATA STRUCTURE
 //-----------------------------
@@ -607,6 +683,7 @@ typedef struct
    double        aBot;            // area of bottom section
    double        sBot;            // slope of bottom section
    double        rBot;            // radius of bottom section
+   TGeomTable*   geomTable;       // cached geometry (NULL if none)
 }  TXsect;
 
 //--------------------------------------
@@ -677,7 +754,7 @@ typedef struct
    char*         ID;              // link ID
    int           type;            // link type code
    int           subIndex;        // index of link's sub-category
-   int*          extPollutFlag;   // external pollutant flag (OWA addition)
+   int*          extPollutFlag;   // external pollutant flag (OWA addition) (+)
    int           rptFlag;         // reporting flag
    int           node1;           // start node index
    int           node2;           // end node index
@@ -706,11 +783,11 @@ typedef struct
    double        targetSetting;   // target control setting
    double        timeLastSet;     // time when setting was last changed
    double        froude;          // Froude number
-   double*       oldQual;         // previous quality state
-   double*       newQual;         // current quality state
-   double*       totalLoad;       // total quality mass loading
-   double*       extQual;	       // external quality state (OWA addition)
-   double*	     reactorQual;     // concentration in the mixed reactor (OWA addition)
+   double*       oldQual;         // previous quality state (+)
+   double*       newQual;         // current quality state (+)
+   double*       totalLoad;       // total quality mass loading (+)
+   double*       extQual;	       // external quality state (OWA addition) (+)
+   double*	     reactorQual;     // concentration in the mixed reactor (OWA addition) (+)
    int           flowClass;       // flow classification
    double        dqdh;            // change in flow w.r.t. head (ft2/sec)
    signed char   direction;       // flow direction flag
@@ -718,6 +795,49 @@ typedef struct
    char          normalFlow;      // normal flow limited flag
    char          inletControl;    // culvert inlet control flag
 }  TLink;
+//  (+) row of the matching LinkQual matrix
+
+//-------------------
+// POLLUTANT MATRICES
+//-------------------
+// Quality state of all nodes or links held as [element x pollutant]
+// matrices, so that the values of element j start at index j*Nobjects[POLLUT].
+typedef struct
+{
+   double*       oldQual;         // previous quality state
+   double*       newQual;         // current quality state
+   double*       extQual;         // external quality state
+   double*       inQual;          // inflow quality state (nodes only)
+   double*       reactorQual;     // concentration in the mixed reactor
+   double*       totalLoad;       // total quality mass loading (links only)
+   int*          extPollutFlag;   // external pollutant flag
+}  TQualMatrix;
+
+//-----------------------------------
+// DYNAMIC WAVE SOLVER STATE OF NODES
+//-----------------------------------
+typedef struct
+{
+   char          converged;       // TRUE if iterations for a node done
+   double        newSurfArea;     // current surface area (ft2)
+   double        oldSurfArea;     // previous surface area (ft2)
+   double        sumdqdh;         // sum of dqdh from adjoining links
+   double        dYdT;            // change in depth w.r.t. time (ft/sec)
+   char          active;          // node recomputed in current trial
+}  TXnode;
+
+//-----------------------------------
+// DYNAMIC WAVE SOLVER STATE OF LINKS
+//-----------------------------------
+typedef struct
+{
+   char          held;            // flow held over current time step
+   char          stepClass;       // time step class (step = 2^class steps)
+   double        heldTime;        // time since flow last computed (sec)
+   double        courantStep;     // Courant time step when last computed (sec)
+   double        headDiff;        // head difference when last computed (ft)
+   char          circBatched;     // geometry found by circular batch kernel
+}  TXlink;
 
 //---------------
 // CONDUIT OBJECT
@@ -877,6 +997,10 @@ typedef struct
    char          controls;        // TRUE if control actions reported
    char          averages;        // TRUE if report step averaged results used
    int           linesPerPage;    // number of lines printed per page
+   int           subcatchVars;    // bit flags of subcatch. variables saved
+   int           nodeVars;        // bit flags of node variables saved
+   int           linkVars;        // bit flags of link variables saved
+                                  // (0 = all variables saved)
 }  TRptFlags;
 
 // OWA EDIT #############################################################################
@@ -972,6 +1096,7 @@ typedef struct
    double        routingTime;          // sum of routing time steps taken (sec)
    int           timeStepCount;        // number of routing time steps
    double        trialsCount;          // total routing trials used
+   double        linkTrialsCount;      // total links visited by trials
    double        steadyStateTime;      // total time in steady state (sec)
    double        timeStepIntervals[TIMELEVELS];  // time step intervals (sec)
    int           timeStepCounts[TIMELEVELS];     // count of steps in interval
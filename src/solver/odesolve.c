@@ -11,9 +11,11 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include "headers.h"
 #include "odesolve.h"
 
 #define MAXSTP 10000
+#undef  TINY      // replaces the generic value from consts.h
 #define TINY   1.0e-30
 #define SAFETY 0.9
 #define PGROW  -0.2
@@ -22,15 +24,15 @@
 
 
 //-----------------------------------------------------------------------------
-//    Local declarations
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-int      nmax;      // max. number of equations
-double*  y;         // dependent variable
-double*  yscal;     // scaling factors
-double*  yerr;      // integration errors
-double*  ytemp;     // temporary values of y
-double*  dydx;      // derivatives of y
-double*  ak;        // derivatives at intermediate points
+#define nmax   (ActiveProject->odesolve.nmax)
+#define y      (ActiveProject->odesolve.y)
+#define yscal  (ActiveProject->odesolve.yscal)
+#define yerr   (ActiveProject->odesolve.yerr)
+#define ytemp  (ActiveProject->odesolve.ytemp)
+#define dydx   (ActiveProject->odesolve.dydx)
+#define ak     (ActiveProject->odesolve.ak)
 
 
 // function that integrates over an error-controlled stepsize
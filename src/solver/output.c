@@ -28,79 +28,99 @@
 //   - Large file support added.
 //   Build5.2.1:
 //   - Corrects the definition of F_OFF for non-Microsoft C/C++ compilers.
+//   Build 5.2.4 (OWA):
+//   - Nodes & links written in input file order when renumbered.
+//   - Reporting period results collected in memory and written to file
+//     by a background writer (see outwrite.c).
+//   - Only the result variables selected with the [REPORT] VARIABLES
+//     option are saved, which the header's lists of variable codes
+//     describe.
+//   - Results saved in compressed chunks when the COMPRESS_OUTPUT option
+//     is set (see outcodec.h).
+//   - Any transposed results file (.tsp) made from an earlier version of
+//     the output file is removed when the file is rewritten.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
-// Large File Support
-#ifdef _MSC_VER    // Windows (32-bit and 64-bit)
-  #define F_OFF __int64
-  #define F_SEEK _fseeki64
-#else              // Other platforms
-  #define F_OFF off_t
-  #define F_SEEK fseeko
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include "headers.h"
+#include "outwrite.h"
+#include "shared/outcodec.h"
 #include "version.h" // OWA manages model version differently from EPA SWMM
 
 // Definition of 4-byte integer, 4-byte real and 8-byte real types
 #define INT4  int
+#define INT8  long long
 #define REAL4 float
 #define REAL8 double
 
 enum InputDataType {INPUT_TYPE_CODE, INPUT_AREA, INPUT_INVERT, INPUT_MAX_DEPTH,
                     INPUT_OFFSET, INPUT_LENGTH};
 
-typedef struct
+typedef struct TAvgResults
 {
     REAL4* xAvg;
 }   TAvgResults;
 
 //-----------------------------------------------------------------------------
-//  Shared variables    
-//-----------------------------------------------------------------------------
-static F_OFF     IDStartPos;           // starting file position of ID names
-static F_OFF     InputStartPos;        // starting file position of input data
-static F_OFF     OutputStartPos;       // starting file position of output data
-static F_OFF     BytesPerPeriod;       // bytes saved per simulation time period
-static INT4      NumSubcatchVars;      // number of subcatchment output variables
-static INT4      NumNodeVars;          // number of node output variables
-static INT4      NumLinkVars;          // number of link output variables
-static INT4      NumSubcatch;          // number of subcatchments reported on
-static INT4      NumNodes;             // number of nodes reported on
-static INT4      NumLinks;             // number of links reported on
-static INT4      NumPolluts;           // number of pollutants reported on
-
-static REAL4     SysResults[MAX_SYS_RESULTS];    // values of system output vars.
-
-static TAvgResults* AvgLinkResults;
-static TAvgResults* AvgNodeResults;
-static int          Nsteps;
-
-//-----------------------------------------------------------------------------
-//  Exportable variables (shared with report.c)
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-REAL4*           SubcatchResults;
-REAL4*           NodeResults;
-REAL4*           LinkResults;
+#define IDStartPos       (ActiveProject->output.IDStartPos)
+#define InputStartPos    (ActiveProject->output.InputStartPos)
+#define OutputStartPos   (ActiveProject->output.OutputStartPos)
+#define BytesPerPeriod   (ActiveProject->output.BytesPerPeriod)
+#define NumSubcatchVars  (ActiveProject->output.NumSubcatchVars)
+#define NumNodeVars      (ActiveProject->output.NumNodeVars)
+#define NumLinkVars      (ActiveProject->output.NumLinkVars)
+#define NumSavedSubcatchVars (ActiveProject->output.NumSavedSubcatchVars)
+#define NumSavedNodeVars (ActiveProject->output.NumSavedNodeVars)
+#define NumSavedLinkVars (ActiveProject->output.NumSavedLinkVars)
+#define SavedSubcatchVars (ActiveProject->output.SavedSubcatchVars)
+#define SavedNodeVars    (ActiveProject->output.SavedNodeVars)
+#define SavedLinkVars    (ActiveProject->output.SavedLinkVars)
+#define NumSubcatch      (ActiveProject->output.NumSubcatch)
+#define NumNodes         (ActiveProject->output.NumNodes)
+#define NumLinks         (ActiveProject->output.NumLinks)
+#define NumPolluts       (ActiveProject->output.NumPolluts)
+#define SysResults       (ActiveProject->output.SysResults)
+#define AvgLinkResults   (ActiveProject->output.AvgLinkResults)
+#define AvgNodeResults   (ActiveProject->output.AvgNodeResults)
+#define Nsteps           (ActiveProject->output.Nsteps)
+#define OutWriter        (ActiveProject->output.OutWriter)
+#define ChunkIndex       (ActiveProject->output.ChunkIndex)
+#define NumChunks        (ActiveProject->output.NumChunks)
+#define ChunkLoaded      (ActiveProject->output.ChunkLoaded)
+#define ChunkPeriods     (ActiveProject->output.ChunkPeriods)
+#define ChunkData        (ActiveProject->output.ChunkData)
 
 
 //-----------------------------------------------------------------------------
 //  Local functions
 //-----------------------------------------------------------------------------
 static void output_openOutFile(void);
+static void output_removeTransposed(void);
 static void output_saveID(char* id, FILE* file);
-static void output_saveSubcatchResults(double reportTime, FILE* file);
-static void output_saveNodeResults(double reportTime, FILE* file);
-static void output_saveLinkResults(double reportTime, FILE* file);
+static REAL4* output_saveSubcatchResults(double reportTime, REAL4* x);
+static REAL4* output_saveNodeResults(double reportTime, REAL4* x);
+static REAL4* output_saveLinkResults(double reportTime, REAL4* x);
+static void   output_flushResults(void);
+static int    output_readResults(F_OFF bytePos, void* x, size_t bytes);
+static int    output_findChunk(INT8 period);
+static int    output_loadChunk(int chunk);
+static int    output_setSavedVars(int flags, int numFixedVars, int numVars,
+              int** savedVars);
+static void   output_saveVarCodes(int numSaved, int* savedVars);
+static REAL4* output_packResults(REAL4* results, int numVars,
+              int* savedVars, int numSaved, REAL4* x);
+static void   output_unpackResults(REAL4* results, int numVars,
+              int* savedVars, int numSaved);
 
 static int  output_openAvgResults(void);
 static void output_closeAvgResults(void);
 static void output_initAvgResults(void);
-static void output_saveAvgResults(FILE* file);
+static REAL4* output_saveAvgResults(REAL4* x);
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
@@ -126,7 +146,7 @@ int output_open()
 //  Purpose: writes basic project data to binary output file.
 //
 {
-    int   j;
+    int   i, j;
     int   m;
     INT4  k;
     REAL4 x;
@@ -134,6 +154,14 @@ int output_open()
     F_OFF numResults;
 
     // --- open binary output file
+    OutWriter = NULL;
+    ChunkIndex = NULL;
+    NumChunks = 0;
+    ChunkLoaded = -1;
+    ChunkData = NULL;
+    SavedSubcatchVars = NULL;
+    SavedNodeVars = NULL;
+    SavedLinkVars = NULL;
     output_openOutFile();
     if ( ErrorCode ) return ErrorCode;
 
@@ -153,6 +181,20 @@ int output_open()
     //     Capacity and Quality
     NumLinkVars = MAX_LINK_RESULTS - 1 + NumPolluts;
 
+    // --- find which of these variables are saved to file
+    NumSavedSubcatchVars = output_setSavedVars(RptFlags.subcatchVars,
+        MAX_SUBCATCH_RESULTS - 1, NumSubcatchVars, &SavedSubcatchVars);
+    NumSavedNodeVars = output_setSavedVars(RptFlags.nodeVars,
+        MAX_NODE_RESULTS - 1, NumNodeVars, &SavedNodeVars);
+    NumSavedLinkVars = output_setSavedVars(RptFlags.linkVars,
+        MAX_LINK_RESULTS - 1, NumLinkVars, &SavedLinkVars);
+    if ( NumSavedSubcatchVars < 0 || NumSavedNodeVars < 0 ||
+         NumSavedLinkVars < 0 )
+    {
+        report_writeErrorMsg(ERR_MEMORY, "");
+        return ErrorCode;
+    }
+
     // --- get number of objects reported on
     NumSubcatch = 0;
     NumNodes = 0;
@@ -162,9 +204,9 @@ int output_open()
     for (j=0; j<Nobjects[LINK]; j++) if (Link[j].rptFlag) NumLinks++;
 
     // --- find size of results saved in each time period
-    numResults = ((F_OFF)NumSubcatch * (F_OFF)NumSubcatchVars)
-        + ((F_OFF)NumNodes * (F_OFF)NumNodeVars)
-        + ((F_OFF)NumLinks * (F_OFF)NumLinkVars) + MAX_SYS_RESULTS;
+    numResults = ((F_OFF)NumSubcatch * (F_OFF)NumSavedSubcatchVars)
+        + ((F_OFF)NumNodes * (F_OFF)NumSavedNodeVars)
+        + ((F_OFF)NumLinks * (F_OFF)NumSavedLinkVars) + MAX_SYS_RESULTS;
     BytesPerPeriod = sizeof(REAL8) + (numResults * sizeof(REAL4));
     Nperiods = 0;
 
@@ -217,12 +259,14 @@ int output_open()
     {
         if ( Subcatch[j].rptFlag ) output_saveID(Subcatch[j].ID, Fout.file);
     }
-    for (j=0; j<Nobjects[NODE]; j++)
+    for (i=0; i<Nobjects[NODE]; i++)
     {
+        j = project_getInternalIndex(NODE, i);
         if ( Node[j].rptFlag ) output_saveID(Node[j].ID, Fout.file);
     }
-    for (j=0; j<Nobjects[LINK]; j++)
+    for (i=0; i<Nobjects[LINK]; i++)
     {
+        j = project_getInternalIndex(LINK, i);
         if ( Link[j].rptFlag ) output_saveID(Link[j].ID, Fout.file);
     }
     for (j=0; j<NumPolluts; j++) output_saveID(Pollut[j].ID, Fout.file);
@@ -257,8 +301,9 @@ int output_open()
     fwrite(&k, sizeof(INT4), 1, Fout.file);
     k = INPUT_MAX_DEPTH;
     fwrite(&k, sizeof(INT4), 1, Fout.file);
-    for (j=0; j<Nobjects[NODE]; j++)
+    for (i=0; i<Nobjects[NODE]; i++)
     {
+        j = project_getInternalIndex(NODE, i);
         if ( !Node[j].rptFlag ) continue;
         k = Node[j].type;
         NodeResults[0] = (REAL4)(Node[j].invertElev * UCF(LENGTH));
@@ -281,8 +326,9 @@ int output_open()
     k = INPUT_LENGTH;
     fwrite(&k, sizeof(INT4), 1, Fout.file);
 
-    for (j=0; j<Nobjects[LINK]; j++)
+    for (i=0; i<Nobjects[LINK]; i++)
     {
+        j = project_getInternalIndex(LINK, i);
         if ( !Link[j].rptFlag ) continue;
         k = Link[j].type;
         if ( k == PUMP )
@@ -312,71 +358,12 @@ int output_open()
         fwrite(LinkResults, sizeof(REAL4), 4, Fout.file);
     }
 
-    // --- save number & codes of subcatchment result variables
-    k = NumSubcatchVars;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = SUBCATCH_RAINFALL;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = SUBCATCH_SNOWDEPTH;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = SUBCATCH_EVAP;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = SUBCATCH_INFIL;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = SUBCATCH_RUNOFF;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = SUBCATCH_GW_FLOW;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = SUBCATCH_GW_ELEV;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = SUBCATCH_SOIL_MOIST;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-
-    for (j=0; j<NumPolluts; j++) 
-    {
-        k = SUBCATCH_WASHOFF + j;
-        fwrite(&k, sizeof(INT4), 1, Fout.file);
-    }
-
-    // --- save number & codes of node result variables
-    k = NumNodeVars;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = NODE_DEPTH;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = NODE_HEAD;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = NODE_VOLUME;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = NODE_LATFLOW;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = NODE_INFLOW;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = NODE_OVERFLOW;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    for (j=0; j<NumPolluts; j++)
-    {
-        k = NODE_QUAL + j;
-        fwrite(&k, sizeof(INT4), 1, Fout.file);
-    }
-
-    // --- save number & codes of link result variables
-    k = NumLinkVars;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = LINK_FLOW;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = LINK_DEPTH;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = LINK_VELOCITY;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = LINK_VOLUME;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    k = LINK_CAPACITY;
-    fwrite(&k, sizeof(INT4), 1, Fout.file);
-    for (j=0; j<NumPolluts; j++)
-    {
-        k = LINK_QUAL + j;
-        fwrite(&k, sizeof(INT4), 1, Fout.file);
-    }
+    // --- save number & codes of subcatchment, node & link result
+    //     variables (a variable's code is its index in the object's
+    //     results vector, where pollutant concentrations come last)
+    output_saveVarCodes(NumSavedSubcatchVars, SavedSubcatchVars);
+    output_saveVarCodes(NumSavedNodeVars, SavedNodeVars);
+    output_saveVarCodes(NumSavedLinkVars, SavedLinkVars);
 
     // --- save number & codes of system result variables
     k = MAX_SYS_RESULTS;
@@ -402,6 +389,11 @@ int output_open()
         return ErrorCode;
     }
     OutputStartPos = ftell(Fout.file);
+
+    // --- start the writer of reporting period results
+    OutWriter = outwrite_open(Fout.file, OutputStartPos, (size_t)BytesPerPeriod,
+                              CompressOutput);
+    if ( OutWriter == NULL ) report_writeErrorMsg(ERR_MEMORY, "");
     return ErrorCode;
 }
 
@@ -442,7 +434,12 @@ void output_openOutFile()
     if (Fout.file != NULL) fclose(Fout.file); 
 
     // --- else if file name supplied then set file mode to SAVE
-    else if (strlen(Fout.name) != 0) Fout.mode = SAVE_FILE;
+    //     (removing any transposed results made from an earlier run)
+    else if (strlen(Fout.name) != 0)
+    {
+        Fout.mode = SAVE_FILE;
+        output_removeTransposed();
+    }
 
     // --- otherwise set file mode to SCRATCH & generate a name
     else
@@ -461,40 +458,80 @@ void output_openOutFile()
 
 //=============================================================================
 
+void output_removeTransposed()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: deletes the transposed results file that the output library
+//           may have made from an earlier version of the output file.
+//
+//  NOTE: the transposed file's name is the output file's name with its
+//        extension replaced by .tsp (see companionName in swmm_output.c).
+//
+{
+    char  name[MAXFNAME+1];
+    char* ext;
+    char* sep;
+
+    sstrncpy(name, Fout.name, MAXFNAME);
+    ext = strrchr(name, '.');
+    sep = strrchr(name, '/');
+    if ( sep == NULL || strrchr(name, '\\') > sep ) sep = strrchr(name, '\\');
+    if ( ext == NULL || (sep != NULL && ext < sep) ) ext = name + strlen(name);
+    if ( ext - name + 4 > MAXFNAME ) return;
+    strcpy(ext, ".tsp");
+    if ( strcmp(name, Fout.name) != 0 ) remove(name);
+}
+
+//=============================================================================
+
 void output_saveResults(double reportTime)
 //
 //  Input:   reportTime = elapsed simulation time (millisec)
 //  Output:  none
 //  Purpose: writes computed results for current report time to binary file.
 //
+//  NOTE: results are placed in a buffer held by the output writer, which
+//        writes them to file in the background.
+//
 {
     int i;
-    extern TRoutingTotals StepFlowTotals;  // defined in massbal.c
     DateTime reportDate = getDateTime(reportTime);
     REAL8 date;
+    char* buf;
+    REAL4* x;
 
     // --- initialize system-wide results
     if ( reportDate < ReportStart ) return;
     for (i=0; i<MAX_SYS_RESULTS; i++) SysResults[i] = 0.0f;
 
+    // --- reserve room for this period's results
+    buf = outwrite_reserve(OutWriter);
+    if ( buf == NULL )
+    {
+        report_writeErrorMsg(ERR_OUT_WRITE, "");
+        return;
+    }
+
     // --- save date corresponding to this elapsed reporting time
     date = reportDate;
-    fwrite(&date, sizeof(REAL8), 1, Fout.file);
+    memcpy(buf, &date, sizeof(REAL8));
+    x = (REAL4 *)(buf + sizeof(REAL8));
 
     // --- save subcatchment results
     if (Nobjects[SUBCATCH] > 0)
-        output_saveSubcatchResults(reportTime, Fout.file);
+        x = output_saveSubcatchResults(reportTime, x);
 
     // --- save average routing results over reporting period if called for
-    if ( RptFlags.averages ) output_saveAvgResults(Fout.file);
+    if ( RptFlags.averages ) x = output_saveAvgResults(x);
 
     // --- otherwise save interpolated point routing results
     else
     {
         if (Nobjects[NODE] > 0)
-            output_saveNodeResults(reportTime, Fout.file);
+            x = output_saveNodeResults(reportTime, x);
         if (Nobjects[LINK] > 0)
-            output_saveLinkResults(reportTime, Fout.file);
+            x = output_saveLinkResults(reportTime, x);
     }
 
     // --- update & save system-wide flows 
@@ -509,7 +546,8 @@ void output_saveResults(double reportTime)
                              SysResults[SYS_GWFLOW] +
                              SysResults[SYS_IIFLOW] +
                              SysResults[SYS_EXFLOW];
-    fwrite(SysResults, sizeof(REAL4), MAX_SYS_RESULTS, Fout.file);
+    memcpy(x, SysResults, MAX_SYS_RESULTS * sizeof(REAL4));
+    outwrite_commit(OutWriter);
 
     // --- save outfall flows to interface file if called for
     if ( Foutflows.mode == SAVE_FILE && !IgnoreRouting ) 
@@ -527,6 +565,12 @@ void output_end()
 //
 {
     INT4 k;
+
+    // --- wait for all results to be written & stop the writer
+    //     (this leaves the file positioned after the last period)
+    if ( !outwrite_close(OutWriter) ) report_writeErrorMsg(ERR_OUT_WRITE, "");
+    OutWriter = NULL;
+
     fwrite(&IDStartPos, sizeof(INT4), 1, Fout.file);
     fwrite(&InputStartPos, sizeof(INT4), 1, Fout.file);
     fwrite(&OutputStartPos, sizeof(INT4), 1, Fout.file);
@@ -553,7 +597,159 @@ void output_close()
     FREE(SubcatchResults);
     FREE(NodeResults);
     FREE(LinkResults);
+    FREE(SavedSubcatchVars);
+    FREE(SavedNodeVars);
+    FREE(SavedLinkVars);
+    FREE(ChunkIndex);
+    FREE(ChunkData);
     output_closeAvgResults();
+    outwrite_close(OutWriter);
+    OutWriter = NULL;
+}
+
+//=============================================================================
+
+void output_flushResults()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: makes sure all results saved so far are in the binary file
+//           before it is read from during a simulation.
+//
+{
+    if ( OutWriter && !outwrite_flush(OutWriter) )
+        report_writeErrorMsg(ERR_OUT_WRITE, "");
+}
+
+//=============================================================================
+
+int output_readResults(F_OFF bytePos, void* x, size_t bytes)
+//
+//  Input:   bytePos = position of results in an uncompressed file
+//           x = array that receives the results
+//           bytes = number of bytes of results read
+//  Output:  returns TRUE if the results were read, FALSE if not
+//  Purpose: reads results of a reporting period from the binary file,
+//           decoding the compressed chunk that holds them if need be.
+//
+{
+    INT8  period;
+    F_OFF offset;
+    int   chunk;
+
+    if ( !CompressOutput )
+    {
+        if ( F_SEEK(Fout.file, bytePos, SEEK_SET) != 0 ) return FALSE;
+        return fread(x, 1, bytes, Fout.file) == bytes;
+    }
+
+    // --- locate the period & the chunk that holds it
+    period = (bytePos - OutputStartPos) / BytesPerPeriod;
+    offset = (bytePos - OutputStartPos) % BytesPerPeriod;
+    chunk = output_findChunk(period);
+    if ( chunk < 0 || !output_loadChunk(chunk) ) return FALSE;
+    if ( OutWriter == NULL ) period -= ChunkIndex[2*chunk+1];
+    else period -= outwrite_index(OutWriter, &NumChunks)[2*chunk+1];
+    if ( period >= ChunkPeriods ) return FALSE;
+    memcpy(x, (char*)ChunkData + period * BytesPerPeriod + offset, bytes);
+    return TRUE;
+}
+
+//=============================================================================
+
+int output_findChunk(INT8 period)
+//
+//  Input:   period = index of a reporting period (starting from 0)
+//  Output:  returns index of the compressed chunk holding the period
+//           or -1 if there is none
+//  Purpose: searches the index of a compressed file's chunks.
+//
+//  NOTE: the index is taken from the writer during a simulation and read
+//        from the end of the file once all results are saved.
+//
+{
+    const INT8* index;
+    INT8  indexPos;
+    INT4  footer[2];
+    int   lo, hi, mid;
+
+    if ( OutWriter ) index = outwrite_index(OutWriter, &NumChunks);
+    else
+    {
+        // --- read index whose position is given by the footer that
+        //     precedes the file's closing records
+        if ( ChunkIndex == NULL )
+        {
+            NumChunks = 0;
+            if ( F_SEEK(Fout.file, -6*(F_OFF)sizeof(INT4) - OUTCODEC_FOOTER,
+                        SEEK_END) != 0 ||
+                 fread(&indexPos, sizeof(INT8), 1, Fout.file) < 1 ||
+                 fread(footer, sizeof(INT4), 2, Fout.file) < 2 ||
+                 footer[1] != OUTCODEC_MAGIC || footer[0] <= 0 ) return -1;
+            ChunkIndex = (INT8 *) malloc(footer[0] * OUTCODEC_INDEX_ENTRY);
+            if ( ChunkIndex == NULL ) return -1;
+            if ( F_SEEK(Fout.file, (F_OFF)indexPos, SEEK_SET) != 0 ||
+                 fread(ChunkIndex, OUTCODEC_INDEX_ENTRY, footer[0],
+                       Fout.file) < (size_t)footer[0] )
+            {
+                FREE(ChunkIndex);
+                return -1;
+            }
+            NumChunks = footer[0];
+        }
+        index = ChunkIndex;
+    }
+
+    // --- find last chunk whose first period is not past the period
+    if ( period < 0 || NumChunks == 0 ) return -1;
+    lo = 0;
+    hi = NumChunks - 1;
+    while ( lo < hi )
+    {
+        mid = (lo + hi + 1) / 2;
+        if ( index[2*mid+1] <= period ) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+//=============================================================================
+
+int output_loadChunk(int chunk)
+//
+//  Input:   chunk = index of a compressed chunk
+//  Output:  returns TRUE if the chunk was decoded, FALSE if not
+//  Purpose: decodes a chunk of a compressed file into ChunkData unless it
+//           is already held there.
+//
+{
+    INT4  header[2];
+    INT8  chunkPos;
+    unsigned char* packed;
+    unsigned int*  data;
+    int   ok;
+
+    if ( chunk == ChunkLoaded ) return TRUE;
+    if ( OutWriter ) chunkPos = outwrite_index(OutWriter, &NumChunks)[2*chunk];
+    else chunkPos = ChunkIndex[2*chunk];
+    if ( F_SEEK(Fout.file, (F_OFF)chunkPos, SEEK_SET) != 0 ||
+         fread(header, sizeof(INT4), 2, Fout.file) < 2 ||
+         header[0] <= 0 || header[1] < 0 ) return FALSE;
+
+    // --- read the chunk's encoded data & decode its periods
+    packed = (unsigned char *) malloc(header[1] + 1);
+    data = (unsigned int *) realloc(ChunkData, header[0] * BytesPerPeriod);
+    if ( data ) ChunkData = data;
+    ChunkLoaded = -1;
+    ok = packed != NULL && data != NULL &&
+         fread(packed, 1, header[1], Fout.file) == (size_t)header[1] &&
+         outcodec_decode(packed, header[1], header[0],
+                         (int)(BytesPerPeriod / 4), ChunkData);
+    free(packed);
+    if ( !ok ) return FALSE;
+    ChunkLoaded = chunk;
+    ChunkPeriods = header[0];
+    return TRUE;
 }
 
 //=============================================================================
@@ -573,12 +769,12 @@ void output_saveID(char* id, FILE* file)
 
 //=============================================================================
 
-void output_saveSubcatchResults(double reportTime, FILE* file)
+REAL4* output_saveSubcatchResults(double reportTime, REAL4* x)
 //
 //  Input:   reportTime = elapsed simulation time (millisec)
-//           file = ptr. to binary output file
-//  Output:  none
-//  Purpose: writes computed subcatchment results to binary file.
+//           x = where to place results in the period's buffer
+//  Output:  returns position in buffer following the results
+//  Purpose: saves computed subcatchment results to the period's buffer.
 //
 {
     int      j;
@@ -602,7 +798,10 @@ void output_saveSubcatchResults(double reportTime, FILE* file)
         // --- retrieve interpolated results for reporting time & write to file
         subcatch_getResults(j, f, SubcatchResults);
         if ( Subcatch[j].rptFlag )
-            fwrite(SubcatchResults, sizeof(REAL4), NumSubcatchVars, file);
+        {
+            x = output_packResults(SubcatchResults, NumSubcatchVars,
+                SavedSubcatchVars, NumSavedSubcatchVars, x);
+        }
 
         // --- update system-wide results
         area = Subcatch[j].area * UCF(LANDAREA);
@@ -635,50 +834,56 @@ void output_saveSubcatchResults(double reportTime, FILE* file)
     SysResults[SYS_TEMPERATURE] = (REAL4)f;
     f = Evap.rate * UCF(EVAPRATE);
     SysResults[SYS_PET] = (REAL4)f;
-
+    return x;
 }
 
 //=============================================================================
 
-void output_saveNodeResults(double reportTime, FILE* file)
+REAL4* output_saveNodeResults(double reportTime, REAL4* x)
 //
 //  Input:   reportTime = elapsed simulation time (millisec)
-//           file = ptr. to binary output file
-//  Output:  none
-//  Purpose: writes computed node results to binary file.
+//           x = where to place results in the period's buffer
+//  Output:  returns position in buffer following the results
+//  Purpose: saves computed node results to the period's buffer.
 //
 {
-    int j;
+    int i, j;
 
     // --- find where current reporting time lies between latest routing times
     double f = (reportTime - OldRoutingTime) /
                (NewRoutingTime - OldRoutingTime);
 
     // --- write node results to file
-    for (j=0; j<Nobjects[NODE]; j++)
+    for (i=0; i<Nobjects[NODE]; i++)
     {
+        j = project_getInternalIndex(NODE, i);
+
         // --- retrieve interpolated results for reporting time & write to file
         node_getResults(j, f, NodeResults);
         if ( Node[j].rptFlag )
-            fwrite(NodeResults, sizeof(REAL4), NumNodeVars, file);
+        {
+            x = output_packResults(NodeResults, NumNodeVars,
+                SavedNodeVars, NumSavedNodeVars, x);
+        }
         stats_updateMaxNodeDepth(j, NodeResults[NODE_DEPTH]);
 
         // --- update system-wide storage volume 
         SysResults[SYS_STORAGE] += NodeResults[NODE_VOLUME];
     }
+    return x;
 }
 
 //=============================================================================
 
-void output_saveLinkResults(double reportTime, FILE* file)
+REAL4* output_saveLinkResults(double reportTime, REAL4* x)
 //
 //  Input:   reportTime = elapsed simulation time (millisec)
-//           file = ptr. to binary output file
-//  Output:  none
-//  Purpose: writes computed link results to binary file.
+//           x = where to place results in the period's buffer
+//  Output:  returns position in buffer following the results
+//  Purpose: saves computed link results to the period's buffer.
 //
 {
-    int j;
+    int i, j;
     double f;
     double z;
 
@@ -686,19 +891,29 @@ void output_saveLinkResults(double reportTime, FILE* file)
     f = (reportTime - OldRoutingTime) / (NewRoutingTime - OldRoutingTime);
 
     // --- write link results to file
-    for (j=0; j<Nobjects[LINK]; j++)
+    for (i=0; i<Nobjects[LINK]; i++)
     {
+        j = project_getInternalIndex(LINK, i);
+
         // --- retrieve interpolated results for reporting time & write to file
-        if (Link[j].rptFlag )
+        //     (directly into the buffer when all variables are saved)
+        if ( Link[j].rptFlag && SavedLinkVars == NULL )
+        {
+            link_getResults(j, f, x);
+            x += NumLinkVars;
+        }
+        else if ( Link[j].rptFlag )
         {
             link_getResults(j, f, LinkResults);
-            fwrite(LinkResults, sizeof(REAL4), NumLinkVars, file);
+            x = output_packResults(LinkResults, NumLinkVars,
+                SavedLinkVars, NumSavedLinkVars, x);
         }
 
         // --- update system-wide results
         z = ((1.0-f)*Link[j].oldVolume + f*Link[j].newVolume) * UCF(VOLUME);
         SysResults[SYS_STORAGE] += (REAL4)z;
     }
+    return x;
 }
 
 //=============================================================================
@@ -713,9 +928,9 @@ void output_readDateTime(long period, DateTime* days)
 {
     F_OFF p = period;
     F_OFF bytePos = OutputStartPos + (p-1)*BytesPerPeriod;
-    F_SEEK(Fout.file, bytePos, SEEK_SET);
+    output_flushResults();
     *days = NO_DATE;
-    fread(days, sizeof(REAL8), 1, Fout.file);
+    output_readResults(bytePos, days, sizeof(REAL8));
 }
 
 //=============================================================================
@@ -729,12 +944,15 @@ void output_readSubcatchResults(long period, int index)
 //           period.
 //
 {
-    long offset = index*NumSubcatchVars;
+    long offset = index*NumSavedSubcatchVars;
     F_OFF p = period;
     F_OFF bytePos = OutputStartPos + (p-1)*BytesPerPeriod +
         sizeof(REAL8) + (F_OFF)offset * sizeof(REAL4);
-    F_SEEK(Fout.file, bytePos, SEEK_SET);
-    fread(SubcatchResults, sizeof(REAL4), NumSubcatchVars, Fout.file);
+    output_flushResults();
+    output_readResults(bytePos, SubcatchResults,
+        NumSavedSubcatchVars * sizeof(REAL4));
+    output_unpackResults(SubcatchResults, NumSubcatchVars, SavedSubcatchVars,
+        NumSavedSubcatchVars);
 }
 
 //=============================================================================
@@ -747,12 +965,14 @@ void output_readNodeResults(long period, int index)
 //  Purpose: reads computed results for a node at a specific time period.
 //
 {
-    long offset = NumSubcatch*NumSubcatchVars + index*NumNodeVars;
+    long offset = NumSubcatch*NumSavedSubcatchVars + index*NumSavedNodeVars;
     F_OFF p = period;
     F_OFF bytePos = OutputStartPos + (p-1)*BytesPerPeriod +
         sizeof(REAL8) + (F_OFF)offset * sizeof(REAL4);
-    F_SEEK(Fout.file, bytePos, SEEK_SET);
-    fread(NodeResults, sizeof(REAL4), NumNodeVars, Fout.file);
+    output_flushResults();
+    output_readResults(bytePos, NodeResults, NumSavedNodeVars * sizeof(REAL4));
+    output_unpackResults(NodeResults, NumNodeVars, SavedNodeVars,
+        NumSavedNodeVars);
 }
 
 //=============================================================================
@@ -765,13 +985,125 @@ void output_readLinkResults(long period, int index)
 //  Purpose: reads computed results for a link at a specific time period.
 //
 {
-    long offset = (NumSubcatch*NumSubcatchVars + NumNodes*NumNodeVars + index*NumLinkVars);
+    long offset = (NumSubcatch*NumSavedSubcatchVars + NumNodes*NumSavedNodeVars
+                   + index*NumSavedLinkVars);
     F_OFF p = period;
     F_OFF bytePos = OutputStartPos + (p-1)*BytesPerPeriod +
         sizeof(REAL8) + (F_OFF)offset * sizeof(REAL4);
-    F_SEEK(Fout.file, bytePos, SEEK_SET);
-    fread(LinkResults, sizeof(REAL4), NumLinkVars, Fout.file);
-    fread(SysResults, sizeof(REAL4), MAX_SYS_RESULTS, Fout.file);
+    output_flushResults();
+    output_readResults(bytePos, LinkResults, NumSavedLinkVars * sizeof(REAL4));
+    bytePos += NumSavedLinkVars * sizeof(REAL4);
+    output_readResults(bytePos, SysResults, MAX_SYS_RESULTS * sizeof(REAL4));
+    output_unpackResults(LinkResults, NumLinkVars, SavedLinkVars,
+        NumSavedLinkVars);
+}
+
+//=============================================================================
+
+int output_setSavedVars(int flags, int numFixedVars, int numVars,
+    int** savedVars)
+//
+//  Input:   flags = bit flags of the variables to save (0 = all)
+//           numFixedVars = number of variables ahead of pollutant results
+//           numVars = total number of variables in results vector
+//  Output:  savedVars = indexes of the variables saved (NULL if all are);
+//           returns number of variables saved or -1 if out of memory
+//  Purpose: finds which of an object type's result variables are saved
+//           to the binary output file.
+//
+//  NOTE: bit j of flags selects fixed variable j while bit numFixedVars
+//        selects the concentrations of all pollutants.
+//
+{
+    int j, n = 0;
+
+    *savedVars = NULL;
+    if ( flags == 0 ) return numVars;
+    *savedVars = (int *) calloc(numVars, sizeof(int));
+    if ( *savedVars == NULL ) return -1;
+    for (j = 0; j < numVars; j++)
+    {
+        if ( flags & (1 << MIN(j, numFixedVars)) ) (*savedVars)[n++] = j;
+    }
+    if ( n == numVars ) FREE(*savedVars);
+    return n;
+}
+
+//=============================================================================
+
+void output_saveVarCodes(int numSaved, int* savedVars)
+//
+//  Input:   numSaved = number of result variables saved
+//           savedVars = indexes of the variables saved (NULL if all are)
+//  Output:  none
+//  Purpose: writes the number & codes of the result variables saved
+//           for a type of object to the binary output file.
+//
+{
+    INT4 j, k;
+
+    k = numSaved;
+    fwrite(&k, sizeof(INT4), 1, Fout.file);
+    for (j = 0; j < numSaved; j++)
+    {
+        k = savedVars ? savedVars[j] : j;
+        fwrite(&k, sizeof(INT4), 1, Fout.file);
+    }
+}
+
+//=============================================================================
+
+REAL4* output_packResults(REAL4* results, int numVars, int* savedVars,
+    int numSaved, REAL4* x)
+//
+//  Input:   results = an object's full vector of results
+//           numVars = size of results vector
+//           savedVars = indexes of the variables saved (NULL if all are)
+//           numSaved = number of variables saved
+//           x = where to place results in the period's buffer
+//  Output:  returns position in buffer following the results
+//  Purpose: copies the saved variables of an object's results to the
+//           period's buffer.
+//
+{
+    int j;
+
+    if ( savedVars == NULL )
+    {
+        memcpy(x, results, numVars * sizeof(REAL4));
+        return x + numVars;
+    }
+    for (j = 0; j < numSaved; j++) x[j] = results[savedVars[j]];
+    return x + numSaved;
+}
+
+//=============================================================================
+
+void output_unpackResults(REAL4* results, int numVars, int* savedVars,
+    int numSaved)
+//
+//  Input:   results = saved variables of an object read from file
+//           numVars = size of results vector
+//           savedVars = indexes of the variables saved (NULL if all are)
+//           numSaved = number of variables saved
+//  Output:  results = full vector of results
+//  Purpose: spreads the saved variables read for an object over its
+//           full results vector, setting variables not saved to 0.
+//
+{
+    int i, j;
+
+    if ( savedVars == NULL ) return;
+
+    // --- work back from the last variable saved
+    //     (savedVars[j] >= j so values not yet moved are never overwritten)
+    i = numVars - 1;
+    for (j = numSaved - 1; j >= 0; j--)
+    {
+        while ( i > savedVars[j] ) results[i--] = 0.0f;
+        results[i--] = results[j];
+    }
+    while ( i >= 0 ) results[i--] = 0.0f;
 }
 
 //=============================================================================
@@ -866,23 +1198,23 @@ void output_updateAvgResults()
     int i, j, k, sign;
 
     // --- update average accumulations for nodes
-    k = 0;
+    //     (an object's rptFlag is its position in the output file)
     for (i = 0; i < Nobjects[NODE]; i++)
     {
         if ( !Node[i].rptFlag ) continue;
+        k = Node[i].rptFlag - 1;
         node_getResults(i, 1.0, NodeResults);
         for (j = 0; j < NumNodeVars; j++)
         {
             AvgNodeResults[k].xAvg[j] += NodeResults[j];
         }
-        k++;
     }
 
     // --- update average accumulations for links
-    k = 0;
     for (i = 0; i < Nobjects[LINK]; i++)
     {
         if ( !Link[i].rptFlag ) continue;
+        k = Link[i].rptFlag - 1;
         link_getResults(i, 1.0, LinkResults);
 
         // --- save sign of current flow rate
@@ -908,14 +1240,16 @@ void output_updateAvgResults()
             // --- accumulation for all other reported results
             else AvgLinkResults[k].xAvg[j] += LinkResults[j];
         }
-        k++;
     }
     Nsteps++;
 }
 
 //=============================================================================
 
-void output_saveAvgResults(FILE* file)
+REAL4* output_saveAvgResults(REAL4* x)
+//
+//  Saves average node & link results to the period's buffer, returning
+//  the position in the buffer following them.
 {
     int i, j;
 
@@ -928,8 +1262,9 @@ void output_saveAvgResults(FILE* file)
             NodeResults[j] = AvgNodeResults[i].xAvg[j] / Nsteps;
         }
 
-        // --- save average results to file
-        fwrite(NodeResults, sizeof(REAL4), NumNodeVars, file);
+        // --- save average results to buffer
+        x = output_packResults(NodeResults, NumNodeVars, SavedNodeVars,
+            NumSavedNodeVars, x);
     }
 
     // --- update each node's max depth and contribution to system storage
@@ -948,8 +1283,9 @@ void output_saveAvgResults(FILE* file)
             LinkResults[j] = AvgLinkResults[i].xAvg[j] / Nsteps;
         }
 
-        // --- save average results to file
-        fwrite(LinkResults, sizeof(REAL4), NumLinkVars, file);
+        // --- save average results to buffer
+        x = output_packResults(LinkResults, NumLinkVars, SavedLinkVars,
+            NumSavedLinkVars, x);
     }
  
     // --- add each link's volume to total system storage
@@ -960,4 +1296,5 @@ void output_saveAvgResults(FILE* file)
 
     // --- re-initialize average results for all nodes and links
     output_initAvgResults();
+    return x;
 }
@@ -0,0 +1,468 @@
+//-----------------------------------------------------------------------------
+//  outwrite.c
+//
+//  Project:  EPA SWMM5
+//  Version:  5.2
+//  Date:     10/16/26   (Build 5.2.4 (OWA))
+//
+//  Background writer of binary output file results.
+//
+//  outwrite_open()    - starts a writer for a file's results section
+//  outwrite_reserve() - returns memory to hold the next period's results
+//  outwrite_commit()  - completes the period last reserved
+//  outwrite_flush()   - waits until all committed periods are on disk
+//  outwrite_close()   - flushes results and stops the writer
+//  outwrite_index()   - returns the index of the chunks written so far
+//
+//  Periods are packed into a ring of OUTWRITE_BUFFERS buffers, each of
+//  roughly OUTWRITE_BLOCK bytes (or one period if that is larger). A full
+//  buffer is handed to a writer thread, which writes it with a single
+//  fwrite while the solver goes on filling the next buffer. The solver
+//  only waits when every buffer is still waiting to be written.
+//
+//  Threads are created with the Windows API or with POSIX threads. On
+//  other platforms a full buffer is written as soon as it is committed.
+//
+//  A writer of a compressed file encodes each buffer as a chunk (see
+//  outcodec.c) on the writer thread and writes the index of the chunks
+//  when it is closed.
+//
+//  Only the writer thread uses the file between outwrite_open() and a
+//  call to outwrite_flush() or outwrite_close().
+//-----------------------------------------------------------------------------
+#define _CRT_SECURE_NO_DEPRECATE
+
+#include <stdlib.h>
+#include <string.h>
+#include "outwrite.h"
+#include "shared/outcodec.h"
+
+#if defined(_WIN32) || defined(__WIN32__)
+  #define OUTWRITE_WINDOWS
+  #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+  #define OUTWRITE_POSIX
+  #include <pthread.h>
+#endif
+
+enum OutWriteConsts {
+    OUTWRITE_BUFFERS = 2,             // number of period buffers
+    OUTWRITE_BLOCK   = 1 << 20        // target size of a buffer (bytes)
+};
+
+// Definition of 4-byte & 8-byte integer types
+#define INT4 int
+#define INT8 long long
+
+struct TOutWriter
+{
+    FILE*   file;                     // binary output file
+    F_OFF   filePos;                  // file position of next write
+    size_t  periodBytes;              // bytes of results per period
+    size_t  bufferBytes;              // capacity of each buffer (bytes)
+    char*   buffer[OUTWRITE_BUFFERS]; // ring of period buffers
+    size_t  used[OUTWRITE_BUFFERS];   // bytes held by each buffer
+    int     fill;                     // buffer being filled by the solver
+    int     head;                     // next buffer to be written
+    int     pending;                  // number of buffers awaiting writing
+    int     error;                    // TRUE if a write failed
+    int     failed;                   // solver's copy of error
+    int     stop;                     // TRUE when writer thread should end
+    int     compress;                 // TRUE if buffers are compressed
+    unsigned char* packed;            // a buffer's encoded chunk
+    INT8*   index;                    // file position & first period of
+                                      // each chunk
+    int     numChunks;                // number of chunks written
+    int     maxChunks;                // capacity of index (chunks)
+    INT8    numPeriods;               // number of periods written
+#if defined(OUTWRITE_WINDOWS)
+    HANDLE             thread;
+    CRITICAL_SECTION   lock;
+    CONDITION_VARIABLE work;          // signals a buffer was submitted
+    CONDITION_VARIABLE done;          // signals a buffer was written
+#elif defined(OUTWRITE_POSIX)
+    pthread_t          thread;
+    pthread_mutex_t    lock;
+    pthread_cond_t     work;
+    pthread_cond_t     done;
+#endif
+};
+
+#if defined(OUTWRITE_WINDOWS)
+  #define LOCK(w)    EnterCriticalSection(&(w)->lock)
+  #define UNLOCK(w)  LeaveCriticalSection(&(w)->lock)
+  #define WAIT(c, w) SleepConditionVariableCS(&(c), &(w)->lock, INFINITE)
+  #define SIGNAL(c)  WakeConditionVariable(&(c))
+#elif defined(OUTWRITE_POSIX)
+  #define LOCK(w)    pthread_mutex_lock(&(w)->lock)
+  #define UNLOCK(w)  pthread_mutex_unlock(&(w)->lock)
+  #define WAIT(c, w) pthread_cond_wait(&(c), &(w)->lock)
+  #define SIGNAL(c)  pthread_cond_signal(&(c))
+#endif
+
+//-----------------------------------------------------------------------------
+//  Local functions
+//-----------------------------------------------------------------------------
+static int  writeBuffer(TOutWriter* w, int b);
+static int  writeChunk(TOutWriter* w, int b);
+static int  writeIndex(TOutWriter* w);
+static void submitBuffer(TOutWriter* w);
+static void freeWriter(TOutWriter* w);
+#if defined(OUTWRITE_WINDOWS)
+static DWORD WINAPI writerThread(LPVOID arg);
+#elif defined(OUTWRITE_POSIX)
+static void* writerThread(void* arg);
+#endif
+
+//=============================================================================
+
+TOutWriter* outwrite_open(FILE* file, F_OFF startPos, size_t periodBytes,
+                          int compress)
+//
+//  Input:   file = binary output file
+//           startPos = file position where the first period is written
+//           periodBytes = size of each period's results (bytes)
+//           compress = TRUE if results are saved in compressed chunks
+//  Output:  returns a new writer or NULL if out of memory
+//  Purpose: starts a writer of reporting period results.
+//
+{
+    int i;
+    size_t periods;
+    TOutWriter* w;
+
+    w = (TOutWriter *) calloc(1, sizeof(TOutWriter));
+    if ( w == NULL ) return NULL;
+    w->file = file;
+    w->filePos = startPos;
+    w->periodBytes = periodBytes;
+    periods = OUTWRITE_BLOCK / periodBytes;
+    if ( periods < 1 ) periods = 1;
+    w->bufferBytes = periods * periodBytes;
+    for (i = 0; i < OUTWRITE_BUFFERS; i++)
+    {
+        w->buffer[i] = (char *) malloc(w->bufferBytes);
+        if ( w->buffer[i] == NULL )
+        {
+            freeWriter(w);
+            return NULL;
+        }
+    }
+    w->compress = compress;
+    if ( compress )
+    {
+        w->packed = (unsigned char *) malloc(OUTCODEC_CHUNK_HEADER +
+            outcodec_bound((int)periods, (int)(periodBytes / 4)));
+        if ( w->packed == NULL )
+        {
+            freeWriter(w);
+            return NULL;
+        }
+    }
+
+#if defined(OUTWRITE_WINDOWS)
+    InitializeCriticalSection(&w->lock);
+    InitializeConditionVariable(&w->work);
+    InitializeConditionVariable(&w->done);
+    w->thread = CreateThread(NULL, 0, writerThread, w, 0, NULL);
+    if ( w->thread == NULL )
+    {
+        DeleteCriticalSection(&w->lock);
+        freeWriter(w);
+        return NULL;
+    }
+#elif defined(OUTWRITE_POSIX)
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->work, NULL);
+    pthread_cond_init(&w->done, NULL);
+    if ( pthread_create(&w->thread, NULL, writerThread, w) != 0 )
+    {
+        pthread_cond_destroy(&w->done);
+        pthread_cond_destroy(&w->work);
+        pthread_mutex_destroy(&w->lock);
+        freeWriter(w);
+        return NULL;
+    }
+#endif
+    return w;
+}
+
+//=============================================================================
+
+char* outwrite_reserve(TOutWriter* w)
+//
+//  Input:   w = a results writer
+//  Output:  returns memory for one period's results or NULL if an
+//           earlier write failed
+//  Purpose: reserves space in the current buffer for the next period.
+//
+//  NOTE: the memory is aligned for 4-byte values as long as periodBytes
+//        is a multiple of 4.
+//
+{
+    char* p;
+    if ( w->failed ) return NULL;
+    p = w->buffer[w->fill] + w->used[w->fill];
+    w->used[w->fill] += w->periodBytes;
+    return p;
+}
+
+//=============================================================================
+
+void outwrite_commit(TOutWriter* w)
+//
+//  Input:   w = a results writer
+//  Output:  none
+//  Purpose: marks the period last reserved as complete, handing the
+//           current buffer to the writer once it is full.
+//
+{
+    if ( w->used[w->fill] + w->periodBytes > w->bufferBytes ) submitBuffer(w);
+}
+
+//=============================================================================
+
+int outwrite_flush(TOutWriter* w)
+//
+//  Input:   w = a results writer
+//  Output:  returns TRUE if all results were written, FALSE if not
+//  Purpose: writes all committed periods to file, waiting until they are.
+//
+//  NOTE: the file is left positioned at the end of the last period.
+//
+{
+    if ( w->used[w->fill] > 0 ) submitBuffer(w);
+#if defined(OUTWRITE_WINDOWS) || defined(OUTWRITE_POSIX)
+    LOCK(w);
+    while ( w->pending > 0 ) WAIT(w->done, w);
+    w->failed = w->error;
+    UNLOCK(w);
+#endif
+    if ( !w->failed && F_SEEK(w->file, w->filePos, SEEK_SET) != 0 )
+        w->failed = 1;
+    return !w->failed;
+}
+
+//=============================================================================
+
+int outwrite_close(TOutWriter* w)
+//
+//  Input:   w = a results writer
+//  Output:  returns TRUE if all results were written, FALSE if not
+//  Purpose: writes all committed periods (and the index of a compressed
+//           file's chunks) to file and frees the writer.
+//
+{
+    int ok;
+    if ( w == NULL ) return 1;
+    ok = outwrite_flush(w);
+    if ( ok && w->compress ) ok = writeIndex(w);
+
+#if defined(OUTWRITE_WINDOWS)
+    LOCK(w);
+    w->stop = 1;
+    SIGNAL(w->work);
+    UNLOCK(w);
+    WaitForSingleObject(w->thread, INFINITE);
+    CloseHandle(w->thread);
+    DeleteCriticalSection(&w->lock);
+#elif defined(OUTWRITE_POSIX)
+    LOCK(w);
+    w->stop = 1;
+    SIGNAL(w->work);
+    UNLOCK(w);
+    pthread_join(w->thread, NULL);
+    pthread_cond_destroy(&w->done);
+    pthread_cond_destroy(&w->work);
+    pthread_mutex_destroy(&w->lock);
+#endif
+    freeWriter(w);
+    return ok;
+}
+
+//=============================================================================
+
+void submitBuffer(TOutWriter* w)
+//
+//  Input:   w = a results writer
+//  Output:  none
+//  Purpose: queues the current buffer for writing and moves on to the
+//           next one, waiting for it to be written if necessary.
+//
+{
+#if defined(OUTWRITE_WINDOWS) || defined(OUTWRITE_POSIX)
+    LOCK(w);
+    w->pending++;
+    SIGNAL(w->work);
+    w->fill = (w->fill + 1) % OUTWRITE_BUFFERS;
+    while ( w->pending == OUTWRITE_BUFFERS ) WAIT(w->done, w);
+    w->failed = w->error;
+    UNLOCK(w);
+#else
+    if ( w->failed ) w->used[w->fill] = 0;
+    else if ( !writeBuffer(w, w->fill) ) w->failed = 1;
+#endif
+}
+
+//=============================================================================
+
+const long long* outwrite_index(TOutWriter* w, int* numChunks)
+//
+//  Input:   w = a results writer
+//  Output:  numChunks = number of compressed chunks written;
+//           returns file position & first period of each chunk
+//  Purpose: retrieves the index of a compressed file's chunks.
+//
+//  NOTE: the index only covers the periods written by the last call to
+//        outwrite_flush() and is invalid once the writer is closed.
+//
+{
+    *numChunks = w->numChunks;
+    return w->index;
+}
+
+//=============================================================================
+
+int writeBuffer(TOutWriter* w, int b)
+//
+//  Input:   w = a results writer
+//           b = index of a buffer
+//  Output:  returns TRUE if the buffer was written, FALSE if not
+//  Purpose: writes a buffer's periods to the file and empties the buffer.
+//
+{
+    size_t n = w->used[b];
+
+    if ( w->compress ) return writeChunk(w, b);
+    w->used[b] = 0;
+    if ( F_SEEK(w->file, w->filePos, SEEK_SET) != 0 ||
+         fwrite(w->buffer[b], 1, n, w->file) < n ) return 0;
+    w->filePos += (F_OFF)n;
+    return 1;
+}
+
+//=============================================================================
+
+int writeChunk(TOutWriter* w, int b)
+//
+//  Input:   w = a results writer
+//           b = index of a buffer
+//  Output:  returns TRUE if the buffer was written, FALSE if not
+//  Purpose: writes a buffer's periods to the file as a compressed chunk
+//           and empties the buffer.
+//
+{
+    INT4   header[2];
+    INT8*  index;
+    int    nPeriods = (int)(w->used[b] / w->periodBytes);
+    size_t n;
+
+    w->used[b] = 0;
+
+    // --- add the chunk to the index
+    if ( w->numChunks == w->maxChunks )
+    {
+        w->maxChunks = w->maxChunks ? 2 * w->maxChunks : 64;
+        index = (INT8 *) realloc(w->index, 2 * w->maxChunks * sizeof(INT8));
+        if ( index == NULL ) return 0;
+        w->index = index;
+    }
+    w->index[2*w->numChunks] = (INT8)w->filePos;
+    w->index[2*w->numChunks+1] = w->numPeriods;
+    w->numChunks++;
+    w->numPeriods += nPeriods;
+
+    // --- encode the buffer's periods after the chunk's header
+    n = outcodec_encode((unsigned int *)w->buffer[b], nPeriods,
+        (int)(w->periodBytes / 4), w->packed + OUTCODEC_CHUNK_HEADER);
+    header[0] = nPeriods;
+    header[1] = (INT4)n;
+    memcpy(w->packed, header, OUTCODEC_CHUNK_HEADER);
+    n += OUTCODEC_CHUNK_HEADER;
+    if ( F_SEEK(w->file, w->filePos, SEEK_SET) != 0 ||
+         fwrite(w->packed, 1, n, w->file) < n ) return 0;
+    w->filePos += (F_OFF)n;
+    return 1;
+}
+
+//=============================================================================
+
+int writeIndex(TOutWriter* w)
+//
+//  Input:   w = a results writer
+//  Output:  returns TRUE if the index was written, FALSE if not
+//  Purpose: writes the index of a compressed file's chunks and its footer
+//           after the last chunk.
+//
+//  NOTE: the file is left positioned at the end of the footer.
+//
+{
+    INT8 indexPos = (INT8)w->filePos;
+    INT4 k;
+
+    if ( fwrite(w->index, OUTCODEC_INDEX_ENTRY, w->numChunks, w->file) <
+         (size_t)w->numChunks ) return 0;
+    fwrite(&indexPos, sizeof(INT8), 1, w->file);
+    k = w->numChunks;
+    fwrite(&k, sizeof(INT4), 1, w->file);
+    k = OUTCODEC_MAGIC;
+    return fwrite(&k, sizeof(INT4), 1, w->file) == 1;
+}
+
+//=============================================================================
+
+#if defined(OUTWRITE_WINDOWS) || defined(OUTWRITE_POSIX)
+#if defined(OUTWRITE_WINDOWS)
+DWORD WINAPI writerThread(LPVOID arg)
+#else
+void* writerThread(void* arg)
+#endif
+//
+//  Input:   arg = a results writer
+//  Output:  none
+//  Purpose: writes buffers to file in the order they are submitted.
+//
+{
+    TOutWriter* w = (TOutWriter *)arg;
+    int b, ok;
+
+    LOCK(w);
+    for (;;)
+    {
+        while ( w->pending == 0 && !w->stop ) WAIT(w->work, w);
+        if ( w->pending == 0 ) break;
+        b = w->head;
+        ok = !w->error;
+        UNLOCK(w);
+
+        // --- the solver never touches a submitted buffer or the file
+        //     (buffers after a failed write are discarded)
+        if ( ok ) ok = writeBuffer(w, b);
+        else w->used[b] = 0;
+
+        LOCK(w);
+        if ( !ok ) w->error = 1;
+        w->head = (w->head + 1) % OUTWRITE_BUFFERS;
+        w->pending--;
+        SIGNAL(w->done);
+    }
+    UNLOCK(w);
+    return 0;
+}
+#endif
+
+//=============================================================================
+
+void freeWriter(TOutWriter* w)
+//
+//  Input:   w = a results writer
+//  Output:  none
+//  Purpose: frees a writer's buffers and the writer itself.
+//
+{
+    int i;
+    for (i = 0; i < OUTWRITE_BUFFERS; i++) free(w->buffer[i]);
+    free(w->packed);
+    free(w->index);
+    free(w);
+}
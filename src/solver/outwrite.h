@@ -0,0 +1,27 @@
+//-----------------------------------------------------------------------------
+//  outwrite.h
+//
+//  Header for outwrite.c
+//
+//  A TOutWriter collects the results of successive reporting periods in
+//  memory and writes them to the binary output file on a background thread,
+//  optionally compressing them (see outcodec.h).
+//-----------------------------------------------------------------------------
+
+#ifndef OUTWRITE_H
+#define OUTWRITE_H
+
+#include <stdio.h>
+#include "macros.h"
+
+typedef struct TOutWriter TOutWriter;
+
+TOutWriter* outwrite_open(FILE* file, F_OFF startPos, size_t periodBytes,
+                          int compress);
+char*       outwrite_reserve(TOutWriter* writer);
+void        outwrite_commit(TOutWriter* writer);
+int         outwrite_flush(TOutWriter* writer);
+int         outwrite_close(TOutWriter* writer);
+const long long* outwrite_index(TOutWriter* writer, int* numChunks);
+
+#endif //OUTWRITE_H
@@ -56,12 +56,28 @@
 //   - Default Inertial Damping changed from SOME to PARTIAL_DAMPING.
 //   - Default CourantFactor changed from 0 (fixed routing time step)
 //   - to 0.75 (variable time step)
+//   Build 5.2.4 (OWA):
+//   - Optional renumbering of nodes & links (RENUMBER option) added.
+//   - DYNWAVE_IMPLICIT flow routing choice added.
+//   - ACTIVE_SET option added.
+//   - TIME_STEP_CLASSES option added.
+//   - MIN_PARALLEL_LINKS option added.
+//   - GEOMETRY_CACHE option added.
+//   - TIMESERIES_CACHE option added.
+//   - Curve validation errors other than out-of-sequence data reported.
+//   - Projects can be read from compiled project files (see snapshot.c).
+//   - Hash tables of compiled projects sized from their object counts.
+//   - Object data allocated from memory pools (one per type of object)
+//     that are freed all at once when the project is closed.
+//   - COMPRESS_OUTPUT option added.
+//   - Quality arrays of objects are rows of contiguous pollutant matrices.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <limits.h>
 
 // Protect against lack of compiler support for OpenMP
 #if defined(_OPENMP)
@@ -76,10 +92,13 @@
 #include "mempool.h"
 
 //-----------------------------------------------------------------------------
-//  Shared variables
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-static HTtable* Htable[MAX_OBJ_TYPES]; // Hash tables for object ID names
-static char     MemPoolAllocated;      // TRUE if memory pool allocated 
+#define Htable  (ActiveProject->project.Htable)
+#define IDPool  (ActiveProject->project.IDPool)
+#define ObjPool (ActiveProject->project.ObjPool)
+#define InternalIndex  (ActiveProject->project.InternalIndex)
+#define InputIndex     (ActiveProject->project.InputIndex)
 
 //-----------------------------------------------------------------------------
 //  External Functions (declared in funcs.h)
@@ -89,12 +108,19 @@ static char     MemPoolAllocated;      // TRUE if memory pool allocated
 //  project_readInput      (called from swmm_open in swmm5.c)
 //  project_readOption     (called from readOption in input.c)
 //  project_validate       (called from swmm_open in swmm5.c)
+//  project_readCompiled   (called from swmm_openCompiled in swmm5.c)
+//  project_validateCompiled (called from swmm_openCompiled in swmm5.c)
 //  project_init           (called from swmm_start in swmm5.c)
 //  project_addObject      (called from addObject in input.c)
 //  project_createMatrix   (called from openFileForInput in iface.c)
 //  project_freeMatrix     (called from iface_closeRoutingFiles)
 //  project_findObject
 //  project_findID
+//  project_renumberObjects  (called from input_countObjects)
+//  project_getInternalIndex
+//  project_getInputIndex
+//  project_getIDs         (called from xferIDs in snapshot.c)
+//  project_alloc
 
 //-----------------------------------------------------------------------------
 //  Function declarations
@@ -105,7 +131,12 @@ static void openFiles(const char *f1, const char *f2, const char *f3);
 static void createObjects(void);
 static void deleteObjects(void);
 static void createHashTables(void);
+static void reserveHashTables(void);
 static void deleteHashTables(void);
+static void deleteObjPools(void);
+static void createQualMatrix(TQualMatrix* m, int type, int n);
+static double* createQualRows(int n);
+static double* qualRow(double* m, int j);
 
 
 //=============================================================================
@@ -206,7 +237,7 @@ void project_validate()
     for ( i=0; i<Nobjects[CURVE]; i++ )
     {
          err = table_validate(&Curve[i]);
-         if ( err ) report_writeErrorMsg(ERR_CURVE_SEQUENCE, Curve[i].ID);
+         if ( err ) report_writeErrorMsg(err, Curve[i].ID);
     }
     for ( i=0; i<Nobjects[TSERIES]; i++ )
     {
@@ -242,6 +273,8 @@ void project_validate()
     // --- validate links before nodes, since the latter can
     //     result in adjustment of node depths
     for ( i=0; i<Nobjects[NODE]; i++) Node[i].oldDepth = Node[i].fullDepth;
+    if ( GeomCache && !xsect_openGeomCache(Nobjects[LINK]) )
+        report_writeErrorMsg(ERR_MEMORY, "");
     for ( i=0; i<Nobjects[LINK]; i++) link_validate(i);
     for ( i=0; i<Nobjects[NODE]; i++) node_validate(i);
 
@@ -279,6 +312,72 @@ void project_validate()
 
 //=============================================================================
 
+void project_readCompiled()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: retrieves project data from a compiled project file.
+//
+{
+    // --- create hash tables for fast retrieval of objects by ID names
+    createHashTables();
+
+    // --- read number of objects from the file and create them
+    controls_init();
+    snapshot_open();
+    reserveHashTables();
+    createObjects();
+
+    // --- read the objects' data from the file
+    snapshot_read();
+}
+
+//=============================================================================
+
+void project_validateCompiled()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: completes the validation of project data read from a compiled
+//           project file.
+//
+//  NOTE: a project is compiled after being validated, so only the steps of
+//        project_validate that open external files, build cached data or
+//        depend on the computer being used are repeated here.
+//
+{
+    int i;
+    int err;
+
+    // --- open external files used by time series
+    for ( i=0; i<Nobjects[TSERIES]; i++ )
+    {
+        if ( Tseries[i].file.mode != USE_FILE ) continue;
+        err = table_validate(&Tseries[i]);
+        if ( err ) report_writeTseriesErrorMsg(err, &Tseries[i]);
+    }
+
+    // --- open the climate data file
+    if ( Fclimate.mode == USE_FILE ) climate_openFile();
+
+    // --- assign cached geometry tables to conduits
+    if ( GeomCache )
+    {
+        if ( !xsect_openGeomCache(Nobjects[LINK]) )
+            report_writeErrorMsg(ERR_MEMORY, "");
+        else for ( i=0; i<Nobjects[LINK]; i++ )
+        {
+            if ( Link[i].type == CONDUIT ) xsect_setGeomTable(&Link[i].xsect);
+        }
+    }
+
+    // --- adjust number of parallel threads to be used
+    NumThreads = MIN(NumThreads, omp_get_max_threads());
+    if ( Nobjects[LINK] < 4 * NumThreads ) NumThreads = 1;
+}
+
+//=============================================================================
+
 void project_close()
 //
 //  Input:   none
@@ -299,7 +398,7 @@ int  project_init(void)
 //  Purpose: initializes the internal state of all objects.
 // 
 {
-    int j, k;
+    int i, j, k;
     climate_initState();
     lid_initState();
     for (j=0; j<Nobjects[TSERIES]; j++)  table_tseriesInit(&Tseries[j]);
@@ -314,10 +413,14 @@ int  project_init(void)
             k++;
         }
     }
+    for (j=0; j<Nobjects[NODE]; j++)     node_initState(j);
+    for (j=0; j<Nobjects[LINK]; j++)     link_initState(j);
+
+    // --- output file positions of nodes & links follow input file order
     k = 1;
-    for (j=0; j<Nobjects[NODE]; j++)
+    for (i=0; i<Nobjects[NODE]; i++)
     {
-        node_initState(j);
+        j = project_getInternalIndex(NODE, i);
         if (Node[j].rptFlag > 0)
         {
             Node[j].rptFlag = k;
@@ -325,9 +428,9 @@ int  project_init(void)
         }
     }
     k = 1;        
-    for (j=0; j<Nobjects[LINK]; j++)
+    for (i=0; i<Nobjects[LINK]; i++)
     {
-        link_initState(j);
+        j = project_getInternalIndex(LINK, i);
         if (Link[j].rptFlag > 0)
         {
             Link[j].rptFlag = k;
@@ -358,6 +461,7 @@ int   project_addObject(int type, char *id, int n)
     // --- use memory from the hash tables' common memory pool to store
     //     a copy of the object's ID string
     len = (long)strlen(id);
+    AllocSetPool(IDPool);
     newID = (char *) Alloc((len+1)*sizeof(char));
     sstrncpy(newID, id, len);
 
@@ -395,6 +499,89 @@ char  *project_findID(int type, char *id)
 
 //=============================================================================
 
+void project_renumberObjects(int type, int inputIndex[])
+//
+//  Input:   type = object type
+//           inputIndex = input file position of the object that is
+//                        given each new index
+//  Output:  none
+//  Purpose: assigns new indexes to objects whose ID names have already
+//           been added to the project, before their data are read.
+//
+{
+    int i, n = Nobjects[type];
+
+    FREE(InternalIndex[type]);
+    FREE(InputIndex[type]);
+    InternalIndex[type] = (int *) calloc(n, sizeof(int));
+    InputIndex[type] = (int *) calloc(n, sizeof(int));
+    if ( InternalIndex[type] == NULL || InputIndex[type] == NULL )
+    {
+        report_writeErrorMsg(ERR_MEMORY, "");
+        return;
+    }
+    for (i = 0; i < n; i++)
+    {
+        InputIndex[type][i] = inputIndex[i];
+        InternalIndex[type][inputIndex[i]] = i;
+    }
+
+    // --- make ID names point to the new indexes
+    HTremap(Htable[type], InternalIndex[type]);
+}
+
+//=============================================================================
+
+int project_getInternalIndex(int type, int index)
+//
+//  Input:   type = object type
+//           index = object's position in the input file
+//  Output:  returns object's index in its project array
+//  Purpose: converts an input file position into an internal object index.
+//
+//  Nodes & links appear in reports, output files and toolkit functions
+//  in input file order even when they have been renumbered. Out of range
+//  values are returned unchanged.
+//
+{
+    if ( type < 0 || type >= MAX_OBJ_TYPES ) return index;
+    if ( InternalIndex[type] == NULL ) return index;
+    if ( index < 0 || index >= Nobjects[type] ) return index;
+    return InternalIndex[type][index];
+}
+
+//=============================================================================
+
+int project_getInputIndex(int type, int index)
+//
+//  Input:   type = object type
+//           index = object's index in its project array
+//  Output:  returns object's position in the input file
+//  Purpose: converts an internal object index into an input file position.
+//
+{
+    if ( type < 0 || type >= MAX_OBJ_TYPES ) return index;
+    if ( InputIndex[type] == NULL ) return index;
+    if ( index < 0 || index >= Nobjects[type] ) return index;
+    return InputIndex[type][index];
+}
+
+//=============================================================================
+
+void project_getIDs(int type, char* ids[])
+//
+//  Input:   type = object type
+//  Output:  ids = ID name of each object (NULL if it has none)
+//  Purpose: retrieves the ID names of all objects of a given type.
+//
+{
+    int i;
+    for (i = 0; i < Nobjects[type]; i++) ids[i] = NULL;
+    HTkeys(Htable[type], ids, Nobjects[type]);
+}
+
+//=============================================================================
+
 double ** project_createMatrix(int nrows, int ncols)
 //
 //  Input:   nrows = number of rows (0-based)
@@ -450,6 +637,37 @@ void project_freeMatrix(double **a)
 
 //=============================================================================
 
+void* project_alloc(int type, int n, size_t size)
+//
+//  Input:   type = object type
+//           n = number of items
+//           size = size of each item (bytes)
+//  Output:  returns a pointer to zeroed memory or NULL if none is available
+//  Purpose: allocates memory for data that lasts as long as the project
+//           from the memory pool of a type of object.
+//
+//  NOTE: the memory is only released by project_close, all at once, so
+//        it must not be freed by the caller.
+//
+{
+    char *p;
+    size_t nbytes = (size_t)n * size;
+
+    if ( n <= 0 || size == 0 ) return NULL;
+    if ( nbytes / size != (size_t)n || nbytes > LONG_MAX ) return NULL;
+    if ( ObjPool[type] == NULL )
+    {
+        ObjPool[type] = AllocInit();
+        if ( ObjPool[type] == NULL ) return NULL;
+    }
+    AllocSetPool(ObjPool[type]);
+    p = Alloc((long)nbytes);
+    if ( p ) memset(p, 0, nbytes);
+    return p;
+}
+
+//=============================================================================
+
 int project_readOption(char* s1, char* s2)
 //
 //  Input:   s1 = option keyword
@@ -489,6 +707,13 @@ int project_readOption(char* s1, char* s2)
 
       // --- choice of flow routing method
       case ROUTE_MODEL:
+        DynWaveSolver = PICARD_SOLVER;
+        if ( strcomp(s2, w_DYNWAVE_IMPLICIT) )
+        {
+            RouteModel = DW;
+            DynWaveSolver = NEWTON_SOLVER;
+            break;
+        }
         m = findmatch(s2, RouteModelWords);
         if ( m < 0 ) m = findmatch(s2, OldRouteModelWords);
         if ( m < 0 ) return error_setInpError(ERR_KEYWORD, s2);
@@ -611,6 +836,10 @@ int project_readOption(char* s1, char* s2)
       case ALLOW_PONDING:
       case SLOPE_WEIGHTING:
       case SKIP_STEADY_STATE:
+      case ACTIVE_SET:
+      case GEOM_CACHE:
+      case TSERIES_CACHE:
+      case COMPRESS_OUTPUT:
       case IGNORE_RAINFALL:
       case IGNORE_SNOWMELT:
       case IGNORE_GWATER:
@@ -624,6 +853,10 @@ int project_readOption(char* s1, char* s2)
           case ALLOW_PONDING:     AllowPonding    = m;  break;
           case SLOPE_WEIGHTING:   SlopeWeighting  = m;  break;
           case SKIP_STEADY_STATE: SkipSteadyState = m;  break;
+          case ACTIVE_SET:        ActiveSet       = m;  break;
+          case GEOM_CACHE:        GeomCache       = m;  break;
+          case TSERIES_CACHE:     TseriesCache    = m;  break;
+          case COMPRESS_OUTPUT:   CompressOutput  = m;  break;
           case IGNORE_RAINFALL:   IgnoreRainfall  = m;  break;
           case IGNORE_SNOWMELT:   IgnoreSnowmelt  = m;  break;
           case IGNORE_GWATER:     IgnoreGwater    = m;  break;
@@ -700,6 +933,22 @@ int project_readOption(char* s1, char* s2)
         NumThreads = m;
         break;
 
+      // --- fewest links a network must have to be routed in parallel
+      case MIN_PARALLEL:
+        m = atoi(s2);
+        if ( m < 0 ) return error_setInpError(ERR_NUMBER, s2);
+        MinParallelLinks = m;
+        break;
+
+      // --- number of time step classes (powers of two of the routing
+      //     step) that conduits are assigned to under dynamic wave routing
+      case STEP_CLASSES:
+        m = atoi(s2);
+        if ( m < 1 || m > MAXSTEPCLASSES )
+            return error_setInpError(ERR_NUMBER, s2);
+        StepClasses = m;
+        break;
+
       // --- safety factor applied to variable time step estimates under
       //     dynamic wave flow routing (value of 0 indicates that variable
       //     time step option not used)
@@ -768,6 +1017,13 @@ int project_readOption(char* s1, char* s2)
           SurchargeMethod = m;
           break;
 
+      // --- method used to renumber nodes & links
+      case RENUMBER:
+          m = findmatch(s2, RenumberWords);
+          if (m < 0) return error_setInpError(ERR_KEYWORD, s2);
+          Renumber = m;
+          break;
+
       case TEMPDIR: // Temporary Directory
         sstrncpy(TempDir, s2, MAXFNAME);
         break;
@@ -785,6 +1041,7 @@ void initPointers()
 //  Purpose: assigns NULL to all dynamic arrays for a new project.
 //
 {
+    int j;
     Gage     = NULL;
     Subcatch = NULL;
     Node     = NULL;
@@ -808,7 +1065,15 @@ void initPointers()
     UnitHyd  = NULL;
     Snowmelt = NULL;
     Event    = NULL;
-    MemPoolAllocated = FALSE;
+    IDPool   = NULL;
+    memset(&NodeQual, 0, sizeof(TQualMatrix));
+    memset(&LinkQual, 0, sizeof(TQualMatrix));
+    for (j = 0; j < MAX_OBJ_TYPES; j++)
+    {
+        InternalIndex[j] = NULL;
+        InputIndex[j] = NULL;
+        ObjPool[j] = NULL;
+    }
 }
 
 //=============================================================================
@@ -852,6 +1117,8 @@ void setDefaults()
    InfilModel      = HORTON;           // Horton infiltration method
    RouteModel      = DW;               // Dynamic wave flow routing method
    SurchargeMethod = EXTRAN;           // Use EXTRAN method for surcharging
+   DynWaveSolver   = PICARD_SOLVER;    // Picard iterations for dynamic wave
+   Renumber        = NO_RENUMBER;      // Keep nodes & links in input order
    CrownCutoff     = 0.96;             // Fractional pipe crown cutoff 
    AllowPonding    = FALSE;            // No ponding at nodes
    InertDamping    = PARTIAL_DAMPING;  // Partial inertial damping
@@ -863,6 +1130,11 @@ void setDefaults()
    MinSurfArea     = 0.0;              // Force use of default min. surface area
    MinSlope        = 0.0;              // No user supplied minimum conduit slope
    SkipSteadyState = FALSE;            // Do flow routing in steady state periods 
+   ActiveSet       = FALSE;            // Recompute all nodes on every trial
+   StepClasses     = 1;                // All conduits use the routing step
+   GeomCache       = FALSE;            // Evaluate xsect geometry exactly
+   TseriesCache    = FALSE;            // Read time series files as text
+   CompressOutput  = FALSE;            // Save uncompressed output results
    IgnoreRainfall  = FALSE;            // Analyze rainfall/runoff
    IgnoreRDII      = FALSE;            // Analyze RDII
    IgnoreSnowmelt  = FALSE;            // Analyze snowmelt 
@@ -881,6 +1153,7 @@ void setDefaults()
    SysFlowTol      = 0.05;             // System flow tolerance for steady state
    LatFlowTol      = 0.05;             // Lateral flow tolerance for steady state
    NumThreads      = 1;                // Number of parallel threads to use
+   MinParallelLinks = MINPARALLELLINKS; // Fewest links routed in parallel
    NumEvents       = 0;                // Number of detailed routing events
 
    // Deprecated options
@@ -908,6 +1181,9 @@ void setDefaults()
    RptFlags.nodes         = FALSE;
    RptFlags.links         = FALSE;
    RptFlags.averages      = FALSE;
+   RptFlags.subcatchVars  = 0;
+   RptFlags.nodeVars      = 0;
+   RptFlags.linkVars      = 0;
 
    // Temperature data
    Temp.dataSource  = NO_TEMP;
@@ -1014,31 +1290,33 @@ void createObjects()
 //        project_readInput().
 //
 {
-    int j, k;
+    int j, k, n;
+    double *initBuildup, *oldQual, *newQual, *pondedQual, *concPonded,
+           *totalLoad, *surfaceBuildup;
 
     // --- allocate memory for each category of object
     if ( ErrorCode ) return;
-    Gage     = (TGage *)     calloc(Nobjects[GAGE],     sizeof(TGage));
-    Subcatch = (TSubcatch *) calloc(Nobjects[SUBCATCH], sizeof(TSubcatch));
-    Node     = (TNode *)     calloc(Nobjects[NODE],     sizeof(TNode));
-    Outfall  = (TOutfall *)  calloc(Nnodes[OUTFALL],    sizeof(TOutfall));
-    Divider  = (TDivider *)  calloc(Nnodes[DIVIDER],    sizeof(TDivider));
-    Storage  = (TStorage *)  calloc(Nnodes[STORAGE],    sizeof(TStorage));
-    Link     = (TLink *)     calloc(Nobjects[LINK],     sizeof(TLink));
-    Conduit  = (TConduit *)  calloc(Nlinks[CONDUIT],    sizeof(TConduit));
-    Pump     = (TPump *)     calloc(Nlinks[PUMP],       sizeof(TPump));
-    Orifice  = (TOrifice *)  calloc(Nlinks[ORIFICE],    sizeof(TOrifice));
-    Weir     = (TWeir *)     calloc(Nlinks[WEIR],       sizeof(TWeir));
-    Outlet   = (TOutlet *)   calloc(Nlinks[OUTLET],     sizeof(TOutlet));
-    Pollut   = (TPollut *)   calloc(Nobjects[POLLUT],   sizeof(TPollut));
-    Landuse  = (TLanduse *)  calloc(Nobjects[LANDUSE],  sizeof(TLanduse));
-    Pattern  = (TPattern *)  calloc(Nobjects[TIMEPATTERN],  sizeof(TPattern));
-    Curve    = (TTable *)    calloc(Nobjects[CURVE],    sizeof(TTable));
-    Tseries  = (TTable *)    calloc(Nobjects[TSERIES],  sizeof(TTable));
-    Aquifer  = (TAquifer *)  calloc(Nobjects[AQUIFER],  sizeof(TAquifer));
-    UnitHyd  = (TUnitHyd *)  calloc(Nobjects[UNITHYD],  sizeof(TUnitHyd));
-    Snowmelt = (TSnowmelt *) calloc(Nobjects[SNOWMELT], sizeof(TSnowmelt));
-    Shape    = (TShape *)    calloc(Nobjects[SHAPE],    sizeof(TShape));
+    Gage     = (TGage *)     project_alloc(GAGE,     Nobjects[GAGE],     sizeof(TGage));
+    Subcatch = (TSubcatch *) project_alloc(SUBCATCH, Nobjects[SUBCATCH], sizeof(TSubcatch));
+    Node     = (TNode *)     project_alloc(NODE,     Nobjects[NODE],     sizeof(TNode));
+    Outfall  = (TOutfall *)  project_alloc(NODE,     Nnodes[OUTFALL],    sizeof(TOutfall));
+    Divider  = (TDivider *)  project_alloc(NODE,     Nnodes[DIVIDER],    sizeof(TDivider));
+    Storage  = (TStorage *)  project_alloc(NODE,     Nnodes[STORAGE],    sizeof(TStorage));
+    Link     = (TLink *)     project_alloc(LINK,     Nobjects[LINK],     sizeof(TLink));
+    Conduit  = (TConduit *)  project_alloc(LINK,     Nlinks[CONDUIT],    sizeof(TConduit));
+    Pump     = (TPump *)     project_alloc(LINK,     Nlinks[PUMP],       sizeof(TPump));
+    Orifice  = (TOrifice *)  project_alloc(LINK,     Nlinks[ORIFICE],    sizeof(TOrifice));
+    Weir     = (TWeir *)     project_alloc(LINK,     Nlinks[WEIR],       sizeof(TWeir));
+    Outlet   = (TOutlet *)   project_alloc(LINK,     Nlinks[OUTLET],     sizeof(TOutlet));
+    Pollut   = (TPollut *)   project_alloc(POLLUT,   Nobjects[POLLUT],   sizeof(TPollut));
+    Landuse  = (TLanduse *)  project_alloc(LANDUSE,  Nobjects[LANDUSE],  sizeof(TLanduse));
+    Pattern  = (TPattern *)  project_alloc(TIMEPATTERN, Nobjects[TIMEPATTERN], sizeof(TPattern));
+    Curve    = (TTable *)    project_alloc(CURVE,    Nobjects[CURVE],    sizeof(TTable));
+    Tseries  = (TTable *)    project_alloc(TSERIES,  Nobjects[TSERIES],  sizeof(TTable));
+    Aquifer  = (TAquifer *)  project_alloc(AQUIFER,  Nobjects[AQUIFER],  sizeof(TAquifer));
+    UnitHyd  = (TUnitHyd *)  project_alloc(UNITHYD,  Nobjects[UNITHYD],  sizeof(TUnitHyd));
+    Snowmelt = (TSnowmelt *) project_alloc(SNOWMELT, Nobjects[SNOWMELT], sizeof(TSnowmelt));
+    Shape    = (TShape *)    project_alloc(SHAPE,    Nobjects[SHAPE],    sizeof(TShape));
 
     // --- create array of detailed routing event periods
     Event = (TEvent *) calloc((size_t)NumEvents+1, sizeof(TEvent));
@@ -1066,25 +1344,36 @@ void createObjects()
     infil_create(Nobjects[SUBCATCH]);
 
     // --- allocate memory for water quality state variables
+    //     (each object's arrays are rows of contiguous pollutant matrices)
+    n = Nobjects[POLLUT];
+    createQualMatrix(&NodeQual, NODE, Nobjects[NODE]);
+    createQualMatrix(&LinkQual, LINK, Nobjects[LINK]);
+    initBuildup = createQualRows(Nobjects[SUBCATCH]);
+    oldQual = createQualRows(Nobjects[SUBCATCH]);
+    newQual = createQualRows(Nobjects[SUBCATCH]);
+    pondedQual = createQualRows(Nobjects[SUBCATCH]);
+    concPonded = createQualRows(Nobjects[SUBCATCH]);
+    totalLoad = createQualRows(Nobjects[SUBCATCH]);
+    surfaceBuildup = createQualRows(Nobjects[SUBCATCH]);
     for (j = 0; j < Nobjects[SUBCATCH]; j++)
     {
-        Subcatch[j].initBuildup =
-                              (double *) calloc(Nobjects[POLLUT], sizeof(double));
-        Subcatch[j].oldQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-        Subcatch[j].newQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-        Subcatch[j].pondedQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-        Subcatch[j].concPonded = (double *) calloc(Nobjects[POLLUT], sizeof(double));      // (OWA addition)
-        Subcatch[j].totalLoad  = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-        Subcatch[j].surfaceBuildup = (double *) calloc(Nobjects[POLLUT], sizeof(double));  // (OWA addition)
+        Subcatch[j].initBuildup = qualRow(initBuildup, j);
+        Subcatch[j].oldQual = qualRow(oldQual, j);
+        Subcatch[j].newQual = qualRow(newQual, j);
+        Subcatch[j].pondedQual = qualRow(pondedQual, j);
+        Subcatch[j].concPonded = qualRow(concPonded, j);             // (OWA addition)
+        Subcatch[j].totalLoad  = qualRow(totalLoad, j);
+        Subcatch[j].surfaceBuildup = qualRow(surfaceBuildup, j);     // (OWA addition)
     }
     for (j = 0; j < Nobjects[NODE]; j++)
     {
-        Node[j].oldQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-        Node[j].newQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-	Node[j].extQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));                 // (OWA addition)
-	Node[j].inQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));                  // (OWA addition)
-	Node[j].reactorQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));             // (OWA addition)
-	Node[j].extPollutFlag = (int *) calloc(Nobjects[POLLUT], sizeof(int));                 // (OWA addition)
+        Node[j].oldQual = qualRow(NodeQual.oldQual, j);
+        Node[j].newQual = qualRow(NodeQual.newQual, j);
+        Node[j].extQual = qualRow(NodeQual.extQual, j);               // (OWA addition)
+        Node[j].inQual = qualRow(NodeQual.inQual, j);                 // (OWA addition)
+        Node[j].reactorQual = qualRow(NodeQual.reactorQual, j);       // (OWA addition)
+        Node[j].extPollutFlag = NodeQual.extPollutFlag ?
+                                NodeQual.extPollutFlag + j*n : NULL;  // (OWA addition)
         Node[j].extInflow = NULL;
         Node[j].dwfInflow = NULL;
         Node[j].rdiiInflow = NULL;
@@ -1093,32 +1382,33 @@ void createObjects()
     for (j = 0; j < Nobjects[LINK]; j++)
     {
         Link[j].inlet = NULL;
-        Link[j].oldQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-        Link[j].newQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-	Link[j].extQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));                 // (OWA addition)
-        Link[j].totalLoad = (double *) calloc(Nobjects[POLLUT], sizeof(double));
-	Link[j].reactorQual = (double *) calloc(Nobjects[POLLUT], sizeof(double));             // (OWA addition)
-	Link[j].extPollutFlag = (int *) calloc(Nobjects[POLLUT], sizeof(int));                 // (OWA addition)
+        Link[j].oldQual = qualRow(LinkQual.oldQual, j);
+        Link[j].newQual = qualRow(LinkQual.newQual, j);
+        Link[j].extQual = qualRow(LinkQual.extQual, j);               // (OWA addition)
+        Link[j].totalLoad = qualRow(LinkQual.totalLoad, j);
+        Link[j].reactorQual = qualRow(LinkQual.reactorQual, j);       // (OWA addition)
+        Link[j].extPollutFlag = LinkQual.extPollutFlag ?
+                                LinkQual.extPollutFlag + j*n : NULL;  // (OWA addition)
     }
 
     // --- allocate memory for land use buildup/washoff functions
     for (j = 0; j < Nobjects[LANDUSE]; j++)
     {
         Landuse[j].buildupFunc =
-            (TBuildup *) calloc(Nobjects[POLLUT], sizeof(TBuildup));
+            (TBuildup *) project_alloc(LANDUSE, n, sizeof(TBuildup));
         Landuse[j].washoffFunc =
-            (TWashoff *) calloc(Nobjects[POLLUT], sizeof(TWashoff));
+            (TWashoff *) project_alloc(LANDUSE, n, sizeof(TWashoff));
     }
 
     // --- allocate memory for subcatchment landuse factors
     for (j = 0; j < Nobjects[SUBCATCH]; j++)
     {
-        Subcatch[j].landFactor =
-            (TLandFactor *) calloc(Nobjects[LANDUSE], sizeof(TLandFactor));
+        Subcatch[j].landFactor = (TLandFactor *)
+            project_alloc(SUBCATCH, Nobjects[LANDUSE], sizeof(TLandFactor));
         for (k = 0; k < Nobjects[LANDUSE]; k++)
         {
             Subcatch[j].landFactor[k].buildup =
-                (double *) calloc(Nobjects[POLLUT], sizeof(double));
+                (double *) project_alloc(SUBCATCH, n, sizeof(double));
         }
     }
 
@@ -1190,87 +1480,87 @@ void createObjects()
 
 //=============================================================================
 
+void createQualMatrix(TQualMatrix* m, int type, int n)
+//
+//  Input:   m = a set of pollutant matrices
+//           type = NODE or LINK
+//           n = number of nodes or links
+//  Output:  none
+//  Purpose: allocates the [element x pollutant] quality matrices of all
+//           nodes or links.
+//
+{
+    size_t rowSize = (size_t)Nobjects[POLLUT] * sizeof(double);
+    memset(m, 0, sizeof(TQualMatrix));
+    if ( Nobjects[POLLUT] == 0 ) return;
+    m->oldQual     = (double *) project_alloc(type, n, rowSize);
+    m->newQual     = (double *) project_alloc(type, n, rowSize);
+    m->extQual     = (double *) project_alloc(type, n, rowSize);
+    m->reactorQual = (double *) project_alloc(type, n, rowSize);
+    if ( type == NODE ) m->inQual = (double *) project_alloc(type, n, rowSize);
+    if ( type == LINK ) m->totalLoad = (double *) project_alloc(type, n, rowSize);
+    m->extPollutFlag = (int *) project_alloc(type, n,
+                               (size_t)Nobjects[POLLUT] * sizeof(int));
+}
+
+//=============================================================================
+
+double* createQualRows(int n)
+//
+//  Input:   n = number of subcatchments
+//  Output:  returns a [subcatchment x pollutant] matrix
+//  Purpose: allocates a quality matrix for all subcatchments.
+//
+{
+    if ( Nobjects[POLLUT] == 0 ) return NULL;
+    return (double *) project_alloc(SUBCATCH, n,
+                                    (size_t)Nobjects[POLLUT] * sizeof(double));
+}
+
+//=============================================================================
+
+double* qualRow(double* m, int j)
+//
+//  Input:   m = a pollutant matrix
+//           j = element index
+//  Output:  returns a pointer to the element's row of the matrix
+//  Purpose: finds the quality values of an element within a matrix.
+//
+{
+    if ( m == NULL ) return NULL;
+    return m + (size_t)j * Nobjects[POLLUT];
+}
+
+//=============================================================================
+
 void deleteObjects()
 //
 //  Input:   none
 //  Output:  none
 //  Purpose: frees memory allocated for a project's objects.
 //
-//  NOTE: care is taken to first free objects that are properties of another
-//        object before the latter is freed (e.g., we must free a
-//        subcatchment's land use factors before freeing the subcatchment).
+//  NOTE: object data held in the object memory pools (see project_alloc)
+//        are all freed at once at the end, so only resources held outside
+//        of them (files, math expressions & time series data) are released
+//        object by object.
 //
 {
-    int j, k;
-
-    // --- free memory for landuse factors & groundwater
-    if ( Subcatch ) for (j = 0; j < Nobjects[SUBCATCH]; j++)
-    {
-        for (k = 0; k < Nobjects[LANDUSE]; k++)
-        {
-            FREE(Subcatch[j].landFactor[k].buildup);
-        }
-        FREE(Subcatch[j].landFactor);
-        FREE(Subcatch[j].groundwater);
-        gwater_deleteFlowExpression(j);
-        FREE(Subcatch[j].snowpack);
-    }
+    int j;
 
-    // --- free memory for buildup/washoff functions
-    if ( Landuse ) for (j = 0; j < Nobjects[LANDUSE]; j++)
-    {
-        FREE(Landuse[j].buildupFunc);
-        FREE(Landuse[j].washoffFunc)
-    }
+    // --- free memory for cached cross section geometry
+    xsect_closeGeomCache();
 
-    // --- free memory for water quality state variables
+    // --- free groundwater flow expressions
     if ( Subcatch ) for (j = 0; j < Nobjects[SUBCATCH]; j++)
     {
-        FREE(Subcatch[j].initBuildup);
-        FREE(Subcatch[j].oldQual);
-        FREE(Subcatch[j].newQual);
-        FREE(Subcatch[j].pondedQual);
-        FREE(Subcatch[j].totalLoad);
-    }
-    if ( Node ) for (j = 0; j < Nobjects[NODE]; j++)
-    {
-        FREE(Node[j].oldQual);
-        FREE(Node[j].newQual);
-    }
-    if ( Link ) for (j = 0; j < Nobjects[LINK]; j++)
-    {
-        FREE(Link[j].oldQual);
-        FREE(Link[j].newQual);
-        FREE(Link[j].totalLoad);
-        // Any inlet assigned to Link[j].inlet is freed in inlet_delete().
+        gwater_deleteFlowExpression(j);
     }
 
     // --- free memory used for rainfall infiltration
     infil_delete();
 
-    // --- free memory used for storage exfiltration
-    if ( Node ) for (j = 0; j < Nnodes[STORAGE]; j++)
-    {
-        if ( Storage[j].exfil )
-        {
-            FREE(Storage[j].exfil->btmExfil);
-            FREE(Storage[j].exfil->bankExfil);
-            FREE(Storage[j].exfil);
-        }
-    }
-
-    // --- free memory used for outfall pollutants loads
-    if ( Node ) for (j = 0; j < Nnodes[OUTFALL]; j++)
-        FREE(Outfall[j].wRouted);
-
-    // --- free memory used for nodal inflows & treatment functions
-    if ( Node ) for (j = 0; j < Nobjects[NODE]; j++)
-    {
-        inflow_deleteExtInflows(j);
-        inflow_deleteDwfInflows(j);
-        rdii_deleteRdiiInflow(j);
-        treatmnt_delete(j);
-    }
+    // --- free nodal treatment functions
+    if ( Node ) for (j = 0; j < Nobjects[NODE]; j++) treatmnt_delete(j);
 
     // --- delete table entries for curves and time series
     if ( Tseries ) for (j = 0; j < Nobjects[TSERIES]; j++)
@@ -1291,29 +1581,39 @@ void deleteObjects()
     // --- delete LIDs
     lid_delete();
 
-    // --- now free each major category of object
-    FREE(Gage);
-    FREE(Subcatch);
-    FREE(Node);
-    FREE(Outfall);
-    FREE(Divider);
-    FREE(Storage);
-    FREE(Link);
-    FREE(Conduit);
-    FREE(Pump);
-    FREE(Orifice);
-    FREE(Weir);
-    FREE(Outlet);
-    FREE(Pollut);
-    FREE(Landuse);
-    FREE(Pattern);
-    FREE(Curve);
-    FREE(Tseries);
-    FREE(Aquifer);
-    FREE(UnitHyd);
-    FREE(Snowmelt);
-    FREE(Shape);
+    // --- now free the memory pools holding each category of object
+    deleteObjPools();
+    Gage     = NULL;
+    Subcatch = NULL;
+    Node     = NULL;
+    Outfall  = NULL;
+    Divider  = NULL;
+    Storage  = NULL;
+    Link     = NULL;
+    Conduit  = NULL;
+    Pump     = NULL;
+    Orifice  = NULL;
+    Weir     = NULL;
+    Outlet   = NULL;
+    Pollut   = NULL;
+    Landuse  = NULL;
+    Pattern  = NULL;
+    Curve    = NULL;
+    Tseries  = NULL;
+    Aquifer  = NULL;
+    UnitHyd  = NULL;
+    Snowmelt = NULL;
+    Shape    = NULL;
+    memset(&NodeQual, 0, sizeof(TQualMatrix));
+    memset(&LinkQual, 0, sizeof(TQualMatrix));
     FREE(Event);
+
+    // --- free renumbered index maps
+    for (j = 0; j < MAX_OBJ_TYPES; j++)
+    {
+        FREE(InternalIndex[j]);
+        FREE(InputIndex[j]);
+    }
 }
 
 //=============================================================================
@@ -1325,7 +1625,7 @@ void createHashTables()
 //  Purpose: allocates memory for object ID hash tables
 //
 {   int j;
-    MemPoolAllocated = FALSE;
+    IDPool = NULL;
     for (j = 0; j < MAX_OBJ_TYPES ; j++)
     {
         Htable[j] = HTcreate();
@@ -1333,8 +1633,30 @@ void createHashTables()
     }
 
     // --- initialize memory pool used to store object ID's
-    if ( AllocInit() == NULL ) report_writeErrorMsg(ERR_MEMORY, "");
-    else MemPoolAllocated = TRUE;
+    IDPool = AllocInit();
+    if ( IDPool == NULL ) report_writeErrorMsg(ERR_MEMORY, "");
+}
+
+//=============================================================================
+
+void reserveHashTables()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: sizes the object ID hash tables for the number of objects
+//           of each type.
+//
+{
+    int j;
+    if ( ErrorCode ) return;
+    for (j = 0; j < MAX_OBJ_TYPES; j++)
+    {
+        if ( !HTreserve(Htable[j], Nobjects[j]) )
+        {
+            report_writeErrorMsg(ERR_MEMORY, "");
+            return;
+        }
+    }
 }
 
 //=============================================================================
@@ -1353,7 +1675,33 @@ void deleteHashTables()
     }
 
     // --- free object ID memory pool
-    if ( MemPoolAllocated ) AllocFreePool();
+    if ( IDPool )
+    {
+        AllocSetPool(IDPool);
+        AllocFreePool();
+        IDPool = NULL;
+    }
+}
+
+//=============================================================================
+
+void deleteObjPools()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: frees the memory pools that hold the data of each type of object.
+//
+{
+    int j;
+    for (j = 0; j < MAX_OBJ_TYPES; j++)
+    {
+        if ( ObjPool[j] )
+        {
+            AllocSetPool(ObjPool[j]);
+            AllocFreePool();
+            ObjPool[j] = NULL;
+        }
+    }
 }
 
 //=============================================================================
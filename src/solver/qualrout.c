@@ -26,11 +26,17 @@
 //   Build 5.2.1:
 //   - Dry non-storage nodes now have quality determined by inflow.   
 //   - Wet non-storage nodes with no inflow now have no change in quality.
+//   Build 5.2.4 (OWA):
+//   - Quality is routed through the contiguous [element x pollutant]
+//     matrices NodeQual & LinkQual rather than each object's arrays.
+//   - New function qualrout_setOldState() replaces the old quality state
+//     of all nodes & links at once.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "headers.h"
 
@@ -45,6 +51,7 @@ static const double ZeroDepth  = 0.003281;  // 1 mm in ft
 //-----------------------------------------------------------------------------
 //  qualrout_init            (called by swmm_start)
 //  qualrout_execute         (called by routing_execute)
+//  qualrout_setOldState     (called by initSystemInflows in routing.c)
 
 //-----------------------------------------------------------------------------
 //  Function declarations
@@ -68,35 +75,64 @@ void    qualrout_init()
 //
 {
     int     i, p, isWet;
+    int     np = Nobjects[POLLUT];
     double  c;
 
     for (i = 0; i < Nobjects[NODE]; i++)
     {
         isWet = ( Node[i].newDepth > ZeroDepth );
-        for (p = 0; p < Nobjects[POLLUT]; p++)
+        for (p = 0; p < np; p++)
         {
             c = 0.0;
             if ( isWet ) c = Pollut[p].initConcen;
-            Node[i].oldQual[p] = c;
-            Node[i].newQual[p] = c;
+            NodeQual.oldQual[i*np + p] = c;
+            NodeQual.newQual[i*np + p] = c;
         }
     }
 
     for (i = 0; i < Nobjects[LINK]; i++)
     {
         isWet = ( Link[i].newDepth > ZeroDepth );
-        for (p = 0; p < Nobjects[POLLUT]; p++)
+        for (p = 0; p < np; p++)
         {
             c = 0.0;
             if ( isWet ) c = Pollut[p].initConcen;
-            Link[i].oldQual[p] = c;
-            Link[i].newQual[p] = c;
+            LinkQual.oldQual[i*np + p] = c;
+            LinkQual.newQual[i*np + p] = c;
         }
     }
 }
 
 //=============================================================================
 
+void qualrout_setOldState()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: replaces the old water quality state of all nodes and links
+//           with their new state and clears the new state.
+//
+{
+    size_t n;
+    int    np = Nobjects[POLLUT];
+
+    if ( np == 0 ) return;
+    n = (size_t)Nobjects[NODE] * np * sizeof(double);
+    if ( n > 0 )
+    {
+        memcpy(NodeQual.oldQual, NodeQual.newQual, n);
+        memset(NodeQual.newQual, 0, n);
+    }
+    n = (size_t)Nobjects[LINK] * np * sizeof(double);
+    if ( n > 0 )
+    {
+        memcpy(LinkQual.oldQual, LinkQual.newQual, n);
+        memset(LinkQual.newQual, 0, n);
+    }
+}
+
+//=============================================================================
+
 void qualrout_execute(double tStep)
 //
 //  Input:   tStep = routing time step (sec)
@@ -123,7 +159,7 @@ void qualrout_execute(double tStep)
         if ( Node[j].treatment || ExtPollutFlag == 1)  // (OWA EDIT: call treatmnt_setInflow when using toolkit API )
         {
             if ( qIn < ZERO ) qIn = 0.0;
-            treatmnt_setInflow(qIn, Node[j].newQual);
+            treatmnt_setInflow(qIn, &NodeQual.newQual[j*Nobjects[POLLUT]]);
         }
        
         // --- find new quality at the node 
@@ -191,7 +227,9 @@ void findLinkMassFlow(int i, double tStep)
 //           calculations made in routing_execute().
 {
     int    j, p;
+    int    np = Nobjects[POLLUT];
     double qLink, w;
+    double *cLink, *wNode, *load;
 
     // --- find inflow to downstream node
     qLink = Link[i].newFlow;
@@ -206,14 +244,17 @@ void findLinkMassFlow(int i, double tStep)
         qLink -= inlet_capturedFlow(i);
 
     // --- examine each pollutant
-    for (p = 0; p < Nobjects[POLLUT]; p++)
+    cLink = &LinkQual.oldQual[i*np];
+    wNode = &NodeQual.newQual[j*np];
+    load  = &LinkQual.totalLoad[i*np];
+    for (p = 0; p < np; p++)
     {
         // --- temporarily accumulate inflow load in Node[j].newQual
-        w = qLink * Link[i].oldQual[p];
-        Node[j].newQual[p] += w;
+        w = qLink * cLink[p];
+        wNode[p] += w;
 
         // --- update total load transported by link
-        Link[i].totalLoad[p] += w * tStep;
+        load[p] += w * tStep;
     }
     Node[j].qualInflow += qLink;
 }
@@ -228,26 +269,27 @@ void findNodeQual(int j)
 //
 {
     int    p;
+    int    np = Nobjects[POLLUT];
     double qNode;
+    double *cOld = &NodeQual.oldQual[j*np];
+    double *cNew = &NodeQual.newQual[j*np];
 
     // --- if there is flow into node then concen. = mass inflow/node flow
     qNode = Node[j].qualInflow;
     if ( qNode > ZERO )
     {
-        for (p = 0; p < Nobjects[POLLUT]; p++)
+        for (p = 0; p < np; p++)
         {
-            Node[j].newQual[p] /= qNode;
+            cNew[p] /= qNode;
         }
     }
 
     // --- otherwise concen. remains the same
-    else for (p = 0; p < Nobjects[POLLUT]; p++)
+    else if (Node[j].newDepth > ZeroDepth)
     {
-        if (Node[j].newDepth > ZeroDepth)
-            Node[j].newQual[p] = Node[j].oldQual[p];
-        else
-            Node[j].newQual[p] = 0.0;
+        for (p = 0; p < np; p++) cNew[p] = cOld[p];
     }
+    else for (p = 0; p < np; p++) cNew[p] = 0.0;
 }
 
 //=============================================================================
@@ -275,6 +317,10 @@ void findLinkQual(int i, double tStep)
            fEvap,            // evaporation concentration factor
            barrels,          // number of barrels in conduit
     	   lossExtQual;      // loss value for external quality (OWA addition)
+    int    np = Nobjects[POLLUT];
+    double *cNode,           // upstream node quality
+           *cOld,            // link quality at start of time step
+           *cNew;            // link quality at end of time step
 
     // --- identify index of upstream node
     j = Link[i].node1;
@@ -282,11 +328,14 @@ void findLinkQual(int i, double tStep)
 
     // --- link quality is that of upstream node when
     //     link is not a conduit or is a dummy link
+    cNode = &NodeQual.newQual[j*np];
+    cOld = &LinkQual.oldQual[i*np];
+    cNew = &LinkQual.newQual[i*np];
     if ( Link[i].type != CONDUIT || Link[i].xsect.type == DUMMY )
     {
-        for (p = 0; p < Nobjects[POLLUT]; p++)
+        for (p = 0; p < np; p++)
         {
-            Link[i].newQual[p] = Node[j].newQual[p];
+            cNew[p] = cNode[p];
         }
         return;
     }
@@ -325,10 +374,10 @@ void findLinkQual(int i, double tStep)
     }
 
     // --- examine each pollutant
-    for (p = 0; p < Nobjects[POLLUT]; p++)
+    for (p = 0; p < np; p++)
     {
         // --- start with concen. at start of time step
-        c1 = Link[i].oldQual[p];
+        c1 = cOld[p];
 
         // --- update mass balance accounting for seepage loss
         massbal_addSeepageLoss(p, qSeep*c1);
@@ -340,7 +389,7 @@ void findLinkQual(int i, double tStep)
         c2 = getReactedQual(p, c1, v1, tStep);
 
         // --- mix resulting contents with inflow from upstream node
-        wIn = Node[j].newQual[p]*qIn;
+        wIn = cNode[p]*qIn;
         c2 = getMixedQual(c2, v1, wIn, qIn, tStep);
 
         // --- set concen. to zero if remaining volume is negligible
@@ -355,22 +404,22 @@ void findLinkQual(int i, double tStep)
     // mass balance and assign qual
 
 	// --- set reactor qual for external pollutant handling
-	Link[i].reactorQual[p] = c2;
+	LinkQual.reactorQual[i*np + p] = c2;
 
-	if (Link[i].extPollutFlag[p] == 0)
+	if (LinkQual.extPollutFlag[i*np + p] == 0)
 	{
             // --- assign new concen. to link
-            Link[i].newQual[p] = c2;
+            cNew[p] = c2;
 	}
 	// --- update mass balance and set external pollutant
-	else if( Link[i].extPollutFlag[p] == 1)
+	else if( LinkQual.extPollutFlag[i*np + p] == 1)
 	{
 	    // --- mass balance update
-            lossExtQual = c2 - Link[i].extQual[p];
+            lossExtQual = c2 - LinkQual.extQual[i*np + p];
             lossExtQual = lossExtQual * v1/ tStep;
             massbal_addReactedMass(p, lossExtQual);
-            Link[i].newQual[p] = Link[i].extQual[p];
-            Link[i].extPollutFlag[p] = 0;
+            cNew[p] = LinkQual.extQual[i*np + p];
+            LinkQual.extPollutFlag[i*np + p] = 0;
 	}
     // ###################################################################
     }
@@ -389,14 +438,17 @@ void  findSFLinkQual(int i, double qSeep, double fEvap, double tStep)
 {
     int j = Link[i].node1;
     int p;
+    int np = Nobjects[POLLUT];
     double c1, c2;
     double lossRate;
+    double *cNode = &NodeQual.newQual[j*np];
+    double *cNew = &LinkQual.newQual[i*np];
 
     // --- examine each pollutant
-    for (p = 0; p < Nobjects[POLLUT]; p++)
+    for (p = 0; p < np; p++)
     {
         // --- conduit's quality equals upstream node quality
-        c1 = Node[j].newQual[p];
+        c1 = cNode[p];
 
         // --- update mass balance accounting for seepage loss
         massbal_addSeepageLoss(p, qSeep*c1);
@@ -413,7 +465,7 @@ void  findSFLinkQual(int i, double qSeep, double fEvap, double tStep)
             lossRate = (c1 - c2) * Link[i].newFlow;
             massbal_addReactedMass(p, lossRate);
         }
-        Link[i].newQual[p] = c2;
+        cNew[p] = c2;
     }
 }
 
@@ -437,6 +489,9 @@ void  findStorageQual(int j, double tStep)
            qExfil = 0.0,     // exfiltration rate from storage unit (cfs)
            vEvap = 0.0,      // evaporation loss from storage unit (ft3)
            fEvap = 1.0;      // evaporation concentration factor
+    int    np = Nobjects[POLLUT];
+    double *cOld = &NodeQual.oldQual[j*np],
+           *cNew = &NodeQual.newQual[j*np];
 
     // --- get inflow rate & initial volume
     qIn = Node[j].qualInflow;
@@ -461,10 +516,10 @@ void  findStorageQual(int j, double tStep)
     }
 
     // --- for each pollutant
-    for (p = 0; p < Nobjects[POLLUT]; p++)
+    for (p = 0; p < np; p++)
     {
         // --- start with concen. at start of time step 
-        c1 = Node[j].oldQual[p];
+        c1 = cOld[p];
 
         // --- update mass balance accounting for exfiltration loss
         massbal_addSeepageLoss(p, qExfil*c1);
@@ -481,7 +536,7 @@ void  findStorageQual(int j, double tStep)
 
         // --- mix resulting contents with inflow from all sources
         //     (temporarily accumulated in Node[j].newQual)
-        wIn = Node[j].newQual[p];
+        wIn = cNew[p];
         c2 = getMixedQual(c1, v1, wIn, qIn, tStep);
 
         // --- set concen. to zero if remaining volume & inflow is negligible
@@ -493,8 +548,8 @@ void  findStorageQual(int j, double tStep)
         }
 
         // --- assign new concen. to node
-        Node[j].newQual[p] = c2;
-	Node[j].reactorQual[p] = c2;    // (OWA addition)
+        cNew[p] = c2;
+	NodeQual.reactorQual[j*np + p] = c2;    // (OWA addition)
     }
 }
 
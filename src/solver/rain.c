@@ -66,20 +66,20 @@ enum ConditionCodes {NO_CONDITION, ACCUMULATED_PERIOD, DELETED_PERIOD,
 //-----------------------------------------------------------------------------
 //  Shared variables
 //-----------------------------------------------------------------------------
-TRainStats RainStats;                  // see objects.h for definition
-int        Condition;                  // rainfall condition code
-int        TimeOffset;                 // time offset of rainfall reading (sec)
-int        DataOffset;                 // start of data on line of input
-int        ValueOffset;                // start of rain value on input line
-int        RainType;                   // rain measurement type code
-int        Interval;                   // rain measurement interval (sec)
-double     UnitsFactor;                // units conversion factor
-float      RainAccum;                  // rainfall depth accumulation
-char       *StationID;                 // station ID appearing in rain file
-DateTime   AccumStartDate;             // date when accumulation begins
-DateTime   PreviousDate;               // date of previous rainfall record
-int        GageIndex;                  // index of rain gage analyzed
-int        hasStationName;             // true if data contains station name
+SWMM_TLS TRainStats RainStats;                  // see objects.h for definition
+SWMM_TLS int        Condition;                  // rainfall condition code
+SWMM_TLS int        TimeOffset;                 // time offset of rainfall reading (sec)
+SWMM_TLS int        DataOffset;                 // start of data on line of input
+SWMM_TLS int        ValueOffset;                // start of rain value on input line
+SWMM_TLS int        RainType;                   // rain measurement type code
+SWMM_TLS int        Interval;                   // rain measurement interval (sec)
+SWMM_TLS double     UnitsFactor;                // units conversion factor
+SWMM_TLS float      RainAccum;                  // rainfall depth accumulation
+SWMM_TLS char       *StationID;                 // station ID appearing in rain file
+SWMM_TLS DateTime   AccumStartDate;             // date when accumulation begins
+SWMM_TLS DateTime   PreviousDate;               // date of previous rainfall record
+SWMM_TLS int        GageIndex;                  // index of rain gage analyzed
+SWMM_TLS int        hasStationName;             // true if data contains station name
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
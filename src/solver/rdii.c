@@ -19,6 +19,8 @@
 //   - Rainfall climate adjustment implemented.
 //   Build 5.1.014:
 //   - Fixes bug related to isUsed property of a unit hydrograph's rain gage.
+//   Build 5.2.4 (OWA):
+//   - RDII inflow objects allocated from the nodes' memory pool.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -57,7 +59,7 @@ typedef struct                         // Data for a single unit hydrograph
    double    iaUsed;                   // initial abstraction used (in or mm)
 }  TUHData;
 
-typedef struct                         // Data for a unit hydrograph group
+typedef struct TUHGroup                // Data for a unit hydrograph group
 {                                      //---------------------------------
    int       isUsed;                   // true if UH group used by any nodes
    int       rainInterval;             // time interval for RDII processing (sec)
@@ -69,19 +71,19 @@ typedef struct                         // Data for a unit hydrograph group
 }  TUHGroup;
 
 //-----------------------------------------------------------------------------
-// Shared Variables
+// Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-static TUHGroup*  UHGroup;             // processing data for each UH group
-static int        RdiiStep;            // RDII time step (sec)
-static int        NumRdiiNodes;        // number of nodes w/ RDII data
-static int*       RdiiNodeIndex;       // indexes of nodes w/ RDII data
-static REAL4*     RdiiNodeFlow;        // inflows for nodes with RDII
-static int        RdiiFlowUnits;       // RDII flow units code
-static DateTime   RdiiStartDate;       // start date of RDII inflow period
-static DateTime   RdiiEndDate;         // end date of RDII inflow period
-static double     TotalRainVol;        // total rainfall volume (ft3)
-static double     TotalRdiiVol;        // total RDII volume (ft3)
-static int        RdiiFileType;        // type (binary/text) of RDII file
+#define UHGroup        (ActiveProject->rdii.UHGroup)
+#define RdiiStep       (ActiveProject->rdii.RdiiStep)
+#define NumRdiiNodes   (ActiveProject->rdii.NumRdiiNodes)
+#define RdiiNodeIndex  (ActiveProject->rdii.RdiiNodeIndex)
+#define RdiiNodeFlow   (ActiveProject->rdii.RdiiNodeFlow)
+#define RdiiFlowUnits  (ActiveProject->rdii.RdiiFlowUnits)
+#define RdiiStartDate  (ActiveProject->rdii.RdiiStartDate)
+#define RdiiEndDate    (ActiveProject->rdii.RdiiEndDate)
+#define TotalRainVol   (ActiveProject->rdii.TotalRainVol)
+#define TotalRdiiVol   (ActiveProject->rdii.TotalRdiiVol)
+#define RdiiFileType   (ActiveProject->rdii.RdiiFileType)
 
 //-----------------------------------------------------------------------------
 // Imported Variables
@@ -98,7 +100,6 @@ extern double Qcf[];                   // flow units conversion factors
 //  External functions (declared in funcs.h)
 //-----------------------------------------------------------------------------
 //  rdii_readRdiiInflow     (called from parseLine in input.c)
-//  rdii_deleteRdiiInflow   (called from deleteObjects in project.c)
 //  rdii_initUnitHyd        (called from createObjects in project.c)
 //  rdii_readUnitHydParams  (called from parseLine in input.c)
 //  rdii_openRdii           (called from rain_open)
@@ -180,7 +181,7 @@ int rdii_readRdiiInflow(char* tok[], int ntoks)
     inflow = Node[j].rdiiInflow;
     if ( inflow == NULL )
     {
-        inflow = (TRdiiInflow *) malloc(sizeof(TRdiiInflow));
+        inflow = (TRdiiInflow *) project_alloc(NODE, 1, sizeof(TRdiiInflow));
         if ( !inflow ) return error_setInpError(ERR_MEMORY, "");
     }
 
@@ -384,23 +385,6 @@ void setUnitHydParams(int j, int i, int m, double x[])
     }
 }
 
-//=============================================================================
-
-void rdii_deleteRdiiInflow(int j)
-//
-//  Input:   j = node index
-//  Output:  none
-//  Purpose: deletes the RDII inflow object for a node.
-//
-{
-    if ( Node[j].rdiiInflow )
-    {
-        free(Node[j].rdiiInflow);
-        Node[j].rdiiInflow = NULL;
-    }
-}
-
-
 //=============================================================================
 //                 Reading Inflow Data From a RDII File
 //=============================================================================
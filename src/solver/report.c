@@ -39,6 +39,13 @@
 //   - Support added for reporting most frequent non-converging links.
 //   - Support added for RptFlags.disabled flag.
 //   - Refactored report_readOptions().
+//   Build 5.2.4 (OWA):
+//   - Nodes & links listed in input file order when renumbered.
+//   - DYNWAVE_IMPLICIT routing method written to report.
+//   - ACTIVE_SET & TIME_STEP_CLASSES options written to report.
+//   - GEOMETRY_CACHE option written to report.
+//   - VARIABLES option added to report_readOptions().
+//   - COMPRESS_OUTPUT option written to report.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -60,21 +67,15 @@
 
 
 //-----------------------------------------------------------------------------
-//  Shared variables
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-static time_t SysTime;
+#define SysTime  (ActiveProject->report.SysTime)
 
 //-----------------------------------------------------------------------------
 //  Imported variables
 //-----------------------------------------------------------------------------
 #define REAL4 float
-extern REAL4* SubcatchResults;         // Results vectors defined in OUTPUT.C
-extern REAL4* NodeResults;             //  "
-extern REAL4* LinkResults;             //  "
-extern char   ErrString[81];           // defined in ERROR.C
-
-
-extern TNodeStats*     NodeStats;
+extern SWMM_TLS char ErrString[256];   // defined in ERROR.C
 
 
 //-----------------------------------------------------------------------------
@@ -89,6 +90,7 @@ static void report_NodeHeader(char *id);
 static void report_Links(void);
 static void report_LinkHeader(char *id);
 static void report_RouteStepFreq(TTimeStepStats* timeStepStats);
+static int  report_readVariables(char* tok[], int ntoks);
 
 //=============================================================================
 
@@ -106,6 +108,9 @@ int report_readOptions(char* tok[], int ntoks)
     k = (char)findmatch(tok[0], ReportWords);
     if ( k < 0 ) return error_setInpError(ERR_KEYWORD, tok[0]);
 
+    // --- VARIABLES keyword
+    if ( k == 10 ) return report_readVariables(tok, ntoks);
+
     // --- keyword not SUBCATCHMENT, NODE, or LINK
     if (k < 2 || k > 4)
     {
@@ -170,6 +175,59 @@ int report_readOptions(char* tok[], int ntoks)
 
 //=============================================================================
 
+int report_readVariables(char* tok[], int ntoks)
+//
+//  Input:   tok[] = array of string tokens
+//           ntoks = number of tokens
+//  Output:  returns an error code
+//  Purpose: reads which result variables of a type of object are saved
+//           to the binary output file.
+//
+//  Format of input line is:
+//     VARIABLES  SUBCATCHMENTS/NODES/LINKS  ALL / var1 var2 ...
+//  where QUALITY selects the concentrations of all pollutants.
+//
+{
+    int    m, t;
+    int*   flags;
+    char** words;
+
+    if ( ntoks < 3 ) return error_setInpError(ERR_ITEMS, "");
+    if ( match(tok[1], w_SUBCATCH) )
+    {
+        flags = &RptFlags.subcatchVars;
+        words = SubcatchVarWords;
+    }
+    else if ( match(tok[1], w_NODE) )
+    {
+        flags = &RptFlags.nodeVars;
+        words = NodeVarWords;
+    }
+    else if ( match(tok[1], w_LINK) )
+    {
+        flags = &RptFlags.linkVars;
+        words = LinkVarWords;
+    }
+    else return error_setInpError(ERR_KEYWORD, tok[1]);
+
+    // --- a variable's bit flag is its position in the list of keywords
+    //     (which follows the order of the object's results vector)
+    if ( strcomp(tok[2], w_ALL) )
+    {
+        *flags = 0;
+        return 0;
+    }
+    for (t = 2; t < ntoks; t++)
+    {
+        m = findmatch(tok[t], words);
+        if ( m < 0 ) return error_setInpError(ERR_KEYWORD, tok[t]);
+        *flags |= 1 << m;
+    }
+    return 0;
+}
+
+//=============================================================================
+
 void report_writeLine(const char *line)
 //
 //  Input:   line = line of text
@@ -311,13 +369,22 @@ void report_writeOptions()
     fprintf(Frpt.file, "\n  Infiltration Method ...... %s",
         InfilModelWords[InfilModel]);
     if ( Nobjects[LINK] > 0 )
-    fprintf(Frpt.file, "\n  Flow Routing Method ...... %s",
-        RouteModelWords[RouteModel]);
+    {
+        if ( RouteModel == DW && DynWaveSolver == NEWTON_SOLVER )
+            fprintf(Frpt.file, "\n  Flow Routing Method ...... %s",
+                w_DYNWAVE_IMPLICIT);
+        else fprintf(Frpt.file, "\n  Flow Routing Method ...... %s",
+            RouteModelWords[RouteModel]);
+    }
 
     if (RouteModel == DW)
     fprintf(Frpt.file, "\n  Surcharge Method ......... %s",
         SurchargeWords[SurchargeMethod]);
 
+    if ( Renumber != NO_RENUMBER )
+    fprintf(Frpt.file, "\n  Node Renumbering ......... %s",
+        RenumberWords[Renumber]);
+
     datetime_dateToStr(StartDate, str);
     fprintf(Frpt.file, "\n  Starting Date ............ %s", str);
     datetime_timeToStr(StartTime, str);
@@ -329,6 +396,8 @@ void report_writeOptions()
     fprintf(Frpt.file, "\n  Antecedent Dry Days ...... %.1f", StartDryDays);
     datetime_timeToStr(datetime_encodeTime(0, 0, ReportStep), str);
     fprintf(Frpt.file, "\n  Report Time Step ......... %s", str);
+    if ( CompressOutput )
+    fprintf(Frpt.file, "\n  Compressed Output ........ YES");
     if ( Nobjects[SUBCATCH] > 0 )
     {
         datetime_timeToStr(datetime_encodeTime(0, 0, WetStep), str);
@@ -339,12 +408,18 @@ void report_writeOptions()
     if ( Nobjects[LINK] > 0 )
     {
         fprintf(Frpt.file, "\n  Routing Time Step ........ %.2f sec", RouteStep);
+        if ( GeomCache )
+        fprintf(Frpt.file, "\n  Geometry Cache ........... YES");
         if ( RouteModel == DW )
         {
             fprintf(Frpt.file, "\n  Variable Time Step ....... ");
             if ( CourantFactor > 0.0 ) fprintf(Frpt.file, "YES");
             else                       fprintf(Frpt.file, "NO");
             fprintf(Frpt.file, "\n  Maximum Trials ........... %d", MaxTrials);
+            if ( ActiveSet )
+            fprintf(Frpt.file, "\n  Active Set Trials ........ YES");
+            if ( StepClasses > 1 )
+            fprintf(Frpt.file, "\n  Time Step Classes ........ %d", StepClasses);
             fprintf(Frpt.file, "\n  Number of Threads ........ %d", NumThreads);
             fprintf(Frpt.file, "\n  Head Tolerance ........... %.6f ",
                 HeadTol*UCF(LENGTH));
@@ -1024,7 +1099,8 @@ void report_writeNonconvergedStats(TMaxStats maxNonconverged[], int nMaxStats)
     WRITE("*********************************");
     WRITE("Most Frequent Nonconverging Nodes");
     WRITE("*********************************");
-    if (nMaxStats <= 0 || maxNonconverged[0].index <= 0 ||
+    if (nMaxStats <= 0 ||
+        project_getInputIndex(NODE, maxNonconverged[0].index) <= 0 ||
         maxNonconverged[0].value < 0.00005)
         fprintf(Frpt.file, "\n  Convergence obtained at all time steps.");
     else
@@ -1273,7 +1349,7 @@ void report_Nodes()
 //  Purpose: writes results for selected nodes to report file.
 //
 {
-    int      j, p, k;
+    int      i, j, p, k;
     int      period;
     DateTime days;
     char     theDate[DATE_STR_SIZE];
@@ -1284,8 +1360,9 @@ void report_Nodes()
     WRITE("************************");
     WRITE("Node Time Series Results");
     WRITE("************************");
-    for (j = 0; j < Nobjects[NODE]; j++)
+    for (i = 0; i < Nobjects[NODE]; i++)
     {
+        j = project_getInternalIndex(NODE, i);
         k = Node[j].rptFlag - 1;
         if ( k >= 0 )
         {
@@ -1351,7 +1428,7 @@ void report_Links()
 //  Purpose: writes results for selected links to report file.
 //
 {
-    int      j, p, k;
+    int      i, j, p, k;
     int      period;
     DateTime days;
     char     theDate[DATE_STR_SIZE];
@@ -1362,8 +1439,9 @@ void report_Links()
     WRITE("************************");
     WRITE("Link Time Series Results");
     WRITE("************************");
-    for (j = 0; j < Nobjects[LINK]; j++)
+    for (i = 0; i < Nobjects[LINK]; i++)
     {
+        j = project_getInternalIndex(LINK, i);
         k = Link[j].rptFlag - 1;
         if ( k >= 0 )
         {
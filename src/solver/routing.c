@@ -37,6 +37,8 @@
 //   Build 5.2.0:
 //   - Support added for street flow capture and sewer backflow thru inlets.
 //   - Shell sort replaces insertion sort for sorting Event array.
+//   Build 5.2.4 (OWA):
+//   - Old quality state of all nodes & links replaced in a single call.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -47,12 +49,12 @@
 #include "headers.h"
 #include "lid.h"
 //-----------------------------------------------------------------------------
-// Shared variables
+// Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-static int* SortedLinks;
-static int  NextEvent;
-static int  BetweenEvents;
-static double NewRuleTime;
+#define SortedLinks    (ActiveProject->routing.SortedLinks)
+#define NextEvent      (ActiveProject->routing.NextEvent)
+#define BetweenEvents  (ActiveProject->routing.BetweenEvents)
+#define NewRuleTime    (ActiveProject->routing.NewRuleTime)
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
@@ -316,8 +318,7 @@ void  initSystemInflows()
     // --- replace old water quality state with new state
     if ( Nobjects[POLLUT] > 0 )
     {
-        for (j=0; j<Nobjects[NODE]; j++) node_setOldQualState(j);
-        for (j=0; j<Nobjects[LINK]; j++) link_setOldQualState(j);
+        qualrout_setOldState();
     }
 
     // --- set infiltration factor for storage unit seepage
@@ -40,26 +40,14 @@
 #include "odesolve.h"
 
 //-----------------------------------------------------------------------------
-// Shared variables
+// Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-static char  IsRaining;                // TRUE if precip. falls on study area
-static char  HasRunoff;                // TRUE if study area generates runoff
-static char  HasSnow;                  // TRUE if any snow cover on study area
-static int   Nsteps;                   // number of runoff time steps taken
-static int   MaxSteps;                 // final number of runoff time steps
-static long  MaxStepsPos;              // position in Runoff interface file
-                                       //    where MaxSteps is saved
-
-//-----------------------------------------------------------------------------
-//  Exportable variables 
-//-----------------------------------------------------------------------------
-char    HasWetLids;  // TRUE if any LIDs are wet (used in lidproc.c)
-double* OutflowLoad; // exported pollutant mass load (used in surfqual.c)
-
-//-----------------------------------------------------------------------------
-//  Imported variables
-//-----------------------------------------------------------------------------
-extern float* SubcatchResults;         // Results vector defined in OUTPUT.C
+#define IsRaining    (ActiveProject->runoff.IsRaining)
+#define HasRunoff    (ActiveProject->runoff.HasRunoff)
+#define HasSnow      (ActiveProject->runoff.HasSnow)
+#define Nsteps       (ActiveProject->runoff.Nsteps)
+#define MaxSteps     (ActiveProject->runoff.MaxSteps)
+#define MaxStepsPos  (ActiveProject->runoff.MaxStepsPos)
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
@@ -16,8 +16,8 @@
 //-----------------------------------------------------------------------------
 //  Shared variables
 //-----------------------------------------------------------------------------
-static double Atotal;
-static double Ptotal;
+static SWMM_TLS double Atotal;
+static SWMM_TLS double Ptotal;
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
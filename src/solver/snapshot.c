@@ -0,0 +1,1024 @@
+//-----------------------------------------------------------------------------
+//   snapshot.c
+//
+//   Project:  EPA SWMM5
+//   Version:  5.2
+//   Date:     10/16/26   (Build 5.2.4 (OWA))
+//
+//   Compiled project files.
+//
+//   A compiled project file is a binary snapshot of a project as it stands
+//   once its input file has been read and validated by swmm_open. It is
+//   written by swmm_saveCompiled and read by swmm_openCompiled, which lets
+//   repeated runs of a large model skip parsing and validating its input.
+//
+//   The file holds, in order:
+//   o a signature and the sizes of the structures saved in it
+//   o the number of each type of object
+//   o analysis options, climate data and the names of interface files
+//   o the ID names of each type of object
+//   o the data of each type of object
+//   o the text of input sections that are read again when loading.
+//
+//   Objects are saved as they are held in memory, so a compiled file can
+//   only be read by a build of the engine with the same structure layouts
+//   (which is checked when the file is opened). Pointers found in these
+//   structures are not saved; the data they refer to are written after
+//   the structure and the pointers are rebuilt when the file is read.
+//
+//   The following are not saved:
+//   o control rules, treatment functions and groundwater flow expressions,
+//     whose input lines are saved instead and parsed again when loading
+//   o data of time series held in external files and of the climate file,
+//     which are opened again (so their contents can change between runs)
+//   o warnings issued while the project was validated.
+//   Projects with LID controls or street inlets cannot be compiled.
+//-----------------------------------------------------------------------------
+#define _CRT_SECURE_NO_DEPRECATE
+
+#include <stdlib.h>
+#include <string.h>
+#include "headers.h"
+#include "infil.h"
+#include "exfil.h"
+
+//-----------------------------------------------------------------------------
+//  Constants
+//-----------------------------------------------------------------------------
+static const char SNAP_SIGNATURE[8] = {'S','W','M','M','C','M','P','2'};
+#define  SNAP_BUFSIZE  (1 << 20)       // size of file I/O buffer (bytes)
+
+// Sizes of the structures saved to a compiled file
+static const int StructSizes[] = {
+    (int)sizeof(void*),      (int)sizeof(long),        (int)sizeof(TFile),
+    (int)sizeof(TRptFlags),  (int)sizeof(TTemp),       (int)sizeof(TEvap),
+    (int)sizeof(TWind),      (int)sizeof(TSnow),       (int)sizeof(TAdjust),
+    (int)sizeof(TGage),      (int)sizeof(TSubcatch),   (int)sizeof(TGroundwater),
+    (int)sizeof(TSnowpack),  (int)sizeof(TAquifer),    (int)sizeof(TSnowmelt),
+    (int)sizeof(TUnitHyd),   (int)sizeof(TNode),       (int)sizeof(TExtInflow),
+    (int)sizeof(TDwfInflow), (int)sizeof(TRdiiInflow), (int)sizeof(TOutfall),
+    (int)sizeof(TDivider),   (int)sizeof(TStorage),    (int)sizeof(TExfil),
+    (int)sizeof(TGrnAmpt),   (int)sizeof(TLink),       (int)sizeof(TConduit),
+    (int)sizeof(TPump),      (int)sizeof(TOrifice),    (int)sizeof(TWeir),
+    (int)sizeof(TOutlet),    (int)sizeof(TPollut),     (int)sizeof(TLanduse),
+    (int)sizeof(TBuildup),   (int)sizeof(TWashoff),    (int)sizeof(TPattern),
+    (int)sizeof(TTable),     (int)sizeof(TTransect),   (int)sizeof(TStreet),
+    (int)sizeof(TShape),     (int)sizeof(TEvent)
+};
+#define  N_STRUCT_SIZES  (int)(sizeof(StructSizes) / sizeof(int))
+
+// Input sections that are saved as text
+static const int TextSections[] = {s_CONTROL, s_TREATMENT, s_GWF};
+#define  N_TEXT_SECTIONS  (int)(sizeof(TextSections) / sizeof(int))
+
+//-----------------------------------------------------------------------------
+//  Shared variables
+//-----------------------------------------------------------------------------
+static SWMM_TLS FILE*   SnapFile;               // compiled project file
+static SWMM_TLS int     Saving;                 // TRUE if file is written
+static SWMM_TLS int     SnapError;              // error code from file I/O
+static SWMM_TLS char**  IDs[MAX_OBJ_TYPES];     // ID name of each object
+
+//-----------------------------------------------------------------------------
+//  External functions (declared in funcs.h)
+//-----------------------------------------------------------------------------
+//  snapshot_save   (called by swmm_saveCompiled in swmm5.c)
+//  snapshot_open   (called by project_readCompiled in project.c)
+//  snapshot_read   (called by project_readCompiled in project.c)
+
+//-----------------------------------------------------------------------------
+//  Local functions
+//-----------------------------------------------------------------------------
+static void   xfer(void* data, size_t size);
+static void*  newBlock(int type, void* saved, size_t size);
+static void*  newTableData(void* saved, size_t size);
+static char*  loadedID(int type, int j, char* savedID);
+static void   xferHeader(void);
+static void   xferCounts(void);
+static void   xferOptions(void);
+static void   xferFile(TFile* file);
+static void   xferIDs(void);
+static void   xferObjects(void);
+static void   xferSubcatchments(void);
+static void   xferNodes(void);
+static void   xferExtInflows(TExtInflow** first);
+static void   xferDwfInflows(TDwfInflow** first);
+static void   xferStorage(void);
+static void   xferLinks(void);
+static void   xferLanduses(void);
+static void   xferTables(TTable* tables, int type);
+static void   xferText(char** text, size_t* size);
+static void   freeIDs(void);
+
+// Transfers a variable to or from the file
+#define XFER(x)  xfer(&(x), sizeof(x))
+
+//=============================================================================
+
+int snapshot_save(const char* fname)
+//
+//  Input:   fname = name of compiled project file
+//  Output:  returns error code
+//  Purpose: saves the current project to a compiled project file.
+//
+{
+    char*  text = NULL;
+    size_t textSize = 0;
+    int    err;
+
+    // --- check for objects that can't be saved
+    if ( Nobjects[LID] > 0 )
+    {
+        report_writeErrorMsg(ERR_COMPILED_OBJECTS, "LID controls");
+        return ErrorCode;
+    }
+    if ( Nobjects[INLET] > 0 )
+    {
+        report_writeErrorMsg(ERR_COMPILED_OBJECTS, "street inlets");
+        return ErrorCode;
+    }
+
+    // --- copy the input sections that are saved as text
+    err = input_copySections(TextSections, N_TEXT_SECTIONS, &text, &textSize);
+    if ( err )
+    {
+        report_writeErrorMsg(err, "");
+        return ErrorCode;
+    }
+
+    // --- open the compiled file
+    SnapFile = fopen(fname, "wb");
+    if ( SnapFile == NULL )
+    {
+        FREE(text);
+        report_writeErrorMsg(ERR_COMPILED_FILE_OPEN, (char *)fname);
+        return ErrorCode;
+    }
+    setvbuf(SnapFile, NULL, _IOFBF, SNAP_BUFSIZE);
+    Saving = TRUE;
+    SnapError = 0;
+
+    // --- write the project to the file
+    xferHeader();
+    xferCounts();
+    xferOptions();
+    xferIDs();
+    xferObjects();
+    xferText(&text, &textSize);
+    if ( fclose(SnapFile) != 0 && !SnapError )
+        SnapError = ERR_COMPILED_FILE_WRITE;
+    SnapFile = NULL;
+    FREE(text);
+    freeIDs();
+
+    // --- don't leave an incomplete file behind
+    if ( SnapError )
+    {
+        remove(fname);
+        report_writeErrorMsg(SnapError, (char *)fname);
+    }
+    return ErrorCode;
+}
+
+//=============================================================================
+
+int snapshot_open()
+//
+//  Input:   none
+//  Output:  returns error code
+//  Purpose: opens the compiled project file named as the project's input
+//           file and reads the number of each type of object from it.
+//
+{
+    int i;
+
+    // --- open the file
+    SnapFile = fopen(Finp.name, "rb");
+    if ( SnapFile == NULL )
+    {
+        report_writeErrorMsg(ERR_COMPILED_FILE_OPEN, Finp.name);
+        return ErrorCode;
+    }
+    setvbuf(SnapFile, NULL, _IOFBF, SNAP_BUFSIZE);
+    Saving = FALSE;
+    SnapError = 0;
+
+    // --- read the file's header & object counts
+    xferHeader();
+    xferCounts();
+    for (i = 0; i < MAX_OBJ_TYPES; i++)
+    {
+        if ( Nobjects[i] < 0 ) SnapError = ERR_COMPILED_FILE_READ;
+    }
+    if ( NumEvents < 0 ) SnapError = ERR_COMPILED_FILE_READ;
+
+    // --- reset the counts if they could not be read
+    if ( SnapError )
+    {
+        for (i = 0; i < MAX_OBJ_TYPES; i++) Nobjects[i] = 0;
+        for (i = 0; i < MAX_NODE_TYPES; i++) Nnodes[i] = 0;
+        for (i = 0; i < MAX_LINK_TYPES; i++) Nlinks[i] = 0;
+        NumEvents = 0;
+        fclose(SnapFile);
+        SnapFile = NULL;
+        report_writeErrorMsg(SnapError, Finp.name);
+    }
+    return ErrorCode;
+}
+
+//=============================================================================
+
+int snapshot_read()
+//
+//  Input:   none
+//  Output:  returns error code
+//  Purpose: reads the data of a project's objects from the compiled project
+//           file opened by snapshot_open and then closes the file.
+//
+//  NOTE: the project's objects have already been created.
+//
+{
+    char*  text = NULL;
+    size_t textSize = 0;
+
+    if ( SnapFile == NULL ) return ErrorCode;
+    if ( !ErrorCode )
+    {
+        xferOptions();
+        xferIDs();
+        xferObjects();
+        xferText(&text, &textSize);
+    }
+    fclose(SnapFile);
+    SnapFile = NULL;
+    freeIDs();
+
+    // --- parse the input sections saved as text
+    if ( SnapError ) report_writeErrorMsg(SnapError, Finp.name);
+    else if ( !ErrorCode ) input_readSections(text, textSize);
+    FREE(text);
+    return ErrorCode;
+}
+
+//=============================================================================
+
+void xfer(void* data, size_t size)
+//
+//  Input:   data = pointer to data
+//           size = size of data (bytes)
+//  Output:  none
+//  Purpose: writes data to or reads data from the compiled project file.
+//
+{
+    if ( SnapError || size == 0 ) return;
+    if ( Saving )
+    {
+        if ( fwrite(data, size, 1, SnapFile) != 1 )
+            SnapError = ERR_COMPILED_FILE_WRITE;
+    }
+    else if ( fread(data, size, 1, SnapFile) != 1 )
+        SnapError = ERR_COMPILED_FILE_READ;
+}
+
+//=============================================================================
+
+void* newBlock(int type, void* saved, size_t size)
+//
+//  Input:   type = type of object that owns the data
+//           saved = value of a pointer when the project was saved
+//           size = size of the data it points to (bytes)
+//  Output:  returns a pointer to newly allocated memory
+//  Purpose: allocates memory from an object type's memory pool in place of
+//           a saved pointer that was not NULL.
+//
+{
+    void* p;
+
+    if ( saved == NULL || size == 0 || SnapError ) return NULL;
+    p = project_alloc(type, 1, size);
+    if ( p == NULL ) SnapError = ERR_MEMORY;
+    return p;
+}
+
+//=============================================================================
+
+void* newTableData(void* saved, size_t size)
+//
+//  Input:   saved = value of a pointer when the project was saved
+//           size = size of the data it points to (bytes)
+//  Output:  returns a pointer to newly allocated memory
+//  Purpose: allocates memory for a table's data arrays (which are freed by
+//           table_deleteEntries) in place of a saved pointer that was not NULL.
+//
+{
+    void* p;
+
+    if ( saved == NULL || size == 0 || SnapError ) return NULL;
+    p = calloc(1, size);
+    if ( p == NULL ) SnapError = ERR_MEMORY;
+    return p;
+}
+
+//=============================================================================
+
+char* loadedID(int type, int j, char* savedID)
+//
+//  Input:   type = object type
+//           j = object index
+//           savedID = object's ID pointer when the project was saved
+//  Output:  returns a pointer to the object's ID name
+//  Purpose: finds the ID name of a loaded object.
+//
+{
+    if ( savedID == NULL || SnapError || IDs[type] == NULL ) return NULL;
+    return IDs[type][j];
+}
+
+//=============================================================================
+
+void xferHeader()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the file's signature & the sizes of the structures
+//           it contains.
+//
+{
+    char signature[sizeof(SNAP_SIGNATURE)];
+    int  sizes[N_STRUCT_SIZES];
+    int  n = N_STRUCT_SIZES;
+
+    memcpy(signature, SNAP_SIGNATURE, sizeof(signature));
+    memcpy(sizes, StructSizes, sizeof(sizes));
+    XFER(signature);
+    XFER(n);
+    if ( !Saving && !SnapError &&
+         (memcmp(signature, SNAP_SIGNATURE, sizeof(signature)) != 0 ||
+          n != N_STRUCT_SIZES) ) SnapError = ERR_COMPILED_FILE_READ;
+    XFER(sizes);
+    if ( !Saving && !SnapError &&
+         memcmp(sizes, StructSizes, sizeof(sizes)) != 0 )
+        SnapError = ERR_COMPILED_FILE_READ;
+}
+
+//=============================================================================
+
+void xferCounts()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the number of each type of object.
+//
+{
+    XFER(Nobjects);
+    XFER(Nnodes);
+    XFER(Nlinks);
+    XFER(NumEvents);
+    XFER(ActiveProject->controls.VariableCount);
+    XFER(ActiveProject->controls.ExpressionCount);
+}
+
+//=============================================================================
+
+void xferOptions()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers analysis options, climate data & interface file names.
+//
+{
+    void* infil;
+    size_t infilSize, size;
+
+    XFER(Title);
+    XFER(TempDir);
+    XFER(RptFlags);
+
+    // --- analysis options
+    XFER(UnitSystem);
+    XFER(FlowUnits);
+    XFER(InfilModel);
+    XFER(RouteModel);
+    XFER(ForceMainEqn);
+    XFER(LinkOffsets);
+    XFER(SurchargeMethod);
+    XFER(DynWaveSolver);
+    XFER(Renumber);
+    XFER(ActiveSet);
+    XFER(StepClasses);
+    XFER(GeomCache);
+    XFER(TseriesCache);
+    XFER(CompressOutput);
+    XFER(AllowPonding);
+    XFER(InertDamping);
+    XFER(NormalFlowLtd);
+    XFER(SlopeWeighting);
+    XFER(Compatibility);
+    XFER(SkipSteadyState);
+    XFER(IgnoreRainfall);
+    XFER(IgnoreRDII);
+    XFER(IgnoreSnowmelt);
+    XFER(IgnoreGwater);
+    XFER(IgnoreRouting);
+    XFER(IgnoreQuality);
+    XFER(WetStep);
+    XFER(DryStep);
+    XFER(ReportStep);
+    XFER(RuleStep);
+    XFER(SweepStart);
+    XFER(SweepEnd);
+    XFER(MaxTrials);
+    XFER(NumThreads);
+    XFER(MinParallelLinks);
+    XFER(ExtPollutFlag);
+    XFER(RouteStep);
+    XFER(MinRouteStep);
+    XFER(LengtheningStep);
+    XFER(StartDryDays);
+    XFER(CourantFactor);
+    XFER(MinSurfArea);
+    XFER(MinSlope);
+    XFER(HeadTol);
+    XFER(SysFlowTol);
+    XFER(LatFlowTol);
+    XFER(CrownCutoff);
+
+    // --- analysis period
+    XFER(StartDate);
+    XFER(StartTime);
+    XFER(StartDateTime);
+    XFER(EndDate);
+    XFER(EndTime);
+    XFER(EndDateTime);
+    XFER(ReportStartDate);
+    XFER(ReportStartTime);
+    XFER(ReportStart);
+    XFER(TotalDuration);
+
+    // --- climate data
+    XFER(Temp);
+    XFER(Evap);
+    XFER(Wind);
+    XFER(Snow);
+    XFER(Adjust);
+
+    // --- interface files
+    xferFile(&Fclimate);
+    xferFile(&Frain);
+    xferFile(&Frunoff);
+    xferFile(&Frdii);
+    xferFile(&Fhotstart1);
+    xferFile(&Fhotstart2);
+    xferFile(&Finflows);
+    xferFile(&Foutflows);
+
+    // --- infiltration parameters of all subcatchments
+    //     (held by infil.c, see infil_getData)
+    infil = infil_getData(&infilSize);
+    size = infilSize;
+    XFER(size);
+    if ( !Saving && !SnapError && size != infilSize )
+        SnapError = ERR_COMPILED_FILE_READ;
+    xfer(infil, infilSize);
+}
+
+//=============================================================================
+
+void xferFile(TFile* file)
+//
+//  Input:   file = an interface file
+//  Output:  none
+//  Purpose: transfers the name & usage of an interface file.
+//
+{
+    XFER(file->name);
+    XFER(file->mode);
+}
+
+//=============================================================================
+
+void xferIDs()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the ID names of all objects (other than control rules,
+//           which are parsed again).
+//
+//  NOTE: the input file position of each object is saved along with its
+//        ID so that renumbered nodes & links keep their new indexes.
+//
+{
+    int    type, i, n, len, renumbered;
+    int*   inputIndex;
+    char   id[MAXLINE+1];
+
+    for (type = 0; type < MAX_OBJ_TYPES; type++)
+    {
+        if ( type == CONTROL || SnapError ) continue;
+        n = Nobjects[type];
+        if ( n == 0 ) continue;
+        IDs[type] = (char **) calloc(n, sizeof(char *));
+        inputIndex = (int *) calloc(n, sizeof(int));
+        if ( IDs[type] == NULL || inputIndex == NULL )
+        {
+            FREE(inputIndex);
+            SnapError = ERR_MEMORY;
+            return;
+        }
+
+        // --- transfer the input file position of each object
+        renumbered = FALSE;
+        if ( Saving )
+        {
+            project_getIDs(type, IDs[type]);
+            for (i = 0; i < n; i++)
+            {
+                inputIndex[i] = project_getInputIndex(type, i);
+                if ( inputIndex[i] != i ) renumbered = TRUE;
+            }
+        }
+        XFER(renumbered);
+        xfer(inputIndex, n * sizeof(int));
+
+        // --- transfer each ID name (saved as its length & characters)
+        for (i = 0; i < n && !SnapError; i++)
+        {
+            if ( Saving )
+            {
+                len = IDs[type][i] ? (int)strlen(IDs[type][i]) : -1;
+                XFER(len);
+                if ( len > 0 ) xfer(IDs[type][i], len);
+                continue;
+            }
+            XFER(len);
+            if ( SnapError || len < 0 ) continue;
+            if ( len > MAXLINE || inputIndex[i] < 0 || inputIndex[i] >= n )
+            {
+                SnapError = ERR_COMPILED_FILE_READ;
+                break;
+            }
+            xfer(id, len);
+            id[len] = '\0';
+            if ( SnapError ) break;
+            if ( project_addObject(type, id, inputIndex[i]) <= 0 )
+            {
+                SnapError = ERR_COMPILED_FILE_READ;
+                break;
+            }
+            IDs[type][i] = project_findID(type, id);
+        }
+
+        // --- restore the indexes of renumbered objects
+        if ( !Saving && renumbered && !SnapError )
+            project_renumberObjects(type, inputIndex);
+        free(inputIndex);
+    }
+}
+
+//=============================================================================
+
+void xferObjects()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the data of all objects.
+//
+{
+    int j;
+    int np = Nobjects[POLLUT];
+
+    // --- rain gages
+    xfer(Gage, Nobjects[GAGE] * sizeof(TGage));
+    if ( !Saving ) for (j = 0; j < Nobjects[GAGE]; j++)
+        Gage[j].ID = loadedID(GAGE, j, Gage[j].ID);
+
+    // --- hydrology objects
+    xfer(Aquifer, Nobjects[AQUIFER] * sizeof(TAquifer));
+    if ( !Saving ) for (j = 0; j < Nobjects[AQUIFER]; j++)
+        Aquifer[j].ID = loadedID(AQUIFER, j, Aquifer[j].ID);
+    xfer(Snowmelt, Nobjects[SNOWMELT] * sizeof(TSnowmelt));
+    if ( !Saving ) for (j = 0; j < Nobjects[SNOWMELT]; j++)
+        Snowmelt[j].ID = loadedID(SNOWMELT, j, Snowmelt[j].ID);
+    xfer(UnitHyd, Nobjects[UNITHYD] * sizeof(TUnitHyd));
+    if ( !Saving ) for (j = 0; j < Nobjects[UNITHYD]; j++)
+        UnitHyd[j].ID = loadedID(UNITHYD, j, UnitHyd[j].ID);
+    xferSubcatchments();
+
+    // --- nodes
+    xferNodes();
+    xfer(Outfall, Nnodes[OUTFALL] * sizeof(TOutfall));
+    if ( !Saving ) for (j = 0; j < Nnodes[OUTFALL]; j++)
+    {
+        // --- an outfall's routed loads are only accumulated at run time
+        if ( Outfall[j].wRouted == NULL || SnapError )
+        {
+            Outfall[j].wRouted = NULL;
+            continue;
+        }
+        Outfall[j].wRouted = (double *) project_alloc(NODE, np, sizeof(double));
+        if ( Outfall[j].wRouted == NULL && np > 0 ) SnapError = ERR_MEMORY;
+    }
+    xfer(Divider, Nnodes[DIVIDER] * sizeof(TDivider));
+    xferStorage();
+
+    // --- links
+    xferLinks();
+    xfer(Conduit, Nlinks[CONDUIT] * sizeof(TConduit));
+    xfer(Pump, Nlinks[PUMP] * sizeof(TPump));
+    xfer(Orifice, Nlinks[ORIFICE] * sizeof(TOrifice));
+    xfer(Weir, Nlinks[WEIR] * sizeof(TWeir));
+    xfer(Outlet, Nlinks[OUTLET] * sizeof(TOutlet));
+
+    // --- water quality objects
+    xfer(Pollut, np * sizeof(TPollut));
+    if ( !Saving ) for (j = 0; j < np; j++)
+        Pollut[j].ID = loadedID(POLLUT, j, Pollut[j].ID);
+    xferLanduses();
+
+    // --- patterns, curves & time series
+    xfer(Pattern, Nobjects[TIMEPATTERN] * sizeof(TPattern));
+    if ( !Saving ) for (j = 0; j < Nobjects[TIMEPATTERN]; j++)
+        Pattern[j].ID = loadedID(TIMEPATTERN, j, Pattern[j].ID);
+    xferTables(Curve, CURVE);
+    xferTables(Tseries, TSERIES);
+
+    // --- cross section geometry
+    xfer(Transect, Nobjects[TRANSECT] * sizeof(TTransect));
+    if ( !Saving ) for (j = 0; j < Nobjects[TRANSECT]; j++)
+        Transect[j].ID = loadedID(TRANSECT, j, Transect[j].ID);
+    xfer(Street, Nobjects[STREET] * sizeof(TStreet));
+    if ( !Saving ) for (j = 0; j < Nobjects[STREET]; j++)
+    {
+        Street[j].ID = loadedID(STREET, j, Street[j].ID);
+        Street[j].transect.ID = NULL;
+    }
+    xfer(Shape, Nobjects[SHAPE] * sizeof(TShape));
+
+    // --- routing events (the sentinel event that follows them was
+    //     created along with the array)
+    xfer(Event, NumEvents * sizeof(TEvent));
+}
+
+//=============================================================================
+
+void xferSubcatchments()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the data of all subcatchments.
+//
+{
+    int j, k;
+    int np = Nobjects[POLLUT];
+    TSubcatch sc;
+
+    for (j = 0; j < Nobjects[SUBCATCH]; j++)
+    {
+        sc = Subcatch[j];
+        XFER(sc);
+        if ( !Saving )
+        {
+            // --- keep arrays created along with the subcatchment
+            sc.ID = loadedID(SUBCATCH, j, sc.ID);
+            sc.initBuildup = Subcatch[j].initBuildup;
+            sc.landFactor = Subcatch[j].landFactor;
+            sc.oldQual = Subcatch[j].oldQual;
+            sc.newQual = Subcatch[j].newQual;
+            sc.pondedQual = Subcatch[j].pondedQual;
+            sc.concPonded = Subcatch[j].concPonded;
+            sc.totalLoad = Subcatch[j].totalLoad;
+            sc.surfaceBuildup = Subcatch[j].surfaceBuildup;
+
+            // --- create its optional objects
+            sc.groundwater = (TGroundwater *)
+                newBlock(SUBCATCH, sc.groundwater, sizeof(TGroundwater));
+            sc.snowpack = (TSnowpack *)
+                newBlock(SUBCATCH, sc.snowpack, sizeof(TSnowpack));
+            sc.gwLatFlowExpr = NULL;
+            sc.gwDeepFlowExpr = NULL;
+            Subcatch[j] = sc;
+        }
+
+        // --- transfer the contents of its arrays & objects
+        xfer(sc.initBuildup, np * sizeof(double));
+        for (k = 0; k < Nobjects[LANDUSE]; k++)
+        {
+            XFER(sc.landFactor[k].fraction);
+            XFER(sc.landFactor[k].lastSwept);
+            xfer(sc.landFactor[k].buildup, np * sizeof(double));
+        }
+        if ( sc.groundwater ) XFER(*sc.groundwater);
+        if ( sc.snowpack ) XFER(*sc.snowpack);
+    }
+}
+
+//=============================================================================
+
+void xferNodes()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the data of all nodes.
+//
+{
+    int j;
+    TNode node;
+
+    for (j = 0; j < Nobjects[NODE]; j++)
+    {
+        node = Node[j];
+        XFER(node);
+        if ( !Saving )
+        {
+            // --- keep arrays created along with the node
+            node.ID = loadedID(NODE, j, node.ID);
+            node.extPollutFlag = Node[j].extPollutFlag;
+            node.oldQual = Node[j].oldQual;
+            node.newQual = Node[j].newQual;
+            node.extQual = Node[j].extQual;
+            node.inQual = Node[j].inQual;
+            node.reactorQual = Node[j].reactorQual;
+
+            // --- create its inflow objects (treatment functions are
+            //     parsed again)
+            node.rdiiInflow = (TRdiiInflow *)
+                newBlock(NODE, node.rdiiInflow, sizeof(TRdiiInflow));
+            node.extInflow = NULL;
+            node.dwfInflow = NULL;
+            node.treatment = NULL;
+            Node[j] = node;
+        }
+        if ( node.rdiiInflow ) XFER(*node.rdiiInflow);
+        xferExtInflows(&Node[j].extInflow);
+        xferDwfInflows(&Node[j].dwfInflow);
+    }
+}
+
+//=============================================================================
+
+void xferExtInflows(TExtInflow** first)
+//
+//  Input:   first = first external inflow object in a node's list
+//  Output:  none
+//  Purpose: transfers a node's list of external inflows.
+//
+{
+    int i, n = 0;
+    TExtInflow*  inflow;
+    TExtInflow** last = first;
+
+    if ( Saving ) for (inflow = *first; inflow; inflow = inflow->next) n++;
+    XFER(n);
+    inflow = *first;
+    for (i = 0; i < n && !SnapError; i++)
+    {
+        if ( !Saving )
+        {
+            inflow = (TExtInflow *) project_alloc(NODE, 1, sizeof(TExtInflow));
+            if ( inflow == NULL )
+            {
+                SnapError = ERR_MEMORY;
+                return;
+            }
+            *last = inflow;
+            last = &inflow->next;
+        }
+        XFER(*inflow);
+        if ( Saving ) inflow = inflow->next;
+        else inflow->next = NULL;
+    }
+}
+
+//=============================================================================
+
+void xferDwfInflows(TDwfInflow** first)
+//
+//  Input:   first = first dry weather inflow object in a node's list
+//  Output:  none
+//  Purpose: transfers a node's list of dry weather inflows.
+//
+{
+    int i, n = 0;
+    TDwfInflow*  inflow;
+    TDwfInflow** last = first;
+
+    if ( Saving ) for (inflow = *first; inflow; inflow = inflow->next) n++;
+    XFER(n);
+    inflow = *first;
+    for (i = 0; i < n && !SnapError; i++)
+    {
+        if ( !Saving )
+        {
+            inflow = (TDwfInflow *) project_alloc(NODE, 1, sizeof(TDwfInflow));
+            if ( inflow == NULL )
+            {
+                SnapError = ERR_MEMORY;
+                return;
+            }
+            *last = inflow;
+            last = &inflow->next;
+        }
+        XFER(*inflow);
+        if ( Saving ) inflow = inflow->next;
+        else inflow->next = NULL;
+    }
+}
+
+//=============================================================================
+
+void xferStorage()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the data of all storage units.
+//
+{
+    int k;
+    TExfil* exfil;
+
+    xfer(Storage, Nnodes[STORAGE] * sizeof(TStorage));
+    for (k = 0; k < Nnodes[STORAGE]; k++)
+    {
+        if ( !Saving )
+            Storage[k].exfil = (TExfil *) newBlock(NODE, Storage[k].exfil,
+                                                   sizeof(TExfil));
+        exfil = Storage[k].exfil;
+        if ( exfil == NULL ) continue;
+        XFER(*exfil);
+        if ( !Saving )
+        {
+            exfil->btmExfil = (TGrnAmpt *) newBlock(NODE, exfil->btmExfil,
+                                                    sizeof(TGrnAmpt));
+            exfil->bankExfil = (TGrnAmpt *) newBlock(NODE, exfil->bankExfil,
+                                                     sizeof(TGrnAmpt));
+        }
+        if ( exfil->btmExfil ) XFER(*exfil->btmExfil);
+        if ( exfil->bankExfil ) XFER(*exfil->bankExfil);
+    }
+}
+
+//=============================================================================
+
+void xferLinks()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the data of all links.
+//
+{
+    int j;
+    TLink link;
+
+    for (j = 0; j < Nobjects[LINK]; j++)
+    {
+        link = Link[j];
+        XFER(link);
+        if ( Saving ) continue;
+
+        // --- keep arrays created along with the link
+        link.ID = loadedID(LINK, j, link.ID);
+        link.extPollutFlag = Link[j].extPollutFlag;
+        link.oldQual = Link[j].oldQual;
+        link.newQual = Link[j].newQual;
+        link.totalLoad = Link[j].totalLoad;
+        link.extQual = Link[j].extQual;
+        link.reactorQual = Link[j].reactorQual;
+
+        // --- cached geometry tables are assigned when validated
+        link.inlet = NULL;
+        link.xsect.geomTable = NULL;
+        Link[j] = link;
+    }
+}
+
+//=============================================================================
+
+void xferLanduses()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: transfers the data of all land uses.
+//
+{
+    int j;
+    int np = Nobjects[POLLUT];
+    TLanduse landuse;
+
+    for (j = 0; j < Nobjects[LANDUSE]; j++)
+    {
+        landuse = Landuse[j];
+        XFER(landuse);
+        if ( !Saving )
+        {
+            landuse.ID = loadedID(LANDUSE, j, landuse.ID);
+            landuse.buildupFunc = Landuse[j].buildupFunc;
+            landuse.washoffFunc = Landuse[j].washoffFunc;
+            Landuse[j] = landuse;
+        }
+        xfer(landuse.buildupFunc, np * sizeof(TBuildup));
+        xfer(landuse.washoffFunc, np * sizeof(TWashoff));
+    }
+}
+
+//=============================================================================
+
+void xferTables(TTable* tables, int type)
+//
+//  Input:   tables = array of curves or time series
+//           type = CURVE or TSERIES
+//  Output:  none
+//  Purpose: transfers the data of all curves or time series.
+//
+//  NOTE: only the name of a time series' external data file is saved, the
+//        file is read again when the project is validated.
+//
+{
+    int    j, n;
+    TTable table, saved;
+
+    for (j = 0; j < Nobjects[type]; j++)
+    {
+        table = tables[j];
+
+        // --- save a table that reads an external file as if unread
+        if ( Saving && table.file.mode == USE_FILE )
+        {
+            saved = table;
+            table_init(&table);
+            table.ID = saved.ID;
+            table.curveType = saved.curveType;
+            table.refersTo = saved.refersTo;
+            table.file = saved.file;
+            table.lastDate = StartDate + StartTime;
+        }
+        XFER(table);
+        n = table.nEntries;
+        if ( !Saving )
+        {
+            if ( n < 0 ) SnapError = ERR_COMPILED_FILE_READ;
+            table.ID = loadedID(type, j, table.ID);
+            table.firstEntry = NULL;
+            table.lastEntry = NULL;
+            table.xData = (double *) newTableData(table.xData,
+                                                  n * sizeof(double));
+            table.yData = (double *) newTableData(table.yData,
+                                                  n * sizeof(double));
+            table.vData = (double *) newTableData(table.vData,
+                                                  2 * n * sizeof(double));
+            table.wData = table.vData ? table.vData + n : NULL;
+            table.file.file = NULL;
+            table.cache = NULL;
+            tables[j] = table;
+        }
+        if ( table.xData ) xfer(table.xData, n * sizeof(double));
+        if ( table.yData ) xfer(table.yData, n * sizeof(double));
+        if ( table.vData ) xfer(table.vData, 2 * n * sizeof(double));
+    }
+}
+
+//=============================================================================
+
+void xferText(char** text, size_t* size)
+//
+//  Input:   text = text of input sections
+//           size = length of text (bytes)
+//  Output:  none
+//  Purpose: transfers the text of the input sections that are parsed again.
+//
+{
+    long long n = (long long)*size;
+
+    XFER(n);
+    if ( Saving )
+    {
+        xfer(*text, *size);
+        return;
+    }
+    if ( SnapError || n == 0 ) return;
+    if ( n < 0 )
+    {
+        SnapError = ERR_COMPILED_FILE_READ;
+        return;
+    }
+    *text = (char *) malloc((size_t)n);
+    if ( *text == NULL )
+    {
+        SnapError = ERR_MEMORY;
+        return;
+    }
+    *size = (size_t)n;
+    xfer(*text, *size);
+}
+
+//=============================================================================
+
+void freeIDs()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: frees the arrays of ID names used while transferring objects.
+//
+{
+    int type;
+    for (type = 0; type < MAX_OBJ_TYPES; type++) FREE(IDs[type]);
+}
@@ -17,6 +17,8 @@
 //     water leaves a snowpack.
 //   Build 5.2.0:
 //   - Subcatchment snow pack area should not include LID area.
+//   Build 5.2.4 (OWA):
+//   - Snowpack objects allocated from the subcatchments' memory pool.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -132,7 +134,7 @@ int snow_createSnowpack(int j, int k)
 //
 {
     TSnowpack* snowpack;
-    snowpack = (TSnowpack *) malloc(sizeof(TSnowpack));
+    snowpack = (TSnowpack *) project_alloc(SUBCATCH, 1, sizeof(TSnowpack));
     if ( !snowpack ) return FALSE;
     Subcatch[j].snowpack = snowpack;
     snowpack->snowmeltIndex = k;
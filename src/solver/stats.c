@@ -37,6 +37,12 @@
 //   - Support added for reporting most frequent non-converging nodes.
 //   - Support added for RptFlags.disabled option.
 //   - Fixed display of routing statistics report for RptFlags.flowStats = FALSE.
+//   Build 5.2.4 (OWA):
+//   - Critical nodes & links searched in input file order.
+//   - Node & link flow statistics updated in parallel again, with system
+//     outfall flow summed afterwards in node order.
+//   - Count of links visited by dynamic wave trials kept with the routing
+//     time step statistics.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -46,34 +52,14 @@
 #include "headers.h"
 
 //-----------------------------------------------------------------------------
-//  Shared variables
+//  Shared variables (held in the project context, see globals.h)
 //-----------------------------------------------------------------------------
-#define MAX_STATS 5
-static TTimeStepStats  TimeStepStats;
-static TMaxStats       MaxMassBalErrs[MAX_STATS];
-static TMaxStats       MaxCourantCrit[MAX_STATS];
-static TMaxStats       MaxFlowTurns[MAX_STATS];
-static TMaxStats       MaxNonConverged[MAX_STATS];
-static double          SysOutfallFlow;
-
-//-----------------------------------------------------------------------------
-//  Exportable variables (shared with statsrpt.c)
-//-----------------------------------------------------------------------------
-TSubcatchStats* SubcatchStats;
-TNodeStats*     NodeStats;
-TLinkStats*     LinkStats;
-TStorageStats*  StorageStats;
-TOutfallStats*  OutfallStats;
-TPumpStats*     PumpStats;
-double          MaxOutfallFlow;
-double          MaxRunoffFlow;
-double          RoutingTimeSpan;
-
-//-----------------------------------------------------------------------------
-//  Imported variables
-//-----------------------------------------------------------------------------
-extern double*         NodeInflow;     // defined in massbal.c
-extern double*         NodeOutflow;    // defined in massbal.c
+#define TimeStepStats    (ActiveProject->stats.TimeStepStats)
+#define MaxMassBalErrs   (ActiveProject->stats.MaxMassBalErrs)
+#define MaxCourantCrit   (ActiveProject->stats.MaxCourantCrit)
+#define MaxFlowTurns     (ActiveProject->stats.MaxFlowTurns)
+#define MaxNonConverged  (ActiveProject->stats.MaxNonConverged)
+#define SysOutfallFlow   (ActiveProject->stats.SysOutfallFlow)
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
@@ -85,6 +71,7 @@ extern double*         NodeOutflow;    // defined in massbal.c
 //  stats_updateGwaterStats       (called from gwater_getGroundwater)
 //  stats_updateFlowStats         (called from routing_execute)
 //  stats_updateTimeStepStats     (called from routing_execute)
+//  stats_updateLinkTrials        (called from dynwave_execute)
 //  stats_updateCriticalTimeCount (called from getVariableStep in dynwave.c)
 //  stats_updateMaxNodeDepth      (called from output_saveNodeResults)
 //  stats_updateConvergenceStats  (called from updateConvergenceStats in dynwave.c)
@@ -293,6 +280,7 @@ int  stats_open()
     TimeStepStats.minTimeStep = RouteStep;
     TimeStepStats.routingTime = 0.0;
     TimeStepStats.trialsCount = 0.0;
+    TimeStepStats.linkTrialsCount = 0.0;
     TimeStepStats.steadyStateTime = 0.0;
     TimeStepStats.timeStepCount = 0;
 
@@ -455,22 +443,32 @@ void   stats_updateFlowStats(double tStep, DateTime aDate)
 //
 {
     int   j;
+    TProject* project = ActiveProject;
 
     // --- update stats only after reporting period begins
     if ( aDate < ReportStart ) return;
-    SysOutfallFlow = 0.0;
 
     // --- update node & link stats
-//#pragma omp parallel num_threads(NumThreads)
+#pragma omp parallel num_threads(NumThreads) \
+    if ( Nobjects[LINK] >= MinParallelLinks )
 {
-//    #pragma omp for
+    ActiveProject = project;  // worker threads work on the caller's project
+    #pragma omp for
     for ( j=0; j<Nobjects[NODE]; j++ )
         stats_updateNodeStats(j, tStep, aDate);
-//    #pragma omp for
+    #pragma omp for
     for ( j=0; j<Nobjects[LINK]; j++ )
         stats_updateLinkStats(j, tStep, aDate);
 }
 
+    // --- add up system outfall flow in node order (so the sum doesn't
+    //     depend on the number of threads)
+    SysOutfallFlow = 0.0;
+    for ( j=0; j<Nobjects[NODE]; j++ )
+    {
+        if ( Node[j].type == OUTFALL ) SysOutfallFlow += Node[j].inflow;
+    }
+
     // --- update count of time steps taken after reporting begins
     ReportStepCount++;
     RoutingTimeSpan += tStep;
@@ -517,6 +515,21 @@ void stats_updateTimeStepStats(double tStep, int trialsCount, int steadyState)
     }
 }
 
+//=============================================================================
+
+void stats_updateLinkTrials(int linkCount)
+//
+//  Input:   linkCount = number of links visited over the trials of a
+//                       dynamic wave time step
+//  Output:  none
+//  Purpose: updates count of links visited by flow routing trials.
+//
+//  Note: links left out of a trial by ACTIVE_SET or held over a time step
+//        by TIME_STEP_CLASSES aren't visited.
+{
+    TimeStepStats.linkTrialsCount += linkCount;
+}
+
 //=============================================================================
    
 void stats_updateCriticalTimeCount(int node, int link)
@@ -620,7 +633,6 @@ void stats_updateNodeStats(int j, double tStep, DateTime aDate)
             OutfallStats[k].totalLoad[p] += 
                 Node[j].inflow * Node[j].newQual[p] * tStep;
         }
-        SysOutfallFlow += Node[j].inflow;
     }
 
     // --- update inflow statistics
@@ -760,8 +772,11 @@ void  stats_findMaxStats()
 //  Purpose: finds nodes & links with highest mass balance errors
 //           & highest times Courant time-step critical.
 //
+//  Nodes & links are examined in input file order so that ties are
+//  listed the same way when a project's objects are renumbered.
+//
 {
-    int    j;
+    int    i, j;
     double x, z;
     double stepCount;
 
@@ -784,16 +799,18 @@ void  stats_findMaxStats()
     {
         stepCount = ReportStepCount;
         z = 100.0 / (2./3. * (stepCount - 2.));
-        for (j=0; j<Nobjects[LINK]; j++)
+        for (i=0; i<Nobjects[LINK]; i++)
         {
+            j = project_getInternalIndex(LINK, i);
             x = LinkStats[j].flowTurns * z;
             stats_updateMaxStats(MaxFlowTurns, LINK, j, x);
         }
     }
 
     // --- find nodes with largest mass balance errors
-    for (j=0; j<Nobjects[NODE]; j++)
+    for (i=0; i<Nobjects[NODE]; i++)
     {
+        j = project_getInternalIndex(NODE, i);
         // --- skip terminal nodes and nodes with negligible inflow
         if ( Node[j].degree <= 0  ) continue;
         if ( NodeInflow[j] <= 0.1 ) continue;
@@ -813,24 +830,29 @@ void  stats_findMaxStats()
 
     // --- find nodes with highest nonconvergence frequency
     if ( RouteModel == DW )
-        for (j = 0; j < Nobjects[NODE]; j++)
+        for (i = 0; i < Nobjects[NODE]; i++)
+        {
+            j = project_getInternalIndex(NODE, i);
             stats_updateMaxStats(MaxNonConverged, NODE, j,
                 NodeStats[j].nonConvergedCount / stepCount);
+        }
     
     // --- stop if not using a variable time step
     if ( RouteModel != DW || CourantFactor == 0.0 ) return;
 
     // --- find nodes most frequently Courant critical
     if ( stepCount == 0 ) return;
-    for (j=0; j<Nobjects[NODE]; j++)
+    for (i=0; i<Nobjects[NODE]; i++)
     {
+        j = project_getInternalIndex(NODE, i);
         x = NodeStats[j].timeCourantCritical / stepCount;
         stats_updateMaxStats(MaxCourantCrit, NODE, j, 100.0*x);
     }
 
     // --- find links most frequently Courant critical
-    for (j=0; j<Nobjects[LINK]; j++)
+    for (i=0; i<Nobjects[LINK]; i++)
     {
+        j = project_getInternalIndex(LINK, i);
         x = LinkStats[j].timeCourantCritical / stepCount;
         stats_updateMaxStats(MaxCourantCrit, LINK, j, 100.0*x);
     }
@@ -30,6 +30,8 @@
 //   Build 5.2.2
 //   - Calculation of % Evaporation and % Exfiltration losses for storage
 //     units was corrected.
+//   Build 5.2.4 (OWA):
+//   - Nodes & links listed in input file order when renumbered.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -40,22 +42,6 @@
 #include "headers.h"
 #include "lid.h"
 
-//-----------------------------------------------------------------------------
-//  Imported variables
-//-----------------------------------------------------------------------------
-extern TSubcatchStats* SubcatchStats;          // defined in STATS.C
-extern TNodeStats*     NodeStats;
-extern TLinkStats*     LinkStats;
-extern TStorageStats*  StorageStats;
-extern TOutfallStats*  OutfallStats;
-extern TPumpStats*     PumpStats;
-extern double          MaxOutfallFlow;
-extern double          MaxRunoffFlow;
-extern double          RoutingTimeSpan;
-
-extern double*         NodeInflow;             // defined in MASSBAL.C
-extern double*         NodeOutflow;
-
 //-----------------------------------------------------------------------------
 //  Local functions
 //-----------------------------------------------------------------------------
@@ -76,8 +62,8 @@ void    writeLinkLoads(void);
 
 #define WRITE(x) (report_writeLine((x)))
 
-static char   FlowFmt[6];
-static double Vcf;
+static SWMM_TLS char   FlowFmt[6];
+static SWMM_TLS double Vcf;
 
 //=============================================================================
 
@@ -314,7 +300,7 @@ void writeNodeDepths()
 //  Purpose: writes simulation statistics for nodes to report file.
 //
 {
-    int j, days, hrs, mins;
+    int i, j, days, hrs, mins;
     if ( Nobjects[LINK] == 0 ) return;
 
     WRITE("");
@@ -334,8 +320,9 @@ void writeNodeDepths()
     fprintf(Frpt.file,
 "\n  ---------------------------------------------------------------------------------");
 
-    for ( j = 0; j < Nobjects[NODE]; j++ )
+    for ( i = 0; i < Nobjects[NODE]; i++ )
     {
+        j = project_getInternalIndex(NODE, i);
         fprintf(Frpt.file, "\n  %-20s", Node[j].ID);
         fprintf(Frpt.file, " %-9s ", NodeTypeWords[Node[j].type]);
         getElapsedTime(NodeStats[j].maxDepthDate, &days, &hrs, &mins);
@@ -357,7 +344,7 @@ void writeNodeFlows()
 //  Purpose: writes flow statistics for nodes to report file.
 //
 {
-    int j;
+    int i, j;
     int days1, hrs1, mins1;
 
     WRITE("");
@@ -377,8 +364,9 @@ void writeNodeFlows()
     fprintf(Frpt.file,
 "\n  -------------------------------------------------------------------------------------------------");
 
-    for ( j = 0; j < Nobjects[NODE]; j++ )
+    for ( i = 0; i < Nobjects[NODE]; i++ )
     {
+        j = project_getInternalIndex(NODE, i);
         fprintf(Frpt.file, "\n  %-20s", Node[j].ID);
         fprintf(Frpt.file, " %-9s", NodeTypeWords[Node[j].type]);
         getElapsedTime(NodeStats[j].maxInflowDate, &days1, &hrs1, &mins1);
@@ -402,7 +390,7 @@ void writeNodeFlows()
 
 void writeNodeSurcharge()
 {
-    int    j, n = 0;
+    int    i, j, n = 0;
     double t, d1, d2;
 
     WRITE("");
@@ -411,8 +399,9 @@ void writeNodeSurcharge()
     WRITE("**********************");
     WRITE("");
 
-    for ( j = 0; j < Nobjects[NODE]; j++ )
+    for ( i = 0; i < Nobjects[NODE]; i++ )
     {
+        j = project_getInternalIndex(NODE, i);
         if ( Node[j].type == OUTFALL ) continue;
         if ( NodeStats[j].timeSurcharged == 0.0 ) continue;
         t = MAX(0.01, (NodeStats[j].timeSurcharged / 3600.0));
@@ -448,7 +437,7 @@ void writeNodeSurcharge()
 
 void writeNodeFlooding()
 {
-    int    j, n = 0;
+    int    i, j, n = 0;
     int    days, hrs, mins;
     double t;
 
@@ -458,8 +447,9 @@ void writeNodeFlooding()
     WRITE("*********************");
     WRITE("");
 
-    for ( j = 0; j < Nobjects[NODE]; j++ )
+    for ( i = 0; i < Nobjects[NODE]; i++ )
     {
+        j = project_getInternalIndex(NODE, i);
         if ( Node[j].type == OUTFALL ) continue;
         if ( NodeStats[j].timeFlooded == 0.0 ) continue;
         t = MAX(0.01, (NodeStats[j].timeFlooded / 3600.0));
@@ -513,7 +503,7 @@ void writeStorageVolumes()
 //  Purpose: writes simulation statistics for storage units to report file.
 //
 {
-    int    j, k, days, hrs, mins;
+    int    i, j, k, days, hrs, mins;
     double avgVol, maxVol, pctAvgVol, pctMaxVol;
     double pctEvapLoss, pctSeepLoss;
 
@@ -538,8 +528,9 @@ void writeStorageVolumes()
         fprintf(Frpt.file,
 "\n  ------------------------------------------------------------------------------------------------");
 
-        for ( j = 0; j < Nobjects[NODE]; j++ )
+        for ( i = 0; i < Nobjects[NODE]; i++ )
         {
+            j = project_getInternalIndex(NODE, i);
             if ( Node[j].type != STORAGE ) continue;
             k = Node[j].subIndex;
             fprintf(Frpt.file, "\n  %-20s", Node[j].ID);
@@ -630,8 +621,9 @@ void writeOutfallLoads()
         for (p = 0; p < Nobjects[POLLUT]; p++) fprintf(Frpt.file, "--------------");
 
         // --- identify each outfall node
-        for (j=0; j<Nobjects[NODE]; j++)
+        for ( i = 0; i < Nobjects[NODE]; i++ )
         {
+            j = project_getInternalIndex(NODE, i);
             if ( Node[j].type != OUTFALL ) continue;
             k = Node[j].subIndex;
             flowCount = OutfallStats[k].totalPeriods;
@@ -697,7 +689,7 @@ void writeLinkFlows()
 //  Purpose: writes simulation statistics for links to report file.
 //
 {
-    int    j, k, days, hrs, mins;
+    int    i, j, k, days, hrs, mins;
     double v, fullDepth;
 
     if (Nobjects[LINK] == 0) return;
@@ -720,8 +712,9 @@ void writeLinkFlows()
     fprintf(Frpt.file,
         "\n  -----------------------------------------------------------------------------");
 
-    for (j = 0; j < Nobjects[LINK]; j++)
+    for ( i = 0; i < Nobjects[LINK]; i++ )
     {
+        j = project_getInternalIndex(LINK, i);
         // --- print link ID
         k = Link[j].subIndex;
         fprintf(Frpt.file, "\n  %-20s", Link[j].ID);
@@ -784,7 +777,7 @@ void writeFlowClass()
 //  Purpose: writes flow classification for each conduit to report file.
 //
 {
-    int   i, j, k;
+    int   i, j, k, m;
     double totalSeconds = RoutingTimeSpan;
 
     if ( RouteModel != DW ) return;
@@ -799,8 +792,9 @@ void writeFlowClass()
 "\n                       /Actual         Up    Down  Sub   Sup   Up    Down  Norm  Inlet "
 "\n  Conduit               Length    Dry  Dry   Dry   Crit  Crit  Crit  Crit  Ltd   Ctrl  "
 "\n  -------------------------------------------------------------------------------------");
-    for ( j = 0; j < Nobjects[LINK]; j++ )
+    for ( m = 0; m < Nobjects[LINK]; m++ )
     {
+        j = project_getInternalIndex(LINK, m);
         if ( Link[j].type != CONDUIT ) continue;
         if ( Link[j].xsect.type == DUMMY ) continue;
         k = Link[j].subIndex;
@@ -822,7 +816,7 @@ void writeFlowClass()
 
 void writeLinkSurcharge()
 {
-    int    i, j, n = 0;
+    int    i, j, m, n = 0;
     double t[5];
 
     WRITE("");
@@ -830,8 +824,9 @@ void writeLinkSurcharge()
     WRITE("Conduit Surcharge Summary");
     WRITE("*************************");
     WRITE("");
-    for ( j = 0; j < Nobjects[LINK]; j++ )
+    for ( m = 0; m < Nobjects[LINK]; m++ )
     {
+        j = project_getInternalIndex(LINK, m);
         if ( Link[j].type != CONDUIT ||
              Link[j].xsect.type == DUMMY ) continue; 
         t[0] = LinkStats[j].timeSurcharged / 3600.0;
@@ -868,7 +863,7 @@ void writePumpFlows()
 //  Purpose: writes simulation statistics for pumps to report file.
 //
 {
-    int    j, k;
+    int    i, j, k;
     double avgFlow, pctUtilized, pctOffCurve1, pctOffCurve2,
            totalSeconds = RoutingTimeSpan;
 
@@ -888,8 +883,9 @@ void writePumpFlows()
 "\n  ---------------------------------------------------------------------------------------------------------",
         FlowUnitWords[FlowUnits], FlowUnitWords[FlowUnits],
         FlowUnitWords[FlowUnits], VolUnitsWords[UnitSystem]);
-    for ( j = 0; j < Nobjects[LINK]; j++ )
+    for ( i = 0; i < Nobjects[LINK]; i++ )
     {
+        j = project_getInternalIndex(LINK, i);
         if ( Link[j].type != PUMP ) continue;
         k = Link[j].subIndex;
         fprintf(Frpt.file, "\n  %-20s", Link[j].ID);
@@ -945,8 +941,9 @@ void writeLinkLoads()
     for (p = 0; p < Nobjects[POLLUT]; p++) fprintf(Frpt.file, "%s", pollutLine);
 
     // --- print the pollutant loadings carried by each link
-    for ( j = 0; j < Nobjects[LINK]; j++ )
+    for ( i = 0; i < Nobjects[LINK]; i++ )
     {
+        j = project_getInternalIndex(LINK, i);
         fprintf(Frpt.file, "\n  %-20s", Link[j].ID);
         for (p = 0; p < Nobjects[POLLUT]; p++)
         {
@@ -11,6 +11,8 @@
 //   Build 5.2.4:
 //   - Fixed incorrect index used to retrieve street backing parameters
 //     in street_readParams.
+//   Build 5.2.4 (OWA):
+//   - Streets allocated from a memory pool freed with the project.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -35,7 +37,8 @@ int   street_create(int nStreets)
 {
     Street = NULL;
     Nobjects[STREET] = 0;
-    Street = (TStreet *)calloc(nStreets, sizeof(TStreet));
+    if (nStreets == 0) return 0;
+    Street = (TStreet *)project_alloc(STREET, nStreets, sizeof(TStreet));
     if (Street == NULL) return ERR_MEMORY;
     Nobjects[STREET] = nStreets;
     return 0;
@@ -47,10 +50,11 @@ void  street_delete()
 //
 //  Input:   none
 //  Output:  none
-//  Purpose: deletes the collection of Street objects.
+//  Purpose: deletes the collection of Street objects (their memory is
+//           freed with the streets' memory pool).
 //
 {
-    FREE(Street)
+    Street = NULL;
 }
 
 //=============================================================================
@@ -57,23 +57,23 @@ const double ODETOL    = 0.0001;            // acceptable error for ODE solver
 // Globally shared variables   
 //-----------------------------------------------------------------------------
 // Volumes (ft3) for a subcatchment over a time step
-double     Vevap;         // evaporation
-double     Vpevap;        // pervious area evaporation
-double     Vinfil;        // non-LID infiltration
-double     Vinflow;       // non-LID precip + snowmelt + runon + ponded water
-double     Voutflow;      // non-LID runoff to subcatchment's outlet
-double     VlidIn;        // impervious area flow to LID units
-double     VlidInfil;     // infiltration from LID units
-double     VlidOut;       // surface outflow from LID units
-double     VlidDrain;     // drain outflow from LID units
-double     VlidReturn;    // LID outflow returned to pervious area
+SWMM_TLS double     Vevap;         // evaporation
+SWMM_TLS double     Vpevap;        // pervious area evaporation
+SWMM_TLS double     Vinfil;        // non-LID infiltration
+SWMM_TLS double     Vinflow;       // non-LID precip + snowmelt + runon + ponded water
+SWMM_TLS double     Voutflow;      // non-LID runoff to subcatchment's outlet
+SWMM_TLS double     VlidIn;        // impervious area flow to LID units
+SWMM_TLS double     VlidInfil;     // infiltration from LID units
+SWMM_TLS double     VlidOut;       // surface outflow from LID units
+SWMM_TLS double     VlidDrain;     // drain outflow from LID units
+SWMM_TLS double     VlidReturn;    // LID outflow returned to pervious area
 
 //-----------------------------------------------------------------------------
 // Locally shared variables   
 //-----------------------------------------------------------------------------
-static  TSubarea* theSubarea;     // subarea to which getDdDt() is applied
-static  double    Dstore;         // monthly adjusted depression storage (ft)
-static  double    Alpha;          // monthly adjusted runoff coeff.
+static SWMM_TLS TSubarea* theSubarea;     // subarea to which getDdDt() is applied
+static SWMM_TLS double    Dstore;         // monthly adjusted depression storage (ft)
+static SWMM_TLS double    Alpha;          // monthly adjusted runoff coeff.
 static  char *RunoffRoutingWords[] = { w_OUTLET,  w_IMPERV, w_PERV, NULL};
 
 //-----------------------------------------------------------------------------
@@ -31,18 +31,15 @@
 //-----------------------------------------------------------------------------
 //  Imported variables 
 //-----------------------------------------------------------------------------
-// Declared in RUNOFF.C
-extern  double*    OutflowLoad;   // exported pollutant mass load
-
 // Volumes (ft3) for a subcatchment over a time step declared in SUBCATCH.C
-extern double      Vinfil;        // non-LID infiltration
-extern double      Vinflow;       // non-LID precip + snowmelt + runon + ponded water
-extern double      Voutflow;      // non-LID runoff to subcatchment's outlet
-extern double      VlidIn;        // inflow to LID units
-extern double      VlidInfil;     // infiltration from LID units
-extern double      VlidOut;       // surface outflow from LID units
-extern double      VlidDrain;     // drain outflow from LID units
-extern double      VlidReturn;    // LID outflow returned to pervious area
+extern SWMM_TLS double      Vinfil;        // non-LID infiltration
+extern SWMM_TLS double      Vinflow;       // non-LID precip + snowmelt + runon + ponded water
+extern SWMM_TLS double      Voutflow;      // non-LID runoff to subcatchment's outlet
+extern SWMM_TLS double      VlidIn;        // inflow to LID units
+extern SWMM_TLS double      VlidInfil;     // infiltration from LID units
+extern SWMM_TLS double      VlidOut;       // surface outflow from LID units
+extern SWMM_TLS double      VlidDrain;     // drain outflow from LID units
+extern SWMM_TLS double      VlidReturn;    // LID outflow returned to pervious area
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)   
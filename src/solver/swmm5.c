@@ -42,6 +42,16 @@
 //   - Prevented possible infinite loop if swmm_step() called when ErrorCode > 0.
 //   - Prevented early exit from swmm_end() when ErrorCode > 0.
 //   - Support added for relative file names.
+//   Build 5.2.4 (OWA):
+//   - Node & link indexes used by the API follow input file order when
+//     the project's nodes & links are renumbered.
+//   - Added swmm_saveCompiled() and swmm_openCompiled() functions that
+//     save and open compiled project files.
+//   - Reentrant swmm_xxx_r() functions generated with SWMM_REENTRANT.
+//   - Counts of routing trials and of links visited by them available
+//     through swmm_getValue().
+//   - Number of cached cross section geometry tables available through
+//     swmm_getValue().
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -112,7 +122,6 @@
 //-----------------------------------------------------------------------------
 #include "macros.h"                    // macros used throughout SWMM
 #include "objects.h"                   // definitions of SWMM's data objects
-#define  EXTERN                        // defined as 'extern' in headers.h
 #include "globals.h"                   // declaration of all global variables
 #include "funcs.h"                     // declaration of all global functions
 #include "error.h"                     // error message codes
@@ -151,21 +160,32 @@ const double Qcf[6] =                  // Flow Conversion Factors:
      0.02832, 28.317,  2.4466 };       // cms, lps, mld --> cfs
 
 //-----------------------------------------------------------------------------
-//  Shared variables
+//  Project context
 //-----------------------------------------------------------------------------
-static int    IsOpenFlag;           // TRUE if a project has been opened
-static int    IsStartedFlag;        // TRUE if a simulation has been started
-static int    SaveResultsFlag;      // TRUE if output to be saved to binary file
-static int    ExceptionCount;       // number of exceptions handled
-static int    DoRunoff;             // TRUE if runoff is computed
-static int    DoRouting;            // TRUE if flow routing is computed
-static double RoutingDuration;      // duration of a set of routing steps (msecs)
+static TProject DefaultProject;     // project used by the non-reentrant API
+
+// project that the calling thread works on (see globals.h)
+SWMM_TLS_FAST TProject* ActiveProject = &DefaultProject;
+
+//-----------------------------------------------------------------------------
+//  Shared variables (held in the project context, see globals.h)
+//-----------------------------------------------------------------------------
+#define IsOpenFlag       (ActiveProject->swmm5.IsOpenFlag)
+#define IsStartedFlag    (ActiveProject->swmm5.IsStartedFlag)
+#define SaveResultsFlag  (ActiveProject->swmm5.SaveResultsFlag)
+#define ExceptionCount   (ActiveProject->swmm5.ExceptionCount)
+#define DoRunoff         (ActiveProject->swmm5.DoRunoff)
+#define DoRouting        (ActiveProject->swmm5.DoRouting)
+#define RoutingDuration  (ActiveProject->swmm5.RoutingDuration)
+#define TimeStepStats    (ActiveProject->stats.TimeStepStats)
 
 //-----------------------------------------------------------------------------
 //  External API functions (prototyped in swmm5.h)
 //-----------------------------------------------------------------------------
 //  swmm_run
 //  swmm_open
+//  swmm_saveCompiled
+//  swmm_openCompiled
 //  swmm_start
 //  swmm_step
 //  swmm_end
@@ -185,6 +205,10 @@ static double RoutingDuration;      // duration of a set of routing steps (msecs
 //  swmm_getSavedValue
 //  swmm_writeLine
 //  swmm_decodeDate
+//  swmm_createProject
+//  swmm_deleteProject
+//  swmm_useProject
+//  swmm_xxx_r         (reentrant versions of the functions listed above)
 
 //-----------------------------------------------------------------------------
 //  Local functions
@@ -206,6 +230,7 @@ static void   setOutfallStage(int index, double value);
 static void   setLinkSetting(int index, double value);
 static void   setRoutingStep(double value);
 static void   getAbsolutePath(const char* fname, char* absPath, size_t size);
+static int    getInternalIndex(int property, int index);
 
 // Exception filtering function
 #ifdef EXH
@@ -348,6 +373,99 @@ int DLLEXPORT swmm_open(const char *f1, const char *f2, const char *f3)
 
 //=============================================================================
 
+int DLLEXPORT swmm_saveCompiled(const char *fname)
+//
+//  Input:   fname = name of compiled project file
+//  Output:  returns error code
+//  Purpose: saves an opened project to a compiled project file.
+//
+{
+    // --- check that a project is open & no run started
+    if ( ErrorCode ) return ErrorCode;
+    if ( !IsOpenFlag )
+        return (ErrorCode = ERR_API_NOT_OPEN);
+    if ( IsStartedFlag )
+        return (ErrorCode = ERR_API_NOT_ENDED);
+
+#ifdef EXH
+    // --- begin exception handling here
+    __try
+#endif
+    {
+        snapshot_save(fname);
+    }
+
+#ifdef EXH
+    // --- end of try loop; handle exception here
+    __except(xfilter(GetExceptionCode(), "swmm_saveCompiled", 0.0, 0))
+    {
+        ErrorCode = ERR_SYSTEM;
+    }
+#endif
+    return ErrorCode;
+}
+
+//=============================================================================
+
+int DLLEXPORT swmm_openCompiled(const char *f1, const char *f2,
+    const char *f3)
+//
+//  Input:   f1 = name of compiled project file
+//           f2 = name of report file
+//           f3 = name of binary output file
+//  Output:  returns error code
+//  Purpose: opens a SWMM project saved by swmm_saveCompiled.
+//
+{
+// --- to be safe, reset the state of the floating point unit
+#ifdef WINDOWS
+    _fpreset();
+    _setmaxstdio(8192);
+#endif
+
+#ifdef EXH
+    // --- begin exception handling here
+    __try
+#endif
+    {
+        // --- initialize error & warning codes
+        datetime_setDateFormat(M_D_Y);
+        ErrorCode = 0;
+        ErrorMsg[0] = '\0';
+        Warnings = 0;
+        IsOpenFlag = FALSE;
+        IsStartedFlag = FALSE;
+        ExceptionCount = 0;
+
+        // --- open a SWMM project
+        strcpy(InpDir, "");
+        project_open(f1, f2, f3);
+        getAbsolutePath(f1, InpDir, sizeof(InpDir));
+        if ( ErrorCode ) return ErrorCode;
+        IsOpenFlag = TRUE;
+        report_writeLogo();
+
+        // --- retrieve project data from the compiled file
+        project_readCompiled();
+        if ( ErrorCode ) return ErrorCode;
+
+        // --- write project title to report file & open external files
+        report_writeTitle();
+        project_validateCompiled();
+    }
+
+#ifdef EXH
+    // --- end of try loop; handle exception here
+    __except(xfilter(GetExceptionCode(), "swmm_openCompiled", 0.0, 0))
+    {
+        ErrorCode = ERR_SYSTEM;
+    }
+#endif
+    return ErrorCode;
+}
+
+//=============================================================================
+
 int DLLEXPORT swmm_start(int saveResults)
 //
 //  Input:   saveResults = TRUE if simulation results saved to binary file 
@@ -850,6 +968,7 @@ void  DLLEXPORT swmm_getName(int objType, int index, char *name, int size)
         return;
     if (index < 0 || index >= Nobjects[objType])
         return;
+    index = project_getInternalIndex(objType, index);
     switch (objType)
     {
         case GAGE:     idName = Gage[index].ID;     break;
@@ -874,7 +993,7 @@ int  DLLEXPORT swmm_getIndex(int objType, const char *name)
         return -1;
     if (objType < swmm_GAGE || objType > swmm_LINK)
         return -1;
-    return project_findObject(objType, name);
+    return project_getInputIndex(objType, project_findObject(objType, name));
 }
 
 //=============================================================================
@@ -889,6 +1008,7 @@ double  DLLEXPORT swmm_getValue(int property, int index)
 {
     if (!IsOpenFlag)
         return 0;
+    index = getInternalIndex(property, index);
     if (property < 100)
         return getSystemValue(property);
     if (property < 200)
@@ -914,6 +1034,7 @@ void  DLLEXPORT swmm_setValue(int property, int index, double value)
 {
     if (!IsOpenFlag)
         return;
+    index = getInternalIndex(property, index);
     switch (property)
     {
     case swmm_GAGE_RAINFALL:
@@ -975,6 +1096,7 @@ double  DLLEXPORT swmm_getSavedValue(int property, int index, int period)
         return 0;
     if (property == swmm_CURRENTDATE)
         return getSavedDate(period);
+    index = getInternalIndex(property, index);
     if (property >= 200 && property < 300)
         return getSavedSubcatchValue(property, index, period);
     if (property < 400)
@@ -999,6 +1121,141 @@ void  DLLEXPORT swmm_decodeDate(double date, int *year, int *month, int *day,
     *dayOfWeek = datetime_dayOfWeek(date);
 }
 
+//=============================================================================
+//   Reentrant API
+//=============================================================================
+
+int DLLEXPORT swmm_createProject(SWMM_Project** project)
+//
+//  Input:   none
+//  Output:  project = handle of a new project;
+//           returns an error code
+//  Purpose: creates a new, empty project.
+//
+{
+    if ( project == NULL ) return ERR_MEMORY;
+    *project = (TProject *) calloc(1, sizeof(TProject));
+    if ( *project == NULL ) return ERR_MEMORY;
+    return 0;
+}
+
+//=============================================================================
+
+int DLLEXPORT swmm_deleteProject(SWMM_Project* project)
+//
+//  Input:   project = handle of a project
+//  Output:  returns an error code
+//  Purpose: closes a project if it is still open and frees it.
+//
+{
+    TProject* prevProject;
+
+    if ( project == NULL || project == &DefaultProject ) return 0;
+    prevProject = swmm_useProject(project);
+    if ( IsOpenFlag ) swmm_close();
+    swmm_useProject(prevProject == project ? NULL : prevProject);
+    free(project);
+    return 0;
+}
+
+//=============================================================================
+
+SWMM_Project* DLLEXPORT swmm_useProject(SWMM_Project* project)
+//
+//  Input:   project = handle of a project (NULL for the default project)
+//  Output:  returns the previously used project
+//  Purpose: makes a project the one the calling thread works on.
+//
+{
+    TProject* prevProject = ActiveProject;
+    ActiveProject = (project == NULL) ? &DefaultProject : project;
+    return prevProject;
+}
+
+//=============================================================================
+
+//  Reentrant versions of the API functions (see SWMM_REENTRANT in macros.h)
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_run,
+    (SWMM_Project* p, const char *f1, const char *f2, const char *f3),
+    (f1, f2, f3))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_open,
+    (SWMM_Project* p, const char *f1, const char *f2, const char *f3),
+    (f1, f2, f3))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_saveCompiled,
+    (SWMM_Project* p, const char *fname),
+    (fname))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_openCompiled,
+    (SWMM_Project* p, const char *f1, const char *f2, const char *f3),
+    (f1, f2, f3))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_start,
+    (SWMM_Project* p, int saveFlag),
+    (saveFlag))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_step,
+    (SWMM_Project* p, double *elapsedTime),
+    (elapsedTime))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_stride,
+    (SWMM_Project* p, int strideStep, double *elapsedTime),
+    (strideStep, elapsedTime))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_end,
+    (SWMM_Project* p),
+    ())
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_report,
+    (SWMM_Project* p),
+    ())
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_close,
+    (SWMM_Project* p),
+    ())
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_getMassBalErr,
+    (SWMM_Project* p, float *runoffErr, float *flowErr, float *qualErr),
+    (runoffErr, flowErr, qualErr))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_getError,
+    (SWMM_Project* p, char *errMsg, int msgLen),
+    (errMsg, msgLen))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_getWarnings,
+    (SWMM_Project* p),
+    ())
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_getCount,
+    (SWMM_Project* p, int objType),
+    (objType))
+
+SWMM_REENTRANT_VOID(void DLLEXPORT, swmm_getName,
+    (SWMM_Project* p, int objType, int index, char *name, int size),
+    (objType, index, name, size))
+
+SWMM_REENTRANT(int, int DLLEXPORT, swmm_getIndex,
+    (SWMM_Project* p, int objType, const char *name),
+    (objType, name))
+
+SWMM_REENTRANT(double, double DLLEXPORT, swmm_getValue,
+    (SWMM_Project* p, int property, int index),
+    (property, index))
+
+SWMM_REENTRANT_VOID(void DLLEXPORT, swmm_setValue,
+    (SWMM_Project* p, int property, int index, double value),
+    (property, index, value))
+
+SWMM_REENTRANT(double, double DLLEXPORT, swmm_getSavedValue,
+    (SWMM_Project* p, int property, int index, int period),
+    (property, index, period))
+
+SWMM_REENTRANT_VOID(void DLLEXPORT, swmm_writeLine,
+    (SWMM_Project* p, const char *line),
+    (line))
+
 //=============================================================================
 //   Object property getters and setters
 //=============================================================================
@@ -1112,9 +1369,9 @@ double getLinkValue(int property, int index)
         case swmm_LINK_TYPE:
           return link->type;
         case swmm_LINK_NODE1:
-          return link->node1;
+          return project_getInputIndex(NODE, link->node1);
         case swmm_LINK_NODE2:
-          return link->node2;
+          return project_getInputIndex(NODE, link->node2);
         case swmm_LINK_LENGTH:
           if (link->type == CONDUIT)
               return Conduit[link->subIndex].length * UCF(LENGTH);
@@ -1189,6 +1446,12 @@ double getSystemValue(int property)
           return RptFlags.disabled;
         case swmm_FLOWUNITS:
           return FlowUnits;
+        case swmm_TRIALS:
+          return TimeStepStats.trialsCount;
+        case swmm_LINKTRIALS:
+          return TimeStepStats.linkTrialsCount;
+        case swmm_GEOMTABLES:
+          return xsect_getGeomTableCount();
         default:
           return 0;
     }
@@ -1278,7 +1541,6 @@ double  getSavedSubcatchValue(int property, int index, int period)
 {
     // --- SubcatchResults array is defined in output.c and contains
     //     computed results in user's units
-    extern float* SubcatchResults;
 
     // --- order in which subcatchment was saved to output results file
     int outIndex = Subcatch[index].rptFlag - 1;
@@ -1313,7 +1575,6 @@ double  getSavedNodeValue(int property, int index, int period)
 {
     // --- NodeResults array is defined in output.c and contains
     //     computed results in user's units
-    extern float* NodeResults;
 
     // --- order in which node was saved to output results file
     int outIndex = Node[index].rptFlag - 1;
@@ -1354,7 +1615,6 @@ double  getSavedLinkValue(int property, int index, int period)
 
     // --- LinkResults array is defined in output.c and contains
     //     computed results in user's units
-    extern float* LinkResults;
 
     // --- order in which link was saved to output results file
     int    outIndex = Link[index].rptFlag - 1;
@@ -1382,6 +1642,23 @@ double  getSavedLinkValue(int property, int index, int period)
 
 //=============================================================================
 
+int getInternalIndex(int property, int index)
+//
+//  Input:   property = an object's property code
+//           index = the object's index as seen by API users
+//  Output:  returns the object's index in its project array
+//  Purpose: converts the index of the node or link a property refers to
+//           from its input file position to its internal index.
+{
+    if (property >= 300 && property < 400)
+        return project_getInternalIndex(NODE, index);
+    if (property >= 400 && property < 500)
+        return project_getInternalIndex(LINK, index);
+    return index;
+}
+
+//=============================================================================
+
 double getMaxRouteStep()
 {
     double tmpCourantFactor = CourantFactor;
@@ -1455,6 +1732,24 @@ size_t sstrncpy(char *dest, const char *src, size_t n)
 
 //=============================================================================
 
+char* sstrtok(char *s, const char *delim)
+//
+//  Input:   s = string to be parsed (NULL to continue parsing the last one)
+//           delim = string of token delimiter characters
+//  Output:  returns pointer to next token or NULL if there are no more
+//  Purpose: thread-safe version of standard strtok function
+//
+{
+    static SWMM_TLS char* next;    // where the next token search starts
+#ifdef _MSC_VER
+    return strtok_s(s, delim, &next);
+#else
+    return strtok_r(s, delim, &next);
+#endif
+}
+
+//=============================================================================
+
 size_t sstrcat(char* dest, const char* src, size_t size)
 //
 //  Input:   dest = string to be appended
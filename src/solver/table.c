@@ -30,6 +30,16 @@
 //   - Support added for relative file names.
 //   Build 5.2.2:
 //   - Prevent re-reading a time series file from start once end is reached.
+//   Build 5.2.4 (OWA):
+//   - Table entries are frozen into contiguous x/y arrays by table_validate
+//     and the linked list of entries is only used while parsing input.
+//   - Curve lookups use a bisection search started from the interval found
+//     by the previous search (updated atomically to remain thread-safe).
+//   - Storage curves keep cumulative volumes at each depth so that
+//     table_getStorageVolume and table_getStorageDepth use bisection too.
+//   - Time series data files can be read from a binary cache (see
+//     tscache.c) and table_tseriesLookup searches for the next time
+//     bracket instead of stepping through each entry.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -44,6 +54,10 @@
 int    table_getNextFileEntry(TTable* table, double* x, double* y);
 int    table_parseFileLine(char* line, TTable* table, double* x, double* y);
 double table_interpolate(double x, double x1, double y1, double x2, double y2);
+int    table_freezeEntries(TTable* table);
+int    table_findInterval(double* v, int n, int* cursor, double x);
+int    table_findEntry(TTable* table, int lo, double x);
+int    table_atFileEnd(TTable* table);
 
 
 //=============================================================================
@@ -246,7 +260,15 @@ void   table_deleteEntries(TTable *table)
     }
     table->firstEntry = NULL;
     table->lastEntry  = NULL;
-    table->thisEntry  = NULL;
+    table->thisEntry  = 0;
+
+    tscache_close(table);
+    FREE(table->xData);
+    FREE(table->yData);
+    FREE(table->vData);
+    table->wData = NULL;
+    table->nEntries = 0;
+    table->nRising = 0;
 
     if (table->file.file)
     { 
@@ -268,7 +290,15 @@ void   table_init(TTable *table)
     table->refersTo = -1;
     table->firstEntry = NULL;
     table->lastEntry = NULL;
-    table->thisEntry = table->firstEntry;
+    table->nEntries = 0;
+    table->xData = NULL;
+    table->yData = NULL;
+    table->nRising = 0;
+    table->cursor = 1;
+    table->vData = NULL;
+    table->wData = NULL;
+    table->wRising = FALSE;
+    table->thisEntry = 0;
     table->lastDate = 0.0;
     table->x1 = 0.0;
     table->x2 = 0.0;
@@ -277,6 +307,7 @@ void   table_init(TTable *table)
     table->dxMin = 0.0;
     table->file.mode = NO_FILE;
     table->file.file = NULL;
+    table->cache = NULL;
     table->curveType = -1;
 }
 
@@ -294,12 +325,21 @@ int   table_validate(TTable *table)
     double dx, dxMin = BIG;
 
     // --- open external file if used as the table's data source
+    //     (a cached file's data were validated when it was cached)
     if ( table->file.mode == USE_FILE )
     {
+        if ( TseriesCache && tscache_open(table) ) return 0;
         table->file.file = fopen(table->file.name, "rt");
         if ( table->file.file == NULL ) return ERR_TABLE_FILE_OPEN;
     }
 
+    // --- otherwise move the table's entries into arrays
+    else
+    {
+        result = table_freezeEntries(table);
+        if ( result ) return result;
+    }
+
     // --- retrieve the first data entry in the table
     result = table_getFirstEntry(table, &x1, &y1);
 
@@ -328,6 +368,115 @@ int   table_validate(TTable *table)
 
 //=============================================================================
 
+int table_freezeEntries(TTable *table)
+//
+//  Input:   table = pointer to a TTable structure
+//  Output:  returns an error code
+//  Purpose: copies the linked list of a table's entries into x/y arrays
+//           and then frees the list.
+//
+{
+    int    n, k;
+    double *x, *y;
+    TTableEntry *entry;
+    TTableEntry *nextEntry;
+
+    // --- count the entries in the list
+    if ( table->firstEntry == NULL ) return 0;
+    n = 0;
+    for (entry = table->firstEntry; entry; entry = entry->next) n++;
+
+    // --- allocate the x/y arrays
+    x = (double *) malloc(n * sizeof(double));
+    y = (double *) malloc(n * sizeof(double));
+    if ( x == NULL || y == NULL )
+    {
+        FREE(x);
+        FREE(y);
+        return ERR_MEMORY;
+    }
+
+    // --- copy each entry into the arrays and free it
+    n = 0;
+    entry = table->firstEntry;
+    while (entry)
+    {
+        x[n] = entry->x;
+        y[n] = entry->y;
+        n++;
+        nextEntry = entry->next;
+        free(entry);
+        entry = nextEntry;
+    }
+    table->firstEntry = NULL;
+    table->lastEntry = NULL;
+    table->xData = x;
+    table->yData = y;
+    table->nEntries = n;
+    table->cursor = 1;
+    table->thisEntry = 0;
+
+    // --- find the length of the initial run of non-decreasing y-values
+    k = 1;
+    while ( k < n && y[k] >= y[k-1] ) k++;
+    table->nRising = k;
+    return 0;
+}
+
+//=============================================================================
+
+int table_findInterval(double* v, int n, int* cursor, double x)
+//
+//  Input:   v = array of n values in ascending order
+//           n = number of values
+//           cursor = index returned by a previous search
+//           x = value being searched for
+//  Output:  returns the smallest index i >= 1 for which x <= v[i]
+//           (or n if there is no such index)
+//  Purpose: finds the interval (v[i-1], v[i]] of an array containing x.
+//
+//  NOTE: the search is narrowed to one side of the interval found by the
+//        previous search, which is checked first (along with the interval
+//        following it) so that repeated lookups of slowly changing values
+//        take constant time.
+//
+{
+    int i, lo = 1, hi = n, mid;
+
+    // --- check the interval found by the previous search
+    #pragma omp atomic read
+    i = *cursor;
+    if ( i >= 1 && i < n )
+    {
+        if ( x <= v[i] )
+        {
+            if ( i == 1 || !(x <= v[i-1]) ) return i;
+            hi = i - 1;
+        }
+        else
+        {
+            lo = i + 1;
+            if ( lo < n && x <= v[lo] ) hi = lo;
+        }
+    }
+
+    // --- bisect the remaining range of intervals
+    while ( lo < hi )
+    {
+        mid = lo + (hi - lo) / 2;
+        if ( x <= v[mid] ) hi = mid;
+        else lo = mid + 1;
+    }
+    if ( lo < n )
+    {
+        #pragma omp atomic write
+        *cursor = lo;
+    }
+    return lo;
+}
+
+//=============================================================================
+
 int table_getFirstEntry(TTable *table, double *x, double *y)
 //
 //  Input:   table = pointer to a TTable structure
@@ -339,23 +488,21 @@ int table_getFirstEntry(TTable *table, double *x, double *y)
 //  NOTE: also moves the current position pointer (thisEntry) to the 1st entry.
 //
 {
-    TTableEntry *entry;
     *x = 0;
     *y = 0.0;
 
-    if ( table->file.mode == USE_FILE )
+    if ( table->file.mode == USE_FILE && table->cache == NULL )
     {
         if ( table->file.file == NULL ) return FALSE;
         rewind(table->file.file);
         return table_getNextFileEntry(table, x, y);
     }
 
-    entry = table->firstEntry;
-    if ( entry )
+    if ( table->nEntries > 0 )
     {
-        *x = entry->x;
-        *y = entry->y;
-        table->thisEntry = entry;
+        *x = table->xData[0];
+        *y = table->yData[0];
+        table->thisEntry = 0;
         return TRUE;
     }
     else return FALSE;
@@ -374,20 +521,23 @@ int table_getNextEntry(TTable *table, double *x, double *y)
 //  NOTE: also updates the current position pointer (thisEntry).
 //
 {
-    TTableEntry *entry;
+    int k;
 
-    if ( table->file.mode == USE_FILE )
+    if ( table->file.mode == USE_FILE && table->cache == NULL )
         return table_getNextFileEntry(table, x, y);
     
-    entry = table->thisEntry->next;
-    if ( entry )
+    k = table->thisEntry + 1;
+    if ( k < table->nEntries )
     {
-        *x = entry->x;
-        *y = entry->y;
-        table->thisEntry = entry;
+        *x = table->xData[k];
+        *y = table->yData[k];
+        table->thisEntry = k;
         return TRUE;
     }
-    else return FALSE;
+
+    // --- position past the last entry (the end of a cached data file)
+    table->thisEntry = table->nEntries;
+    return FALSE;
 }
 
 //=============================================================================
@@ -405,24 +555,15 @@ double table_lookup(TTable *table, double x)
 //        returned.
 //
 {
-    double x1,y1,x2,y2;
-    TTableEntry* entry;
-
-    entry = table->firstEntry;
-    if ( entry == NULL ) return 0.0;
-    x1 = entry->x;
-    y1 = entry->y;
-    if ( x <= x1 ) return y1;
-    while ( entry->next )
-    {
-        entry = entry->next;
-        x2 = entry->x;
-        y2 = entry->y;
-        if ( x <= x2 ) return table_interpolate(x, x1, y1, x2, y2);
-        x1 = x2;
-        y1 = y2;
-    }
-    return y1;
+    int     i, n = table->nEntries;
+    double* xd = table->xData;
+    double* yd = table->yData;
+
+    if ( n == 0 ) return 0.0;
+    if ( x <= xd[0] ) return yd[0];
+    i = table_findInterval(xd, n, &table->cursor, x);
+    if ( i < n ) return table_interpolate(x, xd[i-1], yd[i-1], xd[i], yd[i]);
+    return yd[n-1];
 }
 
 //=============================================================================
@@ -435,28 +576,18 @@ double table_getSlope(TTable *table, double x)
 //  Purpose: retrieves the slope of the curve at the line segment containing x.
 //
 {
-    double x1,y1,x2,y2;
-    double dx;
-    TTableEntry* entry;
-
-    entry = table->firstEntry;
-    if ( entry == NULL ) return 0.0;
-    x1 = entry->x;
-    y1 = entry->y;
-    x2 = x1;
-    y2 = y1;
-    while ( entry->next )
-    {
-        entry = entry->next;
-        x2 = entry->x;
-        y2 = entry->y;
-        if ( x <= x2 ) break;
-        x1 = x2;
-        y1 = y2;
-    }
-    dx = x2 - x1;
+    int     i, n = table->nEntries;
+    double  dx;
+    double* xd = table->xData;
+    double* yd = table->yData;
+
+    // --- slope is 0 beyond the last entry
+    if ( n == 0 ) return 0.0;
+    i = table_findInterval(xd, n, &table->cursor, x);
+    if ( i >= n ) return 0.0;
+    dx = xd[i] - xd[i-1];
     if ( dx == 0.0 ) return 0.0;
-    return (y2 - y1) / dx;
+    return (yd[i] - yd[i-1]) / dx;
 }
 
 //=============================================================================
@@ -471,29 +602,27 @@ double table_lookupEx(TTable *table, double x)
 //           extrapolation outside of the table.
 //
 {
-    double x1,y1,x2,y2;
-    double s = 0.0;
-    TTableEntry* entry;
-
-    entry = table->firstEntry;
-    if (entry == NULL ) return 0.0;
-    x1 = entry->x;
-    y1 = entry->y;
+    int     i, n = table->nEntries;
+    double  x1, y1;
+    double  s = 0.0;
+    double* xd = table->xData;
+    double* yd = table->yData;
+
+    if ( n == 0 ) return 0.0;
+    x1 = xd[0];
+    y1 = yd[0];
     if ( x <= x1 )
     {
         if (x1 > 0.0 ) return x/x1*y1;
         else return y1;
     }
-    while ( entry->next )
-    {
-        entry = entry->next;
-        x2 = entry->x;
-        y2 = entry->y;
-        if ( x2 != x1 ) s = (y2 - y1) / (x2 - x1);
-        if ( x <= x2 ) return table_interpolate(x, x1, y1, x2, y2);
-        x1 = x2;
-        y1 = y2;
-    }
+    i = table_findInterval(xd, n, &table->cursor, x);
+    if ( i < n ) return table_interpolate(x, xd[i-1], yd[i-1], xd[i], yd[i]);
+
+    // --- extrapolate with the slope of the last interval
+    x1 = xd[n-1];
+    y1 = yd[n-1];
+    if ( n > 1 && x1 != xd[n-2] ) s = (y1 - yd[n-2]) / (x1 - xd[n-2]);
     if ( s < 0.0 ) s = 0.0;
     return y1 + s*(x - x1);
 }
@@ -509,17 +638,19 @@ double table_intervalLookup(TTable *table, double x)
 //           whose x-value is > x.
 //
 {
-    TTableEntry* entry;
+    int     lo = 0, hi = table->nEntries, mid;
+    double* xd = table->xData;
 
-    entry = table->firstEntry;
-    if (entry == NULL ) return 0.0;
-    if ( x < entry->x ) return entry->y;
-    while ( entry->next )
+    // --- bisect for the first entry whose x-value is > x
+    if ( hi == 0 ) return 0.0;
+    while ( lo < hi )
     {
-        entry = entry->next;
-        if ( x < entry->x ) return entry->y;
+        mid = lo + (hi - lo) / 2;
+        if ( x < xd[mid] ) hi = mid;
+        else lo = mid + 1;
     }
-    return entry->y;
+    if ( lo == table->nEntries ) lo--;
+    return table->yData[lo];
 }
 
 //=============================================================================
@@ -537,24 +668,23 @@ double table_inverseLookup(TTable *table, double y)
 //        returned.
 //
 {
-    double x1,y1,x2,y2;
-    TTableEntry* entry;
+    int     i, n = table->nEntries;
+    double* xd = table->xData;
+    double* yd = table->yData;
 
-    entry = table->firstEntry;
-    if (entry == NULL ) return 0.0;
-    x1 = entry->x;
-    y1 = entry->y;
-    if ( y <= y1 ) return x1;
-    while ( entry->next )
-    {
-        entry = entry->next;
-        x2 = entry->x;
-        y2 = entry->y;
-        if ( y <= y2 ) return table_interpolate(y, y1, x1, y2, x2);
-        x1 = x2;
-        y1 = y2;
+    if ( n == 0 ) return 0.0;
+    if ( y <= yd[0] ) return xd[0];
+
+    // --- y-values can only be bisected if they never decrease
+    if ( table->nRising == n )
+        i = table_findInterval(yd, n, &table->cursor, y);
+    else
+    {
+        i = 1;
+        while ( i < n && !(y <= yd[i]) ) i++;
     }
-    return x1;
+    if ( i < n ) return table_interpolate(y, yd[i-1], xd[i-1], yd[i], xd[i]);
+    return xd[n-1];
 }
 
 //=============================================================================
@@ -568,18 +698,55 @@ double  table_getMaxY(TTable *table, double x)
 //           portion of a table that appear before value x.
 //
 {
-    double ymax;
-    TTableEntry* entry;
+    int k = table->nRising;
 
-    entry = table->firstEntry;
-    ymax = entry->y;
-    while ( x > entry->x && entry->next )
+    // --- the non-decreasing portion ends at entry k-1
+    if ( k < table->nEntries && x > table->xData[k-1] )
+        return table->yData[k-1];
+    return 0.0;
+}
+
+//=============================================================================
+
+int table_setStorageVolumes(TTable *table)
+//
+//  Input:   table = pointer to a TTable structure
+//  Output:  returns an error code
+//  Purpose: computes the cumulative volume at each depth of a Storage Curve
+//           table using the end area method.
+//
+//  NOTE: vData starts from 0 at the first tabulated depth (as volumes are
+//        computed by table_getStorageVolume) while wData includes the
+//        volume below that depth (as used by table_getStorageDepth).
+//
+{
+    int     i, n = table->nEntries;
+    double  dv;
+    double* xd = table->xData;
+    double* yd = table->yData;
+    double* vd;
+    double* wd;
+
+    // --- check if volumes were already computed for another storage node
+    if ( table->vData || n == 0 ) return 0;
+    vd = (double *) malloc(2 * n * sizeof(double));
+    if ( vd == NULL ) return ERR_MEMORY;
+    wd = vd + n;
+
+    // --- accumulate the volume of each depth interval
+    vd[0] = 0.0;
+    wd[0] = yd[0] * xd[0] / 2.0;
+    table->wRising = TRUE;
+    for (i = 1; i < n; i++)
     {
-        entry = entry->next;
-        if ( entry->y < ymax ) return ymax;
-        ymax = entry->y;
+        dv = (yd[i-1] + yd[i]) / 2.0 * (xd[i] - xd[i-1]);
+        vd[i] = vd[i-1] + dv;
+        wd[i] = wd[i-1] + dv;
+        if ( wd[i] < wd[i-1] ) table->wRising = FALSE;
     }
-    return 0.0;
+    table->vData = vd;
+    table->wData = wd;
+    return 0;
 }
 
 //=============================================================================
@@ -591,16 +758,18 @@ double table_getStorageVolume(TTable *table, double x)
 //  Output:  returns a storage volume 
 //  Purpose: finds volume for a given depth in a Storage Curve table.
 //
+//  NOTE: table_setStorageVolumes must have been called for the table.
+//
 {
-    double a, a1, x1, v, dx = 0.0, dy = 0.0, s;
-    TTableEntry* entry;
+    int     i, n = table->nEntries;
+    double  a, a1, x1, v, dx, dy, s;
+    double* xd = table->xData;
+    double* yd = table->yData;
 
     // --- get first entry in table
-    v = 0.0;
-    entry = table->firstEntry;
-    if (entry == NULL) return 0.0;
-    x1 = entry->x;
-    a1 = entry->y;
+    if (n == 0) return 0.0;
+    x1 = xd[0];
+    a1 = yd[0];
 
     // --- target depth is below first tabulated depth
     if (x <= x1)
@@ -609,28 +778,24 @@ double table_getStorageVolume(TTable *table, double x)
         return (a1/x1) * x * x / 2.0;
     }
 
-    // --- otherwise traverse table entries until target depth is bracketed
-    while (entry->next)
+    // --- target is bracketed - apply end area method to interpolated area
+    //     and add to the volume below the bracket
+    i = table_findInterval(xd, n, &table->cursor, x);
+    if (i < n)
     {
-        entry = entry->next;
-        // --- target is bracketed - apply end area method to interpolated area
-        if (entry->x >= x)
-        {
-            a = table_interpolate(x, x1, a1, entry->x, entry->y);
-            return v + (a1 + a) / 2.0 * (x - x1);
-        }
-        // --- target not yet bracketed so update volume using end area method
-        else
-        {
-            dx = entry->x - x1;
-            dy = entry->y - a1;
-            v = v + (a1 + entry->y) / 2.0 * dx;
-            x1 = entry->x;
-            a1 = entry->y;
-        }
+        x1 = xd[i-1];
+        a1 = yd[i-1];
+        a = table_interpolate(x, x1, a1, xd[i], yd[i]);
+        return table->vData[i-1] + (a1 + a) / 2.0 * (x - x1);
     }
 
     // --- extrapolate area if table limit exceeded
+    v = table->vData[n-1];
+    if (n == 1) return v;
+    x1 = xd[n-1];
+    a1 = yd[n-1];
+    dx = x1 - xd[n-2];
+    dy = a1 - yd[n-2];
     if (dx > 1.0e-6)
     {
         s = dy / dx;
@@ -655,62 +820,75 @@ double table_getStorageDepth(TTable *table, double v)
 //  Output:  returns a storage depth 
 //  Purpose: finds depth for a given volume in a Storage Curve table.
 //
+//  NOTE: table_setStorageVolumes must have been called for the table.
+//
 {
-    double a1, a2, d1, d2, dd = 0.0, da = 0.0, v1, v2, s;
-    TTableEntry* entry;
+    int     i, n = table->nEntries;
+    double  a1, a2, d1, d2, dd = 0.0, da = 0.0, v1, v2, s;
+    double* xd = table->xData;
+    double* yd = table->yData;
+    double* wd = table->wData;
 
     // --- see if target volume is below that of 1st table entry
     if (v == 0.0) return 0.0;
-    entry = table->firstEntry;
-    if (entry == NULL) return 0.0;
-    d1 = entry->x;
-    a1 = entry->y;
-    v1 = a1 * d1 / 2.0;
+    if (n == 0) return 0.0;
+    d1 = xd[0];
+    a1 = yd[0];
+    v1 = wd[0];
     if (v <= v1)
     {
         if (a1 > 0.0) return sqrt(2.0 * v * d1 / a1);
         else return 0.0;
     }
 
-    // --- add next table entry to volume until target volume is bracketed
-    while (entry->next)
+    // --- find the first table entry whose volume is >= target volume
+    if (table->wRising) i = table_findInterval(wd, n, &table->cursor, v);
+    else
     {
-        entry = entry->next;
-        d2 = entry->x;
-        a2 = entry->y;
+        i = 1;
+        while (i < n && !(v <= wd[i])) i++;
+    }
+
+    // target volume is bracketed
+    if (i < n)
+    {
+        d1 = xd[i-1];
+        a1 = yd[i-1];
+        v1 = wd[i-1];
+        d2 = xd[i];
+        a2 = yd[i];
+        v2 = wd[i];
         dd = d2 - d1;
         da = a2 - a1;
-        v2 = v1 + (a1 + a2) / 2.0 * dd;
 
-        // target volume is bracketed
-        if (v <= v2)
+        // --- target coincides with point on curve
+        if (dd <= 0.0) return d1;
+        if (da == 0.0)
         {
-            // --- target coincides with point on curve
-            if (dd <= 0.0) return d1;
-            if (da == 0.0)
-            {
-                if (fabs(v2 - v1) < 1.e-6) return d1;
-                else return d1 + dd * (v - v1) / (v2 - v1);
-            }
-            // --- if area decreases with depth then replace point 1 with point 2
-            if (da < 0.0)
-            {
-                d1 = d2;
-                a1 = a2;
-                v1 = v2;
-            }
-            // --- interpolate between volumes derived from curve
-            s = da / dd;
-            return d1 + (sqrt(a1*a1 + 2.0*s*(v-v1)) - a1) / s;
+            if (fabs(v2 - v1) < 1.e-6) return d1;
+            else return d1 + dd * (v - v1) / (v2 - v1);
         }
-
-        // --- replace point 1 with point 2
-        d1 = d2;
-        a1 = a2;
-        v1 = v2;
+        // --- if area decreases with depth then replace point 1 with point 2
+        if (da < 0.0)
+        {
+            d1 = d2;
+            a1 = a2;
+            v1 = v2;
+        }
+        // --- interpolate between volumes derived from curve
+        s = da / dd;
+        return d1 + (sqrt(a1*a1 + 2.0*s*(v-v1)) - a1) / s;
     }
 
     // --- extrapolate volume if table limit exceeded
+    d1 = xd[n-1];
+    a1 = yd[n-1];
+    v1 = wd[n-1];
+    if (n > 1)
+    {
+        dd = d1 - xd[n-2];
+        da = a1 - yd[n-2];
+    }
     if (dd == 0.0 || da == 0.0)
     {
         if (a1 > 0.0) dd = (v - v1) / a1;
@@ -756,6 +934,8 @@ double table_tseriesLookup(TTable *table, double x, char extend)
 //        returned.
 //
 {
+    int k, n;
+
     // --- x lies within current time bracket
     if ( table->x1 <= x
     &&   table->x2 >= x
@@ -763,7 +943,7 @@ double table_tseriesLookup(TTable *table, double x, char extend)
     return table_interpolate(x, table->x1, table->y1, table->x2, table->y2);
     
     // --- end of external time series file has been reached
-    if ( table->file.mode == USE_FILE && feof(table->file.file) )
+    if ( table_atFileEnd(table) )
     {
         if (extend == TRUE) return table->y1;
         else return 0;
@@ -786,8 +966,35 @@ double table_tseriesLookup(TTable *table, double x, char extend)
     table->x1 = table->x2;
     table->y1 = table->y2;
 
-    // --- get end of next time bracket
-    while ( table_getNextEntry(table, &(table->x2), &(table->y2)) )
+    // --- get end of next time bracket directly from the table's arrays
+    //     (with the same result as stepping through its entries)
+    if ( table->xData )
+    {
+        n = table->nEntries;
+        k = table_findEntry(table, table->thisEntry + 1, x);
+        if ( k < n )
+        {
+            if ( k > table->thisEntry + 1 )
+            {
+                table->x1 = table->xData[k-1];
+                table->y1 = table->yData[k-1];
+            }
+            table->x2 = table->xData[k];
+            table->y2 = table->yData[k];
+            table->thisEntry = k;
+            return table_interpolate(x, table->x1, table->y1,
+                                        table->x2, table->y2);
+        }
+        if ( table->thisEntry + 1 < n )
+        {
+            table->x1 = table->x2 = table->xData[n-1];
+            table->y1 = table->y2 = table->yData[n-1];
+        }
+        table->thisEntry = n;
+    }
+
+    // --- otherwise read entries from the external file
+    else while ( table_getNextEntry(table, &(table->x2), &(table->y2)) )
     {
         // --- x lies within the bracket
         if ( x <= table->x2 )
@@ -805,6 +1012,46 @@ double table_tseriesLookup(TTable *table, double x, char extend)
 
 //=============================================================================
 
+int table_findEntry(TTable* table, int lo, double x)
+//
+//  Input:   table = pointer to a TTable structure
+//           lo = index of first entry to search
+//           x = an x-value
+//  Output:  returns the index of the first entry at or after lo whose
+//           x-value is >= x (or the number of entries if there is none)
+//  Purpose: searches a table's x-value array for a given x-value.
+//
+{
+    int hi = table->nEntries, mid;
+
+    if ( table->cache ) return tscache_findEntry(table, lo, x);
+    if ( lo > hi ) lo = hi;
+    while ( lo < hi )
+    {
+        mid = lo + (hi - lo) / 2;
+        if ( x <= table->xData[mid] ) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+//=============================================================================
+
+int table_atFileEnd(TTable* table)
+//
+//  Input:   table = pointer to a TTable structure
+//  Output:  returns TRUE if the end of a table's external data file has
+//           been reached, FALSE if not
+//  Purpose: checks if all of the entries in a table's data file were read.
+//
+{
+    if ( table->file.mode != USE_FILE ) return FALSE;
+    if ( table->cache ) return table->thisEntry >= table->cache->eofEntry;
+    return feof(table->file.file);
+}
+
+//=============================================================================
+
 int  table_getNextFileEntry(TTable* table, double* x, double* y)
 //
 //  Input:   table = pointer to a TTable structure
@@ -856,7 +1103,7 @@ int  table_parseFileLine(char* line, TTable* table, double* x, double* y)
     n = sscanf(line, "%s %s %s", s1, s2, s3);
 
     // --- return if line is blank or is a comment
-    tStr = strtok(line, SEPSTR);
+    tStr = sstrtok(line, SEPSTR);
     if ( tStr == NULL || *tStr == ';' ) return -1;
 
     // --- line only has a time and a value
@@ -13,6 +13,10 @@
 //   Build 5.2.0:
 //   - Moved strings used in swmm_run() (in swmm5.c) to that function.
 //   - Added text strings used for storage shapes, streets & inlets.
+//   Build 5.2.4 (OWA):
+//   - Added keywords for selecting the result variables saved to the
+//     binary output file.
+//   - Added COMPRESS_OUTPUT option keyword.
 //-----------------------------------------------------------------------------
 
 #ifndef TEXT_H
@@ -104,6 +108,13 @@
 #define  w_MIN_ROUTE_STEP    "MINIMUM_STEP"
 #define  w_NUM_THREADS       "THREADS"
 #define  w_SURCHARGE_METHOD  "SURCHARGE_METHOD"
+#define  w_RENUMBER          "RENUMBER"
+#define  w_ACTIVE_SET        "ACTIVE_SET"
+#define  w_STEP_CLASSES      "TIME_STEP_CLASSES"
+#define  w_MIN_PARALLEL      "MIN_PARALLEL_LINKS"
+#define  w_GEOM_CACHE        "GEOMETRY_CACHE"
+#define  w_TSERIES_CACHE     "TIMESERIES_CACHE"
+#define  w_COMPRESS_OUTPUT   "COMPRESS_OUTPUT"
 
 // Flow Units
 #define  w_CFS               "CFS"
@@ -123,11 +134,16 @@
 #define  w_KINWAVE           "KINWAVE"
 #define  w_XKINWAVE          "XKINWAVE"
 #define  w_DYNWAVE           "DYNWAVE"
+#define  w_DYNWAVE_IMPLICIT  "DYNWAVE_IMPLICIT"
 
 // Surcharge Methods
 #define  w_EXTRAN            "EXTRAN"
 #define  w_SLOT              "SLOT"
 
+// Node & Link Renumbering Methods
+#define  w_BFS               "BFS"
+#define  w_RCM               "RCM"
+
 // Infiltration Methods
 #define  w_HORTON            "HORTON"
 #define  w_MOD_HORTON        "MODIFIED_HORTON"
@@ -327,6 +343,21 @@
 #define  w_CONTROLS          "CONTROL"
 #define  w_NODESTATS         "NODESTATS"
 #define  w_AVERAGES          "AVERAGES"
+#define  w_VARIABLES         "VARIABLES"
+
+// Reported Result Variables
+#define  w_SNOW_DEPTH        "SNOW_DEPTH"
+#define  w_EVAP              "EVAP"
+#define  w_INFIL             "INFIL"
+#define  w_GW_FLOW           "GW_FLOW"
+#define  w_GW_ELEV           "GW_ELEV"
+#define  w_SOIL_MOIST        "SOIL_MOIST"
+#define  w_LATERAL_INFLOW    "LATERAL_INFLOW"
+#define  w_TOTAL_INFLOW      "TOTAL_INFLOW"
+#define  w_FLOODING          "FLOODING"
+#define  w_VELOCITY          "VELOCITY"
+#define  w_CAPACITY          "CAPACITY"
+#define  w_QUALITY           "QUALITY"
 
 // Interface File Types
 #define  w_RAINFALL          "RAINFALL"
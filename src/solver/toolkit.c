@@ -50,6 +50,7 @@ int  stats_getSubcatchStat(int index, TSubcatchStats **subcatchStats);
 
 // Utilty Function Declarations
 double *newDoubleArray(int n);
+static int runOpenedProject(void (*callback) (double *));
 
 
 
@@ -85,19 +86,39 @@ EXPORT_TOOLKIT int swmm_run_cb(const char* f1, const char* f2, const char* f3,
 //  Purpose: runs a SWMM simulation.
 //
 {
-    clock_t check = 0;
-    double progress, elapsedTime = 0.0;
+    // --- open the files & read input data
+    ErrorCode = 0;
+    swmm_open(f1, f2, f3);
+    return runOpenedProject(callback);
+}
 
 
-    // --- initialize flags
-    IsOpenFlag = FALSE;
-    IsStartedFlag = FALSE;
-    SaveResultsFlag = TRUE;
+EXPORT_TOOLKIT int swmm_runCompiled_cb(const char* f1, const char* f2,
+    const char* f3, void (*callback) (double *))
+//
+//  Input:   f1 = name of compiled project file
+//           f2 = name of report file
+//           f3 = name of binary output file
+//  Output:  returns error code
+//  Purpose: runs a SWMM simulation of a compiled project.
+//
+{
+    // --- open the files & read the compiled project
+    ErrorCode = 0;
+    swmm_openCompiled(f1, f2, f3);
+    return runOpenedProject(callback);
+}
 
 
-    // --- open the files & read input data
-    ErrorCode = 0;
-    swmm_open(f1, f2, f3);
+int runOpenedProject(void (*callback) (double *))
+//
+//  Input:   callback = function called with the fraction of the run done
+//  Output:  returns error code
+//  Purpose: runs a simulation of an opened project & then closes it.
+//
+{
+    clock_t check = 0;
+    double progress, elapsedTime = 0.0;
 
     // --- run the simulation if input data OK
     if ( !ErrorCode )
@@ -165,6 +186,7 @@ EXPORT_TOOLKIT int swmm_project_findObject(SM_ObjectType type, char *id, int *in
 
     int idx = project_findObject(type, id);
 
+    idx = project_getInputIndex(type, idx);
     if (idx == -1) {
         index = NULL;
         error_code = ERR_TKAPI_OBJECT_INDEX;
@@ -562,7 +584,7 @@ EXPORT_TOOLKIT int swmm_getObjectIndex(SM_ObjectType type, char *id, int *index)
 
     // Check if Open
     if(swmm_IsOpenFlag() == TRUE)
-        *index = project_findObject(type, id);
+        *index = project_getInputIndex(type, project_findObject(type, id));
     else
         error_code = ERR_TKAPI_INPUTNOTOPEN;
 
@@ -592,6 +614,7 @@ EXPORT_TOOLKIT int swmm_getObjectId(SM_ObjectType type, int index, char **id)
     }
     else
     {
+        index = project_getInternalIndex(type, index);
         switch (type)
         {
             case SM_GAGE:
@@ -644,6 +667,8 @@ EXPORT_TOOLKIT int swmm_getNodeType(int index, SM_NodeType *Ntype)
 {
     int error_code = 0;
     *Ntype = -1;
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -668,6 +693,8 @@ EXPORT_TOOLKIT int swmm_getLinkType(int index, SM_LinkType *Ltype)
 {
     int error_code = 0;
     *Ltype = -1;
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -693,6 +720,8 @@ EXPORT_TOOLKIT int swmm_getLinkConnections(int index, int *Node1, int *Node2)
     int error_code = 0;
     *Node1 = -1;
     *Node2 = -1;
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -705,8 +734,8 @@ EXPORT_TOOLKIT int swmm_getLinkConnections(int index, int *Node1, int *Node2)
     }
     else
     {
-        *Node1 = Link[index].node1;
-        *Node2 = Link[index].node2;
+        *Node1 = project_getInputIndex(NODE, Link[index].node1);
+        *Node2 = project_getInputIndex(NODE, Link[index].node2);
     }
     return error_code;
 }
@@ -720,6 +749,8 @@ EXPORT_TOOLKIT int swmm_getLinkDirection(int index, signed char *value)
 {
     int error_code = 0;
     *value = 0;
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -747,6 +778,8 @@ EXPORT_TOOLKIT int swmm_getNodeParam(int index, SM_NodeProperty param, double *v
 {
     int error_code = 0;
     *value = 0;
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -786,6 +819,8 @@ EXPORT_TOOLKIT int swmm_setNodeParam(int index, SM_NodeProperty param, double va
 /// Purpose: Sets Node Parameter
 {
     int error_code = 0;
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -833,6 +868,8 @@ EXPORT_TOOLKIT int swmm_getLinkParam(int index, SM_LinkProperty param, double *v
 {
     int error_code = 0;
     *value = 0;
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -876,6 +913,8 @@ EXPORT_TOOLKIT int swmm_setLinkParam(int index, SM_LinkProperty param, double va
 /// Purpose: Sets Link Parameter
 {
     int error_code = 0;
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -936,6 +975,8 @@ EXPORT_TOOLKIT int swmm_getInletParam(int index, SM_InletProperty param, double
     *value = 0;
     TInlet* inlet;
 
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -985,6 +1026,8 @@ EXPORT_TOOLKIT int swmm_setInletParam(int index, SM_InletProperty param, double
 {
     int error_code = 0;
     TInlet* inlet;
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -1030,6 +1073,8 @@ EXPORT_TOOLKIT int swmm_getInletResult(int index, SM_InletResult type, double *r
     *result = 0;
     TInlet* inlet;
 
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -1189,7 +1234,7 @@ EXPORT_TOOLKIT int swmm_getSubcatchOutConnection(int index, SM_ObjectType *type,
         }
         if (Subcatch[index].outNode >= 0)
         {
-            *out_index = Subcatch[index].outNode;
+            *out_index = project_getInputIndex(NODE, Subcatch[index].outNode);
             *type = (SM_ObjectType)NODE;
         }
         if (Subcatch[index].outSubcatch >= 0)
@@ -1389,7 +1434,8 @@ EXPORT_TOOLKIT int swmm_getLidUOption(int index, int lidIndex, SM_LidUOptions pa
                 case SM_DRAINSUB:
                     *value = lidUnit->drainSubcatch; break;
                 case SM_DRAINNODE:
-                    *value = lidUnit->drainNode; break;
+                    *value = project_getInputIndex(NODE, lidUnit->drainNode);
+                    break;
                 default:
                     error_code = ERR_TKAPI_OUTBOUNDS; break;
             }
@@ -1443,7 +1489,7 @@ EXPORT_TOOLKIT int swmm_setLidUOption(int index, int lidIndex, SM_LidUOptions pa
                 lidUnit->drainNode = -1;
                 break;
             case SM_DRAINNODE:
-                lidUnit->drainNode = value;
+                lidUnit->drainNode = project_getInternalIndex(NODE, value);
                 lidUnit->drainSubcatch = -1;
                 break;
             default:
@@ -1472,7 +1518,7 @@ EXPORT_TOOLKIT int swmm_setLidUOption(int index, int lidIndex, SM_LidUOptions pa
                     lidUnit->drainNode = -1;
                     break;
                 case SM_DRAINNODE:
-                    lidUnit->drainNode = value;
+                    lidUnit->drainNode = project_getInternalIndex(NODE, value);
                     lidUnit->drainSubcatch = -1;
                     break;
                 default:
@@ -2104,6 +2150,8 @@ EXPORT_TOOLKIT int swmm_getNodeResult(int index, SM_NodeResult type, double *res
     int error_code = 0;
     *result = 0;
 
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -2155,6 +2203,8 @@ EXPORT_TOOLKIT int swmm_getNodePollut(int index, SM_NodePollut type, double **po
     int error_code = 0;
     double* result;
 
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -2217,6 +2267,8 @@ EXPORT_TOOLKIT int swmm_setNodePollut(int index, SM_NodePollut type, int polluta
 {
 	int error_code = 0;
 
+	index = project_getInternalIndex(NODE, index);
+
 	// Check if Open
 	if(swmm_IsOpenFlag() == FALSE)
 	{
@@ -2262,6 +2314,8 @@ EXPORT_TOOLKIT int swmm_getLinkResult(int index, SM_LinkResult type, double *res
     int error_code = 0;
     *result = 0;
 
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -2310,6 +2364,8 @@ EXPORT_TOOLKIT int swmm_getLinkPollut(int index, SM_LinkPollut type, double **po
     int error_code = 0;
     double* result;
 
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if(swmm_IsOpenFlag() == FALSE)
     {
@@ -2377,6 +2433,8 @@ EXPORT_TOOLKIT int swmm_setLinkPollut(int index, SM_LinkPollut type, int polluta
 {
 	int error_code = 0;
     
+	index = project_getInternalIndex(LINK, index);
+
 	// Check if Open
 	if(swmm_IsOpenFlag() == FALSE)
 	{
@@ -2583,6 +2641,8 @@ EXPORT_TOOLKIT int swmm_getNodeStats(int index, SM_NodeStats *nodeStats)
 {
     int error_code = 0;
     
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if (swmm_IsOpenFlag() == FALSE)
         error_code = ERR_TKAPI_INPUTNOTOPEN;
@@ -2612,6 +2672,7 @@ EXPORT_TOOLKIT int swmm_getNodeTotalInflow(int index, double* value)
 /// Purpose: Get Node Total Inflow Volume.
 {
     int error_code = 0;
+    index = project_getInternalIndex(NODE, index);
 
     // Check if Open
     if (swmm_IsOpenFlag() == FALSE)
@@ -2621,6 +2682,10 @@ EXPORT_TOOLKIT int swmm_getNodeTotalInflow(int index, double* value)
     else if (swmm_IsStartedFlag() == FALSE)
         error_code = ERR_TKAPI_SIM_NRUNNING;
 
+    // Check if object index is within bounds
+    else if (index < 0 || index >= Nobjects[NODE])
+        error_code = ERR_TKAPI_OBJECT_INDEX;
+
     else
         massbal_getNodeTotalInflow(index, value);
 
@@ -2635,6 +2700,8 @@ EXPORT_TOOLKIT int swmm_getStorageStats(int index, SM_StorageStats *storageStats
 {
     int error_code = 0;
     
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if (swmm_IsOpenFlag() == FALSE)
         error_code = ERR_TKAPI_INPUTNOTOPEN;
@@ -2664,6 +2731,8 @@ EXPORT_TOOLKIT int swmm_getOutfallStats(int index, SM_OutfallStats *outfallStats
 {
     int error_code = 0;
     
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if (swmm_IsOpenFlag() == FALSE)
         error_code = ERR_TKAPI_INPUTNOTOPEN;
@@ -2698,6 +2767,8 @@ EXPORT_TOOLKIT int swmm_getLinkStats(int index, SM_LinkStats *linkStats)
 {
     int error_code = 0;
 
+	index = project_getInternalIndex(LINK, index);
+
 	// Check if Open
 	if (swmm_IsOpenFlag() == FALSE)
 		error_code = ERR_TKAPI_INPUTNOTOPEN;
@@ -2728,6 +2799,8 @@ EXPORT_TOOLKIT int swmm_getPumpStats(int index, SM_PumpStats *pumpStats)
 {
     int error_code = 0;
 
+	index = project_getInternalIndex(LINK, index);
+
 	// Check if Open
 	if (swmm_IsOpenFlag() == FALSE)
 		error_code = ERR_TKAPI_INPUTNOTOPEN;
@@ -3048,6 +3121,8 @@ EXPORT_TOOLKIT int swmm_setLinkSetting(int index, double setting)
     int error_code = 0;
     char _rule_[11] = "ToolkitAPI";
 
+    index = project_getInternalIndex(LINK, index);
+
     // Check if Open
     if (swmm_IsOpenFlag() == FALSE)
     {
@@ -3089,6 +3164,8 @@ EXPORT_TOOLKIT int swmm_setNodeInflow(int index, double flowrate)
 {
     int error_code = 0;
 
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if (swmm_IsOpenFlag() == FALSE)
     {
@@ -3149,6 +3226,8 @@ EXPORT_TOOLKIT int swmm_setOutfallStage(int index, double stage)
 /// Purpose: Sets new outfall stage and holds until set again.
 {
     int error_code = 0;
+    index = project_getInternalIndex(NODE, index);
+
     // Check if Open
     if (swmm_IsOpenFlag() == FALSE)
     {
@@ -3223,6 +3302,272 @@ EXPORT_TOOLKIT void swmm_freeMemory(void *memory)
 }
 
 
+//-------------------------------
+// Reentrant API Functions
+//-------------------------------
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_run_cb,
+    (struct SWMM_Project* p, const char *f1, const char *f2, const char *f3,
+    void (*callback) (double *)),
+    (f1, f2, f3, callback))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_runCompiled_cb,
+    (struct SWMM_Project* p, const char *f1, const char *f2, const char *f3,
+    void (*callback) (double *)),
+    (f1, f2, f3, callback))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_project_findObject,
+    (struct SWMM_Project* p, SM_ObjectType type, char *id, int *index),
+    (type, id, index))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSimulationUnit,
+    (struct SWMM_Project* p, SM_Units type, int *value),
+    (type, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSimulationAnalysisSetting,
+    (struct SWMM_Project* p, SM_SimOption type, int *value),
+    (type, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSimulationParam,
+    (struct SWMM_Project* p, SM_SimSetting type, double *value),
+    (type, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setSimulationParam,
+    (struct SWMM_Project* p, SM_SimSetting type, double value),
+    (type, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_hotstart,
+    (struct SWMM_Project* p, SM_HotStart type, const char *hsfile),
+    (type, hsfile))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_countObjects,
+    (struct SWMM_Project* p, SM_ObjectType type, int *count),
+    (type, count))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getObjectId,
+    (struct SWMM_Project* p, SM_ObjectType type, int index, char **id),
+    (type, index, id))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getObjectIndex,
+    (struct SWMM_Project* p, SM_ObjectType type, char *id, int *index),
+    (type, id, index))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getNodeType,
+    (struct SWMM_Project* p, int index, SM_NodeType *Ntype),
+    (index, Ntype))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLinkType,
+    (struct SWMM_Project* p, int index, SM_LinkType *Ltype),
+    (index, Ltype))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLinkConnections,
+    (struct SWMM_Project* p, int index, int *node1, int *node2),
+    (index, node1, node2))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLinkDirection,
+    (struct SWMM_Project* p, int index, signed char *value),
+    (index, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSubcatchOutConnection,
+    (struct SWMM_Project* p, int index, SM_ObjectType *type, int *out_index),
+    (index, type, out_index))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLidUCount,
+    (struct SWMM_Project* p, int index, int *value),
+    (index, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLidUParam,
+    (struct SWMM_Project* p, int index, int lidIndex, SM_LidUProperty param,
+    double *value),
+    (index, lidIndex, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setLidUParam,
+    (struct SWMM_Project* p, int index, int lidIndex, SM_LidUProperty param,
+    double value),
+    (index, lidIndex, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLidUOption,
+    (struct SWMM_Project* p, int index, int lidIndex, SM_LidUOptions param,
+    int *value),
+    (index, lidIndex, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setLidUOption,
+    (struct SWMM_Project* p, int index, int lidIndex, SM_LidUOptions param,
+    int value),
+    (index, lidIndex, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLidCOverflow,
+    (struct SWMM_Project* p, int lidControlIndex, int *condition),
+    (lidControlIndex, condition))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLidCParam,
+    (struct SWMM_Project* p, int lidControlIndex, SM_LidLayer layerIndex,
+    SM_LidLayerProperty param, double *value),
+    (lidControlIndex, layerIndex, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setLidCParam,
+    (struct SWMM_Project* p, int lidControlIndex, SM_LidLayer layerIndex,
+    SM_LidLayerProperty param, double value),
+    (lidControlIndex, layerIndex, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLidUFluxRates,
+    (struct SWMM_Project* p, int index, int lidIndex, SM_LidLayer layerIndex,
+    double *result),
+    (index, lidIndex, layerIndex, result))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLidGResult,
+    (struct SWMM_Project* p, int index, SM_LidResult type, double *result),
+    (index, type, result))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLidUResult,
+    (struct SWMM_Project* p, int index, int lidIndex, SM_LidResult type,
+    double *result),
+    (index, lidIndex, type, result))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getNodeParam,
+    (struct SWMM_Project* p, int index, SM_NodeProperty param, double *value),
+    (index, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setNodeParam,
+    (struct SWMM_Project* p, int index, SM_NodeProperty param, double value),
+    (index, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLinkParam,
+    (struct SWMM_Project* p, int index, SM_LinkProperty param, double *value),
+    (index, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setLinkParam,
+    (struct SWMM_Project* p, int index, SM_LinkProperty param, double value),
+    (index, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getInletParam,
+    (struct SWMM_Project* p, int index, SM_InletProperty param, double *value),
+    (index, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setInletParam,
+    (struct SWMM_Project* p, int index, SM_InletProperty param, double value),
+    (index, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSubcatchParam,
+    (struct SWMM_Project* p, int index, SM_SubcProperty param, double *value),
+    (index, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setSubcatchParam,
+    (struct SWMM_Project* p, int index, SM_SubcProperty param, double value),
+    (index, param, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSimulationDateTime,
+    (struct SWMM_Project* p, SM_TimePropety type, int *year, int *month,
+    int *day, int *hour, int *minute, int *second),
+    (type, year, month, day, hour, minute, second))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setSimulationDateTime,
+    (struct SWMM_Project* p, SM_TimePropety type, int year, int month, int day,
+    int hour, int minute, int second),
+    (type, year, month, day, hour, minute, second))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getCurrentDateTime,
+    (struct SWMM_Project* p, int *year, int *month, int *day, int *hour,
+    int *minute, int *second),
+    (year, month, day, hour, minute, second))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getNodeResult,
+    (struct SWMM_Project* p, int index, SM_NodeResult type, double *result),
+    (index, type, result))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getNodePollut,
+    (struct SWMM_Project* p, int index, SM_NodePollut type,
+    double **pollutArray, int *length),
+    (index, type, pollutArray, length))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setNodePollut,
+    (struct SWMM_Project* p, int index, SM_NodePollut type,
+    int pollutant_index, double pollutant_value),
+    (index, type, pollutant_index, pollutant_value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setLinkPollut,
+    (struct SWMM_Project* p, int index, SM_LinkPollut type,
+    int pollutant_index, double pollutant_value),
+    (index, type, pollutant_index, pollutant_value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLinkResult,
+    (struct SWMM_Project* p, int index, SM_LinkResult type, double *result),
+    (index, type, result))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getInletResult,
+    (struct SWMM_Project* p, int index, SM_InletResult type, double *result),
+    (index, type, result))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLinkPollut,
+    (struct SWMM_Project* p, int index, SM_LinkPollut type,
+    double **pollutArray, int *length),
+    (index, type, pollutArray, length))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSubcatchResult,
+    (struct SWMM_Project* p, int index, SM_SubcResult type, double *result),
+    (index, type, result))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSubcatchPollut,
+    (struct SWMM_Project* p, int index, SM_SubcPollut type,
+    double **pollutArray, int *length),
+    (index, type, pollutArray, length))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getGagePrecip,
+    (struct SWMM_Project* p, int index, SM_GagePrecip type, double *result),
+    (index, type, result))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getNodeStats,
+    (struct SWMM_Project* p, int index, SM_NodeStats *nodeStats),
+    (index, nodeStats))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getNodeTotalInflow,
+    (struct SWMM_Project* p, int index, double *value),
+    (index, value))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getStorageStats,
+    (struct SWMM_Project* p, int index, SM_StorageStats *storageStats),
+    (index, storageStats))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getOutfallStats,
+    (struct SWMM_Project* p, int index, SM_OutfallStats *outfallStats),
+    (index, outfallStats))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getLinkStats,
+    (struct SWMM_Project* p, int index, SM_LinkStats *linkStats),
+    (index, linkStats))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getPumpStats,
+    (struct SWMM_Project* p, int index, SM_PumpStats *pumpStats),
+    (index, pumpStats))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSubcatchStats,
+    (struct SWMM_Project* p, int index, SM_SubcatchStats *subcatchStats),
+    (index, subcatchStats))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSystemRoutingTotals,
+    (struct SWMM_Project* p, SM_RoutingTotals *routingTotals),
+    (routingTotals))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_getSystemRunoffTotals,
+    (struct SWMM_Project* p, SM_RunoffTotals *runoffTotals),
+    (runoffTotals))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setLinkSetting,
+    (struct SWMM_Project* p, int index, double setting),
+    (index, setting))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setNodeInflow,
+    (struct SWMM_Project* p, int index, double flowrate),
+    (index, flowrate))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setOutfallStage,
+    (struct SWMM_Project* p, int index, double stage),
+    (index, stage))
+
+SWMM_REENTRANT(int, EXPORT_TOOLKIT int, swmm_setGagePrecip,
+    (struct SWMM_Project* p, int index, double total_precip),
+    (index, total_precip))
+
 //-------------------------------
 // Utility Functions
 //-------------------------------
@@ -7,6 +7,11 @@
 //   Author:   L. Rossman
 //
 //   Topological sorting of conveyance network links
+//
+//   Update History
+//   ==============
+//   Build 5.2.4 (OWA):
+//   - Locality-improving renumbering of nodes and links added.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -21,25 +26,26 @@ enum AdjListType {UNDIRECTED, DIRECTED};    // type of nodal adjacency list
 //-----------------------------------------------------------------------------
 //  Shared variables
 //-----------------------------------------------------------------------------
-static int* InDegree;                  // number of incoming links to each node
-static int* StartPos;                  // start of a node's outlinks in AdjList
-static int* AdjList;                   // list of outlink indexes for each node
-static int* Stack;                     // array of nodes "reached" during sorting
-static int  First;                     // position of first node in stack
-static int  Last;                      // position of last node added to stack
-
-static char* Examined;                 // TRUE if node included in spanning tree
-static char* InTree;                   // state of each link in spanning tree:
+static SWMM_TLS int* InDegree;                  // number of incoming links to each node
+static SWMM_TLS int* StartPos;                  // start of a node's outlinks in AdjList
+static SWMM_TLS int* AdjList;                   // list of outlink indexes for each node
+static SWMM_TLS int* Stack;                     // array of nodes "reached" during sorting
+static SWMM_TLS int  First;                     // position of first node in stack
+static SWMM_TLS int  Last;                      // position of last node added to stack
+
+static SWMM_TLS char* Examined;                 // TRUE if node included in spanning tree
+static SWMM_TLS char* InTree;                   // state of each link in spanning tree:
                                        // 0 = unexamined,
                                        // 1 = in spanning tree,
                                        // 2 = chord of spanning tree
-static int*  LoopLinks;                // list of links which forms a loop
-static int   LoopLinksLast;            // number of links in a loop
+static SWMM_TLS int*  LoopLinks;                // list of links which forms a loop
+static SWMM_TLS int   LoopLinksLast;            // number of links in a loop
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)   
 //-----------------------------------------------------------------------------
 //  toposort_sortLinks (called by routing_open)
+//  toposort_renumber  (called by input_countObjects)
 
 //-----------------------------------------------------------------------------
 //  Local functions
@@ -52,6 +58,7 @@ static void findSpanningTree(int startNode);
 static void evalLoop(int startLink);
 static int  traceLoop(int i1, int i2, int k);
 static void checkDummyLinks(void);
+static void sortByDegree(int nodes[], int n, int degree[]);
 //=============================================================================
 
 void toposort_sortLinks(int sortedLinks[])
@@ -531,3 +538,176 @@ void checkDummyLinks()
 }
 
 //=============================================================================
+
+int toposort_renumber(int method, int nNodes, int nLinks, int node1[],
+                      int node2[], char isOutfall[], int nodeOrder[],
+                      int linkOrder[])
+//
+//  Input:   method = renumbering method (BFS_RENUMBER or RCM_RENUMBER)
+//           nNodes = number of nodes
+//           nLinks = number of links
+//           node1 = input position of each link's upstream node (or -1)
+//           node2 = input position of each link's downstream node (or -1)
+//           isOutfall = TRUE for nodes that are outfalls
+//  Output:  nodeOrder = input position of the node given each new index
+//           linkOrder = input position of the link given each new index
+//           returns an error code
+//  Purpose: orders nodes so that connected nodes receive nearby indexes
+//           and then orders links by the new index of their end nodes.
+//
+//  Nodes are ordered breadth-first over the undirected network, either
+//  starting from each outfall in turn (BFS) or from a node of lowest degree
+//  with neighbors visited in order of increasing degree, the final order
+//  being reversed (reverse Cuthill-McKee).
+//
+{
+    int  i, j, k, m, n1, n2;
+    int  first, last;                  // head & tail of BFS queue
+    int  nSeeds;                       // number of candidate start nodes
+    int* degree   = (int *) calloc(nNodes, sizeof(int));
+    int* startPos = (int *) calloc(nNodes+2, sizeof(int));
+    int* adjList  = (int *) calloc(2*nLinks+1, sizeof(int));
+    int* seeds    = (int *) calloc(nNodes+1, sizeof(int));
+    int* newIndex = (int *) calloc(nNodes, sizeof(int));
+    char* visited = (char *) calloc(nNodes+1, sizeof(char));
+
+    if ( degree == NULL || startPos == NULL || adjList == NULL ||
+         seeds == NULL || newIndex == NULL || visited == NULL )
+    {
+        FREE(degree);
+        FREE(startPos);
+        FREE(adjList);
+        FREE(seeds);
+        FREE(newIndex);
+        FREE(visited);
+        return ERR_MEMORY;
+    }
+
+    // --- build an undirected adjacency list of nodes
+    for ( i = 0; i < nLinks; i++ )
+    {
+        n1 = node1[i];
+        n2 = node2[i];
+        if ( n1 < 0 || n2 < 0 || n1 == n2 ) continue;
+        degree[n1]++;
+        degree[n2]++;
+    }
+    for ( i = 0; i < nNodes; i++ ) startPos[i+1] = startPos[i] + degree[i];
+    for ( i = 0; i < nNodes; i++ ) seeds[i] = startPos[i];
+    for ( i = 0; i < nLinks; i++ )
+    {
+        n1 = node1[i];
+        n2 = node2[i];
+        if ( n1 < 0 || n2 < 0 || n1 == n2 ) continue;
+        adjList[seeds[n1]++] = n2;
+        adjList[seeds[n2]++] = n1;
+    }
+
+    // --- list candidate start nodes: outfalls for BFS,
+    //     all nodes by increasing degree for RCM
+    nSeeds = 0;
+    if ( method == BFS_RENUMBER )
+    {
+        for ( i = 0; i < nNodes; i++ ) if ( isOutfall[i] ) seeds[nSeeds++] = i;
+    }
+    else
+    {
+        // --- counting sort on degree (newIndex holds the counts)
+        for ( i = 0; i < nNodes; i++ ) newIndex[i] = 0;
+        for ( i = 0; i < nNodes; i++ ) newIndex[MIN(degree[i], nNodes-1)]++;
+        for ( i = 1; i < nNodes; i++ ) newIndex[i] += newIndex[i-1];
+        for ( i = nNodes-1; i >= 0; i-- )
+            seeds[--newIndex[MIN(degree[i], nNodes-1)]] = i;
+        nSeeds = nNodes;
+    }
+
+    // --- traverse each connected part of the network breadth-first,
+    //     using nodeOrder as the queue of visited nodes
+    last = 0;
+    k = 0;
+    while ( last < nNodes )
+    {
+        // --- find next start node (any node of an unreached part
+        //     of the network once the candidates are used up)
+        while ( k < nSeeds && visited[seeds[k]] ) k++;
+        if ( k < nSeeds ) j = seeds[k];
+        else for ( j = 0; j < nNodes; j++ ) if ( !visited[j] ) break;
+
+        first = last;
+        nodeOrder[last++] = j;
+        visited[j] = TRUE;
+        while ( first < last )
+        {
+            j = nodeOrder[first++];
+            m = last;
+            for ( i = startPos[j]; i < startPos[j+1]; i++ )
+            {
+                if ( visited[adjList[i]] ) continue;
+                visited[adjList[i]] = TRUE;
+                nodeOrder[last++] = adjList[i];
+            }
+            if ( method == RCM_RENUMBER )
+                sortByDegree(&nodeOrder[m], last - m, degree);
+        }
+    }
+
+    // --- reverse the Cuthill-McKee order
+    if ( method == RCM_RENUMBER )
+    {
+        for ( i = 0, j = nNodes-1; i < j; i++, j-- )
+        {
+            m = nodeOrder[i];
+            nodeOrder[i] = nodeOrder[j];
+            nodeOrder[j] = m;
+        }
+    }
+    for ( i = 0; i < nNodes; i++ ) newIndex[nodeOrder[i]] = i;
+
+    // --- order links by the lower new index of their end nodes
+    //     (a bucket sort that keeps links of the same bucket in
+    //     input order; links with a missing node go last)
+    for ( i = 0; i <= nNodes+1; i++ ) startPos[i] = 0;
+    for ( i = 0; i < nLinks; i++ )
+    {
+        m = nNodes;
+        if ( node1[i] >= 0 && node2[i] >= 0 )
+            m = MIN(newIndex[node1[i]], newIndex[node2[i]]);
+        adjList[i] = m;
+        startPos[m+1]++;
+    }
+    for ( i = 0; i <= nNodes; i++ ) startPos[i+1] += startPos[i];
+    for ( i = 0; i < nLinks; i++ ) linkOrder[startPos[adjList[i]]++] = i;
+
+    FREE(degree);
+    FREE(startPos);
+    FREE(adjList);
+    FREE(seeds);
+    FREE(newIndex);
+    FREE(visited);
+    return 0;
+}
+
+//=============================================================================
+
+void sortByDegree(int nodes[], int n, int degree[])
+//
+//  Input:   nodes = list of node indexes
+//           n = number of nodes in list
+//           degree = number of nodes adjacent to each node
+//  Output:  nodes = list sorted by increasing degree
+//  Purpose: stable insertion sort of a list of nodes by their degree.
+//
+{
+    int i, j, node;
+    for ( i = 1; i < n; i++ )
+    {
+        node = nodes[i];
+        for ( j = i; j > 0 && degree[nodes[j-1]] > degree[node]; j-- )
+        {
+            nodes[j] = nodes[j-1];
+        }
+        nodes[j] = node;
+    }
+}
+
+//=============================================================================
@@ -14,6 +14,8 @@
 //   - Function added to create a transect for a Street cross-section.
 //   Build 5.2.4:
 //   - Corrected street transect points in transect_createStreetTransect.
+//   Build 5.2.4 (OWA):
+//   - Transects allocated from a memory pool freed with the project.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -30,18 +32,18 @@
 //-----------------------------------------------------------------------------
 //  Shared variables
 //-----------------------------------------------------------------------------
-static int    Ntransects;              // total number of transects
-static int    Nstations;               // number of stations in current transect
-static double  Station[MAXSTATION+1];  // x-coordinate of each station
-static double  Elev[MAXSTATION+1];     // elevation of each station
-static double  Nleft;                  // Manning's n for left overbank
-static double  Nright;                 // Manning's n for right overbank
-static double  Nchannel;               // Manning's n for main channel
-static double  Xleftbank;              // station where left overbank ends
-static double  Xrightbank;             // station where right overbank begins
-static double  Xfactor;                // multiplier for station spacing
-static double  Yfactor;                // factor added to station elevations
-static double  Lfactor;                // main channel/flood plain length
+#define Ntransects  (ActiveProject->transect.Ntransects)   // see globals.h
+static SWMM_TLS int    Nstations;               // number of stations in current transect
+static SWMM_TLS double  Station[MAXSTATION+1];  // x-coordinate of each station
+static SWMM_TLS double  Elev[MAXSTATION+1];     // elevation of each station
+static SWMM_TLS double  Nleft;                  // Manning's n for left overbank
+static SWMM_TLS double  Nright;                 // Manning's n for right overbank
+static SWMM_TLS double  Nchannel;               // Manning's n for main channel
+static SWMM_TLS double  Xleftbank;              // station where left overbank ends
+static SWMM_TLS double  Xrightbank;             // station where right overbank begins
+static SWMM_TLS double  Xfactor;                // multiplier for station spacing
+static SWMM_TLS double  Yfactor;                // factor added to station elevations
+static SWMM_TLS double  Lfactor;                // main channel/flood plain length
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)   
@@ -76,7 +78,8 @@ int transect_create(int n)
 {
     Ntransects = n;
     if ( n == 0 ) return 0;
-    Transect = (TTransect *) calloc(Ntransects, sizeof(TTransect));
+    Transect = (TTransect *) project_alloc(TRANSECT, Ntransects,
+                                           sizeof(TTransect));
     if ( Transect == NULL ) return ERR_MEMORY;
     Nchannel = 0.0;
     Nleft = 0.0;
@@ -91,11 +94,12 @@ void transect_delete(void)
 //
 //  Input:   none
 //  Output:  none
-//  Purpose: deletes memory allocated for all transects.
+//  Purpose: releases all transects (their memory is freed with the
+//           transects' memory pool).
 //
 {
     if ( Ntransects == 0 ) return;
-    FREE(Transect);
+    Transect = NULL;
     Ntransects = 0;
 }
 
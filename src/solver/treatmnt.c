@@ -14,6 +14,8 @@
 //   - A bug in evaluating recursive calls to treatment functions was fixed. 
 //   Build 5.2.0:
 //   - Changed enumerated constant used to indicate a math expression error.
+//   Build 5.2.4 (OWA):
+//   - Treatment objects allocated from the nodes' memory pool.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
@@ -34,13 +36,13 @@ enum   ProcessVarType {pvHRT,          // hydraulic residence time
 //-----------------------------------------------------------------------------
 //  Shared variables
 //-----------------------------------------------------------------------------
-static int     ErrCode;                // treatment error code
-static int     J;                      // index of node being analyzed
-static double  Dt;                     // curent time step (sec)
-static double  Q;                      // node inflow (cfs)
-static double  V;                      // node volume (ft3)
-static double* R;                      // array of pollut. removals
-static double* Cin;                    // node inflow concentrations
+static SWMM_TLS int     ErrCode;                // treatment error code
+static SWMM_TLS int     J;                      // index of node being analyzed
+static SWMM_TLS double  Dt;                     // curent time step (sec)
+static SWMM_TLS double  Q;                      // node inflow (cfs)
+static SWMM_TLS double  V;                      // node volume (ft3)
+#define R    (ActiveProject->treatmnt.R)     // array of pollut. removals
+#define Cin  (ActiveProject->treatmnt.Cin)   // node inflow concentrations
 
 //-----------------------------------------------------------------------------
 //  External functions (declared in funcs.h)
@@ -166,7 +168,8 @@ void treatmnt_delete(int j)
 //
 //  Input:   j = node index
 //  Output:  none
-//  Purpose: deletes the treatment objects for each pollutant at a node.
+//  Purpose: deletes the treatment expressions for each pollutant at a node.
+//           (The treatment objects are freed with the node memory pool.)
 //
 {
     int p;
@@ -174,7 +177,6 @@ void treatmnt_delete(int j)
     {
         for (p=0; p<Nobjects[POLLUT]; p++)
             mathexpr_delete(Node[j].treatment[p].equation);
-        free(Node[j].treatment);
     }
     Node[j].treatment = NULL;
 }
@@ -311,8 +313,8 @@ int  createTreatment(int j)
 //
 {
     int p;
-    Node[j].treatment = (TTreatment *) calloc(Nobjects[POLLUT],
-                                              sizeof(TTreatment));
+    Node[j].treatment = (TTreatment *) project_alloc(NODE, Nobjects[POLLUT],
+                                                     sizeof(TTreatment));
     if ( Node[j].treatment == NULL )
     {
         return FALSE;
@@ -0,0 +1,491 @@
+//-----------------------------------------------------------------------------
+//   tscache.c
+//
+//   Project:  EPA SWMM5
+//   Version:  5.2
+//   Date:     10/16/26   (Build 5.2.4 (OWA))
+//
+//   Binary cache of time series data files.
+//
+//   When the TIMESERIES_CACHE option is used, the dates and values parsed
+//   from a time series' external data file are saved to a binary cache file
+//   (the data file's name with a ".tsb" extension added) the first time the
+//   data file is read. Later runs memory-map the cache instead of parsing
+//   the text file, as long as the data file's size, modification time and
+//   a hash of its first and last TSB_HASHED bytes match those recorded in
+//   the cache (so that an edit that keeps the file's size within the same
+//   second is still detected). Entries that begin a data file
+//   without a date are dated from the simulation's start date, so a cache
+//   of such a file is only valid for the start date it was made with.
+//
+//   A cache file contains a TCacheHeader structure followed by the first
+//   date in each block of TSB_BLOCK entries, then the dates of all entries
+//   and finally all of their values (all as doubles). Only the pages of
+//   the cache that a time series lookup touches are ever read from disk.
+//
+//   A cache is written to a temporary file named after the process and
+//   project writing it and then renamed over any existing cache in one
+//   step, so concurrent runs never see a partly written or missing cache.
+//   If a cache file cannot be written then the parsed entries are still
+//   used in place of the text file for the current run.
+//-----------------------------------------------------------------------------
+#define _CRT_SECURE_NO_DEPRECATE
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "headers.h"
+
+#if defined(_WIN32) || defined(__WIN32__)
+  #include <windows.h>
+  #define getProcessId()  ((unsigned long)GetCurrentProcessId())
+#else
+  #include <unistd.h>
+  #define getProcessId()  ((unsigned long)getpid())
+#endif
+
+//-----------------------------------------------------------------------------
+//  Constants
+//-----------------------------------------------------------------------------
+static const char TSB_SIGNATURE[8] = {'S','W','M','M','T','S','B','2'};
+#define  TSB_EXTENSION  ".tsb"         // cache file extension
+#define  TSB_BLOCK      512            // entries per block of the date index
+#define  TSB_HASHED     4096           // bytes hashed at each end of data file
+
+//-----------------------------------------------------------------------------
+//  Cache file header
+//-----------------------------------------------------------------------------
+typedef struct
+{
+    char       signature[8];           // file type & format version
+    long long  srcSize;                // size of data file (bytes)
+    long long  srcTime;                // modification time of data file
+    unsigned long long srcHash;        // hash of start & end of data file
+    int        nEntries;               // number of entries
+    int        nBlocks;                // number of blocks in date index
+    int        eofEntry;               // entry whose reading ends data file
+    int        nRising;                // initial run of non-decreasing values
+    int        undated;                // TRUE if 1st entry has no date
+    int        unused;
+    double     dxMin;                  // smallest interval between dates
+    double     startDate;              // date assigned to undated entries
+}  TCacheHeader;
+
+//-----------------------------------------------------------------------------
+//  Data file stamp
+//-----------------------------------------------------------------------------
+typedef struct
+{
+    long long  size;                   // file size (bytes)
+    long long  mtime;                  // file modification time
+    unsigned long long hash;           // hash of start & end of file
+}  TFileStamp;
+
+//-----------------------------------------------------------------------------
+//  Local functions
+//-----------------------------------------------------------------------------
+static int  getFileStamp(const char* fname, TFileStamp* stamp);
+static unsigned long long hashBytes(unsigned long long hash,
+            const unsigned char* bytes, size_t n);
+static int  openCache(TTable* table, const char* cacheName,
+            TFileStamp* stamp);
+static int  createCache(TTable* table, const char* cacheName,
+            TFileStamp* stamp);
+static int  readEntries(TTable* table, TCacheHeader* hdr, double** x,
+            double** y);
+static void writeCache(const char* cacheName, TCacheHeader* hdr, double* x,
+            double* y);
+
+//=============================================================================
+
+int tscache_open(TTable* table)
+//
+//  Input:   table = pointer to a time series with an external data file
+//  Output:  returns TRUE if the time series' data are now held in a cache,
+//           FALSE if the data file must be read as text
+//  Purpose: opens (or creates) the binary cache of a time series data file.
+//
+{
+    char       cacheName[MAXFNAME+1];
+    TFileStamp stamp;
+
+    // --- retrieve size, modification time & hash of the data file
+    if ( strlen(table->file.name) + strlen(TSB_EXTENSION) > MAXFNAME )
+        return FALSE;
+    if ( !getFileStamp(table->file.name, &stamp) ) return FALSE;
+    sstrncpy(cacheName, table->file.name, MAXFNAME);
+    strcat(cacheName, TSB_EXTENSION);
+
+    // --- use an existing up-to-date cache, otherwise create one
+    if ( openCache(table, cacheName, &stamp) ) return TRUE;
+    return createCache(table, cacheName, &stamp);
+}
+
+//=============================================================================
+
+void tscache_close(TTable* table)
+//
+//  Input:   table = pointer to a time series
+//  Output:  none
+//  Purpose: releases a time series' cached data.
+//
+{
+    TTseriesCache* cache = table->cache;
+
+    if ( cache == NULL ) return;
+    if ( cache->map.data )
+    {
+        mapfile_close(&cache->map);
+        table->xData = NULL;
+        table->yData = NULL;
+    }
+    else
+    {
+        FREE(table->xData);
+        FREE(table->yData);
+    }
+    table->nEntries = 0;
+    FREE(table->cache);
+}
+
+//=============================================================================
+
+int tscache_findEntry(TTable* table, int lo, double x)
+//
+//  Input:   table = pointer to a time series with cached data
+//           lo = index of first entry to search
+//           x = a date
+//  Output:  returns the index of the first entry at or after lo whose date
+//           is >= x (or the number of entries if there is none)
+//  Purpose: searches the date index and then a single block of dates of a
+//           cached time series for a given date.
+//
+{
+    TTseriesCache* cache = table->cache;
+    double* xd = table->xData;
+    int     n = table->nEntries;
+    int     b, bLo, bHi, hi, mid;
+
+    if ( lo >= n ) return n;
+    if ( x <= xd[lo] ) return lo;
+
+    // --- find the first block after the one holding entry lo whose
+    //     first date is >= x
+    bLo = lo / TSB_BLOCK + 1;
+    bHi = cache->nBlocks;
+    b = bLo;
+    while ( bLo < bHi )
+    {
+        mid = bLo + (bHi - bLo) / 2;
+        if ( x <= cache->xBlock[mid] ) bHi = mid;
+        else bLo = mid + 1;
+    }
+
+    // --- the entry lies in the block before that one
+    if ( bLo > b ) lo = MAX(lo, (bLo - 1) * TSB_BLOCK + 1);
+    hi = ( bLo < cache->nBlocks ) ? bLo * TSB_BLOCK : n;
+    while ( lo < hi )
+    {
+        mid = lo + (hi - lo) / 2;
+        if ( x <= xd[mid] ) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+//=============================================================================
+
+int getFileStamp(const char* fname, TFileStamp* stamp)
+//
+//  Input:   fname = name of a file
+//  Output:  stamp = file's size, modification time & content hash
+//           returns TRUE if successful, FALSE if not
+//  Purpose: retrieves the size, modification time and a hash of the first
+//           and last TSB_HASHED bytes of a file.
+//
+{
+    struct stat   st;
+    unsigned char buf[TSB_HASHED];
+    size_t        n;
+    FILE*         f;
+
+    if ( stat(fname, &st) != 0 ) return FALSE;
+    stamp->size = (long long)st.st_size;
+    stamp->mtime = (long long)st.st_mtime;
+
+    // --- hash the start of the file and then its end (FNV-1a)
+    f = fopen(fname, "rb");
+    if ( f == NULL ) return FALSE;
+    n = fread(buf, 1, TSB_HASHED, f);
+    stamp->hash = hashBytes(14695981039346656037ULL, buf, n);
+    if ( stamp->size > TSB_HASHED &&
+         fseek(f, -TSB_HASHED, SEEK_END) == 0 )
+    {
+        n = fread(buf, 1, TSB_HASHED, f);
+        stamp->hash = hashBytes(stamp->hash, buf, n);
+    }
+    fclose(f);
+    return TRUE;
+}
+
+//=============================================================================
+
+unsigned long long hashBytes(unsigned long long hash,
+                             const unsigned char* bytes, size_t n)
+//
+//  Input:   hash = current hash value
+//           bytes = array of bytes
+//           n = number of bytes
+//  Output:  returns the updated hash value
+//  Purpose: adds an array of bytes to a 64-bit FNV-1a hash.
+//
+{
+    size_t i;
+
+    for ( i = 0; i < n; i++ )
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+//=============================================================================
+
+int openCache(TTable* table, const char* cacheName, TFileStamp* stamp)
+//
+//  Input:   table = pointer to a time series
+//           cacheName = name of cache file
+//           stamp = size, modification time & hash of time series' data file
+//  Output:  returns TRUE if successful, FALSE if not
+//  Purpose: memory-maps an existing cache file if it is up to date.
+//
+{
+    TTseriesCache* cache;
+    TCacheHeader*  hdr;
+    double*        data;
+    size_t         nDoubles;
+
+    cache = (TTseriesCache *) calloc(1, sizeof(TTseriesCache));
+    if ( cache == NULL ) return FALSE;
+    if ( !mapfile_open(&cache->map, cacheName) )
+    {
+        free(cache);
+        return FALSE;
+    }
+
+    // --- check that the cache matches the data file and is complete
+    hdr = (TCacheHeader *)cache->map.data;
+    if ( cache->map.size < sizeof(TCacheHeader) ||
+         memcmp(hdr->signature, TSB_SIGNATURE, sizeof(TSB_SIGNATURE)) != 0 ||
+         hdr->srcSize != stamp->size || hdr->srcTime != stamp->mtime ||
+         hdr->srcHash != stamp->hash ||
+         hdr->nEntries <= 0 || hdr->nBlocks <= 0 ||
+         (hdr->undated && hdr->startDate != table->lastDate) )
+    {
+        mapfile_close(&cache->map);
+        free(cache);
+        return FALSE;
+    }
+    nDoubles = (size_t)hdr->nBlocks + 2 * (size_t)hdr->nEntries;
+    if ( cache->map.size != sizeof(TCacheHeader) + nDoubles * sizeof(double) )
+    {
+        mapfile_close(&cache->map);
+        free(cache);
+        return FALSE;
+    }
+
+    // --- point the table's arrays into the cache
+    data = (double *)(cache->map.data + sizeof(TCacheHeader));
+    cache->xBlock = data;
+    cache->nBlocks = hdr->nBlocks;
+    cache->eofEntry = hdr->eofEntry;
+    table->cache = cache;
+    table->xData = data + hdr->nBlocks;
+    table->yData = table->xData + hdr->nEntries;
+    table->nEntries = hdr->nEntries;
+    table->nRising = hdr->nRising;
+    table->dxMin = hdr->dxMin;
+    table->cursor = 1;
+    table->thisEntry = 0;
+    return TRUE;
+}
+
+//=============================================================================
+
+int createCache(TTable* table, const char* cacheName, TFileStamp* stamp)
+//
+//  Input:   table = pointer to a time series
+//           cacheName = name of cache file
+//           stamp = size, modification time & hash of time series' data file
+//  Output:  returns TRUE if successful, FALSE if not
+//  Purpose: parses a time series' data file and saves its entries to a
+//           cache file.
+//
+{
+    TTseriesCache* cache;
+    TCacheHeader   hdr;
+    double*        x = NULL;
+    double*        y = NULL;
+
+    // --- read the data file's entries
+    memset(&hdr, 0, sizeof(TCacheHeader));
+    memcpy(hdr.signature, TSB_SIGNATURE, sizeof(TSB_SIGNATURE));
+    hdr.srcSize = stamp->size;
+    hdr.srcTime = stamp->mtime;
+    hdr.srcHash = stamp->hash;
+    if ( !readEntries(table, &hdr, &x, &y) )
+    {
+        FREE(x);
+        FREE(y);
+        return FALSE;
+    }
+
+    // --- save them to the cache file (failure to do so is not an error)
+    writeCache(cacheName, &hdr, x, y);
+
+    // --- use the parsed entries for the current run
+    cache = (TTseriesCache *) calloc(1, sizeof(TTseriesCache));
+    if ( cache == NULL )
+    {
+        FREE(x);
+        FREE(y);
+        return FALSE;
+    }
+    cache->eofEntry = hdr.eofEntry;
+    table->cache = cache;
+    table->xData = x;
+    table->yData = y;
+    table->nEntries = hdr.nEntries;
+    table->nRising = hdr.nRising;
+    table->dxMin = hdr.dxMin;
+    table->cursor = 1;
+    table->thisEntry = 0;
+    return TRUE;
+}
+
+//=============================================================================
+
+int readEntries(TTable* table, TCacheHeader* hdr, double** x, double** y)
+//
+//  Input:   table = pointer to a time series
+//           hdr = pointer to a cache file header
+//  Output:  x = array of entry dates
+//           y = array of entry values
+//           returns TRUE if the data file was read completely and its
+//           dates are in ascending order, FALSE if not
+//  Purpose: reads all of the entries in a time series' data file.
+//
+//  NOTE: entries are read with the same functions used to read the data
+//        file as text, so the cache holds exactly the same values.
+//
+{
+    int    n = 0, capacity = 1024, ok;
+    int    atEnd = FALSE;
+    double startDate = table->lastDate;
+    double xx, yy;
+    double dx, dxMin = BIG;
+    double* p;
+
+    table->file.file = fopen(table->file.name, "rt");
+    if ( table->file.file == NULL ) return FALSE;
+    *x = (double *) malloc(capacity * sizeof(double));
+    *y = (double *) malloc(capacity * sizeof(double));
+    ok = ( *x != NULL && *y != NULL );
+
+    // --- check if the first entry has no date of its own
+    table->lastDate = -BIG;
+    if ( ok ) ok = table_getFirstEntry(table, &xx, &yy);
+    hdr->undated = ( table->lastDate == -BIG );
+
+    // --- read entries, noting if reading the last one reached end of file
+    table->lastDate = startDate;
+    if ( ok ) ok = table_getFirstEntry(table, &xx, &yy);
+    while ( ok )
+    {
+        if ( n == capacity )
+        {
+            capacity *= 2;
+            p = (double *) realloc(*x, capacity * sizeof(double));
+            if ( p == NULL ) { ok = FALSE; break; }
+            *x = p;
+            p = (double *) realloc(*y, capacity * sizeof(double));
+            if ( p == NULL ) { ok = FALSE; break; }
+            *y = p;
+        }
+        if ( n > 0 )
+        {
+            dx = xx - (*x)[n-1];
+            if ( dx <= 0.0 ) { ok = FALSE; break; }
+            dxMin = MIN(dxMin, dx);
+        }
+        (*x)[n] = xx;
+        (*y)[n] = yy;
+        n++;
+        atEnd = feof(table->file.file);
+        if ( !table_getNextEntry(table, &xx, &yy) ) break;
+    }
+
+    // --- the whole file must have been read
+    if ( ok && !feof(table->file.file) ) ok = FALSE;
+    fclose(table->file.file);
+    table->file.file = NULL;
+
+    // --- a file with both undated & dated entries is not cached since
+    //     re-reading it as text would date its first entries differently
+    if ( hdr->undated && table->lastDate != startDate ) ok = FALSE;
+    table->lastDate = startDate;
+    if ( !ok ) return FALSE;
+
+    hdr->nEntries = n;
+    hdr->nBlocks = (n + TSB_BLOCK - 1) / TSB_BLOCK;
+    hdr->eofEntry = atEnd ? n - 1 : n;
+    hdr->dxMin = dxMin;
+    hdr->startDate = startDate;
+    hdr->nRising = 1;
+    while ( hdr->nRising < n && (*y)[hdr->nRising] >= (*y)[hdr->nRising-1] )
+        hdr->nRising++;
+    return TRUE;
+}
+
+//=============================================================================
+
+void writeCache(const char* cacheName, TCacheHeader* hdr, double* x,
+                double* y)
+//
+//  Input:   cacheName = name of cache file
+//           hdr = pointer to the cache file's header
+//           x = array of entry dates
+//           y = array of entry values
+//  Output:  none
+//  Purpose: writes a time series' entries to a cache file.
+//
+//  NOTE: the cache is written to a temporary file, unique to the process
+//        and project writing it, that then atomically replaces any
+//        existing cache so that a partly written cache is never read and
+//        other runs always find either the old or the new cache.
+//
+{
+    char   tmpName[MAXFNAME+64];
+    int    b, ok;
+    size_t n = hdr->nEntries;
+    FILE*  f;
+
+    snprintf(tmpName, sizeof(tmpName), "%s~%lu.%llx", cacheName,
+             getProcessId(), (unsigned long long)(size_t)ActiveProject);
+    f = fopen(tmpName, "wb");
+    if ( f == NULL ) return;
+    ok = fwrite(hdr, sizeof(TCacheHeader), 1, f) == 1;
+    for ( b = 0; ok && b < hdr->nBlocks; b++ )
+        ok = fwrite(&x[b * TSB_BLOCK], sizeof(double), 1, f) == 1;
+    if ( ok ) ok = fwrite(x, sizeof(double), n, f) == n;
+    if ( ok ) ok = fwrite(y, sizeof(double), n, f) == n;
+    if ( fclose(f) != 0 ) ok = FALSE;
+#if defined(_WIN32) || defined(__WIN32__)
+    if ( ok ) ok = MoveFileExA(tmpName, cacheName,
+                               MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    if ( ok ) ok = rename(tmpName, cacheName) == 0;
+#endif
+    if ( !ok ) remove(tmpName);
+}
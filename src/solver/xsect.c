@@ -34,19 +34,51 @@
 //   - Support added for Street cross sections.
 //   Build 5.2.2:
 //   - Feasibility check added to Mod. Baskethandle & Rect.-Round shapes.
+//   Build 5.2.4 (OWA):
+//   - Optional geometry cache (GEOMETRY_CACHE option) added. Each distinct
+//     cross section shape & size gets uniform-grid tables of getAofY,
+//     getWofY, getRofY, getYofA, getRofA & getSofA that are linearly
+//     interpolated in place of the exact functions. A table's grid is
+//     refined until its interpolation error is within GEOM_TOL of the
+//     function's largest value; functions that can't meet this bound
+//     are left to be evaluated exactly.
+//   - Vectorized batch evaluation of circular area & hyd. radius added
+//     (xsect_getCircAandR).
+//   - xsect_getGeomTableCount added.
 //-----------------------------------------------------------------------------
 #define _CRT_SECURE_NO_DEPRECATE
 
+#include <stdlib.h>
 #include <math.h>
+#include <string.h>
 #include "headers.h"
 #include "findroot.h"
 
+// Where supported, the circular conduit batch kernel is compiled for AVX-512,
+// AVX2 & baseline instruction sets with the best one chosen at run time
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && \
+    defined(__linux__)
+#define  CIRC_KERNEL_TARGETS \
+         __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define  CIRC_KERNEL_TARGETS
+#endif
+
 #define  RECT_ALFMAX        0.97
 #define  RECT_TRIANG_ALFMAX 0.98
 #define  RECT_ROUND_ALFMAX  0.98
 
 #include "xsect.dat"    // File containing geometry tables for rounded shapes
 
+// Geometry cache tables have GEOM_MIN_INTERVALS * 2^k intervals, where
+// GEOM_MIN_INTERVALS is a multiple of the 20, 25 & 50 intervals used by the
+// tables in xsect.dat & by transect and shape curve tables (so that their
+// piecewise linear values are reproduced exactly).
+#define  GEOM_MIN_INTERVALS 100
+#define  GEOM_MAX_INTERVALS 3200
+#define  GEOM_TOL           1.0e-4   // max. interpolation error as fraction
+                                     // of a function's largest value
+
 //-----------------------------------------------------------------------------
 // Constants
 //-----------------------------------------------------------------------------
@@ -108,6 +140,20 @@ typedef struct
 //  xsect_getRofY
 //  xsect_getWofY
 //  xsect_getYcrit
+//  xsect_openGeomCache
+//  xsect_closeGeomCache
+//  xsect_setGeomTable
+//  xsect_getGeomTableCount
+//  xsect_getCircAandR
+
+//-----------------------------------------------------------------------------
+//  Shared variables
+//-----------------------------------------------------------------------------
+#define GeomTables     (ActiveProject->xsect.GeomTables)
+#define NumGeomTables  (ActiveProject->xsect.NumGeomTables)
+#define MaxGeomTables  (ActiveProject->xsect.MaxGeomTables)
+#define GeomIndex      (ActiveProject->xsect.GeomIndex)
+#define GeomIndexSize  (ActiveProject->xsect.GeomIndexSize)
 
 //-----------------------------------------------------------------------------
 //  Local functions
@@ -199,6 +245,14 @@ static double getQcritical(double yc, void* p);
 static double getYcritEnum(TXsect* xsect, double q, double y0);
 static double getYcritRidder(TXsect* xsect, double q, double y0);
 
+static void   getGeomKey(TXsect* xsect, double key[]);
+static unsigned int hashGeomKey(double key[]);
+static void   createGeomTable(TXsect* xsect, TGeomTable* table);
+static void   createGeomFunc(TGeomFunc* f, TXsect* xsect,
+              double (*func)(TXsect*, double), double xMax);
+static int    inGeomRange(TGeomFunc* f, double x);
+static double interpGeomFunc(TGeomFunc* f, double x);
+
 //=============================================================================
 
 int xsect_isOpen(int type)
@@ -721,6 +775,11 @@ double xsect_getSofA(TXsect *xsect, double a)
 {
     double alpha = a / xsect->aFull;
     double r;
+
+    // --- use cached geometry if available
+    if ( xsect->geomTable && inGeomRange(&xsect->geomTable->sOfA, a) )
+        return interpGeomFunc(&xsect->geomTable->sOfA, a);
+
     switch ( xsect->type )
     {
       case FORCE_MAIN:
@@ -779,6 +838,11 @@ double xsect_getYofA(TXsect *xsect, double a)
 //
 {
     double alpha = a / xsect->aFull;
+
+    // --- use cached geometry if available
+    if ( xsect->geomTable && inGeomRange(&xsect->geomTable->yOfA, a) )
+        return interpGeomFunc(&xsect->geomTable->yOfA, a);
+
     switch ( xsect->type )
     {
       case FORCE_MAIN:
@@ -863,6 +927,11 @@ double xsect_getAofY(TXsect *xsect, double y)
 //
 {
     double yNorm = y / xsect->yFull;
+
+    // --- use cached geometry if available
+    if ( xsect->geomTable && inGeomRange(&xsect->geomTable->aOfY, y) )
+        return interpGeomFunc(&xsect->geomTable->aOfY, y);
+
     if ( y <= 0.0 ) return 0.0;
     switch ( xsect->type )
     {
@@ -949,6 +1018,11 @@ double xsect_getWofY(TXsect *xsect, double y)
 //
 {
     double yNorm = y / xsect->yFull;
+
+    // --- use cached geometry if available
+    if ( xsect->geomTable && inGeomRange(&xsect->geomTable->wOfY, y) )
+        return interpGeomFunc(&xsect->geomTable->wOfY, y);
+
     switch ( xsect->type )
     {
       case FORCE_MAIN:
@@ -1037,6 +1111,11 @@ double xsect_getRofY(TXsect *xsect, double y)
 //
 {
     double yNorm = y / xsect->yFull;
+
+    // --- use cached geometry if available
+    if ( xsect->geomTable && inGeomRange(&xsect->geomTable->rOfY, y) )
+        return interpGeomFunc(&xsect->geomTable->rOfY, y);
+
     switch ( xsect->type )
     {
       case FORCE_MAIN:
@@ -1106,6 +1185,11 @@ double xsect_getRofA(TXsect *xsect, double a)
 //
 {
     double cathy;
+
+    // --- use cached geometry if available
+    if ( xsect->geomTable && inGeomRange(&xsect->geomTable->rOfA, a) )
+        return interpGeomFunc(&xsect->geomTable->rOfA, a);
+
     if ( a <= 0.0 ) return 0.0;
     switch ( xsect->type )
     {
@@ -1748,6 +1832,360 @@ double getYcritRidder(TXsect* xsect, double q, double y0)
 }
 
 
+//=============================================================================
+
+CIRC_KERNEL_TARGETS
+void xsect_getCircAandR(int n, double* y, double* yFull, double* aFull,
+                        double* rFull, double* wSlot, double* a, double* r)
+//
+//  Input:   n = number of depths
+//           y = flow depths (ft)
+//           yFull = full depth of circular section at each depth (ft)
+//           aFull = full area of circular section at each depth (ft2)
+//           rFull = full hyd. radius of circular section at each depth (ft)
+//           wSlot = Preissmann slot width at each depth (ft)
+//  Output:  a = flow area at each depth (ft2)
+//           r = hyd. radius at each depth (ft)
+//  Purpose: finds the flow area & hyd. radius of a set of circular
+//           conduits in a branch-free loop that the compiler can vectorize.
+//
+//  Note:    the table interpolation repeats the arithmetic of lookup() so
+//           that below full depth the results are identical to those of
+//           xsect_getAofY & xsect_getRofY. At or above full depth the area
+//           grows with the width of the Preissmann slot (if any) and the
+//           hyd. radius stays at its full value. The A_Circ and R_Circ
+//           tables have the same number of items.
+{
+    int    k;
+    int    last = N_A_Circ - 1;
+    double delta = 1.0 / ((double)N_A_Circ-1);
+    const double* aTable = A_Circ;
+    const double* rTable = R_Circ;
+    double aLast = A_Circ[last];
+    double rLast = R_Circ[last];
+
+    #pragma omp simd
+    for ( k = 0; k < n; k++ )
+    {
+        double x, x0, x1, aTbl, rTbl, aSlot, y2;
+        int    i, i0, i2;
+
+        // --- find which segment of the tables contains x
+        //     (i0 & i2 are kept within the tables for any x)
+        x = y[k] / yFull[k];
+        i = (int)(x / delta);
+        i0 = MIN(i, last - 1);
+        i0 = MAX(i0, 0);
+        i2 = MIN(i0 + 2, last);
+        x0 = i0 * delta;
+        x1 = ((double)i0+1) * delta;
+
+        // --- interpolate normalized area, using quadratic
+        //     interpolation over the first two segments
+        aTbl = aTable[i0] + (x - x0) * (aTable[i0+1] - aTable[i0]) / delta;
+        y2 = aTbl + (x - x0) * (x - x1) / (delta*delta) *
+             (aTable[i0]/2.0 - aTable[i0+1] + aTable[i2]/2.0) ;
+        aTbl = (i0 < 2 && y2 > 0.0) ? y2 : aTbl;
+        aTbl = (aTbl < 0.0) ? 0.0 : aTbl;
+        aTbl = (i >= last) ? aLast : aTbl;
+
+        // --- same for normalized hyd. radius
+        rTbl = rTable[i0] + (x - x0) * (rTable[i0+1] - rTable[i0]) / delta;
+        y2 = rTbl + (x - x0) * (x - x1) / (delta*delta) *
+             (rTable[i0]/2.0 - rTable[i0+1] + rTable[i2]/2.0) ;
+        rTbl = (i0 < 2 && y2 > 0.0) ? y2 : rTbl;
+        rTbl = (rTbl < 0.0) ? 0.0 : rTbl;
+        rTbl = (i >= last) ? rLast : rTbl;
+
+        // --- scale to full values (with slot area above full depth)
+        aTbl = aFull[k] * aTbl;
+        rTbl = rFull[k] * rTbl;
+        aSlot = aFull[k] + (y[k] - yFull[k]) * wSlot[k];
+        aTbl = (y[k] <= 0.0) ? 0.0 : aTbl;
+        a[k] = (y[k] >= yFull[k]) ? aSlot : aTbl;
+        r[k] = (y[k] >= yFull[k]) ? rFull[k] : rTbl;
+    }
+}
+
+//=============================================================================
+//  Geometry cache functions
+//=============================================================================
+
+int xsect_openGeomCache(int nXsects)
+//
+//  Input:   nXsects = max. number of cross sections to be cached
+//  Output:  returns TRUE if successful, FALSE if out of memory
+//  Purpose: allocates an empty set of cross section geometry tables.
+//
+{
+    int i;
+
+    xsect_closeGeomCache();
+    GeomIndexSize = 1;
+    while ( GeomIndexSize < 2 * nXsects ) GeomIndexSize *= 2;
+    GeomTables = (TGeomTable *) calloc(MAX(nXsects, 1), sizeof(TGeomTable));
+    GeomIndex = (int *) malloc(GeomIndexSize * sizeof(int));
+    if ( GeomTables == NULL || GeomIndex == NULL )
+    {
+        xsect_closeGeomCache();
+        return FALSE;
+    }
+    for ( i = 0; i < GeomIndexSize; i++ ) GeomIndex[i] = -1;
+    MaxGeomTables = nXsects;
+    return TRUE;
+}
+
+//=============================================================================
+
+void xsect_closeGeomCache()
+//
+//  Input:   none
+//  Output:  none
+//  Purpose: frees all cross section geometry tables.
+//
+{
+    int i;
+    TGeomTable* t;
+
+    if ( GeomTables ) for ( i = 0; i < NumGeomTables; i++ )
+    {
+        t = &GeomTables[i];
+        FREE(t->aOfY.values);
+        FREE(t->wOfY.values);
+        FREE(t->rOfY.values);
+        FREE(t->yOfA.values);
+        FREE(t->rOfA.values);
+        FREE(t->sOfA.values);
+    }
+    FREE(GeomTables);
+    FREE(GeomIndex);
+    NumGeomTables = 0;
+    MaxGeomTables = 0;
+    GeomIndexSize = 0;
+}
+
+//=============================================================================
+
+void xsect_setGeomTable(TXsect* xsect)
+//
+//  Input:   xsect = ptr. to a cross section data structure
+//  Output:  none
+//  Purpose: assigns a cross section the geometry table shared by all cross
+//           sections of the same shape & size, creating it if need be.
+//
+{
+    int    i, m;
+    double key[GEOM_KEY_SIZE];
+
+    xsect->geomTable = NULL;
+    if ( GeomTables == NULL || xsect->type == DUMMY ) return;
+
+    // --- search the hash index for a table with the same key
+    getGeomKey(xsect, key);
+    m = hashGeomKey(key) & (GeomIndexSize - 1);
+    while ( (i = GeomIndex[m]) >= 0 )
+    {
+        if ( memcmp(GeomTables[i].key, key, sizeof(key)) == 0 )
+        {
+            xsect->geomTable = &GeomTables[i];
+            return;
+        }
+        m = (m + 1) & (GeomIndexSize - 1);
+    }
+
+    // --- create a new table
+    if ( NumGeomTables >= MaxGeomTables ) return;
+    i = NumGeomTables++;
+    GeomIndex[m] = i;
+    memcpy(GeomTables[i].key, key, sizeof(key));
+    createGeomTable(xsect, &GeomTables[i]);
+    xsect->geomTable = &GeomTables[i];
+}
+
+//=============================================================================
+
+int xsect_getGeomTableCount()
+//
+//  Input:   none
+//  Output:  returns number of cross section geometry tables
+//  Purpose: counts the geometry tables created for the project's distinct
+//           cross section shapes & sizes.
+//
+{
+    return NumGeomTables;
+}
+
+//=============================================================================
+
+void getGeomKey(TXsect* xsect, double key[])
+//
+//  Input:   xsect = ptr. to a cross section data structure
+//  Output:  key = values that determine the cross section's geometry
+//  Purpose: finds the key that identifies a cross section's geometry table.
+//
+{
+    memset(key, 0, GEOM_KEY_SIZE * sizeof(double));
+    key[0]  = xsect->type;
+    key[1]  = xsect->transect;
+    key[2]  = xsect->yFull;
+    key[3]  = xsect->wMax;
+    key[4]  = xsect->ywMax;
+    key[5]  = xsect->aFull;
+    key[6]  = xsect->rFull;
+    key[7]  = xsect->sFull;
+    key[8]  = xsect->sMax;
+    key[9]  = xsect->yBot;
+    key[10] = xsect->aBot;
+
+    // --- a force main's sBot & rBot hold friction parameters
+    //     that have no bearing on its geometry
+    if ( xsect->type != FORCE_MAIN )
+    {
+        key[11] = xsect->sBot;
+        key[12] = xsect->rBot;
+    }
+}
+
+//=============================================================================
+
+unsigned int hashGeomKey(double key[])
+//
+//  Input:   key = values that determine a cross section's geometry
+//  Output:  returns a hash value for the key
+//  Purpose: computes the FNV-1a hash of a geometry table key.
+//
+{
+    unsigned int  h = 2166136261u;
+    unsigned char *p = (unsigned char *)key;
+    size_t i;
+
+    for ( i = 0; i < GEOM_KEY_SIZE * sizeof(double); i++ )
+    {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+//=============================================================================
+
+void createGeomTable(TXsect* xsect, TGeomTable* table)
+//
+//  Input:   xsect = ptr. to a cross section data structure
+//           table = ptr. to a geometry table
+//  Output:  none
+//  Purpose: tabulates a cross section's geometric functions.
+//
+{
+    // --- use a copy of the cross section without a table
+    //     so that the exact functions are evaluated
+    TXsect x = *xsect;
+    x.geomTable = NULL;
+
+    createGeomFunc(&table->aOfY, &x, xsect_getAofY, x.yFull);
+    createGeomFunc(&table->wOfY, &x, xsect_getWofY, x.yFull);
+    createGeomFunc(&table->rOfY, &x, xsect_getRofY, x.yFull);
+    createGeomFunc(&table->yOfA, &x, xsect_getYofA, x.aFull);
+    createGeomFunc(&table->rOfA, &x, xsect_getRofA, x.aFull);
+    createGeomFunc(&table->sOfA, &x, xsect_getSofA, x.aFull);
+}
+
+//=============================================================================
+
+void createGeomFunc(TGeomFunc* f, TXsect* xsect,
+                    double (*func)(TXsect*, double), double xMax)
+//
+//  Input:   f = ptr. to a tabulated function
+//           xsect = ptr. to a cross section data structure
+//           func = exact cross section function to tabulate
+//           xMax = largest argument to tabulate
+//  Output:  none
+//  Purpose: tabulates a function on the coarsest uniform grid whose linear
+//           interpolation error, checked at the quarter points of each
+//           interval, is within GEOM_TOL of the function's largest value.
+//
+//  Note:    f->n is left at 0 (no table) if no grid is fine enough.
+//
+{
+    int    i, j, n;
+    double dx, u, vMax, err, tol;
+    double *v;
+
+    f->n = 0;
+    f->values = NULL;
+    if ( xMax <= 0.0 ) return;
+
+    for ( n = GEOM_MIN_INTERVALS; n <= GEOM_MAX_INTERVALS; n *= 2 )
+    {
+        v = (double *) malloc((n + 1) * sizeof(double));
+        if ( v == NULL ) return;
+
+        // --- evaluate function at each grid point
+        dx = xMax / n;
+        vMax = 0.0;
+        for ( i = 0; i <= n; i++ )
+        {
+            v[i] = func(xsect, (i < n) ? i * dx : xMax);
+            vMax = MAX(vMax, fabs(v[i]));
+        }
+
+        // --- find max. interpolation error
+        tol = GEOM_TOL * vMax;
+        err = 0.0;
+        for ( i = 0; i < n && err <= tol; i++ )
+        {
+            for ( j = 1; j <= 3; j++ )
+            {
+                u = 0.25 * j;
+                err = MAX(err, fabs(func(xsect, (i + u) * dx) -
+                                    (v[i] + u * (v[i+1] - v[i]))));
+            }
+        }
+
+        // --- save table if error is acceptable
+        if ( err <= tol )
+        {
+            f->n = n;
+            f->xMax = xMax;
+            f->dxInv = n / xMax;
+            f->values = v;
+            return;
+        }
+        free(v);
+    }
+}
+
+//=============================================================================
+
+int inGeomRange(TGeomFunc* f, double x)
+//
+//  Input:   f = ptr. to a tabulated function
+//           x = function argument
+//  Output:  returns TRUE if x lies within the function's table
+//  Purpose: checks if a tabulated function can be used at a given argument.
+//
+{
+    return f->n > 0 && x >= 0.0 && x <= f->xMax;
+}
+
+//=============================================================================
+
+double interpGeomFunc(TGeomFunc* f, double x)
+//
+//  Input:   f = ptr. to a tabulated function
+//           x = function argument (between 0 and f->xMax)
+//  Output:  returns interpolated function value
+//  Purpose: linearly interpolates a tabulated function in constant time.
+//
+{
+    double u = x * f->dxInv;
+    int    i = MIN((int)u, f->n - 1);
+
+    u -= i;
+    return f->values[i] + u * (f->values[i+1] - f->values[i]);
+}
+
+
 //=============================================================================
 //  RECT_CLOSED fuctions
 //=============================================================================
@@ -0,0 +1,134 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       bench_dynwave.cpp
+ Description:  times dynamic wave routing on a large synthetic network
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+// Usage: bench_dynwave [--nodes n] [--hours h] [--threads t] [--shuffle]
+//                      [--renumber NONE|BFS|RCM]
+//                      [--pollutants p] [--min-parallel m]
+//        bench_dynwave --calibrate --threads t [--hours h]
+//
+// Reports the time spent in swmm_step, the number of routing steps taken
+// and the time per step and per link-step. Comparing the time per
+// link-step of two builds shows how much memory traffic the routing
+// loops save on networks too large for the CPU caches.
+//
+// With --calibrate, networks of increasing size are routed serially and
+// with t threads (always in parallel) and the smallest network size from
+// which the threads are faster is reported. That is the value to use for
+// MINPARALLELLINKS (consts.h) or the MIN_PARALLEL_LINKS option on this
+// machine.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+extern "C" {
+#include "swmm5.h"
+}
+
+#include "bench_network.hpp"
+
+
+// Routes a synthetic network, returning the time spent in swmm_step (s)
+// or a negative value on error
+static double runNetwork(const NetworkOptions& opt, long* steps, int* links)
+{
+    const char* inp = "bench_dynwave.inp";
+    double elapsedTime = 0.0;
+    int    error;
+
+    *steps = 0;
+    if (!writeNetwork(inp, opt))
+    {
+        fprintf(stderr, "cannot write %s\n", inp);
+        return -1.0;
+    }
+    error = swmm_open(inp, "bench_dynwave.rpt", "bench_dynwave.out");
+    if (!error) error = swmm_start(1);
+    if (error)
+    {
+        fprintf(stderr, "swmm error %d\n", error);
+        swmm_close();
+        return -1.0;
+    }
+
+    *links = swmm_getCount(swmm_LINK);
+    auto t0 = std::chrono::steady_clock::now();
+    do
+    {
+        error = swmm_step(&elapsedTime);
+        (*steps)++;
+    } while (elapsedTime > 0.0 && !error);
+    auto t1 = std::chrono::steady_clock::now();
+    swmm_end();
+    swmm_close();
+    if (error) return -1.0;
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+// Finds the network size from which routing with opt.threads threads is
+// faster than serial routing
+static int calibrate(NetworkOptions opt)
+{
+    const int sizes[] = {125, 250, 500, 1000, 2000, 4000, 8000, 16000};
+    int  threads = opt.threads;
+    int  links = 0;
+    int  minLinks = -1;
+    long steps;
+
+    opt.minParallel = 0;
+    printf("%8s %14s %14s\n", "links", "serial us/step", "threads us/step");
+    for (int n : sizes)
+    {
+        opt.nodes = n;
+        opt.threads = 1;
+        double t1 = runNetwork(opt, &steps, &links);
+        if (t1 < 0.0) return 1;
+        t1 /= steps;
+        opt.threads = threads;
+        double tn = runNetwork(opt, &steps, &links);
+        if (tn < 0.0) return 1;
+        tn /= steps;
+        printf("%8d %14.1f %14.1f\n", links, 1.0e6 * t1, 1.0e6 * tn);
+
+        // --- keep the smallest size beyond which threads always win
+        if (tn < t1) { if (minLinks < 0) minLinks = links; }
+        else minLinks = -1;
+    }
+    if (minLinks < 0)
+        printf("threads were not faster at any size: MIN_PARALLEL_LINKS %d\n",
+            links + 1);
+    else printf("MIN_PARALLEL_LINKS %d\n", minLinks);
+    return 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+    NetworkOptions opt = parseOptions(argc, argv);
+    long steps = 0;
+    int  links = 0;
+
+    for (int i = 1; i < argc; i++)
+        if (std::string(argv[i]) == "--calibrate") return calibrate(opt);
+
+    double secs = runNetwork(opt, &steps, &links);
+    if (secs < 0.0) return 1;
+    printf("nodes            %d\n", opt.nodes);
+    printf("links            %d\n", links);
+    printf("threads          %d\n", opt.threads);
+    printf("routing steps    %ld\n", steps);
+    printf("step time (s)    %.3f\n", secs);
+    printf("us per step      %.1f\n", 1.0e6 * secs / steps);
+    printf("ns per link-step %.2f\n", 1.0e9 * secs / steps / links);
+    return 0;
+}
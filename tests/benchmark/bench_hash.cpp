@@ -0,0 +1,123 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       bench_hash.cpp
+ Description:  times the object ID hash tables on a large number of IDs
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+// Usage: bench_hash [--ids n] [--reserve]
+//
+// Inserts n IDs (1,000,000 by default) named like the nodes and links of
+// a large model into a hash table, then looks each of them up, in a
+// different case and in a shuffled order, and looks up as many IDs that
+// are not in the table. Reports the time per insertion and per search.
+// With --reserve the table is first sized for n IDs, as is done for
+// compiled projects whose object counts are known in advance.
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "hash.h"
+}
+
+#include "bench_network.hpp"
+
+
+// Returns the time elapsed since t0 in ns per operation
+static double nsPerOp(std::chrono::steady_clock::time_point t0, int n)
+{
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+
+int main(int argc, char* argv[])
+{
+    int  n = 1000000;
+    bool reserve = false;
+    std::vector<std::string> ids, upper, missing;
+    std::vector<int> order;
+    BenchRandom rnd(12345);
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--ids" && i + 1 < argc) n = atoi(argv[++i]);
+        else if (arg == "--reserve") reserve = true;
+        else
+        {
+            fprintf(stderr, "usage: bench_hash [--ids n] [--reserve]\n");
+            return 1;
+        }
+    }
+    if (n <= 0) n = 1;
+
+    // --- IDs of the form used by model builders (e.g. "mh_001234")
+    for (int i = 0; i < n; i++)
+    {
+        char id[32];
+        snprintf(id, sizeof(id), "%s_%06d", (i % 2) ? "mh" : "pipe", i);
+        ids.push_back(id);
+        for (char& c : id) c = (char)toupper((unsigned char)c);
+        upper.push_back(id);
+        snprintf(id, sizeof(id), "out_%06d", i);
+        missing.push_back(id);
+        order.push_back(i);
+    }
+    for (int i = n - 1; i > 0; i--)
+        std::swap(order[i], order[(int)(rnd.next() * (i + 1))]);
+
+    HTtable* ht = HTcreate();
+    if (ht == NULL || (reserve && !HTreserve(ht, n)))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+    {
+        if (!HTinsert(ht, (char*)ids[i].c_str(), i))
+        {
+            fprintf(stderr, "out of memory\n");
+            return 1;
+        }
+    }
+    double tInsert = nsPerOp(t0, n);
+
+    int errors = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+        if (HTfind(ht, upper[order[i]].c_str()) != order[i]) errors++;
+    double tFind = nsPerOp(t0, n);
+
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+        if (HTfind(ht, missing[order[i]].c_str()) != NOTFOUND) errors++;
+    double tMiss = nsPerOp(t0, n);
+
+    printf("ids              %d\n", n);
+    printf("table slots      %d\n", ht->size);
+    printf("ns per insert    %.1f\n", tInsert);
+    printf("ns per find      %.1f\n", tFind);
+    printf("ns per miss      %.1f\n", tMiss);
+    HTfree(ht);
+    if (errors)
+    {
+        printf("%d searches gave wrong results\n", errors);
+        return 1;
+    }
+    return 0;
+}
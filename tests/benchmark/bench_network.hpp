@@ -0,0 +1,173 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       bench_network.hpp
+ Description:  writes synthetic sewer network input files for benchmarks
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#ifndef BENCH_NETWORK_HPP
+#define BENCH_NETWORK_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+// Options of a synthetic network
+struct NetworkOptions {
+    int    nodes   = 20000;   // number of nodes (junctions, storage & outfall)
+    int    hours   = 6;       // simulation duration (hours)
+    int    threads = 1;       // number of routing threads
+    bool   shuffle = false;   // list nodes & links in random order
+    int    pollutants = 2;    // number of pollutants
+    int    minParallel = -1;  // fewest links routed in parallel (-1 = default)
+    std::string renumber = "NONE"; // node & link renumbering method
+};
+
+
+// Small deterministic random number generator (same sequence on every
+// platform, unlike the distributions of <random>)
+class BenchRandom {
+public:
+    explicit BenchRandom(unsigned long long seed) : state(seed) {}
+    double next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (double)(state >> 11) / 9007199254740992.0;
+    }
+private:
+    unsigned long long state;
+};
+
+
+// Writes a dendritic dynamic wave network draining to a single outfall.
+// Leaf nodes receive runoff from a subcatchment. One in 200 nodes is a
+// storage unit and one in 5 conduits is rectangular.
+inline bool writeNetwork(const char* fname, const NetworkOptions& opt)
+{
+    int n = std::max(opt.nodes, 3);
+    BenchRandom rnd(7);
+    std::vector<int> parent(n, 0), depth(n, 0), order;
+    std::vector<double> elev(n);
+    std::vector<bool> storage(n, false);
+
+    // --- node 1 drains to outfall node 0; others drain to a lower node
+    for (int i = 2; i < n; i++)
+        parent[i] = std::max(1, rnd.next() < 0.7 ? (i - 1) / 2 : i - 1);
+    for (int i = 1; i < n; i++) depth[i] = depth[parent[i]] + 1;
+    for (int i = 0; i < n; i++) elev[i] = 100.0 + 0.3 * depth[i] + 0.1 * rnd.next();
+    for (int i = 1; i < n; i++)
+    {
+        order.push_back(i);
+        if (i % 200 == 0) storage[i] = true;
+    }
+    if (opt.shuffle)
+    {
+        for (size_t i = order.size() - 1; i > 0; i--)
+            std::swap(order[i], order[(size_t)(rnd.next() * (i + 1))]);
+    }
+
+    FILE* f = fopen(fname, "w");
+    if (f == NULL) return false;
+    fprintf(f, "[OPTIONS]\n"
+        "FLOW_UNITS CFS\nINFILTRATION HORTON\nFLOW_ROUTING DYNWAVE\n"
+        "LINK_OFFSETS DEPTH\nSTART_DATE 01/01/2000\nSTART_TIME 00:00:00\n"
+        "REPORT_START_DATE 01/01/2000\nREPORT_START_TIME 00:00:00\n"
+        "END_DATE 01/01/2000\nEND_TIME %02d:00:00\nREPORT_STEP 00:05:00\n"
+        "WET_STEP 00:01:00\nDRY_STEP 01:00:00\nROUTING_STEP 0:00:05\n"
+        "VARIABLE_STEP 0.75\nMIN_SURFAREA 12.566\nMAX_TRIALS 8\n"
+        "HEAD_TOLERANCE 0.005\nTHREADS %d\nRENUMBER %s\n\n",
+        std::min(opt.hours, 23), opt.threads, opt.renumber.c_str());
+    if (opt.minParallel >= 0)
+        fprintf(f, "[OPTIONS]\nMIN_PARALLEL_LINKS %d\n\n", opt.minParallel);
+    fprintf(f, "[RAINGAGES]\nRG1 INTENSITY 1:00 1.0 TIMESERIES TS1\n\n");
+    fprintf(f, "[TIMESERIES]\nTS1 0:00 0\nTS1 1:00 0.5\nTS1 2:00 1.2\n"
+        "TS1 3:00 0.6\nTS1 4:00 0.1\nTS1 5:00 0\n\n");
+
+    // --- subcatchments on leaf nodes
+    std::vector<int> leaves;
+    for (int i = n / 2; i < n; i++) if (!storage[i]) leaves.push_back(i);
+    fprintf(f, "[SUBCATCHMENTS]\n");
+    for (size_t k = 0; k < leaves.size(); k++)
+        fprintf(f, "S%zu RG1 J%d %.2f 40 300 0.5 0\n", k, leaves[k],
+            2.0 + 3.0 * rnd.next());
+    fprintf(f, "\n[SUBAREAS]\n");
+    for (size_t k = 0; k < leaves.size(); k++)
+        fprintf(f, "S%zu 0.012 0.1 0.05 0.1 25 OUTLET\n", k);
+    fprintf(f, "\n[INFILTRATION]\n");
+    for (size_t k = 0; k < leaves.size(); k++)
+        fprintf(f, "S%zu 3 0.5 4 7 0\n", k);
+
+    // --- nodes
+    fprintf(f, "\n[JUNCTIONS]\n");
+    for (int i : order)
+        if (!storage[i]) fprintf(f, "J%d %.3f 8 0 0 0\n", i, elev[i]);
+    fprintf(f, "\n[OUTFALLS]\nJ0 %.3f FREE NO\n", elev[0] - 1.0);
+    fprintf(f, "\n[STORAGE]\n");
+    for (int i : order)
+        if (storage[i]) fprintf(f, "J%d %.3f 12 0 FUNCTIONAL 1000 0 0 0 0\n",
+            i, elev[i] - 2.0);
+
+    // --- conduits
+    fprintf(f, "\n[CONDUITS]\n");
+    for (int i : order)
+        fprintf(f, "C%d J%d J%d %.1f 0.013 0 0 0 0\n", i, i, parent[i],
+            200.0 + 200.0 * rnd.next());
+    fprintf(f, "\n[XSECTIONS]\n");
+    for (int i : order)
+    {
+        double d = 1.0 + 0.25 * std::max(0, 10 - depth[i]);
+        if (i % 5 == 0) fprintf(f, "C%d RECT_CLOSED %.2f %.2f 0 0 1\n", i, d, 1.2*d);
+        else            fprintf(f, "C%d CIRCULAR %.2f 0 0 0 1\n", i, d);
+    }
+
+    // --- water quality
+    if (opt.pollutants > 0)
+    {
+        fprintf(f, "\n[POLLUTANTS]\n");
+        for (int p = 0; p < opt.pollutants; p++)
+            fprintf(f, "P%d MG/L 0 0 0 0 NO * 0 0 0\n", p);
+        fprintf(f, "\n[LANDUSES]\nResidential\n\n[COVERAGES]\n");
+        for (size_t k = 0; k < leaves.size(); k++)
+            fprintf(f, "S%zu Residential 100\n", k);
+        fprintf(f, "\n[BUILDUP]\n");
+        for (int p = 0; p < opt.pollutants; p++)
+            fprintf(f, "Residential P%d POW 50 0.5 2 AREA\n", p);
+        fprintf(f, "\n[WASHOFF]\n");
+        for (int p = 0; p < opt.pollutants; p++)
+            fprintf(f, "Residential P%d EXP 0.1 1 0 0\n", p);
+    }
+    fprintf(f, "\n[REPORT]\nSUBCATCHMENTS ALL\nNODES ALL\nLINKS ALL\n");
+    fclose(f);
+    return true;
+}
+
+
+// Reads the common benchmark options from the command line
+inline NetworkOptions parseOptions(int argc, char* argv[])
+{
+    NetworkOptions opt;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string a = argv[i];
+        if      (a == "--nodes"   && i+1 < argc) opt.nodes = atoi(argv[++i]);
+        else if (a == "--hours"   && i+1 < argc) opt.hours = atoi(argv[++i]);
+        else if (a == "--threads" && i+1 < argc) opt.threads = atoi(argv[++i]);
+        else if (a == "--pollutants" && i+1 < argc)
+            opt.pollutants = atoi(argv[++i]);
+        else if (a == "--renumber" && i+1 < argc) opt.renumber = argv[++i];
+        else if (a == "--min-parallel" && i+1 < argc)
+            opt.minParallel = atoi(argv[++i]);
+        else if (a == "--shuffle") opt.shuffle = true;
+    }
+    return opt;
+}
+
+#endif // BENCH_NETWORK_HPP
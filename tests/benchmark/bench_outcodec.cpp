@@ -0,0 +1,156 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       bench_outcodec.cpp
+ Description:  measures the compression of binary output file results
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+// Usage: bench_outcodec [file.out] [--chunk n] [--repeat r]
+//
+// Reads the results of an uncompressed binary output file
+// (tests/outfile/data/test_example1.out by default), encodes them in
+// chunks of n consecutive periods as is done for the COMPRESS_OUTPUT
+// option (by default as many periods as fill the 1 MB buffers of the
+// results writer) and decodes them again, r times over (10 by default).
+// Reports the compression ratio and the encoding and decoding throughput
+// in MB of uncompressed results per second.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "shared/outcodec.h"
+}
+
+
+// Returns the time elapsed since t0 in seconds
+static double seconds(std::chrono::steady_clock::time_point t0)
+{
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string path = "tests/outfile/data/test_example1.out";
+    int chunk = 0;
+    int repeat = 10;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--chunk" && i + 1 < argc) chunk = atoi(argv[++i]);
+        else if (arg == "--repeat" && i + 1 < argc) repeat = atoi(argv[++i]);
+        else if (arg[0] != '-') path = arg;
+        else
+        {
+            fprintf(stderr,
+                "usage: bench_outcodec [file.out] [--chunk n] [--repeat r]\n");
+            return 1;
+        }
+    }
+    if (repeat <= 0) repeat = 1;
+
+    // --- locate the results from the file's closing records
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> src((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    if (src.size() < 24)
+    {
+        fprintf(stderr, "can't read %s\n", path.c_str());
+        return 1;
+    }
+    int trailer[6];
+    memcpy(trailer, &src[src.size() - 24], sizeof(trailer));
+    long long resultsPos = trailer[2];
+    int nPeriods = trailer[3];
+    long long resultsBytes = (long long)src.size() - 24 - resultsPos;
+    if (nPeriods <= 0 || resultsBytes <= 0 || resultsBytes % nPeriods != 0 ||
+        (resultsBytes / nPeriods) % 4 != 0)
+    {
+        fprintf(stderr, "%s is not an uncompressed output file\n",
+            path.c_str());
+        return 1;
+    }
+    int nWords = (int)(resultsBytes / nPeriods / 4);
+    if (chunk <= 0) chunk = (1 << 20) / (4 * nWords);
+    if (chunk <= 0) chunk = 1;
+    if (chunk > nPeriods) chunk = nPeriods;
+
+    std::vector<unsigned int> results(resultsBytes / 4), decoded(results.size());
+    memcpy(results.data(), &src[resultsPos], resultsBytes);
+    std::vector<unsigned char> packed;
+    std::vector<size_t> chunkPos, chunkSize;
+
+    // --- encode the results chunk by chunk
+    size_t packedBytes = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++)
+    {
+        packed.resize(outcodec_bound(nPeriods, nWords) +
+            outcodec_bound(chunk, nWords));
+        chunkPos.clear();
+        chunkSize.clear();
+        packedBytes = 0;
+        for (int p = 0; p < nPeriods; p += chunk)
+        {
+            int n = nPeriods - p < chunk ? nPeriods - p : chunk;
+            size_t size = outcodec_encode(&results[(size_t)p * nWords], n,
+                nWords, &packed[packedBytes]);
+            chunkPos.push_back(packedBytes);
+            chunkSize.push_back(size);
+            packedBytes += size;
+        }
+    }
+    double tEncode = seconds(t0);
+
+    // --- decode them again
+    int errors = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; r++)
+    {
+        for (size_t c = 0; c < chunkPos.size(); c++)
+        {
+            int p = (int)c * chunk;
+            int n = nPeriods - p < chunk ? nPeriods - p : chunk;
+            if (!outcodec_decode(&packed[chunkPos[c]], chunkSize[c], n,
+                    nWords, &decoded[(size_t)p * nWords])) errors++;
+        }
+    }
+    double tDecode = seconds(t0);
+    if (decoded != results) errors++;
+
+    // --- each chunk also carries its header & index entry in a file
+    size_t fileBytes = packedBytes + chunkPos.size() *
+        (OUTCODEC_CHUNK_HEADER + OUTCODEC_INDEX_ENTRY) + OUTCODEC_FOOTER;
+    double mb = (double)resultsBytes * repeat / (1 << 20);
+
+    printf("periods          %d\n", nPeriods);
+    printf("bytes per period %d\n", 4 * nWords);
+    printf("periods per chunk %d\n", chunk);
+    printf("results bytes    %lld\n", resultsBytes);
+    printf("encoded bytes    %zu\n", packedBytes);
+    printf("compressed bytes %zu\n", fileBytes);
+    printf("ratio            %.2f\n", (double)resultsBytes / fileBytes);
+    printf("encode MB/s      %.1f\n", mb / tEncode);
+    printf("decode MB/s      %.1f\n", mb / tDecode);
+    if (errors)
+    {
+        printf("decoded results differ from the original\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       bench_qual.cpp
+ Description:  times quality routing on a large synthetic network
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+// Usage: bench_qual [--nodes n] [--hours h] [--threads t] [--shuffle]
+//                   [--renumber NONE|BFS|RCM] [--pollutants p]
+//
+// Routes the same network twice, without pollutants and with p of them
+// (12 by default), and reports the extra time per routing step and per
+// element-pollutant step that quality routing costs. Comparing the time
+// per element-pollutant step of two builds shows how the layout of the
+// node & link quality arrays affects quality routing.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+extern "C" {
+#include "swmm5.h"
+}
+
+#include "bench_network.hpp"
+
+
+// Routes a synthetic network, returning the time spent in swmm_step (s)
+// or a negative value on error
+static double runNetwork(const NetworkOptions& opt, long* steps, int* elements)
+{
+    const char* inp = "bench_qual.inp";
+    double elapsedTime = 0.0;
+    int    error;
+
+    *steps = 0;
+    if (!writeNetwork(inp, opt))
+    {
+        fprintf(stderr, "cannot write %s\n", inp);
+        return -1.0;
+    }
+    error = swmm_open(inp, "bench_qual.rpt", "bench_qual.out");
+    if (!error) error = swmm_start(1);
+    if (error)
+    {
+        fprintf(stderr, "swmm error %d\n", error);
+        swmm_close();
+        return -1.0;
+    }
+
+    *elements = swmm_getCount(swmm_NODE) + swmm_getCount(swmm_LINK);
+    auto t0 = std::chrono::steady_clock::now();
+    do
+    {
+        error = swmm_step(&elapsedTime);
+        (*steps)++;
+    } while (elapsedTime > 0.0 && !error);
+    auto t1 = std::chrono::steady_clock::now();
+    swmm_end();
+    swmm_close();
+    if (error) return -1.0;
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+
+int main(int argc, char* argv[])
+{
+    NetworkOptions opt = parseOptions(argc, argv);
+    long steps0 = 0, steps = 0;
+    int  elements = 0;
+
+    // --- use more pollutants than the routing benchmark by default
+    opt.pollutants = 12;
+    for (int i = 1; i < argc - 1; i++)
+        if (std::string(argv[i]) == "--pollutants")
+            opt.pollutants = atoi(argv[i+1]);
+    if (opt.pollutants <= 0)
+    {
+        fprintf(stderr, "--pollutants must be positive\n");
+        return 1;
+    }
+
+    NetworkOptions clean = opt;
+    clean.pollutants = 0;
+    double secs0 = runNetwork(clean, &steps0, &elements);
+    if (secs0 < 0.0) return 1;
+    double secs = runNetwork(opt, &steps, &elements);
+    if (secs < 0.0) return 1;
+
+    double extra = secs / steps - secs0 / steps0;
+    printf("nodes + links    %d\n", elements);
+    printf("pollutants       %d\n", opt.pollutants);
+    printf("routing steps    %ld\n", steps);
+    printf("us per step      %.1f (%.1f without pollutants)\n",
+        1.0e6 * secs / steps, 1.0e6 * secs0 / steps0);
+    printf("quality us/step  %.1f\n", 1.0e6 * extra);
+    printf("ns per element-pollutant step %.3f\n",
+        1.0e9 * extra / elements / opt.pollutants);
+    return 0;
+}
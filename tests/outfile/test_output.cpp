@@ -17,12 +17,26 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 #include <string>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
 
 #include "swmm_output.h"
 
+extern "C" {
+#include "shared/outcodec.h"
+}
+
 // NOTE: Reference data for the unit tests is currently tied to SWMM 5.1.7
 #define DATA_PATH "./test_example1.out"
+#define DATA_PATH_TRANSPOSED "./transposed_example1.out"
+#define DATA_PATH_COMPANION "./transposed_example1.tsp"
+#define DATA_PATH_SELECTED "./selected_example1.out"
+#define DATA_PATH_COMPRESSED "./compressed_example1.out"
 
 using namespace std;
 
@@ -361,3 +375,710 @@ BOOST_FIXTURE_TEST_CASE(test_getSystemResult, Fixture) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+
+// Series of every value in the copy's transposed results must match those
+// read period by period from the original file
+struct FixtureTranspose {
+    FixtureTranspose() {
+        std::ifstream in(DATA_PATH, std::ios::binary);
+        std::ofstream out(DATA_PATH_TRANSPOSED, std::ios::binary);
+        out << in.rdbuf();
+        out.close();
+        remove(DATA_PATH_COMPANION);
+
+        SMO_init(&ref_handle);
+        SMO_open(ref_handle, DATA_PATH);
+        SMO_init(&p_handle);
+        SMO_open(p_handle, DATA_PATH_TRANSPOSED);
+    }
+    ~FixtureTranspose() {
+        SMO_close(ref_handle);
+        SMO_close(p_handle);
+        remove(DATA_PATH_TRANSPOSED);
+        remove(DATA_PATH_COMPANION);
+    }
+
+    // Compares the series of every attribute of every element over a range
+    // of periods
+    void checkSeries(int start, int end) {
+        int *size, length, nVars[3];
+        float *test, *ref;
+        int err;
+
+        SMO_getProjectSize(ref_handle, &size, &length);
+        SMO_getSubcatchResult(ref_handle, 0, 0, &ref, &nVars[0]);
+        SMO_freeMemory(ref);
+        SMO_getNodeResult(ref_handle, 0, 0, &ref, &nVars[1]);
+        SMO_freeMemory(ref);
+        SMO_getLinkResult(ref_handle, 0, 0, &ref, &nVars[2]);
+        SMO_freeMemory(ref);
+
+        for (int type = 0; type < 4; type++) {
+            int nElements = (type < 3) ? size[type] : 1;
+            int nAttrs = (type < 3) ? nVars[type] : SMO_p_evap_rate;
+            for (int i = 0; i < nElements; i++) {
+                for (int a = 0; a < nAttrs; a++) {
+                    int m, n;
+                    switch (type) {
+                    case 0:
+                        SMO_getSubcatchSeries(ref_handle, i,
+                            (SMO_subcatchAttribute)a, start, end, &ref, &m);
+                        err = SMO_getSubcatchSeries(p_handle, i,
+                            (SMO_subcatchAttribute)a, start, end, &test, &n);
+                        break;
+                    case 1:
+                        SMO_getNodeSeries(ref_handle, i,
+                            (SMO_nodeAttribute)a, start, end, &ref, &m);
+                        err = SMO_getNodeSeries(p_handle, i,
+                            (SMO_nodeAttribute)a, start, end, &test, &n);
+                        break;
+                    case 2:
+                        SMO_getLinkSeries(ref_handle, i,
+                            (SMO_linkAttribute)a, start, end, &ref, &m);
+                        err = SMO_getLinkSeries(p_handle, i,
+                            (SMO_linkAttribute)a, start, end, &test, &n);
+                        break;
+                    default:
+                        SMO_getSystemSeries(ref_handle,
+                            (SMO_systemAttribute)a, start, end, &ref, &m);
+                        err = SMO_getSystemSeries(p_handle,
+                            (SMO_systemAttribute)a, start, end, &test, &n);
+                    }
+                    BOOST_REQUIRE(err == 0);
+                    BOOST_REQUIRE(m == n);
+                    for (int k = 0; k < n; k++)
+                        BOOST_REQUIRE(test[k] == ref[k]);
+                    SMO_freeMemory(ref);
+                    SMO_freeMemory(test);
+                }
+            }
+        }
+        SMO_freeMemory(size);
+    }
+
+    SMO_Handle ref_handle;
+    SMO_Handle p_handle;
+};
+
+BOOST_AUTO_TEST_SUITE(test_output_transpose)
+
+BOOST_FIXTURE_TEST_CASE(test_transpose, FixtureTranspose) {
+    int nPeriods;
+
+    SMO_getTimes(ref_handle, SMO_numPeriods, &nPeriods);
+    BOOST_REQUIRE(SMO_transpose(p_handle) == 0);
+    std::ifstream companion(DATA_PATH_COMPANION);
+    BOOST_REQUIRE(companion.good());
+
+    checkSeries(0, nPeriods);
+    checkSeries(3, 7);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_transpose_reopen, FixtureTranspose) {
+    int nPeriods;
+
+    SMO_getTimes(ref_handle, SMO_numPeriods, &nPeriods);
+    BOOST_REQUIRE(SMO_transpose(p_handle) == 0);
+
+    // --- a newly opened handle finds the companion file on its own
+    SMO_close(p_handle);
+    SMO_init(&p_handle);
+    BOOST_REQUIRE(SMO_open(p_handle, DATA_PATH_TRANSPOSED) == 0);
+    checkSeries(1, nPeriods);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+// Queries a file from several threads at once, each through a handle
+// shared from one mapped parent, and compares every batch with the
+// series read through the reference handle
+void checkSharedBatches(SMO_Handle ref_handle, const char *path) {
+    const int nThreads = 4, rounds = 50;
+    int *size, length, nNodes, nPeriods;
+    char *msg;
+    SMO_Handle parent;
+
+    SMO_getProjectSize(ref_handle, &size, &length);
+    nNodes = size[1];
+    SMO_freeMemory(size);
+    SMO_getTimes(ref_handle, SMO_numPeriods, &nPeriods);
+
+    std::vector<std::vector<float>> ref(nNodes);
+    for (int i = 0; i < nNodes; i++) {
+        float *series;
+        int n;
+        SMO_getNodeSeries(ref_handle, i, SMO_hydraulic_head, 0, nPeriods,
+            &series, &n);
+        ref[i].assign(series, series + n);
+        SMO_freeMemory(series);
+    }
+
+    SMO_init(&parent);
+    BOOST_REQUIRE(SMO_openMapped(parent, path) == 0);
+    std::vector<SMO_Handle> shared(nThreads);
+    for (int t = 0; t < nThreads; t++) {
+        SMO_init(&shared[t]);
+        BOOST_REQUIRE(SMO_openShared(shared[t], parent) == 0);
+    }
+
+    std::vector<int> errors(nThreads, 0), mismatches(nThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; t++)
+        threads.emplace_back([&, t]() {
+            // --- each thread walks its own windows of periods so that
+            //     the chunks decoded by the handles keep changing
+            for (int r = 0; r < rounds; r++) {
+                int start = (7 * t + 3 * r) % (nPeriods - 1);
+                int end = std::min(nPeriods, start + 1 + r % 11);
+                int len = end - start;
+                std::vector<int> nodes;
+                for (int i = (t + r) % nNodes; i < nNodes; i += 2)
+                    nodes.push_back(i);
+                std::vector<float> batch(nodes.size() * len);
+                if (SMO_getSeriesBatch(shared[t], SMO_node, nodes.data(),
+                        (int)nodes.size(), SMO_hydraulic_head, start, end,
+                        batch.data()) != 0) {
+                    errors[t]++;
+                    continue;
+                }
+                for (size_t i = 0; i < nodes.size(); i++)
+                    for (int k = 0; k < len; k++)
+                        if (batch[i * len + k] != ref[nodes[i]][start + k])
+                            mismatches[t]++;
+            }
+
+            // --- a failed request only sets its own handle's error
+            int bad = -1;
+            float value;
+            if (SMO_getSeriesBatch(shared[t], SMO_node, &bad, 1,
+                    SMO_hydraulic_head, 0, 1, &value) != 423)
+                errors[t]++;
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    for (int t = 0; t < nThreads; t++) {
+        BOOST_CHECK(errors[t] == 0);
+        BOOST_CHECK(mismatches[t] == 0);
+    }
+    BOOST_CHECK(SMO_checkError(parent, &msg) == 0);
+
+    // --- shared handles can't replace the parent's companion file
+    BOOST_CHECK(SMO_transpose(shared[0]) == 437);
+    for (int t = 0; t < nThreads; t++)
+        SMO_close(shared[t]);
+
+    // --- the parent still reads its mapping once they are closed
+    std::vector<float> last(nPeriods);
+    int node = nNodes - 1;
+    BOOST_REQUIRE(SMO_getSeriesBatch(parent, SMO_node, &node, 1,
+        SMO_hydraulic_head, 0, nPeriods, last.data()) == 0);
+    BOOST_CHECK(last == ref[node]);
+    SMO_close(parent);
+}
+
+
+// A mapped handle must return the same results as a stdio one
+struct FixtureMapped {
+    FixtureMapped() {
+        SMO_init(&ref_handle);
+        SMO_open(ref_handle, DATA_PATH);
+        SMO_init(&p_handle);
+        error = SMO_openMapped(p_handle, DATA_PATH);
+        SMO_getTimes(ref_handle, SMO_numPeriods, &nPeriods);
+    }
+    ~FixtureMapped() {
+        SMO_close(ref_handle);
+        SMO_close(p_handle);
+    }
+
+    int        error;
+    int        nPeriods;
+    SMO_Handle ref_handle;
+    SMO_Handle p_handle;
+};
+
+BOOST_AUTO_TEST_SUITE(test_output_mapped)
+
+BOOST_FIXTURE_TEST_CASE(test_mappedResults, FixtureMapped) {
+    float *test, *ref;
+    int m, n;
+
+    BOOST_REQUIRE(error == 0);
+    SMO_getNodeResult(ref_handle, 5, 3, &ref, &m);
+    SMO_getNodeResult(p_handle, 5, 3, &test, &n);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+
+    SMO_getLinkSeries(ref_handle, 2, SMO_flow_rate_link, 0, nPeriods, &ref, &m);
+    SMO_getLinkSeries(p_handle, 2, SMO_flow_rate_link, 0, nPeriods, &test, &n);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_getSeriesBatch, FixtureMapped) {
+    int *size, length;
+    int start = 2, end = nPeriods - 1, len = end - start;
+
+    SMO_getProjectSize(ref_handle, &size, &length);
+    std::vector<int> nodes;
+    for (int i = size[1] - 1; i >= 0; i -= 2)
+        nodes.push_back(i);
+    SMO_freeMemory(size);
+
+    std::vector<float> batch(nodes.size() * len);
+    error = SMO_getSeriesBatch(p_handle, SMO_node, nodes.data(),
+        (int)nodes.size(), SMO_invert_depth, start, end, batch.data());
+    BOOST_REQUIRE(error == 0);
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        float *ref;
+        int n;
+        SMO_getNodeSeries(ref_handle, nodes[i], SMO_invert_depth, start, end,
+            &ref, &n);
+        BOOST_REQUIRE(n == len);
+        for (int k = 0; k < n; k++)
+            BOOST_CHECK(batch[i * len + k] == ref[k]);
+        SMO_freeMemory(ref);
+    }
+
+    // --- an invalid index fails the whole request
+    nodes.push_back(-1);
+    error = SMO_getSeriesBatch(p_handle, SMO_node, nodes.data(),
+        (int)nodes.size(), SMO_invert_depth, start, end, batch.data());
+    BOOST_CHECK(error == 423);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_sharedBatch, FixtureMapped) {
+    checkSharedBatches(ref_handle, DATA_PATH);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_getSeriesView, FixtureMapped) {
+    const float *view;
+    float *ref;
+    int stride, n, m;
+
+    SMO_getSubcatchSeries(ref_handle, 1, SMO_runoff_rate, 0, nPeriods, &ref,
+        &m);
+    error = SMO_getSeriesView(p_handle, SMO_subcatch, 1, SMO_runoff_rate,
+        &view, &stride, &n);
+
+    // --- a view into the output file is only possible if its results
+    //     are aligned
+    if (error == 0) {
+        BOOST_REQUIRE(n == m);
+        for (int k = 0; k < n; k++)
+            BOOST_CHECK(view[(size_t)k * stride] == ref[k]);
+    }
+    else
+        BOOST_CHECK(error == 438);
+    SMO_freeMemory(ref);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE(test_output_mapped_transpose)
+
+BOOST_FIXTURE_TEST_CASE(test_getSeriesViewTransposed, FixtureTranspose) {
+    SMO_Handle mapped;
+    const float *view;
+    float *ref;
+    int stride, n, m, nPeriods;
+
+    SMO_getTimes(ref_handle, SMO_numPeriods, &nPeriods);
+    BOOST_REQUIRE(SMO_transpose(p_handle) == 0);
+    SMO_init(&mapped);
+    BOOST_REQUIRE(SMO_openMapped(mapped, DATA_PATH_TRANSPOSED) == 0);
+
+    // --- transposed results give a contiguous view of the series
+    SMO_getNodeSeries(ref_handle, 4, SMO_total_inflow, 0, nPeriods, &ref, &m);
+    BOOST_REQUIRE(SMO_getSeriesView(mapped, SMO_node, 4, SMO_total_inflow,
+        &view, &stride, &n) == 0);
+    BOOST_CHECK(stride == 1);
+    BOOST_REQUIRE(n == m);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(view[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_close(mapped);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+// A copy of the example file saving only some variables (runoff for
+// subcatchments, depth & quality for nodes and flow for links) must give
+// the same values for them and reject the others
+struct FixtureSelected {
+    FixtureSelected() {
+        writeSelected({4}, {0, 6, 7}, {0});
+        SMO_init(&ref_handle);
+        SMO_open(ref_handle, DATA_PATH);
+        SMO_init(&p_handle);
+        error = SMO_open(p_handle, DATA_PATH_SELECTED);
+        SMO_getTimes(ref_handle, SMO_numPeriods, &nPeriods);
+    }
+    ~FixtureSelected() {
+        SMO_close(ref_handle);
+        SMO_close(p_handle);
+        remove(DATA_PATH_SELECTED);
+    }
+
+    // Copies the example file keeping the listed variables of each type
+    // of element (the example saves all of its variables)
+    void writeSelected(std::vector<int> subcatchVars, std::vector<int> nodeVars,
+        std::vector<int> linkVars) {
+        std::ifstream in(DATA_PATH, std::ios::binary);
+        std::vector<char> src((std::istreambuf_iterator<char>(in)),
+            std::istreambuf_iterator<char>());
+        auto word = [&](size_t pos) {
+            int k;
+            memcpy(&k, &src[pos], 4);
+            return k;
+        };
+        size_t end = src.size();
+        int nCounts[3] = {word(12), word(16), word(20)};
+        int inputPos = word(end - 20), outputPos = word(end - 16);
+        int nPeriods = word(end - 12);
+
+        // --- the variable codes follow the elements' input data
+        size_t pos = inputPos + (nCounts[0] + 2) * 4 +
+                     (3 * nCounts[1] + 4) * 4 + (5 * nCounts[2] + 6) * 4;
+        std::vector<int> *kept[3] = {&subcatchVars, &nodeVars, &linkVars};
+        int nVars[3], nSys;
+        std::vector<char> out(src.begin(), src.begin() + pos);
+        auto put = [&](const void *x, size_t n) {
+            out.insert(out.end(), (const char *)x, (const char *)x + n);
+        };
+        for (int t = 0; t < 3; t++) {
+            nVars[t] = word(pos);
+            pos += 4 * (nVars[t] + 1);
+            int n = (int)kept[t]->size();
+            put(&n, 4);
+            put(kept[t]->data(), 4 * n);
+        }
+        nSys = word(pos);
+        put(&src[pos], (size_t)outputPos - pos);
+
+        // --- results of each period with only the kept variables
+        int newOutputPos = (int)out.size();
+        pos = outputPos;
+        for (int p = 0; p < nPeriods; p++) {
+            put(&src[pos], 8);
+            pos += 8;
+            for (int t = 0; t < 3; t++) {
+                for (int i = 0; i < nCounts[t]; i++) {
+                    for (int v : *kept[t])
+                        put(&src[pos + 4 * v], 4);
+                    pos += 4 * nVars[t];
+                }
+            }
+            put(&src[pos], 4 * nSys);
+            pos += 4 * nSys;
+        }
+        put(&src[end - 24], 8);
+        put(&newOutputPos, 4);
+        put(&src[end - 12], 12);
+
+        std::ofstream f(DATA_PATH_SELECTED, std::ios::binary);
+        f.write(out.data(), out.size());
+    }
+
+    int        error;
+    int        nPeriods;
+    SMO_Handle ref_handle;
+    SMO_Handle p_handle;
+};
+
+BOOST_AUTO_TEST_SUITE(test_output_selected)
+
+BOOST_FIXTURE_TEST_CASE(test_selectedSeries, FixtureSelected) {
+    float *test, *ref;
+    int m, n;
+
+    BOOST_REQUIRE(error == 0);
+    SMO_getNodeSeries(ref_handle, 3, SMO_invert_depth, 0, nPeriods, &ref, &m);
+    SMO_getNodeSeries(p_handle, 3, SMO_invert_depth, 0, nPeriods, &test, &n);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+
+    SMO_nodeAttribute lead = (SMO_nodeAttribute)(SMO_pollutant_conc_node + 1);
+    SMO_getNodeSeries(ref_handle, 3, lead, 0, nPeriods, &ref, &m);
+    SMO_getNodeSeries(p_handle, 3, lead, 0, nPeriods, &test, &n);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+
+    SMO_getSystemSeries(ref_handle, SMO_outfall_flows, 0, nPeriods, &ref, &m);
+    SMO_getSystemSeries(p_handle, SMO_outfall_flows, 0, nPeriods, &test, &n);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+
+    // --- variables that weren't saved are invalid parameters
+    BOOST_CHECK(SMO_getNodeSeries(p_handle, 3, SMO_hydraulic_head, 0,
+        nPeriods, &test, &n) == 421);
+    BOOST_CHECK(SMO_getSubcatchSeries(p_handle, 1, SMO_rainfall_subcatch, 0,
+        nPeriods, &test, &n) == 421);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_selectedResult, FixtureSelected) {
+    float *test, *ref;
+    int m, n;
+
+    // --- results of an element hold all of its attributes, with those
+    //     that weren't saved set to 0
+    SMO_getNodeResult(ref_handle, 10, 2, &ref, &m);
+    BOOST_REQUIRE(SMO_getNodeResult(p_handle, 10, 2, &test, &n) == 0);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++) {
+        if (k == SMO_invert_depth || k >= SMO_pollutant_conc_node)
+            BOOST_CHECK(test[k] == ref[k]);
+        else
+            BOOST_CHECK(test[k] == 0.0f);
+    }
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_selectedAttribute, FixtureSelected) {
+    float *test, *ref;
+    int m, n;
+
+    SMO_getLinkAttribute(ref_handle, 12, SMO_flow_rate_link, &ref, &m);
+    BOOST_REQUIRE(SMO_getLinkAttribute(p_handle, 12, SMO_flow_rate_link,
+        &test, &n) == 0);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+
+    SMO_getSubcatchAttribute(ref_handle, 12, SMO_runoff_rate, &ref, &m);
+    BOOST_REQUIRE(SMO_getSubcatchAttribute(p_handle, 12, SMO_runoff_rate,
+        &test, &n) == 0);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+
+    BOOST_CHECK(SMO_getLinkAttribute(p_handle, 12, SMO_flow_velocity,
+        &test, &n) == 421);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_selectedBatch, FixtureSelected) {
+    SMO_Handle mapped;
+    int nodes[] = {0, 5, 9};
+    int len = nPeriods;
+    std::vector<float> batch(3 * len);
+
+    SMO_init(&mapped);
+    BOOST_REQUIRE(SMO_openMapped(mapped, DATA_PATH_SELECTED) == 0);
+    BOOST_REQUIRE(SMO_getSeriesBatch(mapped, SMO_node, nodes, 3,
+        SMO_invert_depth, 0, len, batch.data()) == 0);
+    for (int i = 0; i < 3; i++) {
+        float *ref;
+        int n;
+        SMO_getNodeSeries(ref_handle, nodes[i], SMO_invert_depth, 0, len,
+            &ref, &n);
+        for (int k = 0; k < n; k++)
+            BOOST_CHECK(batch[i * len + k] == ref[k]);
+        SMO_freeMemory(ref);
+    }
+    BOOST_CHECK(SMO_getSeriesBatch(mapped, SMO_node, nodes, 3,
+        SMO_lateral_inflow, 0, len, batch.data()) == 421);
+    SMO_close(mapped);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+// A copy of the example file with its results compressed in chunks of a
+// few periods must give the same values as the example itself
+struct FixtureCompressed {
+    FixtureCompressed() {
+        writeCompressed(5);
+        SMO_init(&ref_handle);
+        SMO_open(ref_handle, DATA_PATH);
+        SMO_init(&p_handle);
+        error = SMO_open(p_handle, DATA_PATH_COMPRESSED);
+        SMO_getTimes(ref_handle, SMO_numPeriods, &nPeriods);
+    }
+    ~FixtureCompressed() {
+        SMO_close(ref_handle);
+        SMO_close(p_handle);
+        remove(DATA_PATH_COMPRESSED);
+    }
+
+    // Copies the example file encoding its results in chunks of the
+    // given number of periods, as the engine's writer does
+    void writeCompressed(int chunkPeriods) {
+        std::ifstream in(DATA_PATH, std::ios::binary);
+        std::vector<char> src((std::istreambuf_iterator<char>(in)),
+            std::istreambuf_iterator<char>());
+        size_t end = src.size();
+        int outputPos, periods;
+        memcpy(&outputPos, &src[end - 16], 4);
+        memcpy(&periods, &src[end - 12], 4);
+        int nWords = (int)((end - 24 - outputPos) / periods / 4);
+
+        std::vector<char> out(src.begin(), src.begin() + outputPos);
+        std::vector<long long> index;
+        auto put = [&](const void *x, size_t n) {
+            out.insert(out.end(), (const char *)x, (const char *)x + n);
+        };
+        for (int p = 0; p < periods; p += chunkPeriods) {
+            int header[2];
+            header[0] = std::min(chunkPeriods, periods - p);
+            std::vector<unsigned int> words((size_t)header[0] * nWords);
+            std::vector<unsigned char> packed(
+                outcodec_bound(header[0], nWords));
+            memcpy(words.data(), &src[outputPos + (size_t)p * nWords * 4],
+                words.size() * 4);
+            header[1] = (int)outcodec_encode(words.data(), header[0], nWords,
+                packed.data());
+            index.push_back((long long)out.size());
+            index.push_back(p);
+            put(header, 8);
+            put(packed.data(), header[1]);
+        }
+        long long indexPos = (long long)out.size();
+        int footer[2] = {(int)index.size() / 2, OUTCODEC_MAGIC};
+        put(index.data(), index.size() * 8);
+        put(&indexPos, 8);
+        put(footer, 8);
+        put(&src[end - 24], 24);
+
+        std::ofstream f(DATA_PATH_COMPRESSED, std::ios::binary);
+        f.write(out.data(), out.size());
+    }
+
+    int        error;
+    int        nPeriods;
+    SMO_Handle ref_handle;
+    SMO_Handle p_handle;
+};
+
+BOOST_AUTO_TEST_SUITE(test_output_compressed)
+
+BOOST_FIXTURE_TEST_CASE(test_compressedSeries, FixtureCompressed) {
+    float *test, *ref;
+    int m, n;
+
+    BOOST_REQUIRE(error == 0);
+    std::ifstream ref_file(DATA_PATH, std::ios::binary | std::ios::ate);
+    std::ifstream test_file(DATA_PATH_COMPRESSED,
+        std::ios::binary | std::ios::ate);
+    BOOST_CHECK(test_file.tellg() < ref_file.tellg());
+
+    SMO_getLinkSeries(ref_handle, 7, SMO_flow_rate_link, 0, nPeriods,
+        &ref, &m);
+    SMO_getLinkSeries(p_handle, 7, SMO_flow_rate_link, 0, nPeriods,
+        &test, &n);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+
+    SMO_getSystemSeries(ref_handle, SMO_runoff_flow, 3, nPeriods - 2,
+        &ref, &m);
+    SMO_getSystemSeries(p_handle, SMO_runoff_flow, 3, nPeriods - 2,
+        &test, &n);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_compressedResult, FixtureCompressed) {
+    float *test, *ref;
+    int m, n;
+
+    // --- every period of every chunk decodes to the original results
+    for (int p = 0; p < nPeriods; p++) {
+        SMO_getSubcatchResult(ref_handle, p, 2, &ref, &m);
+        BOOST_REQUIRE(SMO_getSubcatchResult(p_handle, p, 2, &test, &n) == 0);
+        BOOST_REQUIRE(m == n);
+        for (int k = 0; k < n; k++)
+            BOOST_CHECK(test[k] == ref[k]);
+        SMO_freeMemory(ref);
+        SMO_freeMemory(test);
+
+        SMO_getSystemResult(ref_handle, p, 0, &ref, &m);
+        SMO_getSystemResult(p_handle, p, 0, &test, &n);
+        BOOST_REQUIRE(m == n);
+        for (int k = 0; k < n; k++)
+            BOOST_CHECK(test[k] == ref[k]);
+        SMO_freeMemory(ref);
+        SMO_freeMemory(test);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_compressedBatch, FixtureCompressed) {
+    SMO_Handle mapped;
+    int nodes[] = {0, 5, 9};
+    int len = nPeriods;
+    std::vector<float> batch(3 * len);
+    const float *view;
+    int stride, n;
+
+    SMO_init(&mapped);
+    BOOST_REQUIRE(SMO_openMapped(mapped, DATA_PATH_COMPRESSED) == 0);
+    BOOST_REQUIRE(SMO_getSeriesBatch(mapped, SMO_node, nodes, 3,
+        SMO_hydraulic_head, 0, len, batch.data()) == 0);
+    for (int i = 0; i < 3; i++) {
+        float *ref;
+        SMO_getNodeSeries(ref_handle, nodes[i], SMO_hydraulic_head, 0, len,
+            &ref, &n);
+        for (int k = 0; k < n; k++)
+            BOOST_CHECK(batch[i * len + k] == ref[k]);
+        SMO_freeMemory(ref);
+    }
+
+    // --- compressed results can't be viewed in place
+    BOOST_CHECK(SMO_getSeriesView(mapped, SMO_node, 5, SMO_hydraulic_head,
+        &view, &stride, &n) == 438);
+    SMO_close(mapped);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_compressedSharedBatch, FixtureCompressed) {
+    checkSharedBatches(ref_handle, DATA_PATH_COMPRESSED);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_compressedTranspose, FixtureCompressed) {
+    float *test, *ref;
+    int m, n;
+    std::string companion = DATA_PATH_COMPRESSED;
+
+    BOOST_REQUIRE(SMO_transpose(p_handle) == 0);
+    SMO_getNodeSeries(ref_handle, 9, SMO_invert_depth, 0, nPeriods,
+        &ref, &m);
+    SMO_getNodeSeries(p_handle, 9, SMO_invert_depth, 0, nPeriods, &test, &n);
+    BOOST_REQUIRE(m == n);
+    for (int k = 0; k < n; k++)
+        BOOST_CHECK(test[k] == ref[k]);
+    SMO_freeMemory(ref);
+    SMO_freeMemory(test);
+    companion.replace(companion.size() - 4, 4, ".tsp");
+    remove(companion.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
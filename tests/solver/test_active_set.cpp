@@ -0,0 +1,80 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_active_set.cpp
+ Description:  tests for active set dynamic wave trials (ACTIVE_SET option)
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_ACTIVE "active_set.inp"
+#define NUM_DRY_CONDUITS 6
+
+using namespace std;
+
+
+// Lines that add a branch of conduits without inflow to an outfall
+static InpLines dryBranch()
+{
+    InpLines lines = {{"[OUTFALLS]", "DOUT 970 FREE NO\n"}};
+    for (int i = 1; i <= NUM_DRY_CONDUITS; i++)
+    {
+        string node = "D" + to_string(i);
+        string next = i < NUM_DRY_CONDUITS ? "D" + to_string(i + 1) : "DOUT";
+        lines.push_back({"[JUNCTIONS]",
+            node + " " + to_string(1000 - 4 * i) + " 3 0 0 0\n"});
+        lines.push_back({"[CONDUITS]",
+            "C" + node + " " + node + " " + next + " 400 0.01 0 0 0 0\n"});
+        lines.push_back({"[XSECTIONS]",
+            "C" + node + " CIRCULAR 1 0 0 0 1\n"});
+    }
+    return lines;
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_active_set)
+
+BOOST_AUTO_TEST_CASE(same_results) {
+    checkSameResults(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_ACTIVE,
+        {{"ACTIVE_SET", "YES"}}, 0.01);
+}
+
+// --- trials after the second only visit the conduits of nodes that
+//     haven't converged (the example converges within two trials, so a
+//     dry branch and a tighter head tolerance make it take more)
+BOOST_AUTO_TEST_CASE(skips_converged_links) {
+    InpOptions options = {{"HEAD_TOLERANCE", "0.0005"}};
+    InpLines lines = dryBranch();
+    RunResults ref, res;
+    size_t nSteps, nLinks;
+
+    writeInpCopy(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_ACTIVE, options, lines);
+    ref = runInpFile(DATA_PATH_INP_ACTIVE);
+    nSteps = ref.depths.size() / ref.maxDepths.size();
+    nLinks = ref.flows.size() / nSteps;
+    BOOST_REQUIRE(ref.trials > 0.0);
+    BOOST_CHECK_EQUAL(ref.linkTrials, ref.trials * nLinks);
+
+    options.push_back({"ACTIVE_SET", "YES"});
+    writeInpCopy(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_ACTIVE, options, lines);
+    res = runInpFile(DATA_PATH_INP_ACTIVE);
+    BOOST_REQUIRE(res.trials > 0.0);
+    BOOST_CHECK(res.linkTrials < res.trials * nLinks);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_value) {
+    checkInvalidOptions(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_ACTIVE,
+        {{"ACTIVE_SET", "SOMETIMES"}});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
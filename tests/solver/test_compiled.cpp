@@ -0,0 +1,114 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_compiled.cpp
+ Description:  tests for saving and running compiled project files
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_EXAMPLE "test_example1.inp"
+#define DATA_PATH_INP_COMPILED "compiled.inp"
+#define DATA_PATH_COMPILED "compiled.swc"
+
+using namespace std;
+
+
+// Copies an input file adding a control rule and a renumbering option
+static void writeCompiledInp(const char* inp, const char* renumber,
+    const char* compiledInp)
+{
+    writeInpCopy(inp, compiledInp, {{"RENUMBER", renumber}},
+        {{"", "[CONTROLS]\nRULE R1\nIF NODE 9 DEPTH > 0.5\n"
+              "THEN CONDUIT 1 STATUS = CLOSED\n"}});
+}
+
+// Checks that a project gives the same results when run from its input
+// file and from a compiled copy of it
+static void checkSameCompiled(const char* inp)
+{
+    RunResults ref, res;
+    int node, link;
+
+    BOOST_REQUIRE_EQUAL(swmm_open(inp, DATA_PATH_RPT, DATA_PATH_OUT), 0);
+    node = swmm_getIndex(swmm_NODE, "9");
+    link = swmm_getIndex(swmm_LINK, "1");
+    ref = runProject();
+
+    BOOST_REQUIRE_EQUAL(swmm_open(inp, DATA_PATH_RPT, ""), 0);
+    BOOST_REQUIRE_EQUAL(swmm_saveCompiled(DATA_PATH_COMPILED), 0);
+    swmm_close();
+
+    BOOST_REQUIRE_EQUAL(swmm_openCompiled(DATA_PATH_COMPILED, DATA_PATH_RPT,
+        DATA_PATH_OUT), 0);
+    BOOST_CHECK_EQUAL(swmm_getIndex(swmm_NODE, "9"), node);
+    BOOST_CHECK_EQUAL(swmm_getIndex(swmm_LINK, "1"), link);
+    res = runProject();
+    BOOST_CHECK(res.depths == ref.depths);
+    BOOST_CHECK(res.flows == ref.flows);
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_compiled)
+
+BOOST_AUTO_TEST_CASE(same_results) {
+    writeCompiledInp(DATA_PATH_INP_EXAMPLE, "NONE", DATA_PATH_INP_COMPILED);
+    checkSameCompiled(DATA_PATH_INP_COMPILED);
+}
+
+BOOST_AUTO_TEST_CASE(same_results_renumbered) {
+    writeCompiledInp(DATA_PATH_INP_EXAMPLE, "RCM", DATA_PATH_INP_COMPILED);
+    checkSameCompiled(DATA_PATH_INP_COMPILED);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_file) {
+    // --- a missing file, an input file and a truncated file are rejected
+    remove(DATA_PATH_COMPILED);
+    BOOST_CHECK(swmm_openCompiled(DATA_PATH_COMPILED, DATA_PATH_RPT,
+        DATA_PATH_OUT) != 0);
+    swmm_close();
+    BOOST_CHECK(swmm_openCompiled(DATA_PATH_INP_EXAMPLE, DATA_PATH_RPT,
+        DATA_PATH_OUT) != 0);
+    swmm_close();
+
+    BOOST_REQUIRE_EQUAL(swmm_open(DATA_PATH_INP_EXAMPLE, DATA_PATH_RPT, ""),
+        0);
+    BOOST_REQUIRE_EQUAL(swmm_saveCompiled(DATA_PATH_COMPILED), 0);
+    swmm_close();
+    {
+        ifstream in(DATA_PATH_COMPILED, ios::binary);
+        string data((istreambuf_iterator<char>(in)),
+                    istreambuf_iterator<char>());
+        in.close();
+        ofstream(DATA_PATH_COMPILED, ios::binary)
+            << data.substr(0, data.size() / 2);
+    }
+    BOOST_CHECK(swmm_openCompiled(DATA_PATH_COMPILED, DATA_PATH_RPT,
+        DATA_PATH_OUT) != 0);
+    swmm_close();
+}
+
+BOOST_AUTO_TEST_CASE(save_after_start) {
+    BOOST_CHECK(swmm_saveCompiled(DATA_PATH_COMPILED) != 0);
+    BOOST_REQUIRE_EQUAL(swmm_open(DATA_PATH_INP_EXAMPLE, DATA_PATH_RPT,
+        DATA_PATH_OUT), 0);
+    BOOST_REQUIRE_EQUAL(swmm_start(0), 0);
+    BOOST_CHECK(swmm_saveCompiled(DATA_PATH_COMPILED) != 0);
+    swmm_end();
+    swmm_close();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
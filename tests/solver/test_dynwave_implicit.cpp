@@ -0,0 +1,48 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_dynwave_implicit.cpp
+ Description:  tests for the implicit dynamic wave solver (DYNWAVE_IMPLICIT)
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_IMPLICIT "implicit.inp"
+
+
+BOOST_AUTO_TEST_SUITE(test_dynwave_implicit)
+
+BOOST_AUTO_TEST_CASE(same_results) {
+    const char* steps[2] = {"0:00:05", "0:01:00"};
+    for (const char* step : steps)
+        checkSameResults(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_IMPLICIT,
+            {{"FLOW_ROUTING", "DYNWAVE_IMPLICIT"}, {"ROUTING_STEP", step}},
+            0.1);
+}
+
+BOOST_AUTO_TEST_CASE(fixed_time_step) {
+    double elapsedTime = 0.0;
+    int steps = 0;
+
+    writeInpCopy(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_IMPLICIT,
+        {{"FLOW_ROUTING", "DYNWAVE_IMPLICIT"}, {"ROUTING_STEP", "0:01:00"}});
+    BOOST_REQUIRE_EQUAL(swmm_open(DATA_PATH_INP_IMPLICIT, DATA_PATH_RPT,
+        DATA_PATH_OUT), 0);
+    BOOST_REQUIRE_EQUAL(swmm_start(0), 0);
+    do { swmm_step(&elapsedTime); steps++; } while (elapsedTime > 0.0);
+    swmm_end();
+    swmm_close();
+
+    // --- one routing step per minute of the 36 hour simulation
+    BOOST_CHECK_EQUAL(steps, 36 * 60);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,130 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_geom_cache.cpp
+ Description:  tests for tabulated cross section geometry (GEOMETRY_CACHE option)
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <cmath>
+#include <fstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_CACHE "geom_cache.inp"
+#define DATA_PATH_INP_SHAPES "geom_cache_shapes.inp"
+
+// Depth & top width of the parabolic conduits (ft)
+#define PARAB_DEPTH 4.0
+#define PARAB_WIDTH 6.0
+
+// Max. interpolation error of a cached function, as a fraction of its
+// largest value (GEOM_TOL in xsect.c)
+#define GEOM_TOL 1.0e-4
+
+using namespace std;
+
+
+// Writes a chain of two parabolic conduits of the same size, a circular
+// and a rectangular one, fed by an inflow that rises & falls
+static void writeShapesInp(const char* cache)
+{
+    ofstream out(DATA_PATH_INP_SHAPES);
+
+    out << "[OPTIONS]\nFLOW_UNITS CFS\nFLOW_ROUTING DYNWAVE\n"
+           "START_DATE 01/01/2020\nEND_DATE 01/01/2020\nEND_TIME 06:00\n"
+           "ROUTING_STEP 0:00:10\nREPORT_STEP 0:15:00\n"
+           "GEOMETRY_CACHE " << cache << "\n";
+    out << "\n[JUNCTIONS]\nJ1 100 6\nJ2 99 6\nJ3 98 6\nJ4 97 6\n";
+    out << "\n[OUTFALLS]\nOUT 96 FREE\n";
+    out << "\n[CONDUITS]\nC1 J1 J2 500 0.015 0 0\nC2 J2 J3 500 0.015 0 0\n"
+           "C3 J3 J4 500 0.015 0 0\nC4 J4 OUT 500 0.015 0 0\n";
+    out << "\n[XSECTIONS]\n"
+           "C1 PARABOLIC " << PARAB_DEPTH << " " << PARAB_WIDTH << " 0 0\n"
+           "C2 PARABOLIC " << PARAB_DEPTH << " " << PARAB_WIDTH << " 0 0\n"
+           "C3 CIRCULAR 4 0 0 0\nC4 RECT_OPEN 4 6 0 0\n";
+    out << "\n[INFLOWS]\nJ1 FLOW TSQ FLOW 1.0 1.0\n";
+    out << "\n[TIMESERIES]\nTSQ 0:00 0\nTSQ 2:00 60\nTSQ 3:00 60\n"
+           "TSQ 5:00 0\n";
+}
+
+// Exact area of a parabolic conduit at a given depth (ft2)
+static double parabArea(double y)
+{
+    return 2.0 / 3.0 * PARAB_WIDTH * y * sqrt(y / PARAB_DEPTH);
+}
+
+// Runs the chain of conduits, returning the largest difference between
+// the area a parabolic conduit's velocity is found from and its exact
+// area, as a fraction of its full area
+static double maxParabAreaError(const char* cache, int nTables)
+{
+    double elapsedTime = 0.0, maxErr = 0.0, aFull = parabArea(PARAB_DEPTH);
+    int samples = 0;
+
+    writeShapesInp(cache);
+    BOOST_REQUIRE_EQUAL(swmm_open(DATA_PATH_INP_SHAPES, DATA_PATH_RPT,
+        DATA_PATH_OUT), 0);
+    BOOST_REQUIRE_EQUAL(swmm_start(0), 0);
+    BOOST_CHECK_EQUAL(swmm_getValue(swmm_GEOMTABLES, 0), nTables);
+    do
+    {
+        swmm_step(&elapsedTime);
+        for (int i = 0; i < 2; i++)
+        {
+            double y = swmm_getValue(swmm_LINK_DEPTH, i);
+            double q = fabs(swmm_getValue(swmm_LINK_FLOW, i));
+            double v = swmm_getValue(swmm_LINK_VELOCITY, i);
+            if (y < 0.1 * PARAB_DEPTH || y > PARAB_DEPTH || v <= 0.0)
+                continue;
+            maxErr = max(maxErr, fabs(q / v - parabArea(y)) / aFull);
+            samples++;
+        }
+    } while (elapsedTime > 0.0);
+    BOOST_CHECK_EQUAL(swmm_end(), 0);
+    swmm_close();
+    BOOST_REQUIRE(samples > 100);
+    return maxErr;
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_geom_cache)
+
+BOOST_AUTO_TEST_CASE(same_results) {
+    checkSameResults(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_CACHE,
+        {{"GEOMETRY_CACHE", "YES"}}, 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(off_is_exact) {
+    checkSameResults(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_CACHE,
+        {{"GEOMETRY_CACHE", "NO"}});
+}
+
+// --- one table is built for each distinct shape & size and areas found
+//     through it stay within GEOM_TOL of the exact function (which is
+//     what the areas match without the cache)
+BOOST_AUTO_TEST_CASE(cached_lookups) {
+    double err;
+
+    err = maxParabAreaError("NO", 0);
+    BOOST_CHECK_SMALL(err, 1.0e-9);
+
+    err = maxParabAreaError("YES", 3);
+    BOOST_CHECK(err > 1.0e-9);
+    BOOST_CHECK(err <= GEOM_TOL);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_value) {
+    checkInvalidOptions(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_CACHE,
+        {{"GEOMETRY_CACHE", "SOMETIMES"}});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_inp_reader.cpp
+ Description:  tests for reading input files with parallel section parsing
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_SERIAL "inp_reader_serial.inp"
+#define DATA_PATH_INP_READER "inp_reader.inp"
+#define DATA_PATH_INP_CHAIN "inp_reader_chain.inp"
+
+// More conduits than fit in one batch of lines parsed in parallel
+#define NUM_CHAIN_CONDUITS 1500
+
+using namespace std;
+
+
+// Writes a chain of conduits listed in reverse order, each with its own
+// length & diameter, read with a given number of threads & renumbering
+static void writeChainInp(int threads, const char* renumber)
+{
+    ofstream out(DATA_PATH_INP_CHAIN);
+    int n = NUM_CHAIN_CONDUITS;
+
+    out << "[OPTIONS]\nFLOW_UNITS CMS\nFLOW_ROUTING KINWAVE\n"
+           "START_DATE 01/01/2020\nEND_DATE 01/01/2020\nEND_TIME 01:00\n"
+           "THREADS " << threads << "\nRENUMBER " << renumber << "\n";
+    out << "\n[JUNCTIONS]\n";
+    for (int i = 0; i < n; i++)
+        out << "J" << i << " " << 1000.0 - i << " 2\n";
+    out << "\n[OUTFALLS]\nOUT " << 1000.0 - n << " FREE\n";
+    out << "\n[CONDUITS]\n";
+    for (int i = n - 1; i >= 0; i--)
+        out << "C" << i << " J" << i << " "
+            << (i + 1 < n ? "J" + to_string(i + 1) : string("OUT")) << " "
+            << 100 + i % 150 << " 0.013 0 0\n";
+    out << "\n[XSECTIONS]\n";
+    for (int i = n - 1; i >= 0; i--)
+        out << "C" << i << " CIRCULAR " << 0.5 + 0.1 * (i % 10)
+            << " 0 0 0\n";
+}
+
+// Checks that each conduit of the chain has the length, diameter & end
+// nodes that the input file gives it
+static void checkChain(int threads, const char* renumber)
+{
+    char name[64];
+
+    writeChainInp(threads, renumber);
+    BOOST_REQUIRE_EQUAL(swmm_open(DATA_PATH_INP_CHAIN, DATA_PATH_RPT,
+        DATA_PATH_OUT), 0);
+    BOOST_REQUIRE_EQUAL(swmm_getCount(swmm_LINK), NUM_CHAIN_CONDUITS);
+    for (int i = 0; i < NUM_CHAIN_CONDUITS; i++)
+    {
+        int k = swmm_getIndex(swmm_LINK, ("C" + to_string(i)).c_str());
+        BOOST_REQUIRE(k >= 0);
+        BOOST_CHECK_SMALL(swmm_getValue(swmm_LINK_LENGTH, k) -
+            (100 + i % 150), 1.0e-9);
+        BOOST_CHECK_SMALL(swmm_getValue(swmm_LINK_FULLDEPTH, k) -
+            (0.5 + 0.1 * (i % 10)), 1.0e-9);
+        swmm_getName(swmm_NODE, (int)swmm_getValue(swmm_LINK_NODE1, k),
+            name, 64);
+        BOOST_CHECK_EQUAL(name, "J" + to_string(i));
+    }
+    swmm_close();
+}
+
+
+// Opens a project that has input errors, returning the lines of its
+// report file that describe the errors
+static vector<string> readErrors(const char* inp)
+{
+    vector<string> errors;
+    string line;
+
+    BOOST_CHECK(swmm_open(inp, DATA_PATH_RPT, DATA_PATH_OUT) != 0);
+    swmm_close();
+    ifstream rpt(DATA_PATH_RPT);
+    while (getline(rpt, line))
+    {
+        if (line.find("ERROR") != string::npos)
+        {
+            errors.push_back(line);
+            if (getline(rpt, line)) errors.push_back(line);
+        }
+    }
+    return errors;
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_inp_reader)
+
+BOOST_AUTO_TEST_CASE(same_results) {
+    InpLines extra;
+
+    // --- a time series read along with the conduits & cross sections
+    extra.push_back(make_pair("[TIMESERIES]",
+        "TSQ 0 0.5\nTSQ 1 1.5\n\nTSQ 2 0.0\n"
+        "TSR 01/01/1998 0:00 1.0\n;comment\nTSQ 3 2.0\n"));
+
+    writeInpCopy(DATA_PATH_INP, DATA_PATH_INP_SERIAL, {{"THREADS", "1"}},
+        extra);
+    checkSameResults(DATA_PATH_INP_SERIAL, DATA_PATH_INP_READER,
+        {{"THREADS", "4"}});
+}
+
+BOOST_AUTO_TEST_CASE(many_conduits) {
+    const char* methods[2] = {"NONE", "RCM"};
+
+    // --- conduits past the first batch of lines get their own data
+    for (const char* method : methods)
+    {
+        checkChain(1, method);
+        checkChain(4, method);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(same_errors) {
+    vector<string> ref, res;
+    InpLines extra;
+
+    extra.push_back(make_pair("[CONDUITS]", "X1 9 NONE 400 0.01 0 0\n"));
+    extra.push_back(make_pair("[XSECTIONS]",
+        "X2 CIRCULAR 1 0 0 0\n\n1 CIRCULAR x 0 0 0\n"));
+    extra.push_back(make_pair("[TIMESERIES]", "TS1 1/1/1998 0:00 abc\n"));
+
+    // --- errors are reported in line order with the same line numbers
+    writeInpCopy(DATA_PATH_INP, DATA_PATH_INP_READER, {{"THREADS", "1"}},
+        extra);
+    ref = readErrors(DATA_PATH_INP_READER);
+    BOOST_CHECK_EQUAL(ref.size(), 8);
+    writeInpCopy(DATA_PATH_INP, DATA_PATH_INP_READER, {{"THREADS", "4"}},
+        extra);
+    res = readErrors(DATA_PATH_INP_READER);
+    BOOST_CHECK_EQUAL_COLLECTIONS(ref.begin(), ref.end(),
+                                  res.begin(), res.end());
+}
+
+BOOST_AUTO_TEST_CASE(max_errors) {
+    vector<string> ref, res;
+    InpLines extra;
+    string lines;
+
+    for (int i = 0; i < 150; i++)
+        lines += "L" + to_string(i) + " CIRCULAR 1 0 0 0\n";
+    extra.push_back(make_pair("[XSECTIONS]", lines));
+
+    // --- reading stops once the maximum error count is exceeded
+    writeInpCopy(DATA_PATH_INP, DATA_PATH_INP_READER, {{"THREADS", "1"}},
+        extra);
+    ref = readErrors(DATA_PATH_INP_READER);
+    writeInpCopy(DATA_PATH_INP, DATA_PATH_INP_READER, {{"THREADS", "4"}},
+        extra);
+    res = readErrors(DATA_PATH_INP_READER);
+    BOOST_CHECK_EQUAL(ref.size(), 200);
+    BOOST_CHECK_EQUAL_COLLECTIONS(ref.begin(), ref.end(),
+                                  res.begin(), res.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
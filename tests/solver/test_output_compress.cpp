@@ -0,0 +1,105 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_output_compress.cpp
+ Description:  tests for compressed binary output results
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_PLAIN "output_plain.inp"
+#define DATA_PATH_INP_COMPRESS "output_compress.inp"
+#define DATA_PATH_OUT_COMPRESS "output_compress.out"
+
+using namespace std;
+
+
+// Copies the example input file reporting every minute, so that results
+// span several compressed chunks, with or without compression
+static void writeCompressInp(const char* path, bool compress)
+{
+    writeInpCopy(DATA_PATH_INP, path, {{"REPORT_STEP", "00:01:00"},
+        {"COMPRESS_OUTPUT", compress ? "YES" : "NO"}});
+}
+
+static long fileSize(const char* path)
+{
+    ifstream f(path, ios::binary | ios::ate);
+    return (long)f.tellg();
+}
+
+// Reads the saved dates, node depths, link flows & subcatchment runoff
+// of every period from the current project's output file
+static vector<double> savedValues(int nPeriods)
+{
+    vector<double> values;
+    for (int p = 1; p <= nPeriods; p++)
+    {
+        values.push_back(swmm_getSavedValue(swmm_CURRENTDATE, 0, p));
+        for (int i = 0; i < swmm_getCount(swmm_NODE); i++)
+            values.push_back(swmm_getSavedValue(swmm_NODE_DEPTH, i, p));
+        for (int i = 0; i < swmm_getCount(swmm_LINK); i++)
+            values.push_back(swmm_getSavedValue(swmm_LINK_FLOW, i, p));
+        for (int i = 0; i < swmm_getCount(swmm_SUBCATCH); i++)
+            values.push_back(swmm_getSavedValue(swmm_SUBCATCH_RUNOFF, i, p));
+    }
+    return values;
+}
+
+// Runs an input file, returning the saved values of all of its periods
+static vector<double> runSaved(const char* inp, const char* out)
+{
+    vector<double> values;
+    double elapsedTime = 0.0;
+    int error;
+
+    BOOST_REQUIRE_EQUAL(swmm_open(inp, DATA_PATH_RPT, out), 0);
+    BOOST_REQUIRE_EQUAL(swmm_start(1), 0);
+    do
+    {
+        error = swmm_step(&elapsedTime);
+    } while (elapsedTime > 0.0 && !error);
+    BOOST_REQUIRE_EQUAL(error, 0);
+    BOOST_REQUIRE_EQUAL(swmm_end(), 0);
+
+    // --- 36 hours reported every minute
+    values = savedValues(36 * 60);
+    BOOST_CHECK_EQUAL(swmm_getSavedValue(swmm_CURRENTDATE, 0, 36 * 60 + 1),
+        0.0);
+    swmm_close();
+    return values;
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_output_compress)
+
+BOOST_AUTO_TEST_CASE(same_results)
+{
+    writeCompressInp(DATA_PATH_INP_PLAIN, false);
+    writeCompressInp(DATA_PATH_INP_COMPRESS, true);
+    vector<double> plain = runSaved(DATA_PATH_INP_PLAIN, DATA_PATH_OUT);
+    vector<double> compressed = runSaved(DATA_PATH_INP_COMPRESS,
+        DATA_PATH_OUT_COMPRESS);
+
+    // --- compression is lossless
+    BOOST_REQUIRE_EQUAL(compressed.size(), plain.size());
+    BOOST_CHECK(compressed == plain);
+    BOOST_CHECK(compressed[0] > 0.0);
+
+    BOOST_CHECK(fileSize(DATA_PATH_OUT_COMPRESS) <
+                fileSize(DATA_PATH_OUT) / 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_output_transposed.cpp
+ Description:  tests that transposed results files (.tsp) made from an
+               earlier run are never used for a rerun's output file
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+#include "swmm_output.h"
+
+#define DATA_PATH_INP_RERUN "transposed_rerun.inp"
+#define DATA_PATH_OUT_RERUN "transposed_rerun.out"
+#define DATA_PATH_TSP_RERUN "transposed_rerun.tsp"
+
+using namespace std;
+
+
+// Copies the example input file with a given rainfall intensity at 3:00
+static void writeRerunInp(const char* intensity)
+{
+    ifstream in(DATA_PATH_INP);
+    ofstream out(DATA_PATH_INP_RERUN);
+    string line;
+    while (getline(in, line))
+    {
+        if (line.compare(0, 3, "TS1") == 0 &&
+            line.find(" 3:00 ") != string::npos)
+            line = string("TS1 3:00 ") + intensity;
+        out << line << "\n";
+    }
+}
+
+// Reads the total inflow series of every node from the rerun's output
+// file, optionally transposing its results first
+static vector<float> readInflows(bool transpose)
+{
+    SMO_Handle handle = NULL;
+    vector<float> inflows;
+    int *size, n, nPeriods;
+    float *series;
+
+    SMO_init(&handle);
+    BOOST_REQUIRE_EQUAL(SMO_open(handle, DATA_PATH_OUT_RERUN), 0);
+    if (transpose) BOOST_REQUIRE_EQUAL(SMO_transpose(handle), 0);
+    SMO_getProjectSize(handle, &size, &n);
+    SMO_getTimes(handle, SMO_numPeriods, &nPeriods);
+    for (int i = 0; i < size[1]; i++)
+    {
+        BOOST_REQUIRE_EQUAL(SMO_getNodeSeries(handle, i, SMO_total_inflow, 0,
+            nPeriods, &series, &n), 0);
+        inflows.insert(inflows.end(), series, series + n);
+        SMO_freeMemory(series);
+    }
+    SMO_freeMemory(size);
+    SMO_close(handle);
+    return inflows;
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_output_transposed)
+
+BOOST_AUTO_TEST_CASE(rerun_updates_series) {
+    vector<float> before, after;
+    string stale;
+
+    writeRerunInp("0.8");
+    BOOST_REQUIRE_EQUAL(swmm_run(DATA_PATH_INP_RERUN, DATA_PATH_RPT,
+        DATA_PATH_OUT_RERUN), 0);
+    before = readInflows(true);
+    stale = readFile(DATA_PATH_TSP_RERUN);
+    BOOST_REQUIRE(stale.size() > 0);
+
+    // --- rerunning the model removes the transposed results
+    writeRerunInp("2.8");
+    BOOST_REQUIRE_EQUAL(swmm_run(DATA_PATH_INP_RERUN, DATA_PATH_RPT,
+        DATA_PATH_OUT_RERUN), 0);
+    BOOST_CHECK(!ifstream(DATA_PATH_TSP_RERUN).good());
+    after = readInflows(false);
+    BOOST_REQUIRE_EQUAL(after.size(), before.size());
+    BOOST_CHECK(after != before);
+
+    // --- transposed results made from the earlier run's output file of
+    //     the same size are ignored
+    ofstream(DATA_PATH_TSP_RERUN, ios::binary) << stale;
+    BOOST_CHECK(readInflows(false) == after);
+    BOOST_CHECK(readInflows(true) == after);
+    BOOST_CHECK(readInflows(false) == after);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_output_vars.cpp
+ Description:  tests for saving selected result variables to the output file
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_VARS "output_vars.inp"
+#define DATA_PATH_OUT_VARS "output_vars.out"
+
+// Example 1 has 2 pollutants, whose concentrations follow the 8 fixed
+// subcatchment, 6 node and 5 link variables
+#define NUM_POLLUTS 2
+
+using namespace std;
+
+
+// Copies the example input file with the given lines added to [REPORT]
+static void writeVarsInp(const vector<string>& options)
+{
+    InpLines lines;
+    for (const string& option : options)
+        lines.push_back(make_pair("[REPORT]", option + "\n"));
+    writeInpCopy(DATA_PATH_INP, DATA_PATH_INP_VARS, InpOptions(), lines);
+}
+
+static long fileSize(const char* path)
+{
+    ifstream f(path, ios::binary | ios::ate);
+    return (long)f.tellg();
+}
+
+struct SavedResults
+{
+    int nPeriods;
+    vector<double> depth, head, flow, velocity, runoff, rainfall;
+};
+
+// Runs an input file, collecting saved node, link & subcatchment results
+static SavedResults runSaved(const char* inp, const char* out)
+{
+    SavedResults r;
+    BOOST_REQUIRE_EQUAL(swmm_open(inp, DATA_PATH_RPT, out), 0);
+    BOOST_REQUIRE_EQUAL(swmm_start(1), 0);
+    double elapsedTime = 0.0;
+    int error;
+    do
+    {
+        error = swmm_step(&elapsedTime);
+    } while (elapsedTime > 0.0 && !error);
+    BOOST_REQUIRE_EQUAL(error, 0);
+    BOOST_REQUIRE_EQUAL(swmm_end(), 0);
+
+    r.nPeriods = 0;
+    while (swmm_getSavedValue(swmm_CURRENTDATE, 0, r.nPeriods + 1) > 0.0)
+        r.nPeriods++;
+    for (int p = 1; p <= r.nPeriods; p++)
+    {
+        for (int i = 0; i < swmm_getCount(swmm_NODE); i++)
+        {
+            r.depth.push_back(swmm_getSavedValue(swmm_NODE_DEPTH, i, p));
+            r.head.push_back(swmm_getSavedValue(swmm_NODE_HEAD, i, p));
+        }
+        for (int i = 0; i < swmm_getCount(swmm_LINK); i++)
+        {
+            r.flow.push_back(swmm_getSavedValue(swmm_LINK_FLOW, i, p));
+            r.velocity.push_back(swmm_getSavedValue(swmm_LINK_VELOCITY, i, p));
+        }
+        for (int i = 0; i < swmm_getCount(swmm_SUBCATCH); i++)
+        {
+            r.runoff.push_back(swmm_getSavedValue(swmm_SUBCATCH_RUNOFF, i, p));
+            r.rainfall.push_back(
+                swmm_getSavedValue(swmm_SUBCATCH_RAINFALL, i, p));
+        }
+    }
+    swmm_close();
+    return r;
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_output_vars)
+
+BOOST_AUTO_TEST_CASE(selected_variables)
+{
+    SavedResults all = runSaved(DATA_PATH_INP, DATA_PATH_OUT);
+    long allSize = fileSize(DATA_PATH_OUT);
+    long nSubcatch = (long)all.runoff.size() / all.nPeriods;
+    long nNodes = (long)all.depth.size() / all.nPeriods;
+    long nLinks = (long)all.flow.size() / all.nPeriods;
+
+    writeVarsInp({"VARIABLES SUBCATCHMENTS RUNOFF",
+                  "VARIABLES NODES DEPTH QUALITY",
+                  "VARIABLES LINKS FLOW"});
+    SavedResults some = runSaved(DATA_PATH_INP_VARS, DATA_PATH_OUT_VARS);
+    BOOST_REQUIRE_EQUAL(some.nPeriods, all.nPeriods);
+
+    // --- selected variables are saved as before, others read back as 0
+    for (size_t k = 0; k < all.depth.size(); k++)
+    {
+        BOOST_CHECK_EQUAL(some.depth[k], all.depth[k]);
+        BOOST_CHECK_EQUAL(some.head[k], 0.0);
+    }
+    for (size_t k = 0; k < all.flow.size(); k++)
+    {
+        BOOST_CHECK_EQUAL(some.flow[k], all.flow[k]);
+        BOOST_CHECK_EQUAL(some.velocity[k], 0.0);
+    }
+    for (size_t k = 0; k < all.runoff.size(); k++)
+    {
+        BOOST_CHECK_EQUAL(some.runoff[k], all.runoff[k]);
+        BOOST_CHECK_EQUAL(some.rainfall[k], 0.0);
+    }
+
+    // --- the file shrinks by the codes & values of the dropped variables
+    long droppedCodes = (8 - 1 + NUM_POLLUTS) + (6 - 1) +
+                        (5 - 1 + NUM_POLLUTS);
+    long droppedValues = nSubcatch * (8 - 1 + NUM_POLLUTS) +
+                         nNodes * (6 - 1) +
+                         nLinks * (5 - 1 + NUM_POLLUTS);
+    BOOST_CHECK_EQUAL(fileSize(DATA_PATH_OUT_VARS), allSize -
+        4 * droppedCodes - 4 * droppedValues * (long)all.nPeriods);
+}
+
+BOOST_AUTO_TEST_CASE(all_variables)
+{
+    SavedResults all = runSaved(DATA_PATH_INP, DATA_PATH_OUT);
+    long allSize = fileSize(DATA_PATH_OUT);
+
+    // --- listing every variable saves the same file as the default
+    writeVarsInp({"VARIABLES NODES DEPTH HEAD VOLUME",
+                  "VARIABLES NODES LATERAL_INFLOW TOTAL_INFLOW FLOODING",
+                  "VARIABLES NODES QUALITY",
+                  "VARIABLES LINKS ALL"});
+    SavedResults some = runSaved(DATA_PATH_INP_VARS, DATA_PATH_OUT_VARS);
+    BOOST_CHECK_EQUAL(fileSize(DATA_PATH_OUT_VARS), allSize);
+    BOOST_CHECK(some.head == all.head);
+    BOOST_CHECK(some.velocity == all.velocity);
+}
+
+BOOST_AUTO_TEST_CASE(unknown_variable)
+{
+    writeVarsInp({"VARIABLES NODES DEPTH STAGE"});
+    BOOST_CHECK(swmm_open(DATA_PATH_INP_VARS, DATA_PATH_RPT,
+        DATA_PATH_OUT_VARS) > 0);
+    swmm_close();
+
+    writeVarsInp({"VARIABLES GAGES RAINFALL"});
+    BOOST_CHECK(swmm_open(DATA_PATH_INP_VARS, DATA_PATH_RPT,
+        DATA_PATH_OUT_VARS) > 0);
+    swmm_close();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
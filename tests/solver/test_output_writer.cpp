@@ -0,0 +1,95 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_output_writer.cpp
+ Description:  tests for the background writer of binary output results
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_WRITER "output_writer.inp"
+
+using namespace std;
+
+
+// Copies the example input file reporting every minute so that results
+// span several of the writer's buffers
+static void writeWriterInp(bool averages)
+{
+    InpLines lines;
+    if (averages) lines.push_back(make_pair("[REPORT]", "AVERAGES YES\n"));
+    writeInpCopy(DATA_PATH_INP, DATA_PATH_INP_WRITER,
+        {{"REPORT_STEP", "00:01:00"}}, lines);
+}
+
+// Runs the copied input file, checking that every reporting period was
+// saved in order and that the last one holds the final node depths
+static void checkSavedResults(bool averages)
+{
+    vector<double> depths;
+    double elapsedTime = 0.0;
+    int nNodes, error;
+
+    writeWriterInp(averages);
+    BOOST_REQUIRE_EQUAL(swmm_open(DATA_PATH_INP_WRITER, DATA_PATH_RPT,
+        DATA_PATH_OUT), 0);
+    BOOST_REQUIRE_EQUAL(swmm_start(1), 0);
+    nNodes = swmm_getCount(swmm_NODE);
+    do
+    {
+        error = swmm_step(&elapsedTime);
+    } while (elapsedTime > 0.0 && !error);
+    BOOST_REQUIRE_EQUAL(error, 0);
+    for (int i = 0; i < nNodes; i++)
+        depths.push_back(swmm_getValue(swmm_NODE_DEPTH, i));
+    BOOST_REQUIRE_EQUAL(swmm_end(), 0);
+
+    // --- 36 hours reported every minute
+    int nPeriods = 36 * 60;
+    double step = 1.0 / 1440.0;
+    double date0 = swmm_getSavedValue(swmm_CURRENTDATE, 0, 1);
+    BOOST_CHECK(date0 > 0.0);
+    for (int p = 2; p <= nPeriods; p++)
+    {
+        double date = swmm_getSavedValue(swmm_CURRENTDATE, 0, p);
+        BOOST_REQUIRE_SMALL(date - (date0 + (p - 1) * step), 1.0e-6);
+    }
+    BOOST_CHECK_EQUAL(swmm_getSavedValue(swmm_CURRENTDATE, 0, nPeriods + 1),
+        0.0);
+
+    for (int i = 0; i < nNodes; i++)
+    {
+        double saved = swmm_getSavedValue(swmm_NODE_DEPTH, i, nPeriods);
+        if (averages) BOOST_CHECK(saved >= 0.0);
+        else BOOST_CHECK_SMALL(saved - depths[i], 1.0e-4);
+    }
+    swmm_close();
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_output_writer)
+
+BOOST_AUTO_TEST_CASE(point_results)
+{
+    checkSavedResults(false);
+}
+
+BOOST_AUTO_TEST_CASE(average_results)
+{
+    checkSavedResults(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_parallel_routing.cpp
+ Description:  tests that parallel routing results don't depend on the
+               number of threads (MIN_PARALLEL_LINKS & THREADS options)
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <fstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_PARALLEL "parallel_routing.inp"
+#define DATA_PATH_OUT_SERIAL "parallel_serial.out"
+#define DATA_PATH_OUT_THREADS "parallel_threads.out"
+
+using namespace std;
+
+
+BOOST_AUTO_TEST_SUITE(test_parallel_routing)
+
+// --- the trials of a time step give the same results whether they are
+//     carried out by one thread or shared by a team of threads
+BOOST_AUTO_TEST_CASE(same_results) {
+    checkSameResults(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_PARALLEL,
+        {{"THREADS", "2"}, {"MIN_PARALLEL_LINKS", "0"}});
+}
+
+// --- the binary output file is the same for any number of threads, with
+//     either dynamic wave solver
+BOOST_AUTO_TEST_CASE(same_output_files) {
+    const char* routings[2] = {"DYNWAVE", "DYNWAVE_IMPLICIT"};
+    const char* inp = DATA_PATH_INP_PARALLEL;
+    string ref;
+
+    for (const char* routing : routings)
+    {
+        writeInpCopy(DATA_PATH_INP_DYNWAVE, inp, {{"THREADS", "1"},
+            {"MIN_PARALLEL_LINKS", "0"}, {"FLOW_ROUTING", routing}});
+        BOOST_REQUIRE_EQUAL(swmm_run(inp, DATA_PATH_RPT,
+            DATA_PATH_OUT_SERIAL), 0);
+        ref = readFile(DATA_PATH_OUT_SERIAL);
+        BOOST_REQUIRE(ref.size() > 0);
+        for (int threads = 2; threads <= 4; threads++)
+        {
+            writeInpCopy(DATA_PATH_INP_DYNWAVE, inp,
+                {{"THREADS", to_string(threads)},
+                 {"MIN_PARALLEL_LINKS", "0"}, {"FLOW_ROUTING", routing}});
+            BOOST_REQUIRE_EQUAL(swmm_run(inp, DATA_PATH_RPT,
+                DATA_PATH_OUT_THREADS), 0);
+            BOOST_CHECK(readFile(DATA_PATH_OUT_THREADS) == ref);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_value) {
+    checkInvalidOptions(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_PARALLEL,
+        {{"THREADS", "2"}, {"MIN_PARALLEL_LINKS", "-1"}});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_project.cpp
+ Description:  tests for the reentrant (project handle) API functions
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_DYNWAVE "test_ex1_metric_dynwave.inp"
+
+using namespace std;
+
+
+// Runs a project step by step and returns the final depth at every node
+static vector<double> runToEnd(SWMM_Project* p, const char* inp,
+    const char* rpt, const char* out)
+{
+    vector<double> depths;
+    double elapsedTime = 0.0;
+    int n;
+
+    BOOST_REQUIRE_EQUAL(swmm_open_r(p, inp, rpt, out), 0);
+    BOOST_REQUIRE_EQUAL(swmm_start_r(p, 1), 0);
+    do swmm_step_r(p, &elapsedTime); while (elapsedTime > 0.0);
+    n = swmm_getCount_r(p, swmm_NODE);
+    for (int i = 0; i < n; i++)
+        depths.push_back(swmm_getValue_r(p, swmm_NODE_DEPTH, i));
+    swmm_end_r(p);
+    swmm_close_r(p);
+    return depths;
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_project)
+
+BOOST_AUTO_TEST_CASE(create_delete) {
+    SWMM_Project* p = NULL;
+
+    BOOST_CHECK_EQUAL(swmm_createProject(&p), 0);
+    BOOST_REQUIRE(p != NULL);
+    BOOST_CHECK_EQUAL(swmm_getCount_r(p, swmm_NODE), 0);
+
+    // --- deleting an open project closes it first
+    BOOST_CHECK_EQUAL(swmm_open_r(p, DATA_PATH_INP, "p.rpt", "p.out"), 0);
+    BOOST_CHECK_EQUAL(swmm_deleteProject(p), 0);
+}
+
+BOOST_AUTO_TEST_CASE(projects_are_independent) {
+    SWMM_Project *p1, *p2;
+    double t1 = 0.0, t2 = 0.0;
+
+    swmm_createProject(&p1);
+    swmm_createProject(&p2);
+    BOOST_REQUIRE_EQUAL(swmm_open_r(p1, DATA_PATH_INP, "p1.rpt", "p1.out"), 0);
+    BOOST_REQUIRE_EQUAL(
+        swmm_open_r(p2, DATA_PATH_INP_DYNWAVE, "p2.rpt", "p2.out"), 0);
+
+    // --- default project is untouched
+    BOOST_CHECK_EQUAL(swmm_getCount(swmm_NODE), 0);
+    BOOST_CHECK_EQUAL(swmm_getIndex_r(p1, swmm_NODE, "9"), 0);
+    BOOST_CHECK_EQUAL(swmm_getIndex_r(p2, swmm_NODE, "9"), 0);
+
+    // --- interleave steps of the two projects
+    swmm_start_r(p1, 0);
+    swmm_start_r(p2, 0);
+    for (int i = 0; i < 50; i++)
+    {
+        swmm_step_r(p1, &t1);
+        swmm_step_r(p2, &t2);
+    }
+    BOOST_CHECK(t1 != t2);
+
+    swmm_end_r(p1);
+    swmm_end_r(p2);
+    swmm_deleteProject(p1);
+    swmm_deleteProject(p2);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_runs) {
+    const char* inp[2] = {DATA_PATH_INP, DATA_PATH_INP_DYNWAVE};
+    vector<double> ref[2], res[2];
+    SWMM_Project* p[2];
+
+    // --- reference results from runs made one after the other
+    for (int k = 0; k < 2; k++)
+    {
+        swmm_createProject(&p[k]);
+        ref[k] = runToEnd(p[k], inp[k], "ref.rpt", "ref.out");
+    }
+
+    // --- same runs made at the same time on separate threads
+    vector<thread> workers;
+    for (int k = 0; k < 2; k++)
+    {
+        workers.emplace_back([&, k]() {
+            string rpt = "thread" + to_string(k) + ".rpt";
+            string out = "thread" + to_string(k) + ".out";
+            res[k] = runToEnd(p[k], inp[k], rpt.c_str(), out.c_str());
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    for (int k = 0; k < 2; k++)
+    {
+        BOOST_CHECK_EQUAL_COLLECTIONS(ref[k].begin(), ref[k].end(),
+            res[k].begin(), res[k].end());
+        swmm_deleteProject(p[k]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
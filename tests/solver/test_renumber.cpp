@@ -0,0 +1,129 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_renumber.cpp
+ Description:  tests for renumbering of nodes & links (RENUMBER option)
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_RENUMBERED "renumbered.inp"
+
+using namespace std;
+
+
+// Runs a project to completion, returning each node's total inflow volume
+static vector<double> nodeTotalInflows(const char* inp)
+{
+    vector<double> inflows;
+    double elapsedTime = 0.0, value;
+
+    BOOST_REQUIRE_EQUAL(swmm_open(inp, DATA_PATH_RPT, DATA_PATH_OUT), 0);
+    BOOST_REQUIRE_EQUAL(swmm_start(0), 0);
+    do swmm_step(&elapsedTime); while (elapsedTime > 0.0);
+    for (int i = 0; i < swmm_getCount(swmm_NODE); i++)
+    {
+        BOOST_REQUIRE_EQUAL(swmm_getNodeTotalInflow(i, &value), 0);
+        inflows.push_back(value);
+    }
+    BOOST_CHECK(swmm_getNodeTotalInflow(swmm_getCount(swmm_NODE), &value)
+        != 0);
+    swmm_end();
+    swmm_close();
+    return inflows;
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_renumber)
+
+BOOST_AUTO_TEST_CASE(indexes_follow_input_order) {
+    const char* methods[2] = {"BFS", "RCM"};
+    vector<string> names[2];
+    vector<int> ends;
+    char name[64];
+    char* id = NULL;
+    int node1, node2;
+
+    // --- names & end nodes without renumbering
+    BOOST_REQUIRE_EQUAL(swmm_open(DATA_PATH_INP_DYNWAVE, DATA_PATH_RPT,
+        DATA_PATH_OUT), 0);
+    for (int t = 0; t < 2; t++)
+        for (int i = 0; i < swmm_getCount(swmm_NODE + t); i++)
+        {
+            swmm_getName(swmm_NODE + t, i, name, 64);
+            names[t].push_back(name);
+        }
+    for (int i = 0; i < swmm_getCount(swmm_LINK); i++)
+    {
+        ends.push_back((int)swmm_getValue(swmm_LINK_NODE1, i));
+        ends.push_back((int)swmm_getValue(swmm_LINK_NODE2, i));
+    }
+    swmm_close();
+
+    for (const char* method : methods)
+    {
+        writeInpCopy(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_RENUMBERED,
+            {{"RENUMBER", method}});
+        BOOST_REQUIRE_EQUAL(swmm_open(DATA_PATH_INP_RENUMBERED, DATA_PATH_RPT,
+            DATA_PATH_OUT), 0);
+        for (int t = 0; t < 2; t++)
+        {
+            int n = swmm_getCount(swmm_NODE + t);
+            BOOST_REQUIRE_EQUAL(n, (int)names[t].size());
+            for (int i = 0; i < n; i++)
+            {
+                swmm_getName(swmm_NODE + t, i, name, 64);
+                BOOST_CHECK_EQUAL(names[t][i], name);
+                BOOST_CHECK_EQUAL(swmm_getIndex(swmm_NODE + t, name), i);
+                BOOST_CHECK_EQUAL(swmm_getObjectId((SM_ObjectType)(SM_NODE + t),
+                    i, &id), 0);
+                BOOST_CHECK_EQUAL(names[t][i], id);
+                swmm_freeMemory(id);
+            }
+        }
+        for (int i = 0; i < swmm_getCount(swmm_LINK); i++)
+        {
+            BOOST_CHECK_EQUAL((int)swmm_getValue(swmm_LINK_NODE1, i), ends[2*i]);
+            BOOST_CHECK_EQUAL((int)swmm_getValue(swmm_LINK_NODE2, i), ends[2*i+1]);
+            swmm_getLinkConnections(i, &node1, &node2);
+            BOOST_CHECK_EQUAL(node1, ends[2*i]);
+            BOOST_CHECK_EQUAL(node2, ends[2*i+1]);
+        }
+        swmm_close();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(same_results) {
+    checkSameResults(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_RENUMBERED,
+        {{"RENUMBER", "RCM"}}, 1.0e-6);
+}
+
+BOOST_AUTO_TEST_CASE(node_total_inflows) {
+    vector<double> ref, res;
+
+    ref = nodeTotalInflows(DATA_PATH_INP_DYNWAVE);
+    writeInpCopy(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_RENUMBERED,
+        {{"RENUMBER", "RCM"}});
+    res = nodeTotalInflows(DATA_PATH_INP_RENUMBERED);
+    BOOST_REQUIRE_EQUAL(ref.size(), res.size());
+    for (size_t i = 0; i < ref.size(); i++)
+        BOOST_CHECK_SMALL(res[i] - ref[i], 1.0e-6 * (ref[i] + 1.0));
+}
+
+BOOST_AUTO_TEST_CASE(unknown_method) {
+    checkInvalidOptions(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_RENUMBERED,
+        {{"RENUMBER", "SIDEWAYS"}});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
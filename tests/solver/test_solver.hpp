@@ -14,6 +14,14 @@
 #ifndef TEST_SOLVER_HPP
 #define TEST_SOLVER_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
 extern "C" {
 #include "swmm5.h"
 #include "toolkit.h"
@@ -21,6 +29,7 @@ extern "C" {
 
 // Add shared data paths here
 #define DATA_PATH_INP "test_example1.inp"
+#define DATA_PATH_INP_DYNWAVE "test_ex1_metric_dynwave.inp"
 #define DATA_PATH_INP_POLLUT_NODE "node_constantinflow_constanteffluent.inp"
 #define DATA_PATH_INP_POLLUT_LINK "link_constantinflow.inp"
 #define DATA_PATH_INP_LINK_DIR "link_flow_dir.inp"
@@ -124,6 +133,159 @@ struct FixtureBeforeStep_Inlets{
 };
 
 
+// Options set in a copy of an input file, as (name, value) pairs
+typedef std::vector<std::pair<std::string, std::string>> InpOptions;
+
+// Lines added to a copy of an input file, as (heading, text) pairs
+typedef std::vector<std::pair<std::string, std::string>> InpLines;
+
+// Copies an input file, setting options and adding lines to it. An
+// option replaces the line that sets it or else is added to [OPTIONS].
+// The text of each (heading, text) pair is added after the line that
+// starts with the heading (or at the end of the file if it is empty).
+inline void writeInpCopy(const char* inp, const char* copy,
+    const InpOptions& options, const InpLines& lines = InpLines())
+{
+    std::ifstream in(inp);
+    std::vector<std::string> inpLines;
+    std::vector<bool> isSet(options.size(), false);
+    std::string line;
+
+    // --- replace the lines of options set in the file
+    while (getline(in, line))
+    {
+        for (size_t i = 0; i < options.size(); i++)
+        {
+            const std::string& name = options[i].first;
+            if (line.compare(0, name.size(), name) == 0 &&
+                line.size() > name.size() &&
+                (line[name.size()] == ' ' || line[name.size()] == '\t'))
+            {
+                line = name + " " + options[i].second;
+                isSet[i] = true;
+            }
+        }
+        inpLines.push_back(line);
+    }
+
+    std::ofstream out(copy);
+    for (const std::string& inpLine : inpLines)
+    {
+        out << inpLine << "\n";
+        if (inpLine.compare(0, 9, "[OPTIONS]") == 0)
+            for (size_t i = 0; i < options.size(); i++)
+                if (!isSet[i])
+                    out << options[i].first << " " << options[i].second
+                        << "\n";
+        for (const auto& added : lines)
+            if (!added.first.empty() &&
+                inpLine.compare(0, added.first.size(), added.first) == 0)
+                out << added.second;
+    }
+    for (const auto& added : lines)
+        if (added.first.empty()) out << "\n" << added.second;
+}
+
+// Reads the contents of a binary file
+inline std::string readFile(const char* fname)
+{
+    std::ifstream in(fname, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+}
+
+// Results of a project run to completion
+struct RunResults {
+    std::vector<double> depths;       // depth of each node after each step
+    std::vector<double> flows;        // flow in each link after each step
+    std::vector<double> maxDepths;    // max. depth reached at each node
+    float               flowErr;      // flow routing continuity error
+    double              trials;       // routing trials over all steps
+    double              linkTrials;   // links visited by those trials
+};
+
+// Runs the opened project to completion and closes it
+inline RunResults runProject()
+{
+    RunResults r;
+    double elapsedTime = 0.0;
+    float runoffErr, qualErr;
+    int nNodes, nLinks;
+
+    BOOST_REQUIRE_EQUAL(swmm_start(1), 0);
+    nNodes = swmm_getCount(swmm_NODE);
+    nLinks = swmm_getCount(swmm_LINK);
+    r.maxDepths.assign(nNodes, 0.0);
+    do
+    {
+        swmm_step(&elapsedTime);
+        for (int i = 0; i < nNodes; i++)
+        {
+            double depth = swmm_getValue(swmm_NODE_DEPTH, i);
+            r.depths.push_back(depth);
+            r.maxDepths[i] = std::max(r.maxDepths[i], depth);
+        }
+        for (int i = 0; i < nLinks; i++)
+            r.flows.push_back(swmm_getValue(swmm_LINK_FLOW, i));
+    } while (elapsedTime > 0.0);
+    r.trials = swmm_getValue(swmm_TRIALS, 0);
+    r.linkTrials = swmm_getValue(swmm_LINKTRIALS, 0);
+    BOOST_CHECK_EQUAL(swmm_end(), 0);
+    swmm_getMassBalErr(&runoffErr, &r.flowErr, &qualErr);
+    swmm_close();
+    return r;
+}
+
+// Opens an input file and runs it to completion
+inline RunResults runInpFile(const char* inp)
+{
+    BOOST_REQUIRE_EQUAL(swmm_open(inp, DATA_PATH_RPT, DATA_PATH_OUT), 0);
+    return runProject();
+}
+
+// Checks that a copy of an input file with some options set gives the
+// same results as the file itself: identical results at every step if
+// tol is 0, otherwise node depths & link flows within a relative
+// tolerance tol (at every step if both runs take the same steps, else
+// for the max. node depths) and a flow continuity error within 10 * tol
+// percent
+inline void checkSameResults(const char* inp, const char* copy,
+    const InpOptions& options, double tol = 0.0)
+{
+    RunResults ref = runInpFile(inp);
+    writeInpCopy(inp, copy, options);
+    RunResults res = runInpFile(copy);
+
+    BOOST_REQUIRE_EQUAL(ref.maxDepths.size(), res.maxDepths.size());
+    if (tol == 0.0)
+    {
+        BOOST_CHECK_EQUAL(res.flowErr, ref.flowErr);
+        BOOST_CHECK(res.depths == ref.depths);
+        BOOST_CHECK(res.flows == ref.flows);
+        return;
+    }
+    BOOST_CHECK_SMALL(res.flowErr - ref.flowErr, (float)(10.0 * tol));
+    for (size_t i = 0; i < ref.maxDepths.size(); i++)
+        BOOST_CHECK_SMALL(res.maxDepths[i] - ref.maxDepths[i],
+            tol * ref.maxDepths[i] + 0.001);
+    if (res.depths.size() != ref.depths.size()) return;
+    for (size_t i = 0; i < ref.depths.size(); i++)
+        BOOST_CHECK_SMALL(res.depths[i] - ref.depths[i],
+            tol * (std::abs(ref.depths[i]) + 1.0));
+    for (size_t i = 0; i < ref.flows.size(); i++)
+        BOOST_CHECK_SMALL(res.flows[i] - ref.flows[i],
+            tol * (std::abs(ref.flows[i]) + 1.0));
+}
+
+// Checks that a copy of an input file with some options set is rejected
+inline void checkInvalidOptions(const char* inp, const char* copy,
+    const InpOptions& options, const InpLines& lines = InpLines())
+{
+    writeInpCopy(inp, copy, options, lines);
+    BOOST_CHECK(swmm_open(copy, DATA_PATH_RPT, DATA_PATH_OUT) != 0);
+    swmm_close();
+}
+
 
 // Declare shared test predicates here
 boost::test_tools::predicate_result check_cdd_double(std::vector<double>& test,
@@ -0,0 +1,67 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_step_classes.cpp
+ Description:  tests for local time stepping of conduits (TIME_STEP_CLASSES option)
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_CLASSES "step_classes.inp"
+#define BASE_INFLOW "0.2"
+
+using namespace std;
+
+
+BOOST_AUTO_TEST_SUITE(test_step_classes)
+
+BOOST_AUTO_TEST_CASE(same_results) {
+    checkSameResults(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_CLASSES,
+        {{"TIME_STEP_CLASSES", "4"}}, 0.01);
+}
+
+// --- conduits in slower classes are held over some time steps, so
+//     fewer links are visited per trial than the model has (without
+//     ACTIVE_SET held conduits are the only links left out of a trial).
+//     The example's conduits are nearly dry too often to be held, so
+//     base inflows keep them flowing.
+BOOST_AUTO_TEST_CASE(holds_slow_conduits) {
+    InpLines lines = {{"", "[INFLOWS]\n"}};
+    RunResults ref, res;
+    size_t nSteps, nLinks;
+
+    for (const char* node : {"9", "13", "19", "23"})
+        lines.back().second += string(node) + " FLOW \"\" FLOW 1.0 1.0 " +
+            BASE_INFLOW + "\n";
+    writeInpCopy(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_CLASSES, {}, lines);
+    ref = runInpFile(DATA_PATH_INP_CLASSES);
+    nSteps = ref.depths.size() / ref.maxDepths.size();
+    nLinks = ref.flows.size() / nSteps;
+    BOOST_REQUIRE(ref.trials > 0.0);
+    BOOST_CHECK_EQUAL(ref.linkTrials, ref.trials * nLinks);
+
+    writeInpCopy(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_CLASSES,
+        {{"TIME_STEP_CLASSES", "4"}}, lines);
+    res = runInpFile(DATA_PATH_INP_CLASSES);
+    BOOST_REQUIRE(res.trials > 0.0);
+    BOOST_CHECK(res.linkTrials < res.trials * nLinks);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_value) {
+    const char* values[2] = {"0", "9"};
+    for (const char* value : values)
+        checkInvalidOptions(DATA_PATH_INP_DYNWAVE, DATA_PATH_INP_CLASSES,
+            {{"TIME_STEP_CLASSES", value}});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
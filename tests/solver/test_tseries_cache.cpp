@@ -0,0 +1,119 @@
+/*
+ ******************************************************************************
+ Project:      OWA SWMM
+ Version:      5.2.4
+ Module:       test_tseries_cache.cpp
+ Description:  tests for cached time series data files (TIMESERIES_CACHE option)
+ Authors:      see AUTHORS
+ Copyright:    see AUTHORS
+ License:      see LICENSE
+ Last Updated: 10/16/2026
+ ******************************************************************************
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#ifdef _WIN32
+  #include <sys/utime.h>
+#else
+  #include <utime.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_solver.hpp"
+
+#define DATA_PATH_INP_UNCACHED "tseries_uncached.inp"
+#define DATA_PATH_INP_TSERIES "tseries_cache.inp"
+#define DATA_PATH_TSERIES "tseries_cache.dat"
+#define DATA_PATH_TSERIES_CACHE "tseries_cache.dat.tsb"
+
+using namespace std;
+
+
+// Writes a data file of 1-minute inflows spanning the example's duration,
+// with the inflow of its first nEdited entries set to 5
+static void writeInflowFile(const char* fname, int nEdited = 0)
+{
+    ofstream out(fname);
+    char line[64];
+    for (int m = 0; m <= 36 * 60; m++)
+    {
+        snprintf(line, sizeof(line), "01/%02d/1998 %02d:%02d %.4f",
+                 1 + m / 1440, (m % 1440) / 60, m % 60,
+                 m < nEdited ? 5.0 : 1.0 + sin(m / 50.0));
+        out << line << "\n";
+    }
+}
+
+// Copies an input file adding an inflow time series read from a data file
+// and a TIMESERIES_CACHE option
+static void writeTseriesCache(const char* inp, const char* value,
+    const char* cacheInp)
+{
+    writeInpCopy(inp, cacheInp, {{"TIMESERIES_CACHE", value}},
+        {{"[TIMESERIES]", "TSQ FILE " DATA_PATH_TSERIES "\n"},
+         {"", "[INFLOWS]\n9 FLOW TSQ FLOW 1.0 1.0\n"}});
+}
+
+
+BOOST_AUTO_TEST_SUITE(test_tseries_cache)
+
+BOOST_AUTO_TEST_CASE(same_results) {
+    writeInflowFile(DATA_PATH_TSERIES);
+    remove(DATA_PATH_TSERIES_CACHE);
+    writeTseriesCache(DATA_PATH_INP, "NO", DATA_PATH_INP_UNCACHED);
+    runInpFile(DATA_PATH_INP_UNCACHED);
+    BOOST_CHECK(!ifstream(DATA_PATH_TSERIES_CACHE).good());
+
+    // --- first run creates the cache, second run reads it
+    checkSameResults(DATA_PATH_INP_UNCACHED, DATA_PATH_INP_TSERIES,
+        {{"TIMESERIES_CACHE", "YES"}});
+    BOOST_CHECK(ifstream(DATA_PATH_TSERIES_CACHE).good());
+    checkSameResults(DATA_PATH_INP_UNCACHED, DATA_PATH_INP_TSERIES,
+        {{"TIMESERIES_CACHE", "YES"}});
+}
+
+BOOST_AUTO_TEST_CASE(stale_cache) {
+    // --- a cache that doesn't match its data file is replaced
+    writeInflowFile(DATA_PATH_TSERIES);
+    writeTseriesCache(DATA_PATH_INP, "NO", DATA_PATH_INP_UNCACHED);
+    ofstream(DATA_PATH_TSERIES_CACHE) << "not a cache";
+    checkSameResults(DATA_PATH_INP_UNCACHED, DATA_PATH_INP_TSERIES,
+        {{"TIMESERIES_CACHE", "YES"}});
+}
+
+BOOST_AUTO_TEST_CASE(same_size_edit) {
+    struct stat st;
+    struct utimbuf times;
+    RunResults ref;
+
+    // --- cache a data file
+    writeInflowFile(DATA_PATH_TSERIES);
+    writeTseriesCache(DATA_PATH_INP, "YES", DATA_PATH_INP_TSERIES);
+    ref = runInpFile(DATA_PATH_INP_TSERIES);
+    BOOST_REQUIRE_EQUAL(stat(DATA_PATH_TSERIES, &st), 0);
+
+    // --- an edit that keeps the file's size and modification time
+    //     still invalidates the cache
+    writeInflowFile(DATA_PATH_TSERIES, 100);
+    times.actime = st.st_atime;
+    times.modtime = st.st_mtime;
+    BOOST_REQUIRE_EQUAL(utime(DATA_PATH_TSERIES, &times), 0);
+    writeTseriesCache(DATA_PATH_INP, "NO", DATA_PATH_INP_UNCACHED);
+    checkSameResults(DATA_PATH_INP_UNCACHED, DATA_PATH_INP_TSERIES,
+        {{"TIMESERIES_CACHE", "YES"}});
+    BOOST_CHECK(runInpFile(DATA_PATH_INP_TSERIES).depths != ref.depths);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_value) {
+    checkInvalidOptions(DATA_PATH_INP, DATA_PATH_INP_TSERIES,
+        {{"TIMESERIES_CACHE", "SOMETIMES"}});
+}
+
+BOOST_AUTO_TEST_SUITE_END()